@@ -0,0 +1,550 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef LIBPLDM_BEJ_H
+#define LIBPLDM_BEJ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Binary Encoded JSON (BEJ) support for RDE payloads, see DSP0218 section 8.
+ *
+ * Dictionaries are the raw blobs returned by GetSchemaDictionary and
+ * MultipartReceive, as handed to the callback of
+ * pldm_rde_push_get_dictionary_response(). A trailing checksum is ignored.
+ */
+
+/* Containers nested deeper than this are rejected */
+#define PLDM_BEJ_MAX_DEPTH 32
+
+/* Largest fixed-size value (integer, real, enum, ...) the decoder buffers */
+#define PLDM_BEJ_MAX_SCALAR_LENGTH 64
+
+/* Reals with more leading zeros in their fraction than this are rejected. A
+ * double underflows past 324. */
+#define PLDM_BEJ_MAX_LEADING_ZEROS 324
+
+#define PLDM_BEJ_VERSION_1_0 0xf1f0f000
+#define PLDM_BEJ_VERSION_1_1 0xf1f1f000
+
+enum pldm_bej_format {
+	PLDM_BEJ_FORMAT_SET = 0x0,
+	PLDM_BEJ_FORMAT_ARRAY = 0x1,
+	PLDM_BEJ_FORMAT_NULL = 0x2,
+	PLDM_BEJ_FORMAT_INTEGER = 0x3,
+	PLDM_BEJ_FORMAT_ENUM = 0x4,
+	PLDM_BEJ_FORMAT_STRING = 0x5,
+	PLDM_BEJ_FORMAT_REAL = 0x6,
+	PLDM_BEJ_FORMAT_BOOLEAN = 0x7,
+	PLDM_BEJ_FORMAT_BYTE_STRING = 0x8,
+	PLDM_BEJ_FORMAT_CHOICE = 0x9,
+	PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION = 0xa,
+	PLDM_BEJ_FORMAT_REGISTRY_ITEM = 0xb,
+	PLDM_BEJ_FORMAT_RESOURCE_LINK = 0xe,
+	PLDM_BEJ_FORMAT_RESOURCE_LINK_EXPANSION = 0xf,
+};
+
+/** @brief A schema dictionary, borrowed from the caller */
+struct pldm_bej_dictionary {
+	const uint8_t *data;
+	size_t length;
+};
+
+/* Index of a dictionary's root entry */
+#define PLDM_BEJ_DICTIONARY_ROOT 0
+
+/**
+ * @brief Parsed form of a dictionary
+ *
+ * Holds a copy of the dictionary, its entry table split into one array per
+ * field and hash tables resolving a child by sequence number or by name in
+ * constant time. An index is a single position-independent block of
+ * pldm_bej_dictionary_index_size() bytes starting at the index pointer, so
+ * it can be written to a file and mapped by any number of processes with
+ * pldm_bej_dictionary_index_load(). The layout depends on the host byte
+ * order.
+ */
+struct pldm_bej_dictionary_index;
+
+/** @brief A dictionary entry, entries are numbered from the root at 0 */
+struct pldm_bej_dictionary_entry {
+	enum pldm_bej_format format;
+	/* Nullable, read-only and deferred binding flags */
+	uint8_t flags;
+	uint16_t sequence;
+	/* Number of the first child entry */
+	uint16_t children;
+	uint16_t child_count;
+	/* Points into the index, "" for array members */
+	const char *name;
+};
+
+/**
+ * @brief Index a dictionary
+ *
+ * @param[in] dictionary - Dictionary to index, validated and copied here
+ * @param[out] index - Set to the new index, release it with
+ * pldm_bej_dictionary_index_free()
+ *
+ * @return 0 on success, -EINVAL for invalid arguments, -EPROTO if the
+ * dictionary is malformed, -ENOMEM if the index could not be allocated
+ */
+int pldm_bej_dictionary_index_build(
+	const struct pldm_bej_dictionary *dictionary,
+	struct pldm_bej_dictionary_index **index);
+
+/**
+ * @brief Use an index image in place, e.g. from a mapped file
+ *
+ * The image is checked against the dictionary it carries without allocating
+ * or copying, and must stay mapped while the index is in use.
+ *
+ * @param[in] data - Image of an index, aligned to 8 bytes
+ * @param[in] length - Length of @p data
+ * @param[out] index - Set to the index within @p data
+ *
+ * @return 0 on success, -EINVAL for invalid arguments or a misaligned image,
+ * -EPROTO if the image is truncated, corrupt or from another byte order
+ */
+int pldm_bej_dictionary_index_load(
+	const void *data, size_t length,
+	const struct pldm_bej_dictionary_index **index);
+
+/** @brief Length of the image of @p index */
+size_t pldm_bej_dictionary_index_size(
+	const struct pldm_bej_dictionary_index *index);
+
+/**
+ * @brief Release an index built by pldm_bej_dictionary_index_build()
+ *
+ * Loaded indexes belong to their image and are not released.
+ */
+void pldm_bej_dictionary_index_free(struct pldm_bej_dictionary_index *index);
+
+/**
+ * @brief Get the copy of the dictionary held by @p index
+ *
+ * @return 0 on success, -EINVAL for invalid arguments
+ */
+int pldm_bej_dictionary_index_dictionary(
+	const struct pldm_bej_dictionary_index *index,
+	struct pldm_bej_dictionary *dictionary);
+
+/**
+ * @brief Describe entry number @p entry
+ *
+ * @return 0 on success, -EINVAL for invalid arguments, -ENOENT if there is no
+ * such entry
+ */
+int pldm_bej_dictionary_index_entry(
+	const struct pldm_bej_dictionary_index *index, uint16_t entry,
+	struct pldm_bej_dictionary_entry *out);
+
+/**
+ * @brief Find the child of @p parent with sequence number @p sequence
+ *
+ * @return 0 with the entry number in @p child, -EINVAL for invalid arguments,
+ * -ENOENT if there is no such child
+ */
+int pldm_bej_dictionary_index_child(
+	const struct pldm_bej_dictionary_index *index, uint16_t parent,
+	uint16_t sequence, uint16_t *child);
+
+/**
+ * @brief Find the child of @p parent named @p name
+ *
+ * @return 0 with the entry number in @p child, -EINVAL for invalid arguments,
+ * -ENOENT if there is no such child
+ */
+int pldm_bej_dictionary_index_find(
+	const struct pldm_bej_dictionary_index *index, uint16_t parent,
+	const char *name, uint16_t *child);
+
+enum pldm_bej_token_type {
+	PLDM_BEJ_TOKEN_OBJECT_START,
+	PLDM_BEJ_TOKEN_OBJECT_END,
+	PLDM_BEJ_TOKEN_ARRAY_START,
+	PLDM_BEJ_TOKEN_ARRAY_END,
+	PLDM_BEJ_TOKEN_NULL,
+	PLDM_BEJ_TOKEN_INTEGER,
+	PLDM_BEJ_TOKEN_REAL,
+	PLDM_BEJ_TOKEN_BOOLEAN,
+	PLDM_BEJ_TOKEN_ENUM,
+	PLDM_BEJ_TOKEN_STRING,
+	PLDM_BEJ_TOKEN_BYTE_STRING,
+	PLDM_BEJ_TOKEN_RESOURCE_LINK,
+};
+
+/**
+ * @brief A decoded BEJ value
+ *
+ * Names point into the dictionaries and stay valid as long as they do. String
+ * and byte string values point into the chunk being decoded and are only
+ * valid during the callback. Long values are delivered as several tokens of
+ * the same type, all but the first with @p continued set and all but the last
+ * with @p more set.
+ */
+struct pldm_bej_token {
+	enum pldm_bej_token_type type;
+	/* Property name, NULL for the outermost value, array members and the
+	 * *_END tokens */
+	const char *name;
+	/* Annotation name for property annotations ("name@annotation") */
+	const char *annotation;
+	/* Number of containers enclosing the value */
+	unsigned int depth;
+	bool continued;
+	bool more;
+	union {
+		int64_t integer;
+		bool boolean;
+		/* whole.<leading_zeros x '0'>fract e exponent */
+		struct {
+			int64_t whole;
+			uint64_t fract;
+			uint64_t leading_zeros;
+			int64_t exponent;
+		} real;
+		/* Enumeration option name */
+		const char *enumeration;
+		/* Fragment of a string without its NUL terminator, or of a
+		 * byte string */
+		struct {
+			const uint8_t *data;
+			size_t length;
+		} bytes;
+		uint32_t resource_id;
+	} value;
+};
+
+/**
+ * @brief Receives the tokens of a BEJ payload
+ *
+ * @return 0 to continue decoding, a negative errno value to abort. The value
+ * is returned by the pldm_bej_decoder_*() call that emitted the token.
+ */
+typedef int (*pldm_bej_token_fn)(void *arg,
+				 const struct pldm_bej_token *token);
+
+struct pldm_bej_frame {
+	const struct pldm_bej_dictionary *dictionary;
+	/* Offset and count of the dictionary entries the members resolve to */
+	uint16_t children;
+	uint16_t child_count;
+	uint8_t format;
+	const char *annotated;
+	uint64_t end;
+	uint64_t remaining;
+};
+
+/**
+ * @brief Push-style BEJ decoder
+ *
+ * The decoder keeps no references to the chunks pushed into it and needs no
+ * heap memory, so a payload of any size decodes in sizeof(struct
+ * pldm_bej_decoder). Members are private to the implementation.
+ */
+struct pldm_bej_decoder {
+	struct pldm_bej_dictionary schema;
+	struct pldm_bej_dictionary annotation;
+	const struct pldm_bej_dictionary_index *schema_index;
+	const struct pldm_bej_dictionary_index *annotation_index;
+	pldm_bej_token_fn emit;
+	void *arg;
+
+	int state;
+	int error;
+	uint64_t offset;
+
+	/* The tuple being decoded */
+	uint64_t nnint;
+	uint8_t nnint_remaining;
+	uint8_t nnint_shift;
+	uint32_t sequence;
+	uint8_t format;
+	const char *name;
+	const char *annotation_name;
+	uint16_t entry_children;
+	uint16_t entry_child_count;
+	const struct pldm_bej_dictionary *entry_dictionary;
+	uint64_t value_remaining;
+	bool value_continued;
+
+	uint8_t scratch[PLDM_BEJ_MAX_SCALAR_LENGTH];
+	size_t scratch_length;
+
+	struct pldm_bej_frame stack[PLDM_BEJ_MAX_DEPTH];
+	unsigned int depth;
+};
+
+/**
+ * @brief Check the layout of a dictionary
+ *
+ * @return 0 if the header and every entry lie within the dictionary, -EINVAL
+ * for a NULL dictionary, -EPROTO for a malformed one
+ */
+int pldm_bej_dictionary_validate(const struct pldm_bej_dictionary *dictionary);
+
+/**
+ * @brief Prepare a decoder for a new payload
+ *
+ * @param[out] decoder - Decoder to initialize
+ * @param[in] schema - Dictionary of the resource's schema, validated here
+ * @param[in] annotation - Annotation dictionary, validated here. May be NULL
+ * if the payload carries no annotations.
+ * @param[in] emit - Receives the decoded tokens
+ * @param[in] arg - Passed to @p emit
+ *
+ * @return 0 on success, -EINVAL for invalid arguments, -EPROTO if a
+ * dictionary is malformed
+ */
+int pldm_bej_decoder_init(struct pldm_bej_decoder *decoder,
+			  const struct pldm_bej_dictionary *schema,
+			  const struct pldm_bej_dictionary *annotation,
+			  pldm_bej_token_fn emit, void *arg);
+
+/**
+ * @brief Prepare a decoder resolving sequence numbers through indexes
+ *
+ * As pldm_bej_decoder_init() for the dictionaries held by @p schema and
+ * @p annotation, which must outlive the decoder.
+ *
+ * @return 0 on success, -EINVAL for invalid arguments
+ */
+int pldm_bej_decoder_init_indexed(
+	struct pldm_bej_decoder *decoder,
+	const struct pldm_bej_dictionary_index *schema,
+	const struct pldm_bej_dictionary_index *annotation,
+	pldm_bej_token_fn emit, void *arg);
+
+/**
+ * @brief Decode the next chunk of a BEJ payload
+ *
+ * Tokens are emitted for everything the chunk completes. Chunks may split
+ * the encoding at any byte.
+ *
+ * @return 0 on success, -EPROTO if the payload is malformed or does not match
+ * the dictionaries, -EOVERFLOW if it nests deeper than PLDM_BEJ_MAX_DEPTH,
+ * holds a value longer than supported or a real with more than
+ * PLDM_BEJ_MAX_LEADING_ZEROS leading zeros, -ENOTSUP for encodings the decoder does
+ * not handle (choice, registry items and resource link expansion), or the
+ * error returned by the token callback. Once an error is returned every
+ * further call returns it too.
+ */
+int pldm_bej_decoder_push(struct pldm_bej_decoder *decoder, const void *data,
+			  size_t length);
+
+/**
+ * @brief Check that the payload is complete
+ *
+ * @return 0 if the decoder consumed exactly one BEJ encoding, -EPROTO if the
+ * payload was truncated, or the error of an earlier call
+ */
+int pldm_bej_decoder_finish(struct pldm_bej_decoder *decoder);
+
+/**
+ * @brief Receives the JSON text produced by a writer
+ *
+ * @return 0 on success, a negative errno value to abort decoding
+ */
+typedef int (*pldm_bej_write_fn)(void *arg, const char *data, size_t length);
+
+/**
+ * @brief Token callback that renders JSON
+ *
+ * Output is buffered in the writer and passed to @p write in blocks of at
+ * most sizeof(buffer) bytes. Resource links are written as their decimal
+ * resource ID in a string, byte strings as base64.
+ */
+struct pldm_bej_json_writer {
+	pldm_bej_write_fn write;
+	void *arg;
+	char buffer[256];
+	size_t used;
+	/* Bit n is set once the container at depth n has a member */
+	uint64_t populated;
+	uint8_t carry[2];
+	uint8_t carried;
+};
+
+/**
+ * @brief Prepare a JSON writer
+ *
+ * @return 0 on success, -EINVAL for invalid arguments
+ */
+int pldm_bej_json_writer_init(struct pldm_bej_json_writer *writer,
+			      pldm_bej_write_fn write, void *arg);
+
+/**
+ * @brief pldm_bej_token_fn rendering @p token through the writer in @p arg
+ */
+int pldm_bej_json_writer_token(void *arg, const struct pldm_bej_token *token);
+
+/**
+ * @brief Pass any buffered output to the write callback
+ *
+ * @return 0 on success, or the error returned by the write callback
+ */
+int pldm_bej_json_writer_flush(struct pldm_bej_json_writer *writer);
+
+struct pldm_bej_encoder_frame {
+	const struct pldm_bej_dictionary_index *index;
+	/* Number of the container's dictionary entry */
+	uint16_t entry;
+	uint8_t format;
+	/* Offset of the space reserved for the container's length */
+	size_t start;
+	uint64_t count;
+};
+
+/**
+ * @brief Builds a BEJ payload, e.g. the request payload of an RDE update or
+ * create operation
+ *
+ * Values are added in document order through the pldm_bej_encoder_*() calls.
+ * Properties are named as in JSON: "Name" for a member of the enclosing
+ * object, "@odata.id" for an annotation of the object and "Name@odata.count"
+ * for an annotation of a property. Names are ignored for the outermost object
+ * and for array members. Members are private to the implementation.
+ */
+struct pldm_bej_encoder {
+	const struct pldm_bej_dictionary_index *schema;
+	const struct pldm_bej_dictionary_index *annotation;
+	uint8_t *buffer;
+	size_t size;
+	size_t used;
+	int error;
+	bool complete;
+	struct pldm_bej_encoder_frame stack[PLDM_BEJ_MAX_DEPTH];
+	unsigned int depth;
+};
+
+/**
+ * @brief Prepare an encoder writing into @p buffer
+ *
+ * @param[out] encoder - Encoder to initialize
+ * @param[in] schema - Index of the resource's schema dictionary
+ * @param[in] annotation - Index of the annotation dictionary. May be NULL if
+ * the payload carries no annotations.
+ * @param[out] buffer - Receives the encoding
+ * @param[in] size - Size of @p buffer
+ *
+ * @return 0 on success, -EINVAL for invalid arguments, -ENOBUFS if @p buffer
+ * cannot hold the encoding header
+ */
+int pldm_bej_encoder_init(struct pldm_bej_encoder *encoder,
+			  const struct pldm_bej_dictionary_index *schema,
+			  const struct pldm_bej_dictionary_index *annotation,
+			  void *buffer, size_t size);
+
+/*
+ * The value calls below return 0 on success, -EINVAL if the call does not fit
+ * the document built so far or the value does not match the dictionary's
+ * format for the property, -ENOENT for a name the dictionaries do not know,
+ * -EOVERFLOW if containers nest deeper than PLDM_BEJ_MAX_DEPTH, or -ENOBUFS
+ * if the buffer is full. Once an error is returned every further call returns
+ * it too.
+ */
+
+/** @brief Open an object, the outermost value must be one */
+int pldm_bej_encoder_begin_object(struct pldm_bej_encoder *encoder,
+				  const char *name);
+
+/** @brief Open an array */
+int pldm_bej_encoder_begin_array(struct pldm_bej_encoder *encoder,
+				 const char *name);
+
+/** @brief Close the innermost object or array */
+int pldm_bej_encoder_end(struct pldm_bej_encoder *encoder);
+
+int pldm_bej_encoder_null(struct pldm_bej_encoder *encoder, const char *name);
+
+int pldm_bej_encoder_integer(struct pldm_bej_encoder *encoder,
+			     const char *name, int64_t value);
+
+/** @brief Add whole.<leading_zeros x '0'>fract e exponent */
+int pldm_bej_encoder_real(struct pldm_bej_encoder *encoder, const char *name,
+			  int64_t whole, uint64_t leading_zeros,
+			  uint64_t fract, int64_t exponent);
+
+int pldm_bej_encoder_boolean(struct pldm_bej_encoder *encoder,
+			     const char *name, bool value);
+
+/** @brief Add a NUL-terminated string */
+int pldm_bej_encoder_string(struct pldm_bej_encoder *encoder,
+			    const char *name, const char *value);
+
+/** @brief Add an enumeration, resolving @p option among its values */
+int pldm_bej_encoder_enum(struct pldm_bej_encoder *encoder, const char *name,
+			  const char *option);
+
+int pldm_bej_encoder_byte_string(struct pldm_bej_encoder *encoder,
+				 const char *name, const void *data,
+				 size_t length);
+
+int pldm_bej_encoder_resource_link(struct pldm_bej_encoder *encoder,
+				   const char *name, uint32_t resource_id);
+
+/**
+ * @brief Check that the document is complete
+ *
+ * @param[out] length - Set to the length of the encoding in the buffer
+ *
+ * @return 0 on success, -EINVAL if no object was encoded or one is still
+ * open, or the error of an earlier call
+ */
+int pldm_bej_encoder_finish(struct pldm_bej_encoder *encoder, size_t *length);
+
+/**
+ * @brief Finds the encoding of the resource a link points to
+ *
+ * @param[in] arg - As passed to pldm_bej_expand_links()
+ * @param[in] resource_id - Resource the link points to
+ * @param[out] encoding - Set to the resource's complete BEJ encoding
+ * @param[out] length - Set to the length of @p encoding
+ *
+ * @return true to expand the link, false to keep it. A link nested in k sets,
+ * arrays or property annotations is looked up once to size the expansion
+ * and, if it fits, k + 1 more times to write it, as each enclosing container
+ * is measured before its members are copied. It must get the same answer
+ * every time.
+ */
+typedef bool (*pldm_bej_link_fn)(void *arg, uint32_t resource_id,
+				 const uint8_t **encoding, size_t *length);
+
+/**
+ * @brief Expand the resource links of a BEJ payload
+ *
+ * Copies @p payload into @p buffer, replacing each resource link that
+ * @p resolve finds with a resource link expansion holding the linked
+ * resource's encoding, as a device would for $expand. The lengths of the
+ * enclosing containers are rewritten to match. Decoding an expansion needs
+ * the dictionary of the linked resource's schema.
+ *
+ * @param[in] payload - A complete BEJ encoding
+ * @param[in] length - Length of @p payload
+ * @param[in] resolve - Looks up the linked resources
+ * @param[in] arg - Passed to @p resolve
+ * @param[out] buffer - Receives the expanded encoding. May be NULL if @p size
+ * is 0.
+ * @param[in] size - Size of @p buffer
+ * @param[out] used - Set to the length of the expanded encoding, also when
+ * it does not fit
+ *
+ * @return 0 on success, -EINVAL for invalid arguments, -EPROTO if the payload
+ * is malformed, -EOVERFLOW if it nests deeper than PLDM_BEJ_MAX_DEPTH, or
+ * -ENOBUFS if @p buffer is too small
+ */
+int pldm_bej_expand_links(const void *payload, size_t length,
+			  pldm_bej_link_fn resolve, void *arg, void *buffer,
+			  size_t size, size_t *used);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
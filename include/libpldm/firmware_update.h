@@ -581,6 +581,19 @@ int decode_pldm_package_header_info(
 	struct pldm_package_header_information *package_header_info,
 	struct variable_field *package_version_str);
 
+/** @brief Verify the PackageHeaderChecksum of a firmware update package
+ *
+ *  The checksum is the CRC-32 of the package header up to the checksum itself,
+ *  which takes the last four of the PackageHeaderSize bytes.
+ *
+ *  @param[in] data - pointer to the firmware update package
+ *  @param[in] length - available length in the firmware update package
+ *
+ *  @return PLDM_SUCCESS if the checksum matches, PLDM_ERROR_INVALID_LENGTH if
+ *          the package header is truncated, PLDM_ERROR_INVALID_DATA otherwise
+ */
+int verify_pldm_package_header_checksum(const uint8_t *data, size_t length);
+
 /** @brief Decode individual firmware device ID record
  *
  *  @param[in] data - pointer to firmware device ID record
@@ -22,6 +22,7 @@ extern "C" {
 #define PLDM_RDE_COMP_PERCENTAGE_NOT_SUPPORTED 254
 // Variable struct header sizes
 #define PLDM_RDE_MULTIPART_RECEIVE_RESP_HDR_SIZE 10
+#define PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE	 15
 #define PLDM_RDE_OPERATION_INIT_REQ_HDR_SIZE 17
 #define PLDM_RDE_OPERATION_INIT_RESP_HDR_SIZE 17
 #define PLDM_RDE_OPERATION_STATUS_RESP_HDR_SIZE 17
@@ -32,6 +33,7 @@ extern "C" {
 #define RDE_NEGOTIATE_MEDIUM_PARAMETERS_RESP_BYTES 5
 #define RDE_GET_DICTIONARY_SCHEMA_RESP_BYTES 6
 #define RDE_MULTIPART_RECV_MINIMUM_RESP_BYTES 6
+#define RDE_MULTIPART_SEND_RESP_BYTES 2
 #define RDE_READ_OPERATION_INIT_MIN_BYTES 13
 #define RESOURCE_ID_ANY 0xFFFFFFFF
 #define IGNORE(x) (void)(x)
@@ -86,6 +88,7 @@ enum pldm_rde_completion_codes {
 	PLDM_RDE_ERROR_OPERATION_FAILED = 0x87,
 	PLDM_RDE_ERROR_UNEXPECTED = 0x88,
 	PLDM_RDE_ERROR_UNSUPPORTED = 0x89,
+	PLDM_RDE_ERROR_ETAG_MATCH = 0x91,
 	PLDM_RDE_ERROR_NO_SUCH_RESOURCE = 0x92,
 };
 
@@ -97,6 +100,8 @@ enum pldm_rde_transfer_operation {
 	PLDM_RDE_XFER_FIRST_PART = 0,
 	PLDM_RDE_XFER_NEXT_PART = 1,
 	PLDM_RDE_XFER_ABORT = 2,
+	// Asks for the chunk of the given transfer handle again, as in base.h
+	PLDM_RDE_XFER_CURRENT_PART = 4,
 };
 // TODO: Do we need this because base.h already has this
 enum pldm_rde_transfer_flag {
@@ -261,6 +266,24 @@ struct pldm_rde_multipart_receive_resp {
 	uint32_t data_length_bytes;
 	uint8_t payload[1];
 } __attribute__((packed));
+/**
+ * @brief RDEMultipartSend request data structure.
+ */
+struct pldm_rde_multipart_send_req {
+	uint32_t data_transfer_handle;
+	uint16_t operation_id;
+	uint8_t transfer_flag;
+	uint32_t next_data_transfer_handle;
+	uint32_t data_length_bytes;
+	uint8_t payload[1];
+} __attribute__((packed));
+/**
+ * @brief RDEMultipartSend response data structure.
+ */
+struct pldm_rde_multipart_send_resp {
+	uint8_t completion_code;
+	uint8_t transfer_operation;
+} __attribute__((packed));
 /**
  * @brief OperationFlags used in RDEOperationInit request data structure.
  */
@@ -666,6 +689,83 @@ int decode_rde_multipart_receive_resp(
     const struct pldm_msg *msg, size_t payload_length, uint8_t *completion_code,
     uint8_t *ret_transfer_flag, uint32_t *ret_data_transfer_handle,
     uint32_t *data_length_bytes, uint8_t **payload);
+/**
+ * @brief Encode RDEMultipartSend request.
+ *
+ * The chunk is copied straight from @p payload into the message, so callers
+ * can slice a large request payload in place.
+ *
+ * @param[in] instance_id - Message's instance id.
+ * @param[in] data_transfer_handle - A handle to uniquely identify the chunk
+ * of data being sent.
+ * @param[in] operation_id - Identification number for this operation.
+ * @param[in] transfer_flag - The portion of data being sent to the device.
+ * @param[in] next_data_transfer_handle - A handle to uniquely identify the
+ * next chunk of data to be sent, 0 for the last chunk.
+ * @param[in] data_length_bytes - Length of the chunk, excluding the checksum.
+ * @param[in] add_checksum - Indicate whether the chunk needs to be followed by
+ * the provided checksum. Only valid for the END or START_AND_END chunk.
+ * @param[in] checksum - CRC-32 of the entire request payload.
+ * @param[in] payload - Pointer to the chunk.
+ * @param[out] msg - Request will be written to this.
+ * @return pldm_completion_codes.
+ */
+int encode_rde_multipart_send_req(uint8_t instance_id,
+				  uint32_t data_transfer_handle,
+				  uint16_t operation_id, uint8_t transfer_flag,
+				  uint32_t next_data_transfer_handle,
+				  uint32_t data_length_bytes, bool add_checksum,
+				  uint32_t checksum, const uint8_t *payload,
+				  struct pldm_msg *msg);
+/**
+ * @brief Decode RDEMultipartSend request.
+ *
+ * @param[in] msg - Request message.
+ * @param[in] payload_length - Length of request message payload.
+ * @param[out] data_transfer_handle - A handle to uniquely identify the chunk
+ * of data being sent.
+ * @param[out] operation_id - Identification number for this operation.
+ * @param[out] transfer_flag - The portion of data being sent to the device.
+ * @param[out] next_data_transfer_handle - A handle to uniquely identify the
+ * next chunk of data to be sent.
+ * @param[out] data_length_bytes - Length of the chunk, including the checksum
+ * if present.
+ * @param[out] payload - Pointer to the chunk inside @p msg.
+ * @return pldm_completion_codes.
+ */
+int decode_rde_multipart_send_req(
+    const struct pldm_msg *msg, size_t payload_length,
+    uint32_t *data_transfer_handle, uint16_t *operation_id,
+    uint8_t *transfer_flag, uint32_t *next_data_transfer_handle,
+    uint32_t *data_length_bytes, const uint8_t **payload);
+/**
+ * @brief Encode RDEMultipartSend response.
+ *
+ * @param[in] instance_id - Message's instance id.
+ * @param[in] completion_code - PLDM completion code.
+ * @param[in] transfer_operation - The portion of data the device expects
+ * next.
+ * @param[out] msg - Response message will be written to this.
+ * @return pldm_completion_codes.
+ */
+int encode_rde_multipart_send_resp(uint8_t instance_id,
+				   uint8_t completion_code,
+				   uint8_t transfer_operation,
+				   struct pldm_msg *msg);
+/**
+ * @brief Decode RDEMultipartSend response.
+ *
+ * @param[in] msg - Response message.
+ * @param[in] payload_length - Length of response message payload.
+ * @param[out] completion_code - PLDM completion code.
+ * @param[out] transfer_operation - The portion of data the device expects
+ * next.
+ * @return pldm_completion_codes.
+ */
+int decode_rde_multipart_send_resp(const struct pldm_msg *msg,
+				   size_t payload_length,
+				   uint8_t *completion_code,
+				   uint8_t *transfer_operation);
 /**
  * @brief Encode RDEOperationInit request.
  *
@@ -1092,6 +1192,23 @@ int decode_rde_operation_status_resp(
     union pldm_rde_op_execution_flags **operation_execution_flags,
     struct pldm_rde_varstring **resp_etag, uint8_t **payload);
 
+/**
+ * @brief Size of an encoded RDE request.
+ *
+ * The request encoders do not report how much of the message they wrote, so
+ * callers that hand requests to a transport recover the length from the
+ * encoded fields.
+ *
+ * @param[in] msg - Encoded request message.
+ * @param[in] buffer_length - Size of the buffer holding @p msg, including
+ * the PLDM header. The request must fit within it.
+ * @param[out] length - Size of the request, including the PLDM header.
+ * @return pldm_completion_codes. PLDM_ERROR_INVALID_DATA if @p msg is not an
+ * RDE request.
+ */
+int pldm_rde_request_length(const struct pldm_msg *msg, size_t buffer_length,
+			    size_t *length);
+
 #ifdef __cplusplus
 }
 #endif
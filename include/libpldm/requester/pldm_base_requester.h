@@ -5,6 +5,7 @@
 extern "C" {
 #endif
 #include "libpldm/base.h"
+#include "libpldm/requester/pldm_requester_stats.h"
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -42,6 +43,9 @@ struct requester_base_context {
 	bitfield8_t pldm_types[PLDM_MAX_TYPES / 8];
 	uint8_t pldm_commands[PLDM_MAX_TYPES][PLDM_MAX_CMDS_PER_TYPE];
 	ver32_t pldm_versions[PLDM_MAX_TYPES];
+	// Optional statistics, see pldm_base_set_stats()
+	struct pldm_requester_stats *stats;
+	struct pldm_requester_stats_sample stats_sample;
 };
 /**
  * @brief Initializes the context for PLDM Base discovery commands
@@ -54,6 +58,21 @@ pldm_base_requester_rc_t
 pldm_base_init_context(struct requester_base_context *ctx, const char *dev_name,
 		       int net_id);
 
+/**
+ * @brief Attaches statistics to the context
+ *
+ * See pldm_requester_stats.h.
+ *
+ * @param[in] ctx - An initialized context
+ * @param[in] stats - Statistics to update, may be shared by contexts and must
+ * outlive them. NULL detaches the current ones.
+ *
+ * @return pldm_requester_rc_t (errno may be set)
+ */
+pldm_base_requester_rc_t
+pldm_base_set_stats(struct requester_base_context *ctx,
+		    struct pldm_requester_stats *stats);
+
 /**
  * @brief Sets the first command to be triggered for base discovery and sets the
  * status of context to "Ready to PICK"
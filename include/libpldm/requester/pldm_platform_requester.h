@@ -8,6 +8,7 @@ extern "C" {
 #include "libpldm/base.h"
 #include "libpldm/platform.h"
 #include "libpldm/requester/pldm_base_requester.h"
+#include "libpldm/requester/pldm_requester_stats.h"
 
 /**
  * @brief Platform Requester Error enums
@@ -49,6 +50,10 @@ struct pldm_platform_requester_context {
   char device_name[8];
   int net_id;
   uint32_t negotiated_transfer_size;
+
+  // Optional statistics, see pldm_platform_set_stats()
+  struct pldm_requester_stats *stats;
+  struct pldm_requester_stats_sample stats_sample;
 };
 
 /**
@@ -76,6 +81,21 @@ pldm_platform_requester_rc_t pldm_platform_init_context(
     struct pldm_platform_requester_context *ctx, const char *device_id,
     int net_id, uint32_t negotiated_transfer_size);
 
+/**
+ * @brief Attaches statistics to the context
+ *
+ * See pldm_requester_stats.h.
+ *
+ * @param[inout] ctx - Platform requester context
+ * @param[in] stats - Statistics to update, may be shared by contexts and must
+ * outlive them. NULL detaches the current ones.
+ *
+ * @return pldm_platform_requester_rc_t (errno may be set)
+ */
+pldm_platform_requester_rc_t pldm_platform_set_stats(
+    struct pldm_platform_requester_context *ctx,
+    struct pldm_requester_stats *stats);
+
 /**
  * @brief Initializes the Platform Operation context
  *
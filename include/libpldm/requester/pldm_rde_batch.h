@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef PLDM_RDE_BATCH_H
+#define PLDM_RDE_BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "libpldm/base.h"
+#include "libpldm/requester/pldm_rde_engine.h"
+#include "libpldm/requester/pldm_rde_requester.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A batch runs a list of RDE operations against one device through an engine,
+ * for instance the reads behind a Redfish collection. It claims the manager's
+ * free contexts, up to the concurrency negotiated with the device, and starts
+ * an operation on each. Whenever one completes, its context goes straight on
+ * to the next operation not started yet, so the device always has as many
+ * operations in flight as it accepts until the list runs out.
+ */
+
+struct pldm_rde_batch;
+
+/**
+ * @brief One operation of a batch
+ */
+struct pldm_rde_batch_item {
+	// Set by the caller, as for pldm_rde_init_rde_operation_context()
+	uint32_t resource_id;
+	uint16_t operation_id;
+	uint8_t operation_type;
+	uint8_t operation_flags;
+	struct rde_query_options *query_options;
+	uint8_t *request_payload;
+	uint32_t request_payload_length;
+	// Optional response destination, see
+	// pldm_rde_set_operation_reassembly()
+	struct pldm_rde_reassembly *reassembly;
+
+	// Set by the batch. The context the operation runs on while it runs,
+	// then NULL.
+	struct pldm_rde_requester_context *ctx;
+	// Once the item is done, 0 or as for pldm_rde_engine_done_fn. -EINVAL
+	// or -ENOMEM if the operation could not be started.
+	int rc;
+};
+
+/**
+ * @brief Called as each item of a batch is done
+ *
+ * The item's context may already run the next item. Items are done in the
+ * order their operations complete, not in the order they are listed.
+ */
+typedef void (*pldm_rde_batch_item_fn)(void *arg, struct pldm_rde_batch *batch,
+				       struct pldm_rde_batch_item *item);
+
+/**
+ * @brief A list of operations run by pldm_rde_batch_start()
+ *
+ * Owned by the caller, which sets the members up to arg and must keep the
+ * batch, its items and the manager valid until every item is done.
+ */
+struct pldm_rde_batch {
+	struct pldm_rde_requester_manager *manager;
+	pldm_tid_t tid;
+	struct pldm_rde_batch_item *items;
+	size_t count;
+	// Receives response payloads, as with
+	// pldm_rde_push_read_operation_response(). See pldm_rde_batch_item_of()
+	// for the item a payload belongs to.
+	callback_funct callback;
+	// Optional
+	pldm_rde_batch_item_fn item_done;
+	void *arg;
+
+	// Kept by the batch
+	struct pldm_rde_engine *engine;
+	// Item running on each of the manager's contexts, while the batch runs
+	struct pldm_rde_batch_item **running;
+	// Index of the first item not started yet
+	size_t next;
+	size_t finished;
+};
+
+/**
+ * @brief Start running the items of @p batch on @p engine
+ *
+ * Uses the manager's contexts that have no operation, dictionary transfer or
+ * discovery set up on them, up to the lower of mc_concurrency and the
+ * device's concurrency from NegotiateRedfishParameters, or a single one if the
+ * device was not negotiated with. The contexts must be left to the batch until
+ * it is done.
+ *
+ * @param[in] engine - Engine moving the messages, see
+ * pldm_rde_engine_run()
+ * @param[in] batch - The batch, which must not be running already
+ *
+ * @return 0 if the batch was started, in which case every item will be
+ * reported done, and right away if @p batch has no items. -EINVAL,
+ * -EBUSY if no context is free or the batch is already running, or -ENOMEM
+ * otherwise.
+ */
+int pldm_rde_batch_start(struct pldm_rde_engine *engine,
+			 struct pldm_rde_batch *batch);
+
+/**
+ * @brief The item running on @p ctx
+ *
+ * For telling apart the payloads handed to the batch's callback.
+ *
+ * @return The item, or NULL if @p ctx runs none of the batch's items
+ */
+struct pldm_rde_batch_item *
+pldm_rde_batch_item_of(struct pldm_rde_batch *batch,
+		       struct pldm_rde_requester_context *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLDM_RDE_BATCH_H */
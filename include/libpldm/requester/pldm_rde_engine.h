@@ -0,0 +1,206 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef PLDM_RDE_ENGINE_H
+#define PLDM_RDE_ENGINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "libpldm/base.h"
+#include "libpldm/requester/pldm_rde_requester.h"
+
+/*
+ * The RDE requester only encodes requests and decodes responses; moving the
+ * messages is left to the caller. The engine does that for any number of
+ * contexts, across any number of managers and devices, over one transport:
+ * it allocates an instance ID per request, sends it, matches each response to
+ * its context by (TID, instance ID), pushes it into the requester and sends
+ * whatever the context needs next, until the work completes.
+ *
+ * While the device runs an operation, its status is polled no sooner than the
+ * device's own completion estimate, or the progress rate it reports, suggests.
+ * Without either the polling interval doubles each time. Polls falling due
+ * together across contexts go out in one wakeup.
+ *
+ * Reads that join an identical read in flight, see
+ * pldm_rde_set_read_coalescing(), send nothing and complete along with it.
+ */
+
+#define PLDM_RDE_ENGINE_DEFAULT_TIMEOUT_MS  5000
+#define PLDM_RDE_ENGINE_DEFAULT_POLL_MIN_MS 50
+#define PLDM_RDE_ENGINE_DEFAULT_POLL_MAX_MS 10000
+
+struct pldm_rde_engine;
+struct pldm_transport;
+struct pldm_instance_db;
+
+/**
+ * @brief Sequence of RDE commands driven on a context
+ */
+enum pldm_rde_engine_work {
+	// Started with pldm_rde_start_discovery()
+	PLDM_RDE_ENGINE_DISCOVERY,
+	// Started with pldm_rde_init_get_dictionary_schema() or
+	// pldm_rde_start_dictionary_download()
+	PLDM_RDE_ENGINE_DICTIONARY,
+	// Started with pldm_rde_init_rde_operation_context()
+	PLDM_RDE_ENGINE_OPERATION,
+};
+
+/**
+ * @brief Called once the work submitted for a context is over
+ *
+ * @param[in] arg - The argument given to pldm_rde_engine_submit()
+ * @param[in] manager - Context Manager the work ran under
+ * @param[in] ctx - Context the work ran on
+ * @param[in] rc - 0 on success. -EPROTO if the requester rejected a response
+ * or failed the request, -ETIMEDOUT if the device did not answer in time,
+ * -EIO if a request could not be sent and -ECANCELED if the engine was
+ * destroyed first.
+ */
+typedef void (*pldm_rde_engine_done_fn)(
+	void *arg, struct pldm_rde_requester_manager *manager,
+	struct pldm_rde_requester_context *ctx, int rc);
+
+/**
+ * @brief Create an engine driving RDE contexts over @p transport
+ *
+ * @param[out] engine - The new engine, *engine must be NULL
+ * @param[in] transport - Transport the engine sends and receives on. It stays
+ * owned by the caller but must not be used by anything else while the engine
+ * exists, since the engine consumes every message it receives.
+ *
+ * @return 0 on success, -EINVAL or -ENOMEM otherwise
+ */
+int pldm_rde_engine_init(struct pldm_rde_engine **engine,
+			 struct pldm_transport *transport);
+
+/**
+ * @brief Destroy the engine
+ *
+ * Outstanding work completes with -ECANCELED.
+ */
+void pldm_rde_engine_destroy(struct pldm_rde_engine *engine);
+
+/**
+ * @brief Allocate instance IDs from @p db rather than within the engine
+ *
+ * Use this when other requesters talk to the same devices. Only allowed while
+ * no work is outstanding.
+ *
+ * @return 0 on success, -EINVAL or -EBUSY otherwise
+ */
+int pldm_rde_engine_set_instance_db(struct pldm_rde_engine *engine,
+				    struct pldm_instance_db *db);
+
+/**
+ * @brief Time allowed for each response before the work fails with
+ * -ETIMEDOUT, PLDM_RDE_ENGINE_DEFAULT_TIMEOUT_MS by default
+ *
+ * A MultipartReceive request that times out is sent again instead while the
+ * manager has retries left, see pldm_rde_set_multipart_receive_retries().
+ *
+ * @return 0 on success, -EINVAL otherwise
+ */
+int pldm_rde_engine_set_timeout(struct pldm_rde_engine *engine,
+				int timeout_ms);
+
+/**
+ * @brief Bounds on the delay between OperationStatus requests for a running
+ * operation
+ *
+ * Polling without an estimate from the device starts at @p min_ms. By default
+ * the bounds are PLDM_RDE_ENGINE_DEFAULT_POLL_MIN_MS and
+ * PLDM_RDE_ENGINE_DEFAULT_POLL_MAX_MS.
+ *
+ * @return 0 on success, -EINVAL otherwise
+ */
+int pldm_rde_engine_set_poll_interval(struct pldm_rde_engine *engine,
+				      uint32_t min_ms, uint32_t max_ms);
+
+/**
+ * @brief Drive the work prepared on @p ctx to completion
+ *
+ * The first request is sent right away, or as soon as the device has an
+ * instance ID to spare. The context and manager must stay valid, and must not
+ * be driven by anything else, until @p done is called.
+ *
+ * @param[in] engine - The engine
+ * @param[in] work - What was prepared on @p ctx
+ * @param[in] manager - Context Manager of the device
+ * @param[in] ctx - Context ready to pick its next request
+ * @param[in] tid - TID of the device
+ * @param[in] callback - Receives response payloads, as with
+ * pldm_rde_push_get_dictionary_response() and
+ * pldm_rde_push_read_operation_response(). Unused for discovery.
+ * @param[in] done - Called when the work is over, may be NULL
+ * @param[in] arg - Passed to @p done
+ *
+ * @return 0 if the work was accepted, in which case @p done will be called.
+ * -EINVAL or -ENOMEM otherwise.
+ */
+int pldm_rde_engine_submit(struct pldm_rde_engine *engine,
+			   enum pldm_rde_engine_work work,
+			   struct pldm_rde_requester_manager *manager,
+			   struct pldm_rde_requester_context *ctx,
+			   pldm_tid_t tid, callback_funct callback,
+			   pldm_rde_engine_done_fn done, void *arg);
+
+/**
+ * @brief Number of submitted works that have not completed yet
+ */
+unsigned int pldm_rde_engine_pending(struct pldm_rde_engine *engine);
+
+#ifdef PLDM_HAS_POLL
+struct pollfd;
+/**
+ * @brief Set up @p pollfd so the engine can be driven from the caller's own
+ * poll or epoll loop
+ *
+ * Call pldm_rde_engine_dispatch() when the descriptor becomes readable, and
+ * once pldm_rde_engine_next_timeout() elapses.
+ *
+ * @return 0 on success, -EINVAL, -ENOTSUP or -EIO otherwise
+ */
+int pldm_rde_engine_init_pollfd(struct pldm_rde_engine *engine,
+				struct pollfd *pollfd);
+#endif
+
+/**
+ * @brief Milliseconds until the earliest outstanding request times out or
+ * the next status poll is due
+ *
+ * @return The delay, 0 if either is already overdue, or -1 if there is
+ * nothing to wait for
+ */
+int pldm_rde_engine_next_timeout(struct pldm_rde_engine *engine);
+
+/**
+ * @brief Receive one message, push it into the context it answers, fail the
+ * requests that timed out and send the status polls that are due
+ *
+ * Call this when the transport is readable or pldm_rde_engine_next_timeout()
+ * elapses. A message is only received if one is waiting, so this does not
+ * block. Messages that answer no outstanding request are dropped.
+ *
+ * @return 0 on success, -EINVAL or -EIO otherwise
+ */
+int pldm_rde_engine_dispatch(struct pldm_rde_engine *engine);
+
+/**
+ * @brief Run the engine until all submitted work completes
+ *
+ * @param[in] engine - The engine
+ * @param[in] timeout_ms - Give up after this many milliseconds, or never if
+ * negative. Work still outstanding keeps running on the next call.
+ *
+ * @return 0 once no work is pending, -ETIMEDOUT if @p timeout_ms elapsed
+ * first, -EINVAL or -EIO otherwise
+ */
+int pldm_rde_engine_run(struct pldm_rde_engine *engine, int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLDM_RDE_ENGINE_H */
@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef PLDM_RDE_EXPAND_H
+#define PLDM_RDE_EXPAND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "libpldm/base.h"
+#include "libpldm/requester/pldm_rde_batch.h"
+#include "libpldm/requester/pldm_rde_engine.h"
+#include "libpldm/requester/pldm_rde_requester.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * $expand done by the requester. A device asked for $expand reads the
+ * resources below the one requested itself, one after the other. Here the
+ * resources below are found from the containment recorded in the device's
+ * Redfish resource PDRs instead, and read together as a batch across the
+ * manager's contexts. Each link to a resource that was read is then replaced
+ * with the resource, as the device would have done, working up from the
+ * deepest level.
+ */
+
+struct pldm_rde_expand;
+struct rde_expand_node;
+
+/**
+ * @brief Where a resource sits in the device's containment hierarchy
+ */
+struct pldm_rde_resource_link {
+	uint32_t resource_id;
+	uint32_t containing_resource_id;
+};
+
+/**
+ * @brief Get the containment of the resource a Redfish resource PDR describes
+ *
+ * @param[in] record_data - The PDR's record data, as for
+ * get_redfish_pdr_from_decoded_get_pdr_resp()
+ * @param[out] link - Set to the resource and the resource containing it
+ *
+ * @return 0 on success, -EINVAL for invalid arguments
+ */
+int pldm_rde_resource_link_from_pdr(uint8_t *record_data,
+				    struct pldm_rde_resource_link *link);
+
+/**
+ * @brief Receives the expanded resource
+ *
+ * @param[in] arg - The expand's arg
+ * @param[in] expand - The expand
+ * @param[in] rc - 0, as for pldm_rde_engine_done_fn if the resource could
+ * not be read, -EINVAL or -ENOMEM if its read could not be started, or as
+ * for pldm_bej_expand_links() if its payload could not be expanded
+ * @param[in] payload - The expanded payload, NULL if @p rc is not 0. Only
+ * valid during the call.
+ * @param[in] length - Size of @p payload
+ */
+typedef void (*pldm_rde_expand_done_fn)(void *arg,
+					struct pldm_rde_expand *expand, int rc,
+					const uint8_t *payload, size_t length);
+
+/**
+ * @brief A read of a resource with the resources below it, see
+ * pldm_rde_expand_start()
+ *
+ * Owned by the caller, which sets the members up to arg and must keep the
+ * expand, the links and the manager valid until it is done.
+ */
+struct pldm_rde_expand {
+	struct pldm_rde_requester_manager *manager;
+	pldm_tid_t tid;
+	uint32_t resource_id;
+	// Levels of contained resources to expand, as for $levels
+	uint8_t levels;
+	// The containment of the device's resources, in any order
+	const struct pldm_rde_resource_link *links;
+	size_t link_count;
+	// Each resource is read with the next operation ID from here
+	uint16_t operation_id;
+	// Room for the payload of each resource, a larger one fails its read
+	size_t resource_size;
+	pldm_rde_expand_done_fn done;
+	void *arg;
+
+	// Kept by the expand
+	struct pldm_rde_batch batch;
+	// One per resource read, the requested one first
+	struct rde_expand_node *nodes;
+	uint8_t *buffers;
+};
+
+/**
+ * @brief Start reading @p expand's resource and the resources below it on
+ * @p engine
+ *
+ * The resources are read on the manager's free contexts as for
+ * pldm_rde_batch_start(), without query options. A link stays as it is if
+ * the resource it points to could not be read or is not a BEJ encoding.
+ *
+ * @param[in] engine - Engine moving the messages, see pldm_rde_engine_run()
+ * @param[in] expand - The expand, which must not be running already
+ *
+ * @return 0 if the reads started, in which case the done callback will be
+ * called. -EINVAL, -EBUSY if no context is free or the expand is running
+ * already, or -ENOMEM otherwise.
+ */
+int pldm_rde_expand_start(struct pldm_rde_engine *engine,
+			  struct pldm_rde_expand *expand);
+
+/**
+ * @brief Whether the expand's reads are still running
+ */
+bool pldm_rde_expand_running(const struct pldm_rde_expand *expand);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLDM_RDE_EXPAND_H */
@@ -0,0 +1,114 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef PLDM_RDE_PAGER_H
+#define PLDM_RDE_PAGER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "libpldm/base.h"
+#include "libpldm/requester/pldm_rde_engine.h"
+#include "libpldm/requester/pldm_rde_requester.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A pager walks a Redfish collection one page at a time, each page being a
+ * read with $skip and $top supplied as custom request parameters. While the
+ * consumer handles one page, the reads of the pages after it are already in
+ * flight on the manager's spare contexts, so walking a long collection takes
+ * about as long as transferring it. Pages are still handed over in order.
+ */
+
+struct pldm_rde_pager;
+struct rde_pager_slot;
+
+/**
+ * @brief Hands a page of the collection to the consumer
+ *
+ * @param[in] arg - The pager's arg
+ * @param[in] pager - The pager
+ * @param[in] page - Index of the page, counting from the pager's first one
+ * @param[in] rc - 0, or as for pldm_rde_engine_done_fn if the page could not
+ * be read. -EINVAL or -ENOMEM if its read could not be started.
+ * @param[in] payload - The page's response payload, NULL if @p rc is not 0
+ * @param[in] length - Size of @p payload
+ *
+ * @return true for the next page, false to end the walk. The walk also ends
+ * after a page that failed, and once the collection runs out, which the
+ * consumer tells from a page holding fewer than $top members.
+ */
+typedef bool (*pldm_rde_pager_page_fn)(void *arg, struct pldm_rde_pager *pager,
+				       uint32_t page, int rc,
+				       const uint8_t *payload, size_t length);
+
+/**
+ * @brief A walk over a collection, see pldm_rde_pager_start()
+ *
+ * Owned by the caller, which sets the members up to arg and must keep the
+ * pager and the manager valid until the walk is over.
+ */
+struct pldm_rde_pager {
+	struct pldm_rde_requester_manager *manager;
+	pldm_tid_t tid;
+	// The collection
+	uint32_t resource_id;
+	// Reads in flight together use consecutive operation IDs from here
+	uint16_t operation_id;
+	// $skip of the first page and $top of every page
+	uint16_t skip;
+	uint16_t top;
+	// Pages to read at most, 0 to go on until the consumer stops
+	uint32_t pages;
+	// Pages read ahead of the one the consumer is handed
+	uint8_t prefetch;
+	// Room for the payload of each page, a larger one fails its read
+	size_t page_size;
+	pldm_rde_pager_page_fn page;
+	void *arg;
+
+	// Kept by the pager
+	struct pldm_rde_engine *engine;
+	// prefetch + 1 slots, for pages read but not handed over yet
+	struct rde_pager_slot *slots;
+	uint8_t *buffers;
+	uint8_t concurrency;
+	uint8_t in_flight;
+	uint32_t requested;
+	uint32_t delivered;
+	bool stopped;
+	unsigned int nesting;
+};
+
+/**
+ * @brief Start walking the collection on @p engine
+ *
+ * Reads run on the manager's contexts that have no operation, dictionary
+ * transfer or discovery set up on them, as many at a time as the negotiated
+ * concurrency allows, see pldm_rde_start_dictionary_download(). The contexts
+ * must be left to the pager until the walk is over.
+ *
+ * @param[in] engine - Engine moving the messages, see pldm_rde_engine_run()
+ * @param[in] pager - The pager, which must not be walking already
+ *
+ * @return 0 if the walk started, -EINVAL, -EBUSY if no context is free or the
+ * pager is walking already, or -ENOMEM otherwise
+ */
+int pldm_rde_pager_start(struct pldm_rde_engine *engine,
+			 struct pldm_rde_pager *pager);
+
+/**
+ * @brief Whether the pager is still walking its collection
+ *
+ * Pages read ahead of the end of a walk are waited for, and thrown away,
+ * before it is over.
+ */
+bool pldm_rde_pager_walking(const struct pldm_rde_pager *pager);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLDM_RDE_PAGER_H */
@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef PLDM_RDE_READ_CACHE_H
+#define PLDM_RDE_READ_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The read cache keeps the BEJ body and ETag of resources read from RDE
+ * devices, keyed by device, resource ID and the $expand, $skip and $top
+ * parameters of the read. Once attached to Context Managers with
+ * pldm_rde_set_read_cache(), repeated reads of a cached resource are sent as
+ * If-None-Match requests carrying the cached ETag. If the device reports the
+ * ETag still matches, the cached body is handed back and no MultipartReceive
+ * transfer takes place.
+ *
+ * Writes to a resource made through a Context Manager using the cache drop
+ * its cached reads. The cache is not thread safe.
+ */
+
+struct pldm_rde_read_cache;
+
+struct pldm_rde_read_cache_stats {
+	// Reads answered from the cache after the device matched the ETag
+	uint64_t hits;
+	// Responses stored
+	uint64_t stores;
+	// Entries dropped to stay within capacity
+	uint64_t evictions;
+	// Bytes currently held
+	size_t size;
+};
+
+/**
+ * @brief Create an empty read cache
+ *
+ * @param[out] cache - The new cache, *cache must be NULL
+ * @param[in] capacity - Bytes the cached bodies and ETags may take up. The
+ * least recently used entries are dropped to make room.
+ *
+ * @return 0 on success, -EINVAL or -ENOMEM otherwise
+ */
+int pldm_rde_read_cache_init(struct pldm_rde_read_cache **cache,
+			     size_t capacity);
+
+/**
+ * @brief Destroy the cache
+ *
+ * Managers the cache is attached to must be detached or gone first.
+ */
+void pldm_rde_read_cache_destroy(struct pldm_rde_read_cache *cache);
+
+/**
+ * @brief Drop every cached read of a resource, whatever its parameters
+ *
+ * @param[in] cache - The cache
+ * @param[in] net_id - Network ID of the device's Context Manager
+ * @param[in] device_name - Device ID of the device's Context Manager
+ * @param[in] resource_id - The resource
+ */
+void pldm_rde_read_cache_invalidate(struct pldm_rde_read_cache *cache,
+				    int net_id, const char *device_name,
+				    uint32_t resource_id);
+
+/**
+ * @brief Read the cache counters
+ *
+ * @return 0 on success, -EINVAL otherwise
+ */
+int pldm_rde_read_cache_stats(struct pldm_rde_read_cache *cache,
+			      struct pldm_rde_read_cache_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLDM_RDE_READ_CACHE_H */
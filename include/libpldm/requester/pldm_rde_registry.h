@@ -0,0 +1,133 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef PLDM_RDE_REGISTRY_H
+#define PLDM_RDE_REGISTRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "libpldm/requester/pldm_rde_requester.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * A Context Manager describes one RDE device. The registry keeps track of
+ * the managers of many devices, keyed by network ID and endpoint (TID or EID,
+ * whichever the caller addresses devices by), together with each device's
+ * full resource table. Resource IDs are indexed across devices, so every
+ * device exposing a resource is found without walking the devices.
+ */
+
+struct pldm_rde_registry;
+
+/**
+ * @brief A device known to the registry
+ *
+ * Owned by the registry, the members are read-only.
+ */
+struct pldm_rde_registry_device {
+	int net_id;
+	uint8_t endpoint;
+	struct pldm_rde_requester_manager *manager;
+	// Caller data given to pldm_rde_registry_add()
+	void *data;
+	// See pldm_rde_registry_set_resources()
+	uint32_t *resource_ids;
+	size_t number_of_resources;
+};
+
+/**
+ * @brief Create an empty registry
+ *
+ * @param[out] registry - The new registry, *registry must be NULL
+ *
+ * @return 0 on success, -EINVAL or -ENOMEM otherwise
+ */
+int pldm_rde_registry_init(struct pldm_rde_registry **registry);
+
+/**
+ * @brief Destroy the registry and forget its devices
+ *
+ * The managers are owned by the caller and are left alone.
+ */
+void pldm_rde_registry_destroy(struct pldm_rde_registry *registry);
+
+/**
+ * @brief Register a device
+ *
+ * @param[in] registry - The registry
+ * @param[in] net_id - Network the device is on
+ * @param[in] endpoint - TID or EID of the device on that network
+ * @param[in] manager - Context Manager of the device, may be NULL. The
+ * device starts out with the resources set on the manager.
+ * @param[in] data - Caller data kept with the device
+ * @param[out] device - The registered device, may be NULL
+ *
+ * @return 0 on success, -EEXIST if the device is already registered, -EINVAL
+ * or -ENOMEM otherwise
+ */
+int pldm_rde_registry_add(struct pldm_rde_registry *registry, int net_id,
+			  uint8_t endpoint,
+			  struct pldm_rde_requester_manager *manager, void *data,
+			  struct pldm_rde_registry_device **device);
+
+/**
+ * @brief Forget a device
+ *
+ * @return 0 on success, -ENOENT if the device is unknown, -EINVAL otherwise
+ */
+int pldm_rde_registry_remove(struct pldm_rde_registry *registry, int net_id,
+			     uint8_t endpoint);
+
+/**
+ * @brief Look a device up by network ID and endpoint
+ *
+ * @return The device, or NULL if it is unknown
+ */
+struct pldm_rde_registry_device *
+pldm_rde_registry_find(struct pldm_rde_registry *registry, int net_id,
+		       uint8_t endpoint);
+
+/**
+ * @brief Number of registered devices
+ */
+size_t pldm_rde_registry_count(struct pldm_rde_registry *registry);
+
+/**
+ * @brief Replace the resource table of a device
+ *
+ * Unlike pldm_rde_set_resources_in_context() the table is not capped at
+ * MAX_RESOURCE_IDS. Duplicate IDs are only indexed once.
+ *
+ * @param[in] registry - The registry
+ * @param[in] device - A device of @p registry
+ * @param[in] resource_ids - The resource IDs, copied
+ * @param[in] count - Number of IDs in @p resource_ids
+ *
+ * @return 0 on success, -EINVAL or -ENOMEM otherwise. On failure the device
+ * keeps its previous table.
+ */
+int pldm_rde_registry_set_resources(struct pldm_rde_registry *registry,
+				    struct pldm_rde_registry_device *device,
+				    const uint32_t *resource_ids, size_t count);
+
+/**
+ * @brief Every device exposing a resource
+ *
+ * @param[in] registry - The registry
+ * @param[in] resource_id - Resource to look up
+ * @param[out] devices - The devices, in no particular order. Valid until the
+ * registry is next modified.
+ *
+ * @return The number of devices in @p devices
+ */
+size_t pldm_rde_registry_find_resource(
+	struct pldm_rde_registry *registry, uint32_t resource_id,
+	struct pldm_rde_registry_device *const **devices);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLDM_RDE_REGISTRY_H */
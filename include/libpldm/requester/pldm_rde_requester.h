@@ -7,7 +7,12 @@ extern "C" {
 
 #include "libpldm/base.h"
 #include "libpldm/requester/pldm_base_requester.h"
+#include "libpldm/requester/pldm_requester_stats.h"
 #include "libpldm/pldm_rde.h"
+#include "libpldm/utils.h"
+
+#include <sys/types.h>
+#include <sys/uio.h>
 
 // Currently RDE supports a maximum of 50 dictionary resources
 #define MAX_RESOURCE_IDS 50
@@ -16,6 +21,8 @@ extern "C" {
 
 #define MAX_HEADERS 8
 #define MAX_ETAGS 8
+// ETags travel as varstrings, whose length byte counts the NUL terminator
+#define PLDM_RDE_MAX_ETAG_SIZE 255
 
 typedef enum rde_requester_return_codes {
 	PLDM_RDE_REQUESTER_SUCCESS = 0,
@@ -27,7 +34,14 @@ typedef enum rde_requester_return_codes {
 	PLDM_RDE_REQUESTER_ENCODING_REQUEST_FAILURE = -6,
 	PLDM_RDE_CONTEXT_INITIALIZATION_ERROR = -7,
 	PLDM_RDE_CONTEXT_NOT_READY = -8,
-	PLDM_RDE_NO_PDR_RESOURCES_FOUND = -9
+	PLDM_RDE_NO_PDR_RESOURCES_FOUND = -9,
+	// All remaining dictionaries were served from the dictionary cache
+	PLDM_RDE_DICTIONARY_CACHE_HIT = -10,
+	// The response did not fit the reassembly destination, could not be
+	// written to it or failed its checksum
+	PLDM_RDE_REASSEMBLY_ERROR = -11,
+	// The read joined an identical one in flight on another context
+	PLDM_RDE_OPERATION_COALESCED = -12
 } pldm_rde_requester_rc_t;
 
 typedef enum rde_requester_status {
@@ -53,6 +67,11 @@ struct pdr_resource {
 	uint8_t dictionary_format;
 	uint8_t transfer_operation;
 	uint8_t schema_class;
+
+	// Chunks received so far, only collected when the dictionary cache is
+	// enabled
+	uint8_t *dictionary;
+	uint32_t dictionary_length;
 };
 /**
  * @brief The entire RDE Update operation is captured by the following struct
@@ -69,6 +88,9 @@ struct rde_update_operation {
 
 	// Request Data
 	union pldm_rde_operation_flags operation_flags;
+	// Set once SupplyCustomRequestParameters succeeds, after which an
+	// operation that needs input goes on to its request payload
+	bool custom_request_parameters_supplied;
 	uint32_t send_data_transfer_handle;
 	uint8_t operation_locator_length;
 	uint8_t *operation_locator;
@@ -101,6 +123,9 @@ struct rde_read_operation {
 
 	// Request Data
 	union pldm_rde_operation_flags operation_flags;
+	// Set once SupplyCustomRequestParameters succeeds, after which an
+	// operation that needs input goes on to its request payload
+	bool custom_request_parameters_supplied;
 	uint32_t send_data_transfer_handle;
 	uint8_t operation_locator_length;
 	uint8_t *operation_locator;
@@ -140,10 +165,58 @@ struct rde_query_options {
 	char *etags[MAX_ETAGS];
 };
 
+enum pldm_rde_reassembly_type {
+	PLDM_RDE_REASSEMBLY_BUFFER = 0,
+	PLDM_RDE_REASSEMBLY_IOVEC = 1,
+	PLDM_RDE_REASSEMBLY_FD = 2
+};
+
+/**
+ * @brief Destination for the response payload of an RDE operation, see
+ * pldm_rde_set_operation_reassembly()
+ *
+ * The destination is filled in by the caller. The remaining members track the
+ * transfer and are reset by the requester when the first part arrives.
+ */
+struct pldm_rde_reassembly {
+	enum pldm_rde_reassembly_type type;
+	union {
+		struct {
+			uint8_t *data;
+			size_t size;
+		} buffer;
+		struct {
+			const struct iovec *iov;
+			int iovcnt;
+		} iovec;
+		struct {
+			int fd;
+			// File offset of the first payload byte
+			off_t offset;
+			// Bytes that may be written from offset
+			size_t size;
+		} file;
+	} dest;
+
+	// Payload bytes landed so far
+	size_t length;
+	// CRC-32 of the landed bytes
+	struct pldm_crc32 checksum;
+	// Transfer handle the next chunk is expected to be requested with
+	uint32_t transfer_handle;
+	// Position of the next byte in an iovec destination
+	int iov_index;
+	size_t iov_offset;
+};
+
 /**
  * @brief RDE operation
  */
 struct rde_operation {
+	// Set from pldm_rde_init_rde_operation_context() until
+	// free_rde_op_init_context()
+	bool active;
+
 	uint8_t request_id;
 	uint32_t resource_id;
 	uint16_t operation_id;
@@ -155,6 +228,9 @@ struct rde_operation {
 
 	// Request Data
 	union pldm_rde_operation_flags operation_flags;
+	// Set once SupplyCustomRequestParameters succeeds, after which an
+	// operation that needs input goes on to its request payload
+	bool custom_request_parameters_supplied;
 	uint32_t send_data_transfer_handle;
 	uint8_t operation_locator_length;
 	uint8_t *operation_locator;
@@ -172,9 +248,49 @@ struct rde_operation {
 	// For multipart receive
 	uint32_t transfer_handle;
 	uint8_t transfer_operation;
+	// MultipartReceive retries since the last chunk received, see
+	// pldm_rde_set_multipart_receive_retries()
+	uint8_t receive_retries;
+
+	// For multipart send, chunks are encoded straight from request_payload.
+	// send_crc covers the first send_crc_length bytes of it, extended as
+	// chunks are encoded.
+	bool multipart_send;
+	uint32_t send_transfer_handle;
+	uint32_t send_offset;
+	uint32_t send_chunk_length;
+	struct pldm_crc32 send_crc;
+	uint32_t send_crc_length;
+
+	// Optional response destination, see pldm_rde_set_operation_reassembly()
+	struct pldm_rde_reassembly *reassembly;
 
 	// op complete
 	uint8_t completion_code;
+
+	// Storage behind resp_operation_flags, resp_permission_flags and
+	// query_options
+	union pldm_rde_op_execution_flags resp_operation_flags_data;
+	union pldm_rde_permission_flags resp_permission_flags_data;
+	struct rde_query_options query_options_data;
+
+	// Read cache, see pldm_rde_set_read_cache(). The ETag is the one sent
+	// with If-None-Match, then the one the response carried. cache_body
+	// holds the cached body while it is revalidated, then collects the
+	// responses that do not land in a reassembly buffer.
+	bool cache_fill;
+	bool cache_revalidate;
+	char cache_etag[PLDM_RDE_MAX_ETAG_SIZE];
+	uint8_t *cache_body;
+	uint32_t cache_body_length;
+	struct pldm_crc32 cache_crc;
+
+	// Read coalescing, see pldm_rde_set_read_coalescing(). An open read
+	// still takes on identical reads, which point at its context until it
+	// has handed them its result.
+	bool coalesce_open;
+	uint8_t coalesce_followers;
+	struct pldm_rde_requester_context *coalesce_leader;
 };
 
 /**
@@ -185,9 +301,26 @@ struct pldm_rde_requester_context {
 	int next_command;
 	uint8_t requester_status;
 	struct pdr_resource *current_pdr_resource;
+	// Not used by RDE operations, which are kept in operation
 	void *operation_ctx;
+	// The RDE operation in progress, if operation.active. Each context
+	// holds its record, so starting an RDE operation does not allocate.
+	struct rde_operation operation;
+	// The request awaiting a response, see pldm_rde_set_stats()
+	struct pldm_requester_stats_sample stats_sample;
 };
 
+struct pldm_rde_requester_manager;
+
+/**
+ * @brief Callback function for letting the requester handle response payload
+ */
+typedef void (*callback_funct)(struct pldm_rde_requester_manager *manager,
+			       struct pldm_rde_requester_context *ctx,
+			       /*payload_array*/ uint8_t **,
+			       /*payload_length*/ uint32_t,
+			       /*has_checksum*/ bool);
+
 /**
  * @brief Context Manager- Manages all the contexts and common information per
  * rde device
@@ -211,16 +344,29 @@ struct pldm_rde_requester_manager {
 	struct pldm_rde_requester_context *ctx;
 	// A callback to free the pldm_rde_requester_context memory.
 	void (*free_requester_ctx)(void *ctx_memory);
-};
 
-/**
- * @brief Callback function for letting the requester handle response payload
- */
-typedef void (*callback_funct)(struct pldm_rde_requester_manager *manager,
-			       struct pldm_rde_requester_context *ctx,
-			       /*payload_array*/ uint8_t **,
-			       /*payload_length*/ uint32_t,
-			       /*has_checksum*/ bool);
+	// Optional on-disk dictionary cache, see pldm_rde_set_dictionary_cache()
+	const char *dictionary_cache_dir;
+	callback_funct dictionary_cache_callback;
+
+	// Dictionary download scheduler, see
+	// pldm_rde_start_dictionary_download()
+	bool dictionary_download_scheduled;
+	uint8_t next_dictionary_index;
+	uint8_t dictionary_downloads_in_flight;
+
+	// Optional read cache, see pldm_rde_set_read_cache()
+	struct pldm_rde_read_cache *read_cache;
+
+	// See pldm_rde_set_read_coalescing()
+	bool coalesce_reads;
+
+	// See pldm_rde_set_multipart_receive_retries()
+	uint8_t multipart_receive_retries;
+
+	// Optional statistics, see pldm_rde_set_stats()
+	struct pldm_requester_stats *stats;
+};
 
 /**
  * @brief Initializes the context for PLDM RDE discovery commands
@@ -265,6 +411,169 @@ pldm_rde_set_resources_in_context(struct pldm_rde_requester_manager *manager,
 				  uint8_t number_of_resources,
 				  uint32_t *resource_id_address);
 
+/**
+ * @brief Enables the on-disk dictionary cache for a device
+ *
+ * Dictionaries are cached under <cache_dir>/<device_id> and keyed by the
+ * provider name and configuration signature reported in
+ * NegotiateRedfishParameters, the resource ID and the schema class. Entries
+ * that no longer match the device's configuration signature are dropped when
+ * discovery completes.
+ *
+ * When the dictionary of a resource is cached, GetSchemaDictionary and
+ * MultipartReceive are skipped for it and @p callback is invoked once with the
+ * whole dictionary, including the trailing checksum, as if the device had
+ * sent it in a single START_AND_END chunk. If every remaining dictionary is
+ * cached, pldm_rde_get_next_dictionary_schema_command() encodes no request and
+ * returns PLDM_RDE_DICTIONARY_CACHE_HIT.
+ *
+ * @param[in] manager - Context Manager
+ * @param[in] cache_dir - Existing directory holding the cache, must outlive
+ * the manager. NULL disables the cache.
+ * @param[in] callback - Receives the dictionaries served from the cache
+ *
+ * @return pldm_requester_rc_t (errno may be set)
+ */
+pldm_rde_requester_rc_t
+pldm_rde_set_dictionary_cache(struct pldm_rde_requester_manager *manager,
+			      const char *cache_dir, callback_funct callback);
+
+struct pldm_rde_read_cache;
+
+/**
+ * @brief Enables the read cache for a device
+ *
+ * Read operations without an operation locator, custom headers or ETags of
+ * their own are cached by resource ID and $expand parameters, see
+ * pldm_rde_read_cache.h. A read of a cached resource carries the cached ETag
+ * in SupplyCustomRequestParameters with ETAG_IF_NONE_MATCH. If the device
+ * answers ERROR_ETAG_MATCH, the cached body is handed to the callback, or
+ * lands in the reassembly destination, as if the device had returned it in
+ * the response, and the operation moves on to RDEOperationComplete. Other
+ * operations drop the cached reads of their resource.
+ *
+ * @param[in] manager - Context Manager
+ * @param[in] cache - Cache to use, may be shared by managers and must outlive
+ * them. NULL disables the cache.
+ *
+ * @return pldm_requester_rc_t (errno may be set)
+ */
+pldm_rde_requester_rc_t
+pldm_rde_set_read_cache(struct pldm_rde_requester_manager *manager,
+			struct pldm_rde_read_cache *cache);
+
+/**
+ * @brief Lets identical reads share one RDE operation
+ *
+ * A read operation without a request payload, custom headers or ETags
+ * matches another when both name the same resource, operation locator and
+ * $expand parameters. Once a matching read on another of the manager's
+ * contexts has sent its RDEOperationInit and has not yet received any of its
+ * result, pldm_rde_get_next_rde_operation() encodes no request for the new
+ * read and returns PLDM_RDE_OPERATION_COALESCED instead, leaving the context
+ * waiting for a response.
+ *
+ * Whatever the device returns for the first read is then handed to the
+ * callback, or lands in the reassembly destination, of every read that
+ * joined it, in the same way and from the same call to
+ * pldm_rde_push_read_operation_response(). A read that joined another ends
+ * with PLDM_RDE_REQUESTER_NO_PENDING_ACTION once it has its result, or
+ * PLDM_RDE_REQUESTER_REQUEST_FAILED if the first read failed before
+ * delivering it, and never closes an operation on the device.
+ *
+ * @param[in] manager - Context Manager
+ * @param[in] enable - Whether new reads may join others. Reads that already
+ * joined one still get its result.
+ *
+ * @return pldm_requester_rc_t (errno may be set)
+ */
+pldm_rde_requester_rc_t
+pldm_rde_set_read_coalescing(struct pldm_rde_requester_manager *manager,
+			     bool enable);
+
+/**
+ * @brief Lets reads resume a result transfer that lost a chunk
+ *
+ * Without retries, a MultipartReceive response that fails to decode, is
+ * truncated or carries a generic PLDM error ends the read with
+ * PLDM_RDE_REQUESTER_REQUEST_FAILED, and the whole result has to be read
+ * again. With them, pldm_rde_push_read_operation_response() instead leaves
+ * the context ready to ask for the same chunk again: the first chunk with
+ * PLDM_XFER_FIRST_PART, later ones with PLDM_XFER_CURRENT_PART and the
+ * transfer handle of the last chunk received. Nothing of a lost chunk is
+ * handed to the callback, reassembly destination or read cache.
+ *
+ * RDE specific completion codes, which mean the operation itself is gone, are
+ * not retried. For requests that time out, see
+ * pldm_rde_retry_multipart_receive().
+ *
+ * @param[in] manager - Context Manager
+ * @param[in] retries - How many times in a row a chunk may be asked for again
+ * before the read fails. The count starts over with each chunk received. 0,
+ * the default, disables retries.
+ *
+ * @return pldm_requester_rc_t (errno may be set)
+ */
+pldm_rde_requester_rc_t
+pldm_rde_set_multipart_receive_retries(
+	struct pldm_rde_requester_manager *manager, uint8_t retries);
+
+/**
+ * @brief Asks again for a chunk whose MultipartReceive response never came
+ *
+ * For a context waiting on a MultipartReceive response when it times out.
+ * Counts against the retries allowed by
+ * pldm_rde_set_multipart_receive_retries() and, if any are left, leaves the
+ * context ready to send the request again in the same way as a lost chunk
+ * would. The retried request must use a new instance ID, so that a late
+ * response to the one given up on is not taken for its answer.
+ *
+ * @param[in] manager - Context Manager
+ * @param[in] ctx - Context waiting on a MultipartReceive response
+ *
+ * @return PLDM_RDE_REQUESTER_SUCCESS if the request is to be sent again,
+ * PLDM_RDE_CONTEXT_NOT_READY if @p ctx is not waiting on a MultipartReceive
+ * response and PLDM_RDE_REQUESTER_RECV_FAIL if no retries are left, in which
+ * case @p ctx is left as it was.
+ */
+pldm_rde_requester_rc_t
+pldm_rde_retry_multipart_receive(struct pldm_rde_requester_manager *manager,
+				 struct pldm_rde_requester_context *ctx);
+
+/**
+ * @brief Attaches statistics to a Context Manager
+ *
+ * Requests encoded by the get_next functions and responses pushed to any of
+ * the manager's contexts are counted and timed, see pldm_requester_stats.h.
+ * Reads that joined another, see pldm_rde_set_read_coalescing(), send nothing
+ * and are not counted.
+ *
+ * @param[in] manager - Context Manager
+ * @param[in] stats - Statistics to update, may be shared by managers and must
+ * outlive them. NULL detaches the current ones.
+ *
+ * @return pldm_requester_rc_t (errno may be set)
+ */
+pldm_rde_requester_rc_t
+pldm_rde_set_stats(struct pldm_rde_requester_manager *manager,
+		   struct pldm_requester_stats *stats);
+
+/**
+ * @brief Fails the reads that joined a read that is given up on
+ *
+ * Needed when a read others joined, see pldm_rde_set_read_coalescing(), is
+ * abandoned without pushing a response, for instance on a timeout. Must be
+ * called before such a read's context is freed or reused.
+ *
+ * @param[in] manager - Context Manager
+ * @param[in] ctx - Context of the abandoned read
+ *
+ * @return pldm_requester_rc_t (errno may be set)
+ */
+pldm_rde_requester_rc_t
+pldm_rde_abandon_coalesced_reads(struct pldm_rde_requester_manager *manager,
+				 struct pldm_rde_requester_context *ctx);
+
 /**
  * @brief Sets the first command to be triggered for base discovery and sets
  * the status of context to "Ready to PICK
@@ -333,6 +642,32 @@ pldm_rde_create_context(struct pldm_rde_requester_context *current_ctx);
 pldm_rde_requester_rc_t
 pldm_rde_init_get_dictionary_schema(struct pldm_rde_requester_context *ctx);
 
+/**
+ * @brief Spreads the dictionary download of all resources over the free
+ * contexts of the manager
+ *
+ * Up to the negotiated concurrency (the lower of mc_concurrency and the
+ * device's concurrency from NegotiateRedfishParameters) free contexts are
+ * initialized, each with its own resource. A context that completes a
+ * dictionary picks up the next resource nobody has claimed yet, so every
+ * chain stays busy until the resource list is exhausted. Each started context
+ * is driven exactly like one set up by pldm_rde_init_get_dictionary_schema(),
+ * using a distinct instance ID, and reaches
+ * PLDM_RDE_REQUESTER_NO_PENDING_ACTION once no resources are left for it.
+ *
+ * A context is free if it is not busy and holds neither a dictionary nor an
+ * RDE operation.
+ *
+ * @param[in] manager - Context Manager
+ * @param[out] contexts_started - Number of contexts that now have a
+ * GetSchemaDictionary request to send
+ *
+ * @return pldm_requester_rc_t (errno may be set)
+ */
+pldm_rde_requester_rc_t
+pldm_rde_start_dictionary_download(struct pldm_rde_requester_manager *manager,
+				   uint8_t *contexts_started);
+
 /**
  * @brief Gets the next command in sequence required to extract dictionaries
  * from the RDE Device for the given resources
@@ -385,7 +720,10 @@ pldm_rde_requester_rc_t pldm_rde_push_get_dictionary_response(
  * @param[in] operation_locator_length - Operation Locator length
  * @param[in] request_payload_length - Request payload length
  * @param[in] operation_locator - operation locator
- * @param[in] request_payload - pointer Request payload buffer
+ * @param[in] request_payload - pointer Request payload buffer. If the payload
+ * does not fit in RDEOperationInit at the negotiated transfer size it is sent
+ * with RDEMultipartSend, chunked in place, so the buffer must stay valid until
+ * the operation completes.
  *
  * @return pldm_requester_rc_t (errno may be set)
  */
@@ -397,6 +735,34 @@ pldm_rde_requester_rc_t pldm_rde_init_rde_operation_context(
 	uint32_t request_payload_length, uint8_t *operation_locator,
 	uint8_t *request_payload);
 
+/**
+ * @brief Reassemble the response payload of an RDE operation in place
+ *
+ * Instead of handing every MultipartReceive chunk to the callback, the
+ * requester writes each chunk at its final offset in @p reassembly's
+ * destination and folds it into a running CRC-32, which is checked against the
+ * checksum of the final chunk. Responses returned inline by RDEOperationInit
+ * land in the destination the same way.
+ *
+ * The callback is then invoked once, when the whole payload has landed, with
+ * the payload length and without a checksum. The payload pointer refers to the
+ * destination buffer for PLDM_RDE_REASSEMBLY_BUFFER and is NULL otherwise.
+ *
+ * If the payload overflows the destination, cannot be written or fails its
+ * checksum, the request fails and pldm_rde_push_read_operation_response()
+ * returns PLDM_RDE_REASSEMBLY_ERROR.
+ *
+ * @param[in] ctx - Context initialized with
+ * pldm_rde_init_rde_operation_context()
+ * @param[in] reassembly - Destination, must stay valid until the operation
+ * completes. NULL restores per-chunk callbacks.
+ *
+ * @return pldm_requester_rc_t (errno may be set)
+ */
+pldm_rde_requester_rc_t
+pldm_rde_set_operation_reassembly(struct pldm_rde_requester_context *ctx,
+				  struct pldm_rde_reassembly *reassembly);
+
 /**
  * @brief Get next RDE operation in sequence to cater to a RDE request
  *
@@ -435,7 +801,8 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
 /**
  * @brief Cleanup memory after RDE Operation completes (Succeeds/Fails)
  * Needs to be called after every rde_operation_init once RDE Operation init is
- * completed
+ * completed. The operation record is held by the context, so this releases it
+ * for the next operation without freeing anything.
  *
  * @param[in] ctx - Requester context holds RDE operation context to be cleared
  *
@@ -450,6 +817,16 @@ free_rde_op_init_context(struct pldm_rde_requester_context *ctx);
 pldm_rde_requester_rc_t free_op_context_after_dictionary_extraction(
 	struct pldm_rde_requester_context *ctx);
 
+/**
+ * @brief Number of heap allocations made by the RDE requester
+ *
+ * Counts the allocations of every manager since the library was loaded.
+ * Dictionary extraction allocates, RDE operations do not.
+ *
+ * @return The allocation count
+ */
+unsigned long pldm_rde_requester_allocations(void);
+
 /**
  * =============== Workaround begins for b/293742455 ===================
  */
@@ -0,0 +1,105 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef PLDM_REQUESTER_STATS_H
+#define PLDM_REQUESTER_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Requester statistics count, per PLDM type and command, the requests the
+ * base, platform and RDE requesters encode and the responses pushed back to
+ * them, and time each response against its request. They are attached to
+ * requester contexts with pldm_base_set_stats(), pldm_platform_set_stats()
+ * and pldm_rde_set_stats(), and may be shared by any number of contexts on
+ * any number of threads: every update is a relaxed atomic operation, so
+ * statistics can stay attached in production.
+ *
+ * The time measured runs from the get_next call encoding a request to the
+ * push call handing over its response, and so includes transport queueing
+ * and retries as well as the time the device took.
+ */
+
+// Commands tracked per set of statistics, later ones are counted as dropped
+#define PLDM_REQUESTER_STATS_COMMANDS 32
+#define PLDM_REQUESTER_STATS_BUCKETS  32
+
+struct pldm_requester_stats;
+
+struct pldm_requester_command_stats {
+	uint8_t type;
+	uint8_t command;
+	// Completion code of the last unsuccessful response
+	uint8_t last_error;
+	uint64_t requests;
+	uint64_t responses;
+	// Responses without a completion code or with one other than
+	// PLDM_SUCCESS
+	uint64_t errors;
+	// Message sizes, including the PLDM header
+	uint64_t request_bytes;
+	uint64_t response_bytes;
+	// latency[0] counts responses pushed within a microsecond of their
+	// request, latency[i] those taking from 2^(i-1) up to 2^i microseconds
+	// and the last bucket everything slower
+	uint64_t latency[PLDM_REQUESTER_STATS_BUCKETS];
+};
+
+struct pldm_requester_stats_snapshot {
+	// Entries of commands used, in the order they were first seen
+	size_t count;
+	struct pldm_requester_command_stats
+		commands[PLDM_REQUESTER_STATS_COMMANDS];
+	// Requests and responses of commands that did not fit
+	uint64_t dropped;
+};
+
+/**
+ * @brief The request a requester context is waiting on
+ *
+ * Kept in the requester contexts, not meant to be used directly.
+ */
+struct pldm_requester_stats_sample {
+	uint64_t sent_ns;
+	uint8_t type;
+	uint8_t command;
+	bool pending;
+};
+
+/**
+ * @brief Create an empty set of statistics
+ *
+ * @param[out] stats - The new statistics, *stats must be NULL
+ *
+ * @return 0 on success, -EINVAL or -ENOMEM otherwise
+ */
+int pldm_requester_stats_init(struct pldm_requester_stats **stats);
+
+/**
+ * @brief Destroy the statistics
+ *
+ * Contexts they are attached to must be detached or gone first.
+ */
+void pldm_requester_stats_destroy(struct pldm_requester_stats *stats);
+
+/**
+ * @brief Copy out the statistics
+ *
+ * Safe against concurrent updates. Each counter is read atomically, but
+ * updates made while the snapshot is taken may be reflected in some counters
+ * and not others.
+ *
+ * @return 0 on success, -EINVAL otherwise
+ */
+int pldm_requester_stats_snapshot(struct pldm_requester_stats *stats,
+				  struct pldm_requester_stats_snapshot *snapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLDM_REQUESTER_STATS_H */
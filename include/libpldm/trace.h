@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef PLDM_TRACE_H
+#define PLDM_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * libpldm reports the errors it hits, and what the requesters are up to,
+ * through a trace sink installed by the application. Nothing is formatted or
+ * written until a sink is installed and the message's level and category are
+ * enabled, so by default tracing costs one relaxed load per trace point.
+ *
+ * When built with USDT support, every trace point also fires the
+ * libpldm:trace probe with the level, category and formatted message, whether
+ * or not a sink is installed. When built with -Dtracing=disabled, the trace
+ * points are compiled out and these functions do nothing.
+ */
+
+enum pldm_trace_level {
+	PLDM_TRACE_ERROR = 0,
+	PLDM_TRACE_WARNING = 1,
+	PLDM_TRACE_INFO = 2,
+	PLDM_TRACE_DEBUG = 3,
+};
+
+enum pldm_trace_category {
+	// RDE message encoding and decoding
+	PLDM_TRACE_RDE = 1 << 0,
+	// RDE requester state machines
+	PLDM_TRACE_RDE_REQUESTER = 1 << 1,
+	// Platform requester state machines
+	PLDM_TRACE_PLATFORM_REQUESTER = 1 << 2,
+	// Raw MCTP socket requests
+	PLDM_TRACE_MCTP_SOCKET = 1 << 3,
+};
+
+#define PLDM_TRACE_ALL_CATEGORIES UINT32_MAX
+
+/**
+ * @brief Receives a formatted trace message
+ *
+ * @param[in] arg - The argument the sink was installed with
+ * @param[in] level - Severity of the message
+ * @param[in] category - The enum pldm_trace_category the message belongs to
+ * @param[in] message - NUL terminated, without a trailing newline. Only valid
+ * for the duration of the call.
+ */
+typedef void (*pldm_trace_sink_fn)(void *arg, enum pldm_trace_level level,
+				   uint32_t category, const char *message);
+
+/**
+ * @brief Install the trace sink
+ *
+ * The sink is called on the thread hitting the trace point, and must not
+ * call back into libpldm. It may be replaced while other threads are tracing:
+ * each message then goes to either the old or the new sink, always with that
+ * sink's own @p arg, so the old argument must stay valid until those threads
+ * have moved on.
+ *
+ * @param[in] sink - The sink, or NULL to discard messages
+ * @param[in] arg - Passed to every call of @p sink
+ */
+void pldm_trace_set_sink(pldm_trace_sink_fn sink, void *arg);
+
+/**
+ * @brief Choose which messages reach the sink
+ *
+ * May be called at any time, from any thread. Nothing is enabled initially.
+ *
+ * @param[in] level - The least severe level passed on
+ * @param[in] categories - Mask of enum pldm_trace_category values passed on,
+ * PLDM_TRACE_ALL_CATEGORIES for all of them, or 0 to disable tracing
+ */
+void pldm_trace_set_level(enum pldm_trace_level level, uint32_t categories);
+
+/**
+ * @brief A sink writing each message as a line to stderr
+ *
+ * @p arg is unused.
+ */
+void pldm_trace_sink_stderr(void *arg, enum pldm_trace_level level,
+			    uint32_t category, const char *message);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLDM_TRACE_H */
@@ -69,7 +69,8 @@ pldm_requester_rc_t pldm_transport_send_msg(struct pldm_transport *transport,
  * @param[out] pldm_msg - *pldm_msg will point to the received PLDM msg if
  * 	       return code is PLDM_REQUESTER_SUCCESS; otherwise, NULL. On
  * 	       success this function allocates memory, caller to
- * 	       free(*pldm_msg).
+ * 	       free(*pldm_msg), or to pldm_transport_release_msg() it if the
+ * 	       transport has a receive pool.
  * @param[out] msg_len - caller owned pointer that will be made to point to
  *             the size of the PLDM msg. If NULL,
  * 	       PLDM_REQUESTER_INVALID_SETUP is returned.
@@ -82,6 +83,98 @@ pldm_requester_rc_t pldm_transport_recv_msg(struct pldm_transport *transport,
 					    pldm_tid_t *tid, void **pldm_msg,
 					    size_t *msg_len);
 
+/**
+ * @brief A message of pldm_transport_send_batch() or
+ * pldm_transport_recv_batch()
+ *
+ * @var tid - destination or source PLDM TID
+ * @var pldm_msg - the PLDM message. Not modified when sending.
+ * @var msg_len - size of the PLDM message
+ */
+struct pldm_transport_msg {
+	pldm_tid_t tid;
+	void *pldm_msg;
+	size_t msg_len;
+};
+
+/**
+ * @brief Send several PLDM messages at once
+ *
+ * The AF_MCTP transport hands them to the kernel with a single sendmmsg(), the
+ * others send them one at a time. Messages are sent in order, and sending
+ * stops at the first one that fails.
+ *
+ * @param[in] transport - pldm transport instance
+ * @param[in] msgs - the messages, each as for pldm_transport_send_msg()
+ * @param[in] count - number of messages, at most INT_MAX
+ *
+ * @return The number of messages sent from the start of @p msgs, which is less
+ * than @p count if one failed. A pldm_requester_rc_t as for
+ * pldm_transport_send_msg() if the first one failed, or
+ * PLDM_REQUESTER_INVALID_SETUP for invalid arguments.
+ */
+int pldm_transport_send_batch(struct pldm_transport *transport,
+			      struct pldm_transport_msg *msgs, size_t count);
+
+/**
+ * @brief Receive the PLDM messages waiting on the transport at once
+ *
+ * Receives one message as pldm_transport_recv_msg() does, then those already
+ * queued behind it, up to @p count. The AF_MCTP transport does so with a
+ * single recvmmsg() if it has a receive pool, see
+ * pldm_transport_rx_pool_init(), the others one message at a time.
+ *
+ * Messages that cannot be received, for instance from an unknown endpoint, are
+ * dropped. Each message received must be handed back with
+ * pldm_transport_release_msg().
+ *
+ * @param[in] transport - pldm transport instance
+ * @param[out] msgs - filled with the messages received
+ * @param[in] count - room in @p msgs, at most INT_MAX
+ *
+ * @return The number of messages received, or a pldm_requester_rc_t as for
+ * pldm_transport_recv_msg() if none was
+ */
+int pldm_transport_recv_batch(struct pldm_transport *transport,
+			      struct pldm_transport_msg *msgs, size_t count);
+
+/**
+ * @brief Receive into a pool of buffers owned by the transport
+ *
+ * The AF_MCTP and mctp-demux backends then receive each message straight
+ * into a buffer of the pool, with a single system call and no allocation.
+ * Messages longer than @p size are dropped with PLDM_REQUESTER_INVALID_RECV_LEN,
+ * so it should be the largest message expected, e.g. the negotiated maximum
+ * transfer size plus the PLDM header. Other backends ignore the pool.
+ *
+ * Once a pool is set up, messages from pldm_transport_recv_msg() and
+ * pldm_transport_send_recv_msg() must be handed back with
+ * pldm_transport_release_msg() rather than free(), and all of them must be
+ * handed back before the transport is destroyed.
+ *
+ * @param[in] transport - The transport instance
+ * @param[in] count - Number of buffers. Messages received while all of them
+ * are out get a buffer from the heap.
+ * @param[in] size - Size of each buffer
+ *
+ * @return 0 on success, -EINVAL for invalid arguments, -EBUSY if the
+ * transport has a pool already, or -ENOMEM
+ */
+int pldm_transport_rx_pool_init(struct pldm_transport *transport,
+				size_t count, size_t size);
+
+/**
+ * @brief Hand back a message received from the transport
+ *
+ * Returns the buffer to the transport's pool, or frees it if it did not come
+ * from one, so it may be used whether or not the transport has a pool.
+ *
+ * @param[in] transport - The transport the message came from
+ * @param[in] pldm_msg - The message, may be NULL
+ */
+void pldm_transport_release_msg(struct pldm_transport *transport,
+				void *pldm_msg);
+
 /**
  * @brief Synchronously send a PLDM request and receive the response. Control is
  * 	  returned to the caller once the response is received.
@@ -89,7 +182,7 @@ pldm_requester_rc_t pldm_transport_recv_msg(struct pldm_transport *transport,
  * pldm_transport_send_recv() will discard messages received on the underlying transport instance
  * that are not a response that matches the request. Do not use this function if you're attempting
  * to use the transport instance asynchronously, as this discard behaviour will affect other
- * responses that you may care about.
+ * responses that you may care about. Use pldm_transport_async_send_request() instead.
  *
  * @pre The pldm transport instance must be initialised; otherwise,
  * 	PLDM_REQUESTER_INVALID_SETUP is returned. If the transport requires a
@@ -107,7 +200,8 @@ pldm_requester_rc_t pldm_transport_recv_msg(struct pldm_transport *transport,
  * @param[out] pldm_resp_msg - *pldm_resp_msg will point to PLDM response msg if
  * 	       return code is PLDM_REQUESTER_SUCCESS; otherwise, NULL. On
  * 	       success this function allocates memory, caller to
- * 	       free(*pldm_resp_msg).
+ * 	       free(*pldm_resp_msg), or to pldm_transport_release_msg() it if
+ * 	       the transport has a receive pool.
  * @param[out] resp_msg_len - caller owned pointer that will be made to point to
  *             the size of the PLDM response msg. If NULL,
  * 	       PLDM_REQUESTER_INVALID_SETUP is returned.
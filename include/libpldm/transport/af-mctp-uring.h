@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef LIBPLDM_AF_MCTP_URING_H
+#define LIBPLDM_AF_MCTP_URING_H
+
+#include <libpldm/base.h>
+#include <libpldm/pldm.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * An AF_MCTP transport driven through io_uring. A multishot receive stays
+ * armed on the socket, landing messages in a ring of buffers provided to the
+ * kernel, so they are collected without a system call each. Sends are queued
+ * on a second ring and complete in the background, which keeps the pollfd
+ * signalling received messages only.
+ *
+ * Once submitted, a send that fails is not reported, as for a message lost on
+ * the MCTP network.
+ */
+
+struct pldm_transport_af_mctp_uring;
+
+/**
+ * @brief Init the transport backend
+ *
+ * @param[out] ctx - Set to the transport, which must be NULL beforehand
+ * @param[in] msg_size - Size of the largest message to receive, e.g. the
+ * negotiated maximum transfer size plus the PLDM header. Larger messages are
+ * dropped.
+ *
+ * @return 0 on success, -EINVAL for invalid arguments, -ENOMEM, or the
+ * negative errno of the socket or io_uring setup that failed
+ */
+int pldm_transport_af_mctp_uring_init(struct pldm_transport_af_mctp_uring **ctx,
+				      size_t msg_size);
+
+/* Destroy the transport backend, waiting for the sends in flight */
+void pldm_transport_af_mctp_uring_destroy(
+	struct pldm_transport_af_mctp_uring *ctx);
+
+/* Get the core pldm transport struct */
+struct pldm_transport *
+pldm_transport_af_mctp_uring_core(struct pldm_transport_af_mctp_uring *ctx);
+
+#ifdef PLDM_HAS_POLL
+struct pollfd;
+/* Init pollfd for async calls */
+int pldm_transport_af_mctp_uring_init_pollfd(struct pldm_transport *t,
+					     struct pollfd *pollfd);
+#endif
+
+/* Inserts a TID-to-EID mapping into the transport's device map */
+int pldm_transport_af_mctp_uring_map_tid(
+	struct pldm_transport_af_mctp_uring *ctx, pldm_tid_t tid,
+	mctp_eid_t eid);
+
+/* Removes a TID-to-EID mapping from the transport's device map */
+int pldm_transport_af_mctp_uring_unmap_tid(
+	struct pldm_transport_af_mctp_uring *ctx, pldm_tid_t tid,
+	mctp_eid_t eid);
+
+/* Maps a TID to an endpoint on a given MCTP network, as for
+ * pldm_transport_af_mctp_map_tid_network() */
+int pldm_transport_af_mctp_uring_map_tid_network(
+	struct pldm_transport_af_mctp_uring *ctx, pldm_tid_t tid,
+	uint32_t network, mctp_eid_t eid);
+
+/* Removes the mapping of an endpoint on a given MCTP network */
+int pldm_transport_af_mctp_uring_unmap_tid_network(
+	struct pldm_transport_af_mctp_uring *ctx, pldm_tid_t tid,
+	uint32_t network, mctp_eid_t eid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBPLDM_AF_MCTP_URING_H */
@@ -37,6 +37,29 @@ int pldm_transport_af_mctp_map_tid(struct pldm_transport_af_mctp *ctx,
 int pldm_transport_af_mctp_unmap_tid(struct pldm_transport_af_mctp *ctx,
 				     pldm_tid_t tid, mctp_eid_t eid);
 
+/**
+ * @brief Map a TID to an endpoint on a given MCTP network
+ *
+ * Each TID maps to one endpoint, and each endpoint to one TID, so mapping
+ * either again replaces its previous mapping. pldm_transport_af_mctp_map_tid()
+ * maps on MCTP_NET_ANY, which matches the EID on every network.
+ *
+ * @param[in] ctx - The transport instance
+ * @param[in] tid - The TID, 0 to only remove the endpoint's mapping
+ * @param[in] network - The MCTP network ID, as smctp_network
+ * @param[in] eid - The EID of the endpoint on @p network
+ *
+ * @return 0
+ */
+int pldm_transport_af_mctp_map_tid_network(struct pldm_transport_af_mctp *ctx,
+					   pldm_tid_t tid, uint32_t network,
+					   mctp_eid_t eid);
+
+/* Removes the mapping of an endpoint on a given MCTP network */
+int pldm_transport_af_mctp_unmap_tid_network(
+	struct pldm_transport_af_mctp *ctx, pldm_tid_t tid, uint32_t network,
+	mctp_eid_t eid);
+
 /**
  * @brief Allow the transport to receive requests from remote endpoints
  *
@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef LIBPLDM_TRANSPORT_ASYNC_H
+#define LIBPLDM_TRANSPORT_ASYNC_H
+
+#include <libpldm/base.h>
+#include <libpldm/pldm.h>
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * pldm_transport_send_recv_msg() keeps one request outstanding and drops
+ * every other message it receives. The tracker instead keeps any number of
+ * requests outstanding over one transport, and hands each response to the
+ * callback of the request it answers, as matched on (TID, instance ID, PLDM
+ * type, command). Requests received from other termini go to a handler, so a
+ * single transport serves requesters and responder alike.
+ *
+ * Instance IDs remain the caller's to allocate, e.g. from a
+ * struct pldm_instance_db, and to free once the request completes.
+ */
+
+struct pldm_transport;
+struct pldm_transport_async;
+
+/* PT2max of DSP0240, as for pldm_transport_send_recv_msg() */
+#define PLDM_TRANSPORT_ASYNC_DEFAULT_TIMEOUT_MS 4800
+
+/**
+ * @brief Called once a request completes
+ *
+ * @param[in] arg - The argument given to pldm_transport_async_send_request()
+ * @param[in] tid - TID the request was sent to
+ * @param[in] pldm_msg - The response, valid until the callback returns. NULL
+ * unless @p rc is 0.
+ * @param[in] msg_len - Size of the response
+ * @param[in] rc - 0 on success, -ETIMEDOUT if no response came in time, or
+ * -ECANCELED if the tracker was destroyed first
+ */
+typedef void (*pldm_transport_async_response_fn)(void *arg, pldm_tid_t tid,
+						 const void *pldm_msg,
+						 size_t msg_len, int rc);
+
+/**
+ * @brief Called for each request received
+ *
+ * Responses go out with pldm_transport_send_msg() on the tracker's transport.
+ *
+ * @param[in] arg - The argument given to
+ * pldm_transport_async_set_request_handler()
+ * @param[in] tid - TID of the requester
+ * @param[in] pldm_msg - The request, valid until the handler returns
+ * @param[in] msg_len - Size of the request
+ */
+typedef void (*pldm_transport_async_request_fn)(void *arg, pldm_tid_t tid,
+						const void *pldm_msg,
+						size_t msg_len);
+
+/**
+ * @brief Create a tracker for the requests sent over @p transport
+ *
+ * @param[out] async - The new tracker, *async must be NULL
+ * @param[in] transport - Transport the tracker sends and receives on. It stays
+ * owned by the caller, but nothing else may receive from it while the tracker
+ * exists.
+ *
+ * @return 0 on success, -EINVAL or -ENOMEM otherwise
+ */
+int pldm_transport_async_init(struct pldm_transport_async **async,
+			      struct pldm_transport *transport);
+
+/**
+ * @brief Destroy the tracker
+ *
+ * Outstanding requests complete with -ECANCELED. Their callbacks must not
+ * send further requests.
+ */
+void pldm_transport_async_destroy(struct pldm_transport_async *async);
+
+/**
+ * @brief Time allowed for each response before its request completes with
+ * -ETIMEDOUT, PLDM_TRANSPORT_ASYNC_DEFAULT_TIMEOUT_MS by default
+ *
+ * Applies to the requests sent from then on.
+ *
+ * @return 0 on success, -EINVAL otherwise
+ */
+int pldm_transport_async_set_timeout(struct pldm_transport_async *async,
+				     int timeout_ms);
+
+/**
+ * @brief Hand the requests received to @p handler, rather than dropping them
+ *
+ * @param[in] async - The tracker
+ * @param[in] handler - Called for each request received, or NULL to drop them
+ * @param[in] arg - Passed to @p handler
+ *
+ * @return 0 on success, -EINVAL otherwise
+ */
+int pldm_transport_async_set_request_handler(
+	struct pldm_transport_async *async,
+	pldm_transport_async_request_fn handler, void *arg);
+
+/**
+ * @brief Send a request, and track it until its response comes
+ *
+ * @param[in] async - The tracker
+ * @param[in] tid - Destination PLDM TID
+ * @param[in] pldm_msg - The request, as for pldm_transport_send_msg()
+ * @param[in] msg_len - Size of the request
+ * @param[in] callback - Called when the request completes
+ * @param[in] arg - Passed to @p callback
+ *
+ * @return 0 if the request was sent, in which case @p callback will be called.
+ * -EINVAL for invalid arguments or if @p pldm_msg is not a request, -EBUSY if
+ * a request with the same TID, instance ID, type and command is outstanding,
+ * -ENOMEM, or -EIO if the transport failed to send it.
+ */
+int pldm_transport_async_send_request(struct pldm_transport_async *async,
+				      pldm_tid_t tid, const void *pldm_msg,
+				      size_t msg_len,
+				      pldm_transport_async_response_fn callback,
+				      void *arg);
+
+/**
+ * @brief Number of requests that have not completed yet
+ */
+unsigned int pldm_transport_async_pending(struct pldm_transport_async *async);
+
+/**
+ * @brief Milliseconds until the earliest outstanding request times out
+ *
+ * @return The delay, 0 if it is already overdue, or -1 if no request is
+ * outstanding
+ */
+int pldm_transport_async_next_timeout(struct pldm_transport_async *async);
+
+/**
+ * @brief Receive the messages waiting on the transport, then fail the
+ * requests that timed out
+ *
+ * Responses go to the callbacks of the requests they answer, and requests to
+ * the handler. Responses that answer no outstanding request, such as those
+ * arriving after their request timed out, are dropped.
+ *
+ * Call this when the transport is readable, and once
+ * pldm_transport_async_next_timeout() elapses. It does not block.
+ *
+ * @return 0 on success, -EINVAL, or -EIO if the transport failed. Requests that
+ * timed out are failed regardless.
+ */
+int pldm_transport_async_dispatch(struct pldm_transport_async *async);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBPLDM_TRANSPORT_ASYNC_H */
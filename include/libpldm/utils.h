@@ -38,6 +38,67 @@ uint8_t crc8(const void *data, size_t size);
  */
 uint32_t crc32(const void *data, size_t size);
 
+/** @struct pldm_crc32
+ *
+ *  CRC-32 of data passed in any number of pieces
+ */
+struct pldm_crc32 {
+	uint32_t state;
+};
+
+/** @brief Start a CRC-32 over no data
+ *
+ *  @param[out] crc - The CRC to start
+ */
+void pldm_crc32_init(struct pldm_crc32 *crc);
+
+/** @brief Extend a CRC-32 over the next piece of data
+ *
+ *  Large pieces use PCLMULQDQ or the ARMv8 CRC32 instructions if the CPU has
+ *  them.
+ *
+ *  @param[in,out] crc - The CRC so far
+ *  @param[in] data - Pointer to the next data
+ *  @param[in] size - Size of the data
+ */
+void pldm_crc32_update(struct pldm_crc32 *crc, const void *data, size_t size);
+
+/** @brief Finish a CRC-32
+ *
+ *  @param[in] crc - The CRC so far, which may be extended further
+ *  @return The checksum of all data passed so far, as crc32() computes it
+ */
+uint32_t pldm_crc32_final(const struct pldm_crc32 *crc);
+
+/** @struct pldm_crc8
+ *
+ *  Crc8 of data passed in any number of pieces
+ */
+struct pldm_crc8 {
+	uint8_t state;
+};
+
+/** @brief Start a Crc8 over no data
+ *
+ *  @param[out] crc - The CRC to start
+ */
+void pldm_crc8_init(struct pldm_crc8 *crc);
+
+/** @brief Extend a Crc8 over the next piece of data
+ *
+ *  @param[in,out] crc - The CRC so far
+ *  @param[in] data - Pointer to the next data
+ *  @param[in] size - Size of the data
+ */
+void pldm_crc8_update(struct pldm_crc8 *crc, const void *data, size_t size);
+
+/** @brief Finish a Crc8
+ *
+ *  @param[in] crc - The CRC so far, which may be extended further
+ *  @return The checksum of all data passed so far, as crc8() computes it
+ */
+uint8_t pldm_crc8_final(const struct pldm_crc8 *crc);
+
 /** @brief Convert ver32_t to string
  *  @param[in] version - Pointer to ver32_t
  *  @param[out] buffer - Pointer to the buffer
@@ -0,0 +1,2594 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include <libpldm/bej.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BEJ_DICTIONARY_HEADER_SIZE 12
+#define BEJ_DICTIONARY_ENTRY_SIZE  10
+#define BEJ_ENCODING_HEADER_SIZE   7
+
+/* Dictionary entry layout, DSP0218 table 37 */
+#define BEJ_ENTRY_FORMAT	  0
+#define BEJ_ENTRY_SEQUENCE	  1
+#define BEJ_ENTRY_CHILD_POINTER 3
+#define BEJ_ENTRY_CHILD_COUNT	  5
+#define BEJ_ENTRY_NAME_LENGTH	  7
+#define BEJ_ENTRY_NAME_OFFSET	  8
+
+enum bej_decoder_state {
+	BEJ_STATE_HEADER,
+	BEJ_STATE_SEQUENCE,
+	BEJ_STATE_FORMAT,
+	BEJ_STATE_LENGTH,
+	BEJ_STATE_COUNT,
+	BEJ_STATE_SCALAR,
+	BEJ_STATE_STREAM,
+	BEJ_STATE_DONE,
+};
+
+/* Marks an nnint whose length byte has not been seen yet */
+#define BEJ_NNINT_START 0xff
+
+static uint16_t bej_get16(const uint8_t *p)
+{
+	return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t bej_get32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+	       ((uint32_t)p[3] << 24);
+}
+
+/* Size of the dictionary proper, without any trailing checksum */
+static size_t bej_dictionary_size(const struct pldm_bej_dictionary *dictionary)
+{
+	return bej_get32(dictionary->data + 8);
+}
+
+static const uint8_t *
+bej_dictionary_entry(const struct pldm_bej_dictionary *dictionary,
+		     uint16_t offset)
+{
+	return dictionary->data + offset;
+}
+
+static const char *bej_entry_name(const struct pldm_bej_dictionary *dictionary,
+				  const uint8_t *entry)
+{
+	if (entry[BEJ_ENTRY_NAME_LENGTH] == 0) {
+		return "";
+	}
+	return (const char *)dictionary->data +
+	       bej_get16(entry + BEJ_ENTRY_NAME_OFFSET);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_dictionary_validate(const struct pldm_bej_dictionary *dictionary)
+{
+	const uint8_t *entry;
+	uint16_t child_pointer;
+	uint16_t child_count;
+	uint16_t name_offset;
+	uint8_t name_length;
+	uint16_t entries;
+	size_t size;
+	uint16_t i;
+
+	if (dictionary == NULL || dictionary->data == NULL) {
+		return -EINVAL;
+	}
+
+	if (dictionary->length < BEJ_DICTIONARY_HEADER_SIZE) {
+		return -EPROTO;
+	}
+
+	entries = bej_get16(dictionary->data + 2);
+	size = bej_dictionary_size(dictionary);
+	if (size > dictionary->length || size > UINT16_MAX + 1 ||
+	    entries == 0 ||
+	    BEJ_DICTIONARY_HEADER_SIZE +
+			    (size_t)entries * BEJ_DICTIONARY_ENTRY_SIZE >
+		    size) {
+		return -EPROTO;
+	}
+
+	for (i = 0; i < entries; i++) {
+		entry = dictionary->data + BEJ_DICTIONARY_HEADER_SIZE +
+			(size_t)i * BEJ_DICTIONARY_ENTRY_SIZE;
+		child_pointer = bej_get16(entry + BEJ_ENTRY_CHILD_POINTER);
+		child_count = bej_get16(entry + BEJ_ENTRY_CHILD_COUNT);
+		name_length = entry[BEJ_ENTRY_NAME_LENGTH];
+		name_offset = bej_get16(entry + BEJ_ENTRY_NAME_OFFSET);
+
+		// Children must be whole entries of the entry table
+		if (child_count &&
+		    (child_pointer < BEJ_DICTIONARY_HEADER_SIZE ||
+		     (child_pointer - BEJ_DICTIONARY_HEADER_SIZE) %
+			     BEJ_DICTIONARY_ENTRY_SIZE ||
+		     child_pointer + (size_t)child_count *
+						 BEJ_DICTIONARY_ENTRY_SIZE >
+			     BEJ_DICTIONARY_HEADER_SIZE +
+				     (size_t)entries *
+					     BEJ_DICTIONARY_ENTRY_SIZE)) {
+			return -EPROTO;
+		}
+
+		// Names are NUL-terminated and the length includes the NUL
+		if (name_length &&
+		    ((size_t)name_offset + name_length > size ||
+		     dictionary->data[name_offset + name_length - 1] != '\0')) {
+			return -EPROTO;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * A dictionary index is one position-independent block: this header, a copy
+ * of the dictionary, the entry table split into one array per field and two
+ * open addressing tables. Built indexes live on the heap; loaded ones are used
+ * in place, e.g. from a file mapped by every process on the BMC.
+ */
+struct pldm_bej_dictionary_index {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t entries;
+	uint32_t size;
+	/* Offsets from the start of the index */
+	uint32_t dictionary;
+	uint32_t dictionary_length;
+	uint32_t format;
+	uint32_t sequence;
+	uint32_t children;
+	uint32_t child_count;
+	uint32_t name;
+	uint32_t names;
+	uint32_t names_mask;
+	uint32_t sequences;
+	uint32_t sequences_mask;
+};
+
+/* "BEJI" in little-endian order, so an index from another byte order fails */
+#define BEJ_INDEX_MAGIC	  0x494a4542
+#define BEJ_INDEX_VERSION 1
+#define BEJ_INDEX_ALIGN	  8
+
+/*
+ * Keys are entry indices plus one so a zero key marks a free slot. The names
+ * table is keyed by parent entry, the sequences table by the first entry of a
+ * child list and only holds children listed out of sequence number order.
+ */
+struct bej_index_slot {
+	uint32_t hash;
+	uint16_t key;
+	uint16_t entry;
+};
+
+/* Bound on (parent, child) pairs, far above any published schema */
+#define BEJ_INDEX_MAX_PAIRS (1u << 20)
+
+static const void *bej_index_at(const struct pldm_bej_dictionary_index *index,
+				uint32_t offset)
+{
+	return (const uint8_t *)index + offset;
+}
+
+static const uint16_t *
+bej_index_u16(const struct pldm_bej_dictionary_index *index, uint32_t offset)
+{
+	return bej_index_at(index, offset);
+}
+
+static const struct bej_index_slot *
+bej_index_slots(const struct pldm_bej_dictionary_index *index, uint32_t offset)
+{
+	return bej_index_at(index, offset);
+}
+
+static const uint8_t *
+bej_index_data(const struct pldm_bej_dictionary_index *index)
+{
+	return bej_index_at(index, index->dictionary);
+}
+
+static const char *bej_index_name(const struct pldm_bej_dictionary_index *index,
+				  uint16_t entry)
+{
+	uint16_t offset = bej_index_u16(index, index->name)[entry];
+
+	return offset ? (const char *)bej_index_data(index) + offset : "";
+}
+
+static uint32_t bej_name_hash(uint16_t key, const char *name, size_t length)
+{
+	uint32_t hash = 2166136261u ^ key;
+	size_t i;
+
+	// FNV-1a
+	for (i = 0; i < length; i++) {
+		hash ^= (uint8_t)name[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static uint32_t bej_sequence_hash(uint16_t key, uint32_t sequence)
+{
+	uint32_t hash = key * 0x9e3779b1u ^ sequence * 0x85ebca6bu;
+
+	return hash ^ (hash >> 15);
+}
+
+static bool bej_index_named(const struct pldm_bej_dictionary_index *index,
+			    uint16_t entry, const char *name, size_t length)
+{
+	const char *found = bej_index_name(index, entry);
+
+	return !strncmp(found, name, length) && found[length] == '\0';
+}
+
+/* Find the child named @p name of entry @p parent, or return -1 */
+static int bej_index_find_name(const struct pldm_bej_dictionary_index *index,
+			       uint16_t parent, const char *name, size_t length)
+{
+	const struct bej_index_slot *slots =
+		bej_index_slots(index, index->names);
+	uint16_t key = parent + 1;
+	uint32_t hash = bej_name_hash(key, name, length);
+	uint32_t i;
+
+	for (i = hash & index->names_mask;; i = (i + 1) & index->names_mask) {
+		if (slots[i].key == 0) {
+			return -1;
+		}
+		if (slots[i].hash == hash && slots[i].key == key &&
+		    bej_index_named(index, slots[i].entry, name, length)) {
+			return slots[i].entry;
+		}
+	}
+}
+
+/*
+ * Find the entry for a sequence number among @p count entries from @p first,
+ * or return -1. Dictionaries list children in sequence number order, so the
+ * direct index almost always hits and the table covers the rest.
+ */
+static int bej_index_find_sequence(const struct pldm_bej_dictionary_index *index,
+				   uint16_t first, uint16_t count,
+				   uint64_t sequence)
+{
+	const uint16_t *sequences = bej_index_u16(index, index->sequence);
+	const struct bej_index_slot *slots;
+	uint16_t key = first + 1;
+	uint32_t hash;
+	uint32_t i;
+
+	if (sequence < count && sequences[first + sequence] == sequence) {
+		return first + (int)sequence;
+	}
+	if (sequence > UINT16_MAX) {
+		return -1;
+	}
+
+	slots = bej_index_slots(index, index->sequences);
+	hash = bej_sequence_hash(key, sequence);
+	for (i = hash & index->sequences_mask;;
+	     i = (i + 1) & index->sequences_mask) {
+		if (slots[i].key == 0) {
+			return -1;
+		}
+		if (slots[i].key == key && sequences[slots[i].entry] == sequence &&
+		    slots[i].entry >= first && slots[i].entry - first < count) {
+			return slots[i].entry;
+		}
+	}
+}
+
+static void bej_index_insert(struct bej_index_slot *slots, uint32_t mask,
+			     uint32_t hash, uint16_t key, uint16_t entry)
+{
+	uint32_t i;
+
+	for (i = hash & mask; slots[i].key; i = (i + 1) & mask) {
+		;
+	}
+
+	slots[i].hash = hash;
+	slots[i].key = key;
+	slots[i].entry = entry;
+}
+
+static uint32_t bej_index_align(size_t offset)
+{
+	return (offset + BEJ_INDEX_ALIGN - 1) & ~(size_t)(BEJ_INDEX_ALIGN - 1);
+}
+
+/* Smallest power of two keeping the load factor at or below one half */
+static uint32_t bej_index_slot_count(size_t keys)
+{
+	uint32_t slots = 8;
+
+	while (slots < 2 * keys) {
+		slots <<= 1;
+	}
+
+	return slots;
+}
+
+static struct bej_index_slot *
+bej_index_slots_mut(struct pldm_bej_dictionary_index *index, uint32_t offset)
+{
+	return (struct bej_index_slot *)((uint8_t *)index + offset);
+}
+
+static void bej_index_add_name(struct pldm_bej_dictionary_index *index,
+			       uint16_t parent, uint16_t child)
+{
+	const char *name = bej_index_name(index, child);
+	size_t length = strlen(name);
+
+	// Array members are unnamed, and the first of several siblings
+	// sharing a name wins
+	if (length == 0 ||
+	    bej_index_find_name(index, parent, name, length) >= 0) {
+		return;
+	}
+
+	bej_index_insert(bej_index_slots_mut(index, index->names),
+			 index->names_mask,
+			 bej_name_hash(parent + 1, name, length), parent + 1,
+			 child);
+}
+
+static void bej_index_add_sequence(struct pldm_bej_dictionary_index *index,
+				   uint16_t first, uint16_t count,
+				   uint16_t child)
+{
+	uint16_t sequence = bej_index_u16(index, index->sequence)[child];
+
+	if (bej_index_find_sequence(index, first, count, sequence) >= 0) {
+		return;
+	}
+
+	bej_index_insert(bej_index_slots_mut(index, index->sequences),
+			 index->sequences_mask,
+			 bej_sequence_hash(first + 1, sequence), first + 1,
+			 child);
+}
+
+/* Fill the per-field arrays from the dictionary entry table */
+static void bej_index_fill(struct pldm_bej_dictionary_index *index)
+{
+	uint8_t *base = (uint8_t *)index;
+	uint16_t *sequences = (uint16_t *)(base + index->sequence);
+	uint16_t *children = (uint16_t *)(base + index->children);
+	uint16_t *counts = (uint16_t *)(base + index->child_count);
+	uint16_t *names = (uint16_t *)(base + index->name);
+	uint8_t *formats = base + index->format;
+	const uint8_t *entry;
+	uint16_t i;
+
+	for (i = 0; i < index->entries; i++) {
+		entry = bej_index_data(index) + BEJ_DICTIONARY_HEADER_SIZE +
+			(size_t)i * BEJ_DICTIONARY_ENTRY_SIZE;
+		formats[i] = entry[BEJ_ENTRY_FORMAT];
+		sequences[i] = bej_get16(entry + BEJ_ENTRY_SEQUENCE);
+		counts[i] = bej_get16(entry + BEJ_ENTRY_CHILD_COUNT);
+		children[i] = 0;
+		if (counts[i]) {
+			children[i] = (bej_get16(entry +
+						 BEJ_ENTRY_CHILD_POINTER) -
+				       BEJ_DICTIONARY_HEADER_SIZE) /
+				      BEJ_DICTIONARY_ENTRY_SIZE;
+		}
+		names[i] = 0;
+		if (entry[BEJ_ENTRY_NAME_LENGTH]) {
+			names[i] = bej_get16(entry + BEJ_ENTRY_NAME_OFFSET);
+		}
+	}
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_dictionary_index_build(
+	const struct pldm_bej_dictionary *dictionary,
+	struct pldm_bej_dictionary_index **index)
+{
+	struct pldm_bej_dictionary_index layout = { 0 };
+	struct pldm_bej_dictionary_index *built;
+	const uint16_t *children;
+	const uint16_t *counts;
+	const uint8_t *entry;
+	size_t misplaced = 0;
+	size_t pairs = 0;
+	uint16_t sequence;
+	uint16_t pointer;
+	size_t offset;
+	uint16_t i;
+	uint16_t j;
+	int rc;
+
+	if (index == NULL) {
+		return -EINVAL;
+	}
+
+	rc = pldm_bej_dictionary_validate(dictionary);
+	if (rc) {
+		return rc;
+	}
+
+	// Size the tables: every named child goes in the names table, and
+	// children listed out of order in the sequences table
+	layout.entries = bej_get16(dictionary->data + 2);
+	for (i = 0; i < layout.entries; i++) {
+		entry = dictionary->data + BEJ_DICTIONARY_HEADER_SIZE +
+			(size_t)i * BEJ_DICTIONARY_ENTRY_SIZE;
+		pointer = bej_get16(entry + BEJ_ENTRY_CHILD_POINTER);
+		for (j = 0; j < bej_get16(entry + BEJ_ENTRY_CHILD_COUNT); j++) {
+			sequence = bej_get16(dictionary->data + pointer +
+					     j * BEJ_DICTIONARY_ENTRY_SIZE +
+					     BEJ_ENTRY_SEQUENCE);
+			pairs++;
+			misplaced += sequence != j;
+		}
+	}
+	if (pairs > BEJ_INDEX_MAX_PAIRS) {
+		return -EPROTO;
+	}
+
+	layout.magic = BEJ_INDEX_MAGIC;
+	layout.version = BEJ_INDEX_VERSION;
+	layout.dictionary_length = bej_dictionary_size(dictionary);
+	layout.names_mask = bej_index_slot_count(pairs) - 1;
+	layout.sequences_mask = bej_index_slot_count(misplaced) - 1;
+
+	offset = bej_index_align(sizeof(layout));
+	layout.dictionary = offset;
+	offset = bej_index_align(offset + layout.dictionary_length);
+	layout.format = offset;
+	offset = bej_index_align(offset + layout.entries);
+	layout.sequence = offset;
+	offset = bej_index_align(offset + layout.entries * sizeof(uint16_t));
+	layout.children = offset;
+	offset = bej_index_align(offset + layout.entries * sizeof(uint16_t));
+	layout.child_count = offset;
+	offset = bej_index_align(offset + layout.entries * sizeof(uint16_t));
+	layout.name = offset;
+	offset = bej_index_align(offset + layout.entries * sizeof(uint16_t));
+	layout.names = offset;
+	offset += (layout.names_mask + 1) * sizeof(struct bej_index_slot);
+	layout.sequences = offset;
+	offset += (layout.sequences_mask + 1) * sizeof(struct bej_index_slot);
+	layout.size = offset;
+
+	built = calloc(1, layout.size);
+	if (built == NULL) {
+		return -ENOMEM;
+	}
+	*built = layout;
+	memcpy((uint8_t *)built + layout.dictionary, dictionary->data,
+	       layout.dictionary_length);
+	bej_index_fill(built);
+
+	children = bej_index_u16(built, built->children);
+	counts = bej_index_u16(built, built->child_count);
+	for (i = 0; i < layout.entries; i++) {
+		for (j = 0; j < counts[i]; j++) {
+			bej_index_add_name(built, i, children[i] + j);
+			if (bej_index_u16(built, built->sequence)[children[i] +
+								  j] != j) {
+				bej_index_add_sequence(built, children[i],
+						       counts[i],
+						       children[i] + j);
+			}
+		}
+	}
+
+	*index = built;
+	return 0;
+}
+
+/* Check that [offset, offset + length) lies within the index, aligned */
+static bool bej_index_region(const struct pldm_bej_dictionary_index *index,
+			     uint32_t offset, size_t length)
+{
+	return offset >= sizeof(*index) && !(offset % BEJ_INDEX_ALIGN) &&
+	       offset <= index->size && length <= index->size - offset;
+}
+
+/* Check a table has a free slot to end probes and only names real entries */
+static bool bej_index_table(const struct pldm_bej_dictionary_index *index,
+			    uint32_t offset, uint32_t mask)
+{
+	const struct bej_index_slot *slots;
+	bool free = false;
+	uint32_t i;
+
+	if (mask & (mask + 1) || mask >= BEJ_INDEX_MAX_PAIRS * 2 ||
+	    !bej_index_region(index, offset,
+			      ((size_t)mask + 1) * sizeof(*slots))) {
+		return false;
+	}
+
+	slots = bej_index_slots(index, offset);
+	for (i = 0; i <= mask; i++) {
+		if (slots[i].key == 0) {
+			free = true;
+		} else if (slots[i].entry >= index->entries) {
+			return false;
+		}
+	}
+
+	return free;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_dictionary_index_load(
+	const void *data, size_t length,
+	const struct pldm_bej_dictionary_index **index)
+{
+	const struct pldm_bej_dictionary_index *loaded = data;
+	struct pldm_bej_dictionary dictionary;
+	const uint8_t *entry;
+	uint16_t count;
+	size_t arrays;
+	uint16_t i;
+	int rc;
+
+	if (data == NULL || index == NULL ||
+	    (uintptr_t)data % BEJ_INDEX_ALIGN) {
+		return -EINVAL;
+	}
+
+	if (length < sizeof(*loaded) || loaded->magic != BEJ_INDEX_MAGIC ||
+	    loaded->version != BEJ_INDEX_VERSION || loaded->size > length) {
+		return -EPROTO;
+	}
+
+	arrays = (size_t)loaded->entries * sizeof(uint16_t);
+	if (!bej_index_region(loaded, loaded->dictionary,
+			      loaded->dictionary_length) ||
+	    !bej_index_region(loaded, loaded->format, loaded->entries) ||
+	    !bej_index_region(loaded, loaded->sequence, arrays) ||
+	    !bej_index_region(loaded, loaded->children, arrays) ||
+	    !bej_index_region(loaded, loaded->child_count, arrays) ||
+	    !bej_index_region(loaded, loaded->name, arrays) ||
+	    !bej_index_table(loaded, loaded->names, loaded->names_mask) ||
+	    !bej_index_table(loaded, loaded->sequences,
+			     loaded->sequences_mask)) {
+		return -EPROTO;
+	}
+
+	dictionary.data = bej_index_data(loaded);
+	dictionary.length = loaded->dictionary_length;
+	rc = pldm_bej_dictionary_validate(&dictionary);
+	if (rc) {
+		return rc;
+	}
+	if (bej_get16(dictionary.data + 2) != loaded->entries) {
+		return -EPROTO;
+	}
+
+	// Lookups trust the arrays, so they must agree with the dictionary
+	for (i = 0; i < loaded->entries; i++) {
+		entry = dictionary.data + BEJ_DICTIONARY_HEADER_SIZE +
+			(size_t)i * BEJ_DICTIONARY_ENTRY_SIZE;
+		count = bej_get16(entry + BEJ_ENTRY_CHILD_COUNT);
+		if (((const uint8_t *)loaded + loaded->format)[i] !=
+			    entry[BEJ_ENTRY_FORMAT] ||
+		    bej_index_u16(loaded, loaded->sequence)[i] !=
+			    bej_get16(entry + BEJ_ENTRY_SEQUENCE) ||
+		    bej_index_u16(loaded, loaded->child_count)[i] != count ||
+		    (count &&
+		     bej_index_u16(loaded, loaded->children)[i] !=
+			     (bej_get16(entry + BEJ_ENTRY_CHILD_POINTER) -
+			      BEJ_DICTIONARY_HEADER_SIZE) /
+				     BEJ_DICTIONARY_ENTRY_SIZE) ||
+		    bej_index_u16(loaded, loaded->name)[i] !=
+			    (entry[BEJ_ENTRY_NAME_LENGTH]
+				     ? bej_get16(entry + BEJ_ENTRY_NAME_OFFSET)
+				     : 0)) {
+			return -EPROTO;
+		}
+	}
+
+	*index = loaded;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+size_t pldm_bej_dictionary_index_size(
+	const struct pldm_bej_dictionary_index *index)
+{
+	return index ? index->size : 0;
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_bej_dictionary_index_free(struct pldm_bej_dictionary_index *index)
+{
+	free(index);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_dictionary_index_dictionary(
+	const struct pldm_bej_dictionary_index *index,
+	struct pldm_bej_dictionary *dictionary)
+{
+	if (index == NULL || dictionary == NULL) {
+		return -EINVAL;
+	}
+
+	dictionary->data = bej_index_data(index);
+	dictionary->length = index->dictionary_length;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_dictionary_index_entry(
+	const struct pldm_bej_dictionary_index *index, uint16_t entry,
+	struct pldm_bej_dictionary_entry *out)
+{
+	uint8_t format;
+
+	if (index == NULL || out == NULL) {
+		return -EINVAL;
+	}
+	if (entry >= index->entries) {
+		return -ENOENT;
+	}
+
+	format = ((const uint8_t *)index + index->format)[entry];
+	out->format = format >> 4;
+	out->flags = format & 0xf;
+	out->sequence = bej_index_u16(index, index->sequence)[entry];
+	out->children = bej_index_u16(index, index->children)[entry];
+	out->child_count = bej_index_u16(index, index->child_count)[entry];
+	out->name = bej_index_name(index, entry);
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_dictionary_index_child(
+	const struct pldm_bej_dictionary_index *index, uint16_t parent,
+	uint16_t sequence, uint16_t *child)
+{
+	int found;
+
+	if (index == NULL || child == NULL) {
+		return -EINVAL;
+	}
+	if (parent >= index->entries) {
+		return -ENOENT;
+	}
+
+	found = bej_index_find_sequence(
+		index, bej_index_u16(index, index->children)[parent],
+		bej_index_u16(index, index->child_count)[parent], sequence);
+	if (found < 0) {
+		return -ENOENT;
+	}
+
+	*child = found;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_dictionary_index_find(
+	const struct pldm_bej_dictionary_index *index, uint16_t parent,
+	const char *name, uint16_t *child)
+{
+	int found;
+
+	if (index == NULL || name == NULL || child == NULL) {
+		return -EINVAL;
+	}
+	if (parent >= index->entries) {
+		return -ENOENT;
+	}
+
+	found = bej_index_find_name(index, parent, name, strlen(name));
+	if (found < 0) {
+		return -ENOENT;
+	}
+
+	*child = found;
+	return 0;
+}
+
+/*
+ * Find the entry for a sequence number among the children of a container.
+ * Dictionaries list children in sequence number order, so the direct index
+ * almost always hits. Without an index the rest are found by a scan.
+ */
+static const uint8_t *bej_find_child(const struct pldm_bej_decoder *decoder,
+				     const struct pldm_bej_dictionary *dictionary,
+				     uint16_t children, uint16_t child_count,
+				     uint64_t sequence)
+{
+	const struct pldm_bej_dictionary_index *index;
+	const uint8_t *entry;
+	int found;
+	uint16_t i;
+
+	index = dictionary == &decoder->schema ? decoder->schema_index
+					       : decoder->annotation_index;
+	if (index != NULL) {
+		if (child_count == 0) {
+			return NULL;
+		}
+		found = bej_index_find_sequence(
+			index,
+			(children - BEJ_DICTIONARY_HEADER_SIZE) /
+				BEJ_DICTIONARY_ENTRY_SIZE,
+			child_count, sequence);
+		if (found < 0) {
+			return NULL;
+		}
+		return bej_dictionary_entry(
+			dictionary, BEJ_DICTIONARY_HEADER_SIZE +
+					    found * BEJ_DICTIONARY_ENTRY_SIZE);
+	}
+
+	if (sequence < child_count) {
+		entry = bej_dictionary_entry(
+			dictionary,
+			children + sequence * BEJ_DICTIONARY_ENTRY_SIZE);
+		if (bej_get16(entry + BEJ_ENTRY_SEQUENCE) == sequence) {
+			return entry;
+		}
+	}
+
+	for (i = 0; i < child_count; i++) {
+		entry = bej_dictionary_entry(
+			dictionary, children + i * BEJ_DICTIONARY_ENTRY_SIZE);
+		if (bej_get16(entry + BEJ_ENTRY_SEQUENCE) == sequence) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static const uint8_t *
+bej_dictionary_root(const struct pldm_bej_dictionary *dictionary)
+{
+	return bej_dictionary_entry(dictionary, BEJ_DICTIONARY_HEADER_SIZE);
+}
+
+static void bej_decoder_setup(struct pldm_bej_decoder *decoder,
+			      const struct pldm_bej_dictionary *schema,
+			      const struct pldm_bej_dictionary *annotation,
+			      pldm_bej_token_fn emit, void *arg)
+{
+	memset(decoder, 0, sizeof(*decoder));
+	decoder->schema = *schema;
+	if (annotation != NULL) {
+		decoder->annotation = *annotation;
+	}
+	decoder->emit = emit;
+	decoder->arg = arg;
+	decoder->state = BEJ_STATE_HEADER;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_decoder_init(struct pldm_bej_decoder *decoder,
+			  const struct pldm_bej_dictionary *schema,
+			  const struct pldm_bej_dictionary *annotation,
+			  pldm_bej_token_fn emit, void *arg)
+{
+	int rc;
+
+	if (decoder == NULL || schema == NULL || emit == NULL) {
+		return -EINVAL;
+	}
+
+	rc = pldm_bej_dictionary_validate(schema);
+	if (rc) {
+		return rc;
+	}
+
+	if (annotation != NULL) {
+		rc = pldm_bej_dictionary_validate(annotation);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	bej_decoder_setup(decoder, schema, annotation, emit, arg);
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_decoder_init_indexed(
+	struct pldm_bej_decoder *decoder,
+	const struct pldm_bej_dictionary_index *schema,
+	const struct pldm_bej_dictionary_index *annotation,
+	pldm_bej_token_fn emit, void *arg)
+{
+	struct pldm_bej_dictionary annotation_dictionary;
+	struct pldm_bej_dictionary schema_dictionary;
+
+	if (decoder == NULL || schema == NULL || emit == NULL) {
+		return -EINVAL;
+	}
+
+	// Indexes carry dictionaries validated when they were built or loaded
+	pldm_bej_dictionary_index_dictionary(schema, &schema_dictionary);
+	if (annotation != NULL) {
+		pldm_bej_dictionary_index_dictionary(annotation,
+						     &annotation_dictionary);
+	}
+	bej_decoder_setup(decoder, &schema_dictionary,
+			  annotation ? &annotation_dictionary : NULL, emit,
+			  arg);
+	decoder->schema_index = schema;
+	decoder->annotation_index = annotation;
+	return 0;
+}
+
+/* Containers enclosing the current tuple, not counting annotation wrappers */
+static unsigned int bej_container_depth(const struct pldm_bej_decoder *decoder)
+{
+	unsigned int depth = 0;
+	unsigned int i;
+
+	for (i = 0; i < decoder->depth; i++) {
+		if (decoder->stack[i].format !=
+		    PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION) {
+			depth++;
+		}
+	}
+
+	return depth;
+}
+
+static int bej_emit(struct pldm_bej_decoder *decoder,
+		    struct pldm_bej_token *token)
+{
+	token->name = decoder->name;
+	token->annotation = decoder->annotation_name;
+	token->depth = bej_container_depth(decoder);
+	return decoder->emit(decoder->arg, token);
+}
+
+static void bej_nnint_start(struct pldm_bej_decoder *decoder, int state)
+{
+	decoder->state = state;
+	decoder->nnint = 0;
+	decoder->nnint_remaining = BEJ_NNINT_START;
+	decoder->nnint_shift = 0;
+}
+
+/*
+ * Feed one byte of a nonnegative integer: a length byte followed by that many
+ * little-endian value bytes. Returns 1 once the value is complete.
+ */
+static int bej_nnint_feed(struct pldm_bej_decoder *decoder, uint8_t byte)
+{
+	if (decoder->nnint_remaining == BEJ_NNINT_START) {
+		if (byte > sizeof(decoder->nnint)) {
+			return -EOVERFLOW;
+		}
+		decoder->nnint_remaining = byte;
+		return byte == 0;
+	}
+
+	decoder->nnint |= (uint64_t)byte << decoder->nnint_shift;
+	decoder->nnint_shift += 8;
+	return --decoder->nnint_remaining == 0;
+}
+
+/* Decode a nonnegative integer from a buffered value */
+static int bej_read_nnint(const uint8_t **cursor, const uint8_t *end,
+			  uint64_t *value)
+{
+	uint8_t length;
+	uint8_t i;
+
+	if (*cursor >= end) {
+		return -EPROTO;
+	}
+
+	length = *(*cursor)++;
+	if (length > sizeof(*value)) {
+		return -EOVERFLOW;
+	}
+	if (length > end - *cursor) {
+		return -EPROTO;
+	}
+
+	*value = 0;
+	for (i = 0; i < length; i++) {
+		*value |= (uint64_t) * (*cursor)++ << (8 * i);
+	}
+
+	return 0;
+}
+
+/* Decode a little-endian two's complement integer of 1 to 8 bytes */
+static int bej_read_integer(const uint8_t *data, size_t length, int64_t *value)
+{
+	uint64_t raw = 0;
+	size_t i;
+
+	if (length == 0 || length > sizeof(raw)) {
+		return length ? -EOVERFLOW : -EPROTO;
+	}
+
+	for (i = 0; i < length; i++) {
+		raw |= (uint64_t)data[i] << (8 * i);
+	}
+	if (length < sizeof(raw) && (data[length - 1] & 0x80)) {
+		raw |= UINT64_MAX << (8 * length);
+	}
+
+	memcpy(value, &raw, sizeof(*value));
+	return 0;
+}
+
+static int bej_read_real(const uint8_t *data, size_t length,
+			 struct pldm_bej_token *token)
+{
+	const uint8_t *cursor = data;
+	const uint8_t *end = data + length;
+	uint64_t field;
+	int rc;
+
+	rc = bej_read_nnint(&cursor, end, &field);
+	if (rc) {
+		return rc;
+	}
+	if (field > (uint64_t)(end - cursor)) {
+		return -EPROTO;
+	}
+	rc = bej_read_integer(cursor, field, &token->value.real.whole);
+	if (rc) {
+		return rc;
+	}
+	cursor += field;
+
+	rc = bej_read_nnint(&cursor, end, &token->value.real.leading_zeros);
+	if (rc) {
+		return rc;
+	}
+	// Writing them out is linear in their count
+	if (token->value.real.leading_zeros > PLDM_BEJ_MAX_LEADING_ZEROS) {
+		return -EOVERFLOW;
+	}
+
+	rc = bej_read_nnint(&cursor, end, &token->value.real.fract);
+	if (rc) {
+		return rc;
+	}
+
+	rc = bej_read_nnint(&cursor, end, &field);
+	if (rc) {
+		return rc;
+	}
+	if (field != (uint64_t)(end - cursor)) {
+		return -EPROTO;
+	}
+	token->value.real.exponent = 0;
+	if (field) {
+		rc = bej_read_integer(cursor, field,
+				      &token->value.real.exponent);
+	}
+
+	return rc;
+}
+
+/*
+ * A value finished: count it against its container and close every container
+ * that is now complete.
+ */
+static int bej_value_done(struct pldm_bej_decoder *decoder)
+{
+	struct pldm_bej_token token;
+	struct pldm_bej_frame *frame;
+	int rc;
+
+	while (decoder->depth) {
+		frame = &decoder->stack[decoder->depth - 1];
+		if (frame->remaining) {
+			frame->remaining--;
+		}
+		if (frame->remaining) {
+			bej_nnint_start(decoder, BEJ_STATE_SEQUENCE);
+			return 0;
+		}
+
+		if (decoder->offset != frame->end) {
+			return -EPROTO;
+		}
+
+		decoder->depth--;
+		if (frame->format == PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION) {
+			continue;
+		}
+
+		memset(&token, 0, sizeof(token));
+		token.type = frame->format == PLDM_BEJ_FORMAT_SET
+				     ? PLDM_BEJ_TOKEN_OBJECT_END
+				     : PLDM_BEJ_TOKEN_ARRAY_END;
+		decoder->name = NULL;
+		decoder->annotation_name = NULL;
+		rc = bej_emit(decoder, &token);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	decoder->state = BEJ_STATE_DONE;
+	return 0;
+}
+
+/* Resolve the name and dictionary entry of the tuple just started */
+static int bej_resolve(struct pldm_bej_decoder *decoder)
+{
+	const struct pldm_bej_dictionary *dictionary = &decoder->schema;
+	uint32_t sequence = decoder->sequence >> 1;
+	bool annotation = decoder->sequence & 1;
+	struct pldm_bej_frame *frame;
+	const uint8_t *entry;
+
+	decoder->name = NULL;
+	decoder->annotation_name = NULL;
+
+	if (decoder->depth == 0) {
+		entry = bej_dictionary_root(dictionary);
+		goto found;
+	}
+
+	frame = &decoder->stack[decoder->depth - 1];
+	switch (frame->format) {
+	case PLDM_BEJ_FORMAT_ARRAY:
+		// Members share the array's only child entry
+		dictionary = frame->dictionary;
+		entry = frame->child_count ? bej_dictionary_entry(
+						     dictionary, frame->children)
+					   : NULL;
+		goto found;
+	case PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION:
+		if (!annotation) {
+			return -EPROTO;
+		}
+		break;
+	default:
+		if (annotation == (frame->dictionary == &decoder->annotation)) {
+			// Members of the same dictionary
+			dictionary = frame->dictionary;
+			entry = bej_find_child(decoder, dictionary, frame->children,
+					       frame->child_count, sequence);
+			if (entry == NULL) {
+				return -EPROTO;
+			}
+			decoder->name = bej_entry_name(dictionary, entry);
+			goto found;
+		}
+		if (!annotation) {
+			return -EPROTO;
+		}
+		break;
+	}
+
+	// Annotations resolve against the top level of the annotation
+	// dictionary
+	dictionary = &decoder->annotation;
+	if (dictionary->data == NULL) {
+		return -EPROTO;
+	}
+	entry = bej_dictionary_root(dictionary);
+	entry = bej_find_child(decoder, dictionary,
+			       bej_get16(entry + BEJ_ENTRY_CHILD_POINTER),
+			       bej_get16(entry + BEJ_ENTRY_CHILD_COUNT),
+			       sequence);
+	if (entry == NULL) {
+		return -EPROTO;
+	}
+	if (frame->format == PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION) {
+		decoder->name = frame->annotated;
+		decoder->annotation_name = bej_entry_name(dictionary, entry);
+	} else {
+		decoder->name = bej_entry_name(dictionary, entry);
+	}
+
+found:
+	decoder->entry_dictionary = dictionary;
+	if (entry == NULL) {
+		decoder->entry_children = 0;
+		decoder->entry_child_count = 0;
+	} else {
+		decoder->entry_children =
+			bej_get16(entry + BEJ_ENTRY_CHILD_POINTER);
+		decoder->entry_child_count =
+			bej_get16(entry + BEJ_ENTRY_CHILD_COUNT);
+	}
+	return 0;
+}
+
+static int bej_push_frame(struct pldm_bej_decoder *decoder, uint64_t count)
+{
+	struct pldm_bej_frame *frame;
+
+	if (decoder->depth == PLDM_BEJ_MAX_DEPTH) {
+		return -EOVERFLOW;
+	}
+
+	frame = &decoder->stack[decoder->depth++];
+	frame->dictionary = decoder->entry_dictionary;
+	frame->children = decoder->entry_children;
+	frame->child_count = decoder->entry_child_count;
+	frame->format = decoder->format;
+	frame->annotated = decoder->name;
+	frame->end = decoder->offset + decoder->value_remaining;
+	frame->remaining = count;
+	return 0;
+}
+
+static int bej_finish_scalar(struct pldm_bej_decoder *decoder);
+static int bej_stream(struct pldm_bej_decoder *decoder, const uint8_t *data,
+		      size_t length, size_t *consumed);
+
+/* The tuple's length is known, decide how to consume its value */
+static int bej_start_value(struct pldm_bej_decoder *decoder)
+{
+	struct pldm_bej_token token;
+	int rc;
+
+	decoder->value_remaining = decoder->nnint;
+	if (decoder->depth &&
+	    decoder->value_remaining >
+		    decoder->stack[decoder->depth - 1].end - decoder->offset) {
+		return -EPROTO;
+	}
+
+	switch (decoder->format) {
+	case PLDM_BEJ_FORMAT_SET:
+	case PLDM_BEJ_FORMAT_ARRAY:
+		bej_nnint_start(decoder, BEJ_STATE_COUNT);
+		return 0;
+	case PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION:
+		// The value is a single tuple from the annotation dictionary
+		rc = bej_push_frame(decoder, 1);
+		if (rc) {
+			return rc;
+		}
+		bej_nnint_start(decoder, BEJ_STATE_SEQUENCE);
+		return 0;
+	case PLDM_BEJ_FORMAT_NULL:
+		if (decoder->value_remaining) {
+			return -EPROTO;
+		}
+		memset(&token, 0, sizeof(token));
+		token.type = PLDM_BEJ_TOKEN_NULL;
+		rc = bej_emit(decoder, &token);
+		return rc ? rc : bej_value_done(decoder);
+	case PLDM_BEJ_FORMAT_STRING:
+	case PLDM_BEJ_FORMAT_BYTE_STRING: {
+		size_t consumed;
+
+		decoder->value_continued = false;
+		decoder->state = BEJ_STATE_STREAM;
+		return decoder->value_remaining
+			       ? 0
+			       : bej_stream(decoder, NULL, 0, &consumed);
+	}
+	case PLDM_BEJ_FORMAT_INTEGER:
+	case PLDM_BEJ_FORMAT_ENUM:
+	case PLDM_BEJ_FORMAT_REAL:
+	case PLDM_BEJ_FORMAT_BOOLEAN:
+	case PLDM_BEJ_FORMAT_RESOURCE_LINK:
+		if (decoder->value_remaining > sizeof(decoder->scratch)) {
+			return -EOVERFLOW;
+		}
+		decoder->scratch_length = 0;
+		decoder->state = BEJ_STATE_SCALAR;
+		return decoder->value_remaining ? 0 : bej_finish_scalar(decoder);
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static int bej_finish_scalar(struct pldm_bej_decoder *decoder)
+{
+	const uint8_t *cursor = decoder->scratch;
+	const uint8_t *end = decoder->scratch + decoder->scratch_length;
+	struct pldm_bej_token token;
+	const uint8_t *entry;
+	uint64_t value;
+	int rc;
+
+	memset(&token, 0, sizeof(token));
+	switch (decoder->format) {
+	case PLDM_BEJ_FORMAT_INTEGER:
+		token.type = PLDM_BEJ_TOKEN_INTEGER;
+		rc = bej_read_integer(cursor, end - cursor,
+				      &token.value.integer);
+		break;
+	case PLDM_BEJ_FORMAT_BOOLEAN:
+		token.type = PLDM_BEJ_TOKEN_BOOLEAN;
+		token.value.boolean = end - cursor == 1 && *cursor;
+		rc = end - cursor == 1 ? 0 : -EPROTO;
+		break;
+	case PLDM_BEJ_FORMAT_REAL:
+		token.type = PLDM_BEJ_TOKEN_REAL;
+		rc = bej_read_real(cursor, end - cursor, &token);
+		break;
+	case PLDM_BEJ_FORMAT_ENUM:
+		token.type = PLDM_BEJ_TOKEN_ENUM;
+		rc = bej_read_nnint(&cursor, end, &value);
+		if (rc) {
+			break;
+		}
+		if (cursor != end) {
+			rc = -EPROTO;
+			break;
+		}
+		entry = bej_find_child(decoder, decoder->entry_dictionary,
+				       decoder->entry_children,
+				       decoder->entry_child_count, value);
+		if (entry == NULL) {
+			rc = -EPROTO;
+			break;
+		}
+		token.value.enumeration =
+			bej_entry_name(decoder->entry_dictionary, entry);
+		break;
+	case PLDM_BEJ_FORMAT_RESOURCE_LINK:
+		token.type = PLDM_BEJ_TOKEN_RESOURCE_LINK;
+		rc = bej_read_nnint(&cursor, end, &value);
+		if (!rc && (cursor != end || value > UINT32_MAX)) {
+			rc = -EPROTO;
+		}
+		token.value.resource_id = value;
+		break;
+	default:
+		rc = -ENOTSUP;
+		break;
+	}
+	if (rc) {
+		return rc;
+	}
+
+	rc = bej_emit(decoder, &token);
+	return rc ? rc : bej_value_done(decoder);
+}
+
+/*
+ * Hand the part of a string or byte string that is in this chunk straight to
+ * the callback. The NUL that terminates strings is not passed on.
+ */
+static int bej_stream(struct pldm_bej_decoder *decoder, const uint8_t *data,
+		      size_t length, size_t *consumed)
+{
+	bool string = decoder->format == PLDM_BEJ_FORMAT_STRING;
+	struct pldm_bej_token token;
+	uint64_t content;
+	size_t take;
+	size_t emit;
+	int rc;
+
+	take = length < decoder->value_remaining ? length
+						 : decoder->value_remaining;
+	content = decoder->value_remaining;
+	if (string && content) {
+		content--;
+	}
+	emit = take < content ? take : content;
+
+	if (string && take > content && data[content] != '\0') {
+		return -EPROTO;
+	}
+
+	decoder->value_remaining -= take;
+	decoder->offset += take;
+	*consumed = take;
+
+	if (emit || (decoder->value_remaining == 0 &&
+		     !decoder->value_continued)) {
+		memset(&token, 0, sizeof(token));
+		token.type = string ? PLDM_BEJ_TOKEN_STRING
+				    : PLDM_BEJ_TOKEN_BYTE_STRING;
+		token.continued = decoder->value_continued;
+		token.more = content > emit;
+		token.value.bytes.data = data;
+		token.value.bytes.length = emit;
+		decoder->value_continued = true;
+		rc = bej_emit(decoder, &token);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return decoder->value_remaining ? 0 : bej_value_done(decoder);
+}
+
+static int bej_feed(struct pldm_bej_decoder *decoder, const uint8_t *data,
+		    size_t length, size_t *consumed)
+{
+	struct pldm_bej_frame *frame;
+	uint8_t byte = data[0];
+	uint32_t version;
+	int rc;
+
+	*consumed = 1;
+
+	if (decoder->state == BEJ_STATE_STREAM) {
+		return bej_stream(decoder, data, length, consumed);
+	}
+
+	if (decoder->state == BEJ_STATE_DONE) {
+		return -EPROTO;
+	}
+
+	// Tuples may not run past the container they belong to
+	frame = decoder->depth ? &decoder->stack[decoder->depth - 1] : NULL;
+	if (frame && decoder->offset >= frame->end) {
+		return -EPROTO;
+	}
+	decoder->offset++;
+
+	switch (decoder->state) {
+	case BEJ_STATE_HEADER:
+		decoder->scratch[decoder->scratch_length++] = byte;
+		if (decoder->scratch_length < BEJ_ENCODING_HEADER_SIZE) {
+			return 0;
+		}
+		version = bej_get32(decoder->scratch);
+		if (version != PLDM_BEJ_VERSION_1_0 &&
+		    version != PLDM_BEJ_VERSION_1_1) {
+			return -EPROTO;
+		}
+		bej_nnint_start(decoder, BEJ_STATE_SEQUENCE);
+		return 0;
+	case BEJ_STATE_SEQUENCE:
+		rc = bej_nnint_feed(decoder, byte);
+		if (rc <= 0) {
+			return rc;
+		}
+		if (decoder->nnint > UINT32_MAX) {
+			return -EPROTO;
+		}
+		decoder->sequence = decoder->nnint;
+		decoder->state = BEJ_STATE_FORMAT;
+		return 0;
+	case BEJ_STATE_FORMAT:
+		decoder->format = byte >> 4;
+		rc = bej_resolve(decoder);
+		if (rc) {
+			return rc;
+		}
+		bej_nnint_start(decoder, BEJ_STATE_LENGTH);
+		return 0;
+	case BEJ_STATE_LENGTH:
+		rc = bej_nnint_feed(decoder, byte);
+		if (rc <= 0) {
+			return rc;
+		}
+		return bej_start_value(decoder);
+	case BEJ_STATE_COUNT: {
+		struct pldm_bej_token token;
+
+		if (decoder->value_remaining == 0) {
+			return -EPROTO;
+		}
+		decoder->value_remaining--;
+		rc = bej_nnint_feed(decoder, byte);
+		if (rc <= 0) {
+			return rc;
+		}
+
+		memset(&token, 0, sizeof(token));
+		token.type = decoder->format == PLDM_BEJ_FORMAT_SET
+				     ? PLDM_BEJ_TOKEN_OBJECT_START
+				     : PLDM_BEJ_TOKEN_ARRAY_START;
+		rc = bej_emit(decoder, &token);
+		if (rc) {
+			return rc;
+		}
+
+		rc = bej_push_frame(decoder, decoder->nnint);
+		if (rc) {
+			return rc;
+		}
+		if (decoder->nnint) {
+			bej_nnint_start(decoder, BEJ_STATE_SEQUENCE);
+			return 0;
+		}
+		// An empty container completes right away
+		decoder->stack[decoder->depth - 1].remaining = 1;
+		return bej_value_done(decoder);
+	}
+	case BEJ_STATE_SCALAR:
+		decoder->scratch[decoder->scratch_length++] = byte;
+		if (decoder->scratch_length < decoder->value_remaining) {
+			return 0;
+		}
+		return bej_finish_scalar(decoder);
+	default:
+		return -EPROTO;
+	}
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_decoder_push(struct pldm_bej_decoder *decoder, const void *data,
+			  size_t length)
+{
+	const uint8_t *cursor = data;
+	size_t consumed;
+	int rc;
+
+	if (decoder == NULL || (length && data == NULL)) {
+		return -EINVAL;
+	}
+
+	if (decoder->error) {
+		return decoder->error;
+	}
+
+	while (length) {
+		rc = bej_feed(decoder, cursor, length, &consumed);
+		if (rc) {
+			decoder->error = rc;
+			return rc;
+		}
+		cursor += consumed;
+		length -= consumed;
+	}
+
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_decoder_finish(struct pldm_bej_decoder *decoder)
+{
+	if (decoder == NULL) {
+		return -EINVAL;
+	}
+
+	if (decoder->error) {
+		return decoder->error;
+	}
+
+	return decoder->state == BEJ_STATE_DONE ? 0 : -EPROTO;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_json_writer_init(struct pldm_bej_json_writer *writer,
+			      pldm_bej_write_fn write, void *arg)
+{
+	if (writer == NULL || write == NULL) {
+		return -EINVAL;
+	}
+
+	memset(writer, 0, sizeof(*writer));
+	writer->write = write;
+	writer->arg = arg;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_json_writer_flush(struct pldm_bej_json_writer *writer)
+{
+	int rc;
+
+	if (writer == NULL) {
+		return -EINVAL;
+	}
+
+	if (writer->used == 0) {
+		return 0;
+	}
+
+	rc = writer->write(writer->arg, writer->buffer, writer->used);
+	writer->used = 0;
+	return rc;
+}
+
+static int bej_json_put(struct pldm_bej_json_writer *writer, const char *data,
+			size_t length)
+{
+	size_t room;
+	int rc;
+
+	while (length) {
+		if (writer->used == sizeof(writer->buffer)) {
+			rc = pldm_bej_json_writer_flush(writer);
+			if (rc) {
+				return rc;
+			}
+		}
+		room = sizeof(writer->buffer) - writer->used;
+		if (room > length) {
+			room = length;
+		}
+		memcpy(writer->buffer + writer->used, data, room);
+		writer->used += room;
+		data += room;
+		length -= room;
+	}
+
+	return 0;
+}
+
+static int bej_json_puts(struct pldm_bej_json_writer *writer, const char *str)
+{
+	return bej_json_put(writer, str, strlen(str));
+}
+
+/* Write string content with the escaping JSON requires, without quotes */
+static int bej_json_escape(struct pldm_bej_json_writer *writer,
+			   const uint8_t *data, size_t length)
+{
+	static const char hex[] = "0123456789abcdef";
+	char escape[6] = { '\\', 'u', '0', '0' };
+	size_t run = 0;
+	size_t escaped;
+	size_t i;
+	int rc;
+
+	for (i = 0; i < length; i++) {
+		uint8_t c = data[i];
+
+		if (c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+
+		// Pass the unescaped run before this character through in one go
+		rc = bej_json_put(writer, (const char *)data + run, i - run);
+		if (rc) {
+			return rc;
+		}
+		run = i + 1;
+
+		escaped = 2;
+		switch (c) {
+		case '"':
+		case '\\':
+			escape[1] = c;
+			break;
+		case '\b':
+			escape[1] = 'b';
+			break;
+		case '\f':
+			escape[1] = 'f';
+			break;
+		case '\n':
+			escape[1] = 'n';
+			break;
+		case '\r':
+			escape[1] = 'r';
+			break;
+		case '\t':
+			escape[1] = 't';
+			break;
+		default:
+			escape[1] = 'u';
+			escape[4] = hex[c >> 4];
+			escape[5] = hex[c & 0xf];
+			escaped = sizeof(escape);
+			break;
+		}
+		rc = bej_json_put(writer, escape, escaped);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return bej_json_put(writer, (const char *)data + run, length - run);
+}
+
+static int bej_json_base64(struct pldm_bej_json_writer *writer,
+			   const uint8_t *data, size_t length, bool last)
+{
+	static const char alphabet[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	uint8_t group[3];
+	char out[4];
+	size_t n;
+	int rc;
+
+	// Zero-length fragments come with no data, which memcpy() must not see
+	if (!length && (!last || !writer->carried)) {
+		return 0;
+	}
+
+	while (writer->carried + length >= 3 || (last && writer->carried + length)) {
+		memset(group, 0, sizeof(group));
+		memcpy(group, writer->carry, writer->carried);
+		n = 3 - writer->carried;
+		if (n > length) {
+			n = length;
+		}
+		if (n) {
+			memcpy(group + writer->carried, data, n);
+			data += n;
+			length -= n;
+		}
+		n += writer->carried;
+		writer->carried = 0;
+
+		out[0] = alphabet[group[0] >> 2];
+		out[1] = alphabet[((group[0] & 0x3) << 4) | (group[1] >> 4)];
+		out[2] = n > 1 ? alphabet[((group[1] & 0xf) << 2) |
+					  (group[2] >> 6)]
+			       : '=';
+		out[3] = n > 2 ? alphabet[group[2] & 0x3f] : '=';
+		rc = bej_json_put(writer, out, sizeof(out));
+		if (rc) {
+			return rc;
+		}
+	}
+
+	// Keep a partial group for the next fragment
+	if (!length) {
+		return 0;
+	}
+	memcpy(writer->carry + writer->carried, data, length);
+	writer->carried += length;
+	return 0;
+}
+
+static int bej_json_real(struct pldm_bej_json_writer *writer,
+			 const struct pldm_bej_token *token)
+{
+	char number[24];
+	uint64_t zeros;
+	int rc;
+
+	snprintf(number, sizeof(number), "%" PRId64, token->value.real.whole);
+	rc = bej_json_puts(writer, number);
+	if (rc) {
+		return rc;
+	}
+
+	if (token->value.real.fract || token->value.real.leading_zeros) {
+		rc = bej_json_put(writer, ".", 1);
+		for (zeros = token->value.real.leading_zeros; !rc && zeros;
+		     zeros--) {
+			rc = bej_json_put(writer, "0", 1);
+		}
+		if (rc) {
+			return rc;
+		}
+		if (token->value.real.fract) {
+			snprintf(number, sizeof(number), "%" PRIu64,
+				 token->value.real.fract);
+			rc = bej_json_puts(writer, number);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	if (token->value.real.exponent) {
+		snprintf(number, sizeof(number), "e%" PRId64,
+			 token->value.real.exponent);
+		rc = bej_json_puts(writer, number);
+	}
+
+	return rc;
+}
+
+/* Separator and member name in front of a value */
+static int bej_json_prefix(struct pldm_bej_json_writer *writer,
+			   const struct pldm_bej_token *token)
+{
+	uint64_t bit;
+	int rc;
+
+	if (token->depth == 0 || token->depth > 63) {
+		return token->depth ? -EOVERFLOW : 0;
+	}
+
+	bit = UINT64_C(1) << token->depth;
+	if (writer->populated & bit) {
+		rc = bej_json_put(writer, ",", 1);
+		if (rc) {
+			return rc;
+		}
+	}
+	writer->populated |= bit;
+
+	if (token->name == NULL) {
+		return 0;
+	}
+
+	rc = bej_json_put(writer, "\"", 1);
+	if (!rc) {
+		rc = bej_json_escape(writer, (const uint8_t *)token->name,
+				     strlen(token->name));
+	}
+	if (!rc && token->annotation) {
+		if (token->annotation[0] != '@') {
+			rc = bej_json_put(writer, "@", 1);
+		}
+		if (!rc) {
+			rc = bej_json_escape(
+				writer, (const uint8_t *)token->annotation,
+				strlen(token->annotation));
+		}
+	}
+	if (!rc) {
+		rc = bej_json_put(writer, "\":", 2);
+	}
+
+	return rc;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_json_writer_token(void *arg, const struct pldm_bej_token *token)
+{
+	struct pldm_bej_json_writer *writer = arg;
+	char number[24];
+	int rc = 0;
+
+	if (writer == NULL || token == NULL) {
+		return -EINVAL;
+	}
+
+	switch (token->type) {
+	case PLDM_BEJ_TOKEN_OBJECT_END:
+		return bej_json_put(writer, "}", 1);
+	case PLDM_BEJ_TOKEN_ARRAY_END:
+		return bej_json_put(writer, "]", 1);
+	default:
+		break;
+	}
+
+	if (!token->continued) {
+		rc = bej_json_prefix(writer, token);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	switch (token->type) {
+	case PLDM_BEJ_TOKEN_OBJECT_START:
+	case PLDM_BEJ_TOKEN_ARRAY_START:
+		if (token->depth + 1 <= 63) {
+			writer->populated &=
+				~(UINT64_C(1) << (token->depth + 1));
+		}
+		return bej_json_put(
+			writer,
+			token->type == PLDM_BEJ_TOKEN_OBJECT_START ? "{" : "[",
+			1);
+	case PLDM_BEJ_TOKEN_NULL:
+		return bej_json_puts(writer, "null");
+	case PLDM_BEJ_TOKEN_BOOLEAN:
+		return bej_json_puts(writer,
+				     token->value.boolean ? "true" : "false");
+	case PLDM_BEJ_TOKEN_INTEGER:
+		snprintf(number, sizeof(number), "%" PRId64,
+			 token->value.integer);
+		return bej_json_puts(writer, number);
+	case PLDM_BEJ_TOKEN_REAL:
+		return bej_json_real(writer, token);
+	case PLDM_BEJ_TOKEN_ENUM:
+		rc = bej_json_put(writer, "\"", 1);
+		if (!rc) {
+			rc = bej_json_escape(
+				writer,
+				(const uint8_t *)token->value.enumeration,
+				strlen(token->value.enumeration));
+		}
+		return rc ? rc : bej_json_put(writer, "\"", 1);
+	case PLDM_BEJ_TOKEN_RESOURCE_LINK:
+		snprintf(number, sizeof(number), "\"%" PRIu32 "\"",
+			 token->value.resource_id);
+		return bej_json_puts(writer, number);
+	case PLDM_BEJ_TOKEN_STRING:
+	case PLDM_BEJ_TOKEN_BYTE_STRING:
+		if (!token->continued) {
+			writer->carried = 0;
+			rc = bej_json_put(writer, "\"", 1);
+		}
+		if (!rc) {
+			rc = token->type == PLDM_BEJ_TOKEN_STRING
+				     ? bej_json_escape(writer,
+						       token->value.bytes.data,
+						       token->value.bytes.length)
+				     : bej_json_base64(writer,
+						       token->value.bytes.data,
+						       token->value.bytes.length,
+						       !token->more);
+		}
+		if (!rc && !token->more) {
+			rc = bej_json_put(writer, "\"", 1);
+		}
+		return rc;
+	default:
+		return -EINVAL;
+	}
+}
+
+/* Largest nnint: a length byte and eight value bytes */
+#define BEJ_NNINT_MAX_SIZE 9
+
+static size_t bej_uint_length(uint64_t value)
+{
+	size_t length = 1;
+
+	while (length < sizeof(value) && value >> (8 * length)) {
+		length++;
+	}
+
+	return length;
+}
+
+/* Bytes of the shortest two's complement form of @p value */
+static size_t bej_int_length(int64_t value)
+{
+	size_t length = 1;
+
+	while (length < sizeof(value) &&
+	       (value < -(INT64_C(1) << (8 * length - 1)) ||
+		value >= (INT64_C(1) << (8 * length - 1)))) {
+		length++;
+	}
+
+	return length;
+}
+
+static void bej_put_le(uint8_t *out, uint64_t value, size_t length)
+{
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		out[i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+static size_t bej_put_nnint(uint8_t *out, uint64_t value)
+{
+	size_t length = bej_uint_length(value);
+
+	out[0] = (uint8_t)length;
+	bej_put_le(out + 1, value, length);
+	return length + 1;
+}
+
+static int bej_encoder_fail(struct pldm_bej_encoder *encoder, int rc)
+{
+	if (!encoder->error) {
+		encoder->error = rc;
+	}
+	return encoder->error;
+}
+
+static uint8_t *bej_encoder_reserve(struct pldm_bej_encoder *encoder,
+				    size_t length)
+{
+	uint8_t *out;
+
+	if (encoder->size - encoder->used < length) {
+		bej_encoder_fail(encoder, -ENOBUFS);
+		return NULL;
+	}
+
+	out = encoder->buffer + encoder->used;
+	encoder->used += length;
+	return out;
+}
+
+static int bej_encoder_put(struct pldm_bej_encoder *encoder, const void *data,
+			   size_t length)
+{
+	uint8_t *out = bej_encoder_reserve(encoder, length);
+
+	if (out == NULL) {
+		return encoder->error;
+	}
+	if (length) {
+		memcpy(out, data, length);
+	}
+	return 0;
+}
+
+static int bej_encoder_nnint(struct pldm_bej_encoder *encoder, uint64_t value)
+{
+	uint8_t out[BEJ_NNINT_MAX_SIZE];
+
+	return bej_encoder_put(encoder, out, bej_put_nnint(out, value));
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_init(struct pldm_bej_encoder *encoder,
+			  const struct pldm_bej_dictionary_index *schema,
+			  const struct pldm_bej_dictionary_index *annotation,
+			  void *buffer, size_t size)
+{
+	uint8_t header[BEJ_ENCODING_HEADER_SIZE] = { 0 };
+
+	if (encoder == NULL || schema == NULL || (buffer == NULL && size)) {
+		return -EINVAL;
+	}
+
+	memset(encoder, 0, sizeof(*encoder));
+	encoder->schema = schema;
+	encoder->annotation = annotation;
+	encoder->buffer = buffer;
+	encoder->size = size;
+
+	// Version, flags and a major schema class
+	bej_put_le(header, PLDM_BEJ_VERSION_1_0, 4);
+	return bej_encoder_put(encoder, header, sizeof(header));
+}
+
+static int bej_encoder_close(struct pldm_bej_encoder *encoder);
+
+/* Close the property annotation wrappers completed by the last value */
+static int bej_encoder_value_done(struct pldm_bej_encoder *encoder)
+{
+	struct pldm_bej_encoder_frame *frame;
+	int rc;
+
+	if (encoder->depth == 0) {
+		encoder->complete = true;
+		return 0;
+	}
+
+	frame = &encoder->stack[encoder->depth - 1];
+	if (frame->format == PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION &&
+	    frame->count) {
+		rc = bej_encoder_close(encoder);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+static int bej_encoder_open(struct pldm_bej_encoder *encoder,
+			    const struct pldm_bej_dictionary_index *index,
+			    uint16_t entry, uint8_t format)
+{
+	struct pldm_bej_encoder_frame *frame;
+	size_t start = encoder->used;
+
+	if (encoder->depth == PLDM_BEJ_MAX_DEPTH) {
+		return bej_encoder_fail(encoder, -EOVERFLOW);
+	}
+
+	// Lengths are only known once the container closes: reserve room for
+	// the largest nnints and compact in bej_encoder_close()
+	if (bej_encoder_reserve(encoder,
+				format == PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION
+					? BEJ_NNINT_MAX_SIZE
+					: 2 * BEJ_NNINT_MAX_SIZE) == NULL) {
+		return encoder->error;
+	}
+
+	frame = &encoder->stack[encoder->depth++];
+	frame->index = index;
+	frame->entry = entry;
+	frame->format = format;
+	frame->start = start;
+	frame->count = 0;
+	return 0;
+}
+
+static int bej_encoder_close(struct pldm_bej_encoder *encoder)
+{
+	struct pldm_bej_encoder_frame *frame =
+		&encoder->stack[--encoder->depth];
+	uint8_t count[BEJ_NNINT_MAX_SIZE];
+	size_t count_length = 0;
+	size_t reserved;
+	size_t length;
+	size_t prefix;
+	uint8_t *out;
+
+	if (frame->format == PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION) {
+		reserved = BEJ_NNINT_MAX_SIZE;
+	} else {
+		reserved = 2 * BEJ_NNINT_MAX_SIZE;
+		count_length = bej_put_nnint(count, frame->count);
+	}
+
+	// The final nnints are never longer than the space reserved for them,
+	// so the body only moves towards the start of the buffer
+	out = encoder->buffer + frame->start;
+	length = encoder->used - frame->start - reserved;
+	prefix = bej_put_nnint(out, count_length + length);
+	memcpy(out + prefix, count, count_length);
+	memmove(out + prefix + count_length, out + reserved, length);
+	encoder->used = frame->start + prefix + count_length + length;
+
+	return bej_encoder_value_done(encoder);
+}
+
+/* Resolve an annotation among the top level of the annotation dictionary */
+static int bej_encoder_annotation(struct pldm_bej_encoder *encoder,
+				  const char *name)
+{
+	if (encoder->annotation == NULL) {
+		return -1;
+	}
+	return bej_index_find_name(encoder->annotation, 0, name, strlen(name));
+}
+
+/*
+ * Resolve @p name against the innermost container and write the sequence
+ * number and format of a new tuple. On success *index and *entry describe the
+ * dictionary entry of the value.
+ */
+static int bej_encoder_tuple(struct pldm_bej_encoder *encoder,
+			     const char *name, uint8_t format,
+			     const struct pldm_bej_dictionary_index **index,
+			     uint16_t *entry)
+{
+	const struct pldm_bej_dictionary_index *found = encoder->schema;
+	struct pldm_bej_encoder_frame *frame;
+	const char *at;
+	uint64_t sequence;
+	int property;
+	int child;
+	uint8_t *out;
+	int rc;
+
+	if (encoder->error) {
+		return encoder->error;
+	}
+
+	if (encoder->depth == 0) {
+		if (encoder->complete || format != PLDM_BEJ_FORMAT_SET) {
+			return bej_encoder_fail(encoder, -EINVAL);
+		}
+		child = 0;
+		sequence = 0;
+		goto write;
+	}
+
+	frame = &encoder->stack[encoder->depth - 1];
+	frame->count++;
+	found = frame->index;
+
+	if (frame->format == PLDM_BEJ_FORMAT_ARRAY) {
+		// Members share the array's only child entry and are numbered
+		// by position
+		if (bej_index_u16(found, found->child_count)[frame->entry] ==
+		    0) {
+			return bej_encoder_fail(encoder, -ENOENT);
+		}
+		child = bej_index_u16(found, found->children)[frame->entry];
+		sequence = ((frame->count - 1) << 1) |
+			   (found == encoder->annotation);
+		goto write;
+	}
+
+	if (name == NULL) {
+		return bej_encoder_fail(encoder, -EINVAL);
+	}
+
+	at = strchr(name, '@');
+	if (found == encoder->annotation || at == NULL) {
+		// Members of the same dictionary
+		child = bej_index_find_name(found, frame->entry, name,
+					    strlen(name));
+	} else if (at == name) {
+		// An annotation of the object
+		found = encoder->annotation;
+		child = bej_encoder_annotation(encoder, name);
+	} else {
+		// An annotation of a property: wrap it in a tuple of the
+		// property's sequence number
+		property = bej_index_find_name(found, frame->entry, name,
+					       at - name);
+		child = bej_encoder_annotation(encoder, at);
+		if (property < 0 || child < 0) {
+			return bej_encoder_fail(encoder, -ENOENT);
+		}
+		rc = bej_encoder_nnint(
+			encoder,
+			(uint64_t)bej_index_u16(found,
+						found->sequence)[property]
+				<< 1);
+		if (!rc) {
+			out = bej_encoder_reserve(encoder, 1);
+			if (out == NULL) {
+				return encoder->error;
+			}
+			*out = PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION << 4;
+			rc = bej_encoder_open(
+				encoder, found, property,
+				PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION);
+		}
+		if (rc) {
+			return rc;
+		}
+		encoder->stack[encoder->depth - 1].count++;
+		found = encoder->annotation;
+	}
+
+	if (child < 0) {
+		return bej_encoder_fail(encoder, -ENOENT);
+	}
+	sequence = ((uint64_t)bej_index_u16(found, found->sequence)[child]
+		    << 1) |
+		   (found == encoder->annotation);
+
+write:
+	// Any property may be null
+	if (format != PLDM_BEJ_FORMAT_NULL &&
+	    ((const uint8_t *)found + found->format)[child] >> 4 != format) {
+		return bej_encoder_fail(encoder, -EINVAL);
+	}
+
+	*index = found;
+	*entry = child;
+	rc = bej_encoder_nnint(encoder, sequence);
+	if (rc) {
+		return rc;
+	}
+	out = bej_encoder_reserve(encoder, 1);
+	if (out == NULL) {
+		return encoder->error;
+	}
+	*out = format << 4;
+	return 0;
+}
+
+static int bej_encoder_container(struct pldm_bej_encoder *encoder,
+				 const char *name, uint8_t format)
+{
+	const struct pldm_bej_dictionary_index *index;
+	uint16_t entry;
+	int rc;
+
+	rc = bej_encoder_tuple(encoder, name, format, &index, &entry);
+	if (rc) {
+		return rc;
+	}
+
+	return bej_encoder_open(encoder, index, entry, format);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_begin_object(struct pldm_bej_encoder *encoder,
+				  const char *name)
+{
+	if (encoder == NULL) {
+		return -EINVAL;
+	}
+	return bej_encoder_container(encoder, name, PLDM_BEJ_FORMAT_SET);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_begin_array(struct pldm_bej_encoder *encoder,
+				 const char *name)
+{
+	if (encoder == NULL) {
+		return -EINVAL;
+	}
+	return bej_encoder_container(encoder, name, PLDM_BEJ_FORMAT_ARRAY);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_end(struct pldm_bej_encoder *encoder)
+{
+	if (encoder == NULL) {
+		return -EINVAL;
+	}
+	if (encoder->error) {
+		return encoder->error;
+	}
+	if (encoder->depth == 0) {
+		return bej_encoder_fail(encoder, -EINVAL);
+	}
+	return bej_encoder_close(encoder);
+}
+
+/* Start a scalar tuple and return the @p length bytes of its value */
+static uint8_t *bej_encoder_scalar(struct pldm_bej_encoder *encoder,
+				   const char *name, uint8_t format,
+				   size_t length)
+{
+	const struct pldm_bej_dictionary_index *index;
+	uint16_t entry;
+
+	if (bej_encoder_tuple(encoder, name, format, &index, &entry) ||
+	    bej_encoder_nnint(encoder, length)) {
+		return NULL;
+	}
+	return bej_encoder_reserve(encoder, length);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_null(struct pldm_bej_encoder *encoder, const char *name)
+{
+	if (encoder == NULL) {
+		return -EINVAL;
+	}
+	if (bej_encoder_scalar(encoder, name, PLDM_BEJ_FORMAT_NULL, 0) == NULL) {
+		return encoder->error;
+	}
+	return bej_encoder_value_done(encoder);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_integer(struct pldm_bej_encoder *encoder,
+			     const char *name, int64_t value)
+{
+	size_t length;
+	uint8_t *out;
+
+	if (encoder == NULL) {
+		return -EINVAL;
+	}
+
+	length = bej_int_length(value);
+	out = bej_encoder_scalar(encoder, name, PLDM_BEJ_FORMAT_INTEGER, length);
+	if (out == NULL) {
+		return encoder->error;
+	}
+	bej_put_le(out, (uint64_t)value, length);
+	return bej_encoder_value_done(encoder);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_real(struct pldm_bej_encoder *encoder, const char *name,
+			  int64_t whole, uint64_t leading_zeros,
+			  uint64_t fract, int64_t exponent)
+{
+	size_t whole_length = bej_int_length(whole);
+	size_t exponent_length = bej_int_length(exponent);
+	size_t length;
+	uint8_t *out;
+
+	if (encoder == NULL) {
+		return -EINVAL;
+	}
+
+	// nnint(length) whole nnint(leading zeros) nnint(fract)
+	// nnint(length) exponent
+	length = 1 + bej_uint_length(whole_length) + whole_length + 1 +
+		 bej_uint_length(leading_zeros) + 1 + bej_uint_length(fract) +
+		 1 + bej_uint_length(exponent_length) + exponent_length;
+	out = bej_encoder_scalar(encoder, name, PLDM_BEJ_FORMAT_REAL, length);
+	if (out == NULL) {
+		return encoder->error;
+	}
+
+	out += bej_put_nnint(out, whole_length);
+	bej_put_le(out, (uint64_t)whole, whole_length);
+	out += whole_length;
+	out += bej_put_nnint(out, leading_zeros);
+	out += bej_put_nnint(out, fract);
+	out += bej_put_nnint(out, exponent_length);
+	bej_put_le(out, (uint64_t)exponent, exponent_length);
+	return bej_encoder_value_done(encoder);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_boolean(struct pldm_bej_encoder *encoder,
+			     const char *name, bool value)
+{
+	uint8_t *out;
+
+	if (encoder == NULL) {
+		return -EINVAL;
+	}
+
+	out = bej_encoder_scalar(encoder, name, PLDM_BEJ_FORMAT_BOOLEAN, 1);
+	if (out == NULL) {
+		return encoder->error;
+	}
+	*out = value;
+	return bej_encoder_value_done(encoder);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_string(struct pldm_bej_encoder *encoder,
+			    const char *name, const char *value)
+{
+	size_t length;
+	uint8_t *out;
+
+	if (encoder == NULL || value == NULL) {
+		return -EINVAL;
+	}
+
+	length = strlen(value) + 1;
+	out = bej_encoder_scalar(encoder, name, PLDM_BEJ_FORMAT_STRING, length);
+	if (out == NULL) {
+		return encoder->error;
+	}
+	memcpy(out, value, length);
+	return bej_encoder_value_done(encoder);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_enum(struct pldm_bej_encoder *encoder, const char *name,
+			  const char *option)
+{
+	const struct pldm_bej_dictionary_index *index;
+	uint16_t sequence;
+	uint16_t entry;
+	int found;
+	int rc;
+
+	if (encoder == NULL || option == NULL) {
+		return -EINVAL;
+	}
+
+	rc = bej_encoder_tuple(encoder, name, PLDM_BEJ_FORMAT_ENUM, &index,
+			       &entry);
+	if (rc) {
+		return rc;
+	}
+
+	found = bej_index_find_name(index, entry, option, strlen(option));
+	if (found < 0) {
+		return bej_encoder_fail(encoder, -ENOENT);
+	}
+
+	sequence = bej_index_u16(index, index->sequence)[found];
+	rc = bej_encoder_nnint(encoder, 1 + bej_uint_length(sequence));
+	if (!rc) {
+		rc = bej_encoder_nnint(encoder, sequence);
+	}
+	return rc ? rc : bej_encoder_value_done(encoder);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_byte_string(struct pldm_bej_encoder *encoder,
+				 const char *name, const void *data,
+				 size_t length)
+{
+	uint8_t *out;
+
+	if (encoder == NULL || (data == NULL && length)) {
+		return -EINVAL;
+	}
+
+	out = bej_encoder_scalar(encoder, name, PLDM_BEJ_FORMAT_BYTE_STRING,
+				 length);
+	if (out == NULL) {
+		return encoder->error;
+	}
+	if (length) {
+		memcpy(out, data, length);
+	}
+	return bej_encoder_value_done(encoder);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_resource_link(struct pldm_bej_encoder *encoder,
+				   const char *name, uint32_t resource_id)
+{
+	size_t length = 1 + bej_uint_length(resource_id);
+	uint8_t *out;
+
+	if (encoder == NULL) {
+		return -EINVAL;
+	}
+
+	out = bej_encoder_scalar(encoder, name, PLDM_BEJ_FORMAT_RESOURCE_LINK,
+				 length);
+	if (out == NULL) {
+		return encoder->error;
+	}
+	bej_put_nnint(out, resource_id);
+	return bej_encoder_value_done(encoder);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_encoder_finish(struct pldm_bej_encoder *encoder, size_t *length)
+{
+	if (encoder == NULL || length == NULL) {
+		return -EINVAL;
+	}
+	if (encoder->error) {
+		return encoder->error;
+	}
+	if (encoder->depth || !encoder->complete) {
+		return bej_encoder_fail(encoder, -EINVAL);
+	}
+
+	*length = encoder->used;
+	return 0;
+}
+
+/*
+ * Copies a payload while expanding its resource links. With out set to NULL
+ * nothing is written and used only counts the bytes, which is how container
+ * lengths are found before their members are written.
+ */
+struct bej_expand {
+	pldm_bej_link_fn resolve;
+	void *arg;
+	uint8_t *out;
+	size_t used;
+};
+
+static void bej_expand_put(struct bej_expand *expand, const void *data,
+			   size_t length)
+{
+	if (expand->out && length) {
+		memcpy(expand->out + expand->used, data, length);
+	}
+	expand->used += length;
+}
+
+static void bej_expand_nnint(struct bej_expand *expand, uint64_t value)
+{
+	uint8_t out[BEJ_NNINT_MAX_SIZE];
+
+	bej_expand_put(expand, out, bej_put_nnint(out, value));
+}
+
+static int bej_expand_tuple(struct bej_expand *expand, const uint8_t **cursor,
+			    const uint8_t *end, unsigned int depth);
+
+/* The value of a set, an array or a property annotation */
+static int bej_expand_members(struct bej_expand *expand, uint8_t format,
+			      const uint8_t *value, const uint8_t *end,
+			      unsigned int depth)
+{
+	const uint8_t *cursor = value;
+	uint64_t count = 1;
+	int rc;
+
+	if (format != PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION) {
+		rc = bej_read_nnint(&cursor, end, &count);
+		if (rc) {
+			return rc;
+		}
+		bej_expand_put(expand, value, cursor - value);
+	}
+
+	while (count--) {
+		rc = bej_expand_tuple(expand, &cursor, end, depth + 1);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return cursor == end ? 0 : -EPROTO;
+}
+
+static int bej_expand_tuple(struct bej_expand *expand, const uint8_t **cursor,
+			    const uint8_t *end, unsigned int depth)
+{
+	const uint8_t *start = *cursor;
+	const uint8_t *format_at;
+	const uint8_t *value;
+	uint64_t sequence;
+	uint64_t length;
+	uint8_t format;
+	int rc;
+
+	rc = bej_read_nnint(cursor, end, &sequence);
+	if (rc) {
+		return rc;
+	}
+	if (*cursor >= end) {
+		return -EPROTO;
+	}
+	format_at = (*cursor)++;
+	format = *format_at >> 4;
+	rc = bej_read_nnint(cursor, end, &length);
+	if (rc) {
+		return rc;
+	}
+	if (length > (uint64_t)(end - *cursor)) {
+		return -EPROTO;
+	}
+	value = *cursor;
+	*cursor += length;
+
+	switch (format) {
+	case PLDM_BEJ_FORMAT_SET:
+	case PLDM_BEJ_FORMAT_ARRAY:
+	case PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION: {
+		struct bej_expand measure = { expand->resolve, expand->arg,
+					      NULL, 0 };
+
+		if (depth >= PLDM_BEJ_MAX_DEPTH) {
+			return -EOVERFLOW;
+		}
+		rc = bej_expand_members(&measure, format, value, *cursor,
+					depth);
+		if (rc) {
+			return rc;
+		}
+		bej_expand_put(expand, start, format_at + 1 - start);
+		bej_expand_nnint(expand, measure.used);
+		if (!expand->out) {
+			expand->used += measure.used;
+			return 0;
+		}
+		return bej_expand_members(expand, format, value, *cursor,
+					  depth);
+	}
+	case PLDM_BEJ_FORMAT_RESOURCE_LINK: {
+		const uint8_t *link = value;
+		const uint8_t *encoding;
+		uint64_t resource_id;
+		size_t encoding_length;
+
+		rc = bej_read_nnint(&link, *cursor, &resource_id);
+		if (rc) {
+			return rc;
+		}
+		if (resource_id > UINT32_MAX ||
+		    !expand->resolve(expand->arg, (uint32_t)resource_id,
+				     &encoding, &encoding_length)) {
+			break;
+		}
+		// The flags in the low nibble carry over
+		bej_expand_put(expand, start, format_at - start);
+		format = PLDM_BEJ_FORMAT_RESOURCE_LINK_EXPANSION << 4 |
+			 (*format_at & 0xf);
+		bej_expand_put(expand, &format, 1);
+		bej_expand_nnint(expand, encoding_length);
+		bej_expand_put(expand, encoding, encoding_length);
+		return 0;
+	}
+	default:
+		break;
+	}
+
+	bej_expand_put(expand, start, *cursor - start);
+	return 0;
+}
+
+static int bej_expand_encoding(struct bej_expand *expand,
+			       const uint8_t *payload, size_t length)
+{
+	const uint8_t *cursor = payload + BEJ_ENCODING_HEADER_SIZE;
+	const uint8_t *end = payload + length;
+	int rc;
+
+	bej_expand_put(expand, payload, BEJ_ENCODING_HEADER_SIZE);
+	rc = bej_expand_tuple(expand, &cursor, end, 0);
+	if (rc) {
+		return rc;
+	}
+	return cursor == end ? 0 : -EPROTO;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_bej_expand_links(const void *payload, size_t length,
+			  pldm_bej_link_fn resolve, void *arg, void *buffer,
+			  size_t size, size_t *used)
+{
+	struct bej_expand expand = { resolve, arg, NULL, 0 };
+	uint32_t version;
+	int rc;
+
+	if (payload == NULL || resolve == NULL || used == NULL ||
+	    (buffer == NULL && size)) {
+		return -EINVAL;
+	}
+	if (length < BEJ_ENCODING_HEADER_SIZE) {
+		return -EPROTO;
+	}
+	version = bej_get32(payload);
+	if (version != PLDM_BEJ_VERSION_1_0 &&
+	    version != PLDM_BEJ_VERSION_1_1) {
+		return -EPROTO;
+	}
+
+	rc = bej_expand_encoding(&expand, payload, length);
+	if (rc) {
+		return rc;
+	}
+	*used = expand.used;
+	if (expand.used > size) {
+		return -ENOBUFS;
+	}
+
+	expand.out = buffer;
+	expand.used = 0;
+	return bej_expand_encoding(&expand, payload, length);
+}
@@ -354,6 +354,40 @@ int decode_pldm_package_header_info(
 	return PLDM_SUCCESS;
 }
 
+LIBPLDM_ABI_TESTING
+int verify_pldm_package_header_checksum(const uint8_t *data, size_t length)
+{
+	const struct pldm_package_header_information *data_header;
+	uint16_t header_size;
+	uint32_t checksum;
+
+	if (data == NULL) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+
+	if (length < sizeof(struct pldm_package_header_information)) {
+		return PLDM_ERROR_INVALID_LENGTH;
+	}
+
+	data_header = (const struct pldm_package_header_information *)data;
+	header_size = le16toh(data_header->package_header_size);
+	if (header_size < sizeof(struct pldm_package_header_information) +
+				  sizeof(checksum)) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	if (length < header_size) {
+		return PLDM_ERROR_INVALID_LENGTH;
+	}
+
+	memcpy(&checksum, data + header_size - sizeof(checksum),
+	       sizeof(checksum));
+	if (crc32(data, header_size - sizeof(checksum)) != le32toh(checksum)) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+
+	return PLDM_SUCCESS;
+}
+
 LIBPLDM_ABI_STABLE
 int decode_firmware_device_id_record(
 	const uint8_t *data, size_t length,
@@ -1,7 +1,8 @@
 #include "libpldm/pldm_rde.h"
 #include "libpldm/base.h"
+#include "trace.h"
 #include <endian.h>
-#include <stdio.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -91,7 +92,8 @@ int decode_negotiate_redfish_parameters_req(const struct pldm_msg *msg,
 	struct pldm_rde_negotiate_redfish_parameters_req *request =
 	    (struct pldm_rde_negotiate_redfish_parameters_req *)msg->payload;
 	if (request->mc_concurrency_support == 0) {
-		fprintf(stderr, "Concurrency support is 0\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Concurrency support is 0\n");
 		return PLDM_ERROR_INVALID_DATA;
 	}
 	*mc_concurrency_support = request->mc_concurrency_support;
@@ -139,9 +141,9 @@ int decode_negotiate_redfish_parameters_resp(
 	*completion_code = msg->payload[0];
 
 	if (PLDM_SUCCESS != *completion_code) {
-		fprintf(stderr,
-			"Unsuccessful completion code received in neg. params: %x\n",
-			(uint8_t)(*completion_code));
+		pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+			   "Unsuccessful completion code received in neg. params: %x\n",
+			   (uint8_t)(*completion_code));
 		return PLDM_SUCCESS;
 	}
 
@@ -175,9 +177,9 @@ int decode_negotiate_medium_parameters_resp(
 	*completion_code = msg->payload[0];
 
 	if (PLDM_SUCCESS != *completion_code) {
-        fprintf(stderr,
-            "Unsuccessful completion code received in neg med params: %x\n",
-            (uint8_t)(*completion_code));
+        pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+                   "Unsuccessful completion code received in neg med params: %x\n",
+                   (uint8_t)(*completion_code));
 		return PLDM_SUCCESS;
 	}
 
@@ -332,14 +334,16 @@ int decode_get_schema_dictionary_resp(const struct pldm_msg *msg,
 	*completion_code = msg->payload[0];
 
 	if (PLDM_SUCCESS != *completion_code) {
-        fprintf(stderr, "Unsuccessful completion code received in schema: %x\n",
-            (uint8_t)(*completion_code));
+        pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+                   "Unsuccessful completion code received in schema: %x\n",
+                   (uint8_t)(*completion_code));
 		return PLDM_SUCCESS;
 	}
 
 	if (payload_length < RDE_GET_DICTIONARY_SCHEMA_RESP_BYTES) {
-        fprintf(stderr, "Unsuccessful completion code received %x",
-            (uint8_t)(*completion_code));
+        pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+                   "Unsuccessful completion code received %x",
+                   (uint8_t)(*completion_code));
 		return PLDM_ERROR_INVALID_LENGTH;
 	}
 
@@ -396,7 +400,8 @@ int decode_rde_multipart_receive_req(const struct pldm_msg *msg,
 	*data_transfer_handle = le32toh(request->data_transfer_handle);
 	*operation_id = le16toh(request->operation_id);
 	*transfer_operation = request->transfer_operation;
-	if (*transfer_operation > PLDM_RDE_XFER_ABORT) {
+	if (*transfer_operation > PLDM_RDE_XFER_ABORT &&
+	    *transfer_operation != PLDM_RDE_XFER_CURRENT_PART) {
 		return PLDM_ERROR_INVALID_DATA;
 	}
 	return PLDM_SUCCESS;
@@ -457,17 +462,18 @@ int decode_rde_multipart_receive_resp(
 	*completion_code = msg->payload[0];
 
 	if (PLDM_SUCCESS != *completion_code) {
-		fprintf(stderr,
-            "Unsuccessful completion code received in multipart: %x\n",
-            (uint8_t)(*completion_code));
+		pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+			   "Unsuccessful completion code received in multipart: %x\n",
+			   (uint8_t)(*completion_code));
 		return PLDM_ERROR;
 	}
 
 	if (payload_length < RDE_MULTIPART_RECV_MINIMUM_RESP_BYTES) {
-		fprintf(stderr,
-			"Decoded successfully with failed payload length in multipart"
-			" with payload length: %zu and expected: %d\n",
-			payload_length, RDE_MULTIPART_RECV_MINIMUM_RESP_BYTES);
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Decoded successfully with failed payload length in multipart"
+			   " with payload length: %zu and expected: %d\n",
+			   payload_length,
+			   RDE_MULTIPART_RECV_MINIMUM_RESP_BYTES);
 		return PLDM_ERROR_INVALID_LENGTH;
 	}
 
@@ -481,6 +487,146 @@ int decode_rde_multipart_receive_resp(
 	return PLDM_SUCCESS;
 }
 
+LIBPLDM_ABI_TESTING
+int encode_rde_multipart_send_req(uint8_t instance_id,
+				  uint32_t data_transfer_handle,
+				  uint16_t operation_id, uint8_t transfer_flag,
+				  uint32_t next_data_transfer_handle,
+				  uint32_t data_length_bytes, bool add_checksum,
+				  uint32_t checksum, const uint8_t *payload,
+				  struct pldm_msg *msg)
+{
+	if (msg == NULL) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	if ((data_length_bytes > 0) && (payload == NULL)) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	if (transfer_flag > PLDM_RDE_START_AND_END) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	if (add_checksum && (transfer_flag != PLDM_RDE_END) &&
+	    (transfer_flag != PLDM_RDE_START_AND_END)) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	if (add_checksum && (data_length_bytes > UINT32_MAX - sizeof(checksum))) {
+		return PLDM_ERROR_INVALID_LENGTH;
+	}
+	struct pldm_header_info header = {0};
+	header.instance = instance_id;
+	header.pldm_type = PLDM_RDE;
+	header.msg_type = PLDM_REQUEST;
+	header.command = PLDM_RDE_MULTIPART_SEND;
+	uint8_t rc = pack_pldm_header(&header, &(msg->hdr));
+	if (rc != PLDM_SUCCESS) {
+		return rc;
+	}
+	struct pldm_rde_multipart_send_req *req =
+	    (struct pldm_rde_multipart_send_req *)msg->payload;
+	req->data_transfer_handle = htole32(data_transfer_handle);
+	req->operation_id = htole16(operation_id);
+	req->transfer_flag = transfer_flag;
+	req->next_data_transfer_handle = htole32(next_data_transfer_handle);
+	if (data_length_bytes > 0) {
+		memcpy(req->payload, payload, data_length_bytes);
+	}
+	uint32_t tot_length = data_length_bytes;
+	if (add_checksum) {
+		tot_length += sizeof(checksum);
+		checksum = htole32(checksum);
+		memcpy(req->payload + data_length_bytes, &checksum,
+		       sizeof(checksum));
+	}
+	req->data_length_bytes = htole32(tot_length);
+	return PLDM_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+int decode_rde_multipart_send_req(
+    const struct pldm_msg *msg, size_t payload_length,
+    uint32_t *data_transfer_handle, uint16_t *operation_id,
+    uint8_t *transfer_flag, uint32_t *next_data_transfer_handle,
+    uint32_t *data_length_bytes, const uint8_t **payload)
+{
+	if ((msg == NULL) || (data_transfer_handle == NULL) ||
+	    (operation_id == NULL) || (transfer_flag == NULL) ||
+	    (next_data_transfer_handle == NULL) ||
+	    (data_length_bytes == NULL) || (payload == NULL)) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	if (payload_length < PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE) {
+		return PLDM_ERROR_INVALID_LENGTH;
+	}
+	const struct pldm_rde_multipart_send_req *request =
+	    (const struct pldm_rde_multipart_send_req *)msg->payload;
+	*data_transfer_handle = le32toh(request->data_transfer_handle);
+	*operation_id = le16toh(request->operation_id);
+	*transfer_flag = request->transfer_flag;
+	*next_data_transfer_handle =
+	    le32toh(request->next_data_transfer_handle);
+	*data_length_bytes = le32toh(request->data_length_bytes);
+	if (*transfer_flag > PLDM_RDE_START_AND_END) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	if (*data_length_bytes >
+	    payload_length - PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE) {
+		return PLDM_ERROR_INVALID_LENGTH;
+	}
+	*payload = request->payload;
+	return PLDM_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+int encode_rde_multipart_send_resp(uint8_t instance_id,
+				   uint8_t completion_code,
+				   uint8_t transfer_operation,
+				   struct pldm_msg *msg)
+{
+	if (msg == NULL) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	struct pldm_header_info header = {0};
+	header.msg_type = PLDM_RESPONSE;
+	header.instance = instance_id;
+	header.pldm_type = PLDM_RDE;
+	header.command = PLDM_RDE_MULTIPART_SEND;
+	uint8_t rc = pack_pldm_header(&header, &(msg->hdr));
+	if (rc != PLDM_SUCCESS) {
+		return rc;
+	}
+	struct pldm_rde_multipart_send_resp *response =
+	    (struct pldm_rde_multipart_send_resp *)msg->payload;
+	response->completion_code = completion_code;
+	if (response->completion_code != PLDM_SUCCESS) {
+		return PLDM_SUCCESS;
+	}
+	response->transfer_operation = transfer_operation;
+	return PLDM_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+int decode_rde_multipart_send_resp(const struct pldm_msg *msg,
+				   size_t payload_length,
+				   uint8_t *completion_code,
+				   uint8_t *transfer_operation)
+{
+	if ((msg == NULL) || (completion_code == NULL) ||
+	    (transfer_operation == NULL)) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	*completion_code = msg->payload[0];
+	if (PLDM_SUCCESS != *completion_code) {
+		return PLDM_SUCCESS;
+	}
+	if (payload_length < RDE_MULTIPART_SEND_RESP_BYTES) {
+		return PLDM_ERROR_INVALID_LENGTH;
+	}
+	const struct pldm_rde_multipart_send_resp *response =
+	    (const struct pldm_rde_multipart_send_resp *)msg->payload;
+	*transfer_operation = response->transfer_operation;
+	return PLDM_SUCCESS;
+}
+
 LIBPLDM_ABI_STABLE
 int encode_rde_operation_init_req(
     uint8_t instance_id, uint32_t resource_id, uint16_t operation_id,
@@ -660,16 +806,17 @@ int decode_rde_operation_init_resp(
 	}
 	*completion_code = msg->payload[0];
 	if (PLDM_SUCCESS != *completion_code) {
-		fprintf(stderr, "Unsuccessful completion code received in op init: %x\n",
-            (uint8_t)(*completion_code));
+		pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+			   "Unsuccessful completion code received in op init: %x\n",
+			   (uint8_t)(*completion_code));
 		return PLDM_ERROR;
 	}
 
 	if (payload_length < RDE_READ_OPERATION_INIT_MIN_BYTES) {
-		fprintf(stderr,
-			"Decoded successfully with failed payload length with payload "
-			"length: %zu and expected: %d\n",
-			payload_length, RDE_READ_OPERATION_INIT_MIN_BYTES);
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Decoded successfully with failed payload length with payload "
+			   "length: %zu and expected: %d\n", payload_length,
+			   RDE_READ_OPERATION_INIT_MIN_BYTES);
 		return PLDM_ERROR_INVALID_LENGTH;
 	}
 
@@ -883,19 +1030,19 @@ int decode_supply_custom_request_parameters_resp(
     struct pldm_rde_varstring **resp_etag, uint8_t **response_payload)
 {
     if (msg == NULL) {
-        fprintf(stderr, "Invalid msg object\n");
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE, "Invalid msg object\n");
         return PLDM_ERROR_INVALID_DATA;
     }
     *completion_code = msg->payload[0];
     if (PLDM_SUCCESS != *completion_code) {
-        fprintf(stderr,
-            "Unsuccessful completion code received in op status: %x\n",
-            (uint8_t)(*completion_code));
+        pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+                   "Unsuccessful completion code received in op status: %x\n",
+                   (uint8_t)(*completion_code));
         return PLDM_SUCCESS;
     }
     if (payload_length < RDE_READ_OPERATION_INIT_MIN_BYTES) {
-        fprintf(stderr,
-            "Decoded sucessfully with failed payload length\n");
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+                   "Decoded sucessfully with failed payload length\n");
         return PLDM_ERROR_INVALID_LENGTH;
     }
     struct pldm_supply_custom_request_parameters_resp *response =
@@ -996,20 +1143,22 @@ int decode_rde_operation_complete_resp(const struct pldm_msg *msg,
 				       uint8_t *completion_code)
 {
 	if (msg == NULL) {
-		fprintf(stderr, "Invalid message object\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Invalid message object\n");
 		return PLDM_ERROR_INVALID_DATA;
 	}
 	if (payload_length < 1) {
-		fprintf(stderr, "Invalid payload length\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Invalid payload length\n");
 		return PLDM_ERROR_INVALID_LENGTH;
 	}
 
 	*completion_code = msg->payload[0];
 
 	if (PLDM_SUCCESS != *completion_code) {
-		fprintf(stderr,
-            "Unsuccessful completion code received in op complete: %x\n",
-            (uint8_t)(*completion_code));
+		pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+			   "Unsuccessful completion code received in op complete: %x\n",
+			   (uint8_t)(*completion_code));
 		return PLDM_SUCCESS;
 	}
 	return PLDM_SUCCESS;
@@ -1116,13 +1265,15 @@ int decode_rde_operation_enumerate_resp(
     uint16_t operation_data_array_size)
 {
 	if (msg == NULL) {
-		fprintf(stderr, "Invalid msg object\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Invalid msg object\n");
 		return PLDM_ERROR_INVALID_DATA;
 	}
 
 	if ((completion_code == NULL) || (operation_count == NULL) ||
 	    (operation_data == NULL)) {
-		fprintf(stderr, "Invalid input pointers\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Invalid input pointers\n");
 		return PLDM_ERROR_INVALID_DATA;
 	}
 
@@ -1131,17 +1282,16 @@ int decode_rde_operation_enumerate_resp(
 
 	*completion_code = response->completion_code;
 	if (*completion_code != PLDM_SUCCESS) {
-		fprintf(
-		    stderr,
-		    "Unsuccessful completion code received in op status: %x\n",
-		    (uint8_t)(*completion_code));
+		pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+			   "Unsuccessful completion code received in op status: %x\n",
+			   (uint8_t)(*completion_code));
 		return PLDM_SUCCESS;
 	}
 
 	*operation_count = le16toh(response->operation_count);
 	if (operation_data_array_size < *operation_count) {
-		fprintf(stderr,
-			"Input operation_data struct array too small\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Input operation_data struct array too small\n");
 		return PLDM_ERROR_INVALID_DATA;
 	}
 
@@ -1276,21 +1426,22 @@ int decode_rde_operation_status_resp(
     struct pldm_rde_varstring **resp_etag, uint8_t **response_payload)
 {
 	if (msg == NULL) {
-		fprintf(stderr, "Invalid msg object\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Invalid msg object\n");
 		return PLDM_ERROR_INVALID_DATA;
 	}
 
 	*completion_code = msg->payload[0];
 	if (PLDM_SUCCESS != *completion_code) {
-		fprintf(stderr,
-            "Unsuccessful completion code received in op status: %x\n",
-            (uint8_t)(*completion_code));
+		pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE,
+			   "Unsuccessful completion code received in op status: %x\n",
+			   (uint8_t)(*completion_code));
 		return PLDM_SUCCESS;
 	}
 
 	if (payload_length < RDE_READ_OPERATION_INIT_MIN_BYTES) {
-		fprintf(stderr,
-			"Decoded sucessfully with failed payload length\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE,
+			   "Decoded sucessfully with failed payload length\n");
 		return PLDM_ERROR_INVALID_LENGTH;
 	}
 
@@ -1337,3 +1488,145 @@ int encode_rde_operation_kill_req(uint8_t instance_id, uint32_t resource_id,
 	req->killflags.byte = 4;
 	return PLDM_SUCCESS;
 }
+
+/*
+ * Walks @p count varstrings starting at @p offset within the first
+ * @p length bytes of @p data, leaving @p offset just past the last one.
+ */
+static int rde_skip_varstrings(const uint8_t *data, size_t length,
+			       size_t *offset, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		// Format and length bytes
+		if (length - *offset < 2) {
+			return PLDM_ERROR_INVALID_LENGTH;
+		}
+		*offset += 2 + data[*offset + 1];
+		if (*offset > length) {
+			return PLDM_ERROR_INVALID_LENGTH;
+		}
+	}
+	return PLDM_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_request_length(const struct pldm_msg *msg, size_t buffer_length,
+			    size_t *length)
+{
+	struct pldm_header_info header;
+	size_t payload_length;
+	size_t fixed;
+
+	if (msg == NULL || length == NULL) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+	if (buffer_length < sizeof(struct pldm_msg_hdr)) {
+		return PLDM_ERROR_INVALID_LENGTH;
+	}
+
+	uint8_t rc = unpack_pldm_header(&msg->hdr, &header);
+	if (rc != PLDM_SUCCESS) {
+		return rc;
+	}
+	if (header.pldm_type != PLDM_RDE || header.msg_type != PLDM_REQUEST) {
+		return PLDM_ERROR_INVALID_DATA;
+	}
+
+	payload_length = buffer_length - sizeof(struct pldm_msg_hdr);
+	switch (header.command) {
+	case PLDM_NEGOTIATE_REDFISH_PARAMETERS:
+		fixed = sizeof(struct pldm_rde_negotiate_redfish_parameters_req);
+		break;
+	case PLDM_NEGOTIATE_MEDIUM_PARAMETERS:
+		fixed = sizeof(struct pldm_rde_negotiate_medium_parameters_req);
+		break;
+	case PLDM_GET_SCHEMA_DICTIONARY:
+		fixed = sizeof(struct pldm_rde_get_schema_dictionary_req);
+		break;
+	case PLDM_RDE_MULTIPART_RECEIVE:
+		fixed = sizeof(struct pldm_rde_multipart_receive_req);
+		break;
+	case PLDM_RDE_OPERATION_STATUS:
+		fixed = sizeof(struct pldm_rde_operation_status_req);
+		break;
+	case PLDM_RDE_OPERATION_COMPLETE:
+		fixed = sizeof(struct pldm_rde_operation_complete_req);
+		break;
+	case PLDM_RDE_OPERATION_KILL:
+		fixed = sizeof(struct pldm_rde_operation_kill_req);
+		break;
+	case PLDM_RDE_OPERATION_ENUMERATE:
+		fixed = 0;
+		break;
+	case PLDM_RDE_OPERATION_INIT: {
+		const struct pldm_rde_operation_init_req *req =
+			(const struct pldm_rde_operation_init_req *)msg->payload;
+
+		if (payload_length < PLDM_RDE_OPERATION_INIT_REQ_HDR_SIZE) {
+			return PLDM_ERROR_INVALID_LENGTH;
+		}
+		fixed = PLDM_RDE_OPERATION_INIT_REQ_HDR_SIZE +
+			req->operation_locator_length;
+		if (le32toh(req->request_payload_length) >
+		    payload_length - PLDM_RDE_OPERATION_INIT_REQ_HDR_SIZE) {
+			return PLDM_ERROR_INVALID_LENGTH;
+		}
+		fixed += le32toh(req->request_payload_length);
+		break;
+	}
+	case PLDM_RDE_MULTIPART_SEND: {
+		const struct pldm_rde_multipart_send_req *req =
+			(const struct pldm_rde_multipart_send_req *)msg->payload;
+
+		if (payload_length < PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE) {
+			return PLDM_ERROR_INVALID_LENGTH;
+		}
+		if (le32toh(req->data_length_bytes) >
+		    payload_length - PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE) {
+			return PLDM_ERROR_INVALID_LENGTH;
+		}
+		fixed = PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE +
+			le32toh(req->data_length_bytes);
+		break;
+	}
+	case PLDM_SUPPLY_CUSTOM_REQUEST_PARAMETERS: {
+		const struct pldm_supply_custom_request_parameters_req *req =
+			(const struct pldm_supply_custom_request_parameters_req *)
+				msg->payload;
+		size_t offset = offsetof(
+			struct pldm_supply_custom_request_parameters_req,
+			var_data);
+
+		if (payload_length < offset) {
+			return PLDM_ERROR_INVALID_LENGTH;
+		}
+		if (req->etag_operation != PLDM_RDE_ETAG_IGNORE) {
+			rc = rde_skip_varstrings(msg->payload, payload_length,
+						 &offset, req->etag_count);
+			if (rc != PLDM_SUCCESS) {
+				return rc;
+			}
+		}
+		if (offset >= payload_length) {
+			return PLDM_ERROR_INVALID_LENGTH;
+		}
+		// Header names, then their parameters
+		size_t header_count = msg->payload[offset++];
+		rc = rde_skip_varstrings(msg->payload, payload_length, &offset,
+					 2 * header_count);
+		if (rc != PLDM_SUCCESS) {
+			return rc;
+		}
+		fixed = offset;
+		break;
+	}
+	default:
+		return PLDM_ERROR_INVALID_DATA;
+	}
+
+	if (fixed > payload_length) {
+		return PLDM_ERROR_INVALID_LENGTH;
+	}
+	*length = sizeof(struct pldm_msg_hdr) + fixed;
+	return PLDM_SUCCESS;
+}
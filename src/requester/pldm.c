@@ -12,8 +12,8 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
-#include <stdio.h>
 #include "mctp-defines.h"
+#include "trace.h"
 #include <errno.h>
 
 /* Temporary for old api */
@@ -243,7 +243,8 @@ pldm_requester_rc_t pldm_send_at_network(mctp_eid_t eid, int network_id,
 
     if (rc == -1)
     {
-        perror("FAILED ON SEND LIBPLDM");
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_MCTP_SOCKET,
+                   "Send to socket failed, errno: %d\n", errno);
         return PLDM_REQUESTER_SEND_FAIL;
     }
     return PLDM_REQUESTER_SUCCESS;
@@ -266,7 +267,9 @@ static pldm_requester_rc_t mctp_recv_at_network(mctp_eid_t eid, int mctp_fd,
                               (struct sockaddr*)&addr, &addrlen);
     if (length <= 0)
     {
-		fprintf(stderr, "No length received at MCTP socket, errno: %d\n", errno);
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_MCTP_SOCKET,
+			   "No length received at MCTP socket, errno: %d\n",
+			   errno);
         return PLDM_REQUESTER_RECV_FAIL;
     }
     else if (length < min_len)
@@ -282,7 +285,8 @@ static pldm_requester_rc_t mctp_recv_at_network(mctp_eid_t eid, int mctp_fd,
                                  (struct sockaddr*)&addr, &addrlen);
         if (length != bytes)
         {
-            fprintf(stderr, "Receive from socket failed, errno: %d\n", errno);
+            pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_MCTP_SOCKET,
+                       "Receive from socket failed, errno: %d\n", errno);
             return PLDM_REQUESTER_INVALID_RECV_LEN;
         }
         *resp_msg_len = length;
@@ -298,23 +302,25 @@ pldm_requester_rc_t recv_at_network(mctp_eid_t eid, int mctp_fd,
                                                   resp_msg_len, network_id);
     if (rc != PLDM_REQUESTER_SUCCESS)
     {
-        fprintf(stderr,
-            "MCTP Data Failure: No data received on eid:%u, nid:%d\n",
-            eid, network_id);
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_MCTP_SOCKET,
+                   "MCTP Data Failure: No data received on eid:%u, nid:%d\n",
+                   eid, network_id);
         return rc;
     }
 
     struct pldm_msg_hdr* hdr = (struct pldm_msg_hdr*)(*pldm_resp_msg);
     if (hdr->request != PLDM_RESPONSE)
     {
-        fprintf(stderr, "MCTP Receive failed - Header is not a response\n");
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_MCTP_SOCKET,
+                   "MCTP Receive failed - Header is not a response\n");
         return PLDM_REQUESTER_NOT_RESP_MSG;
     }
 
     uint8_t pldm_rc = 0;
     if (*resp_msg_len < (sizeof(struct pldm_msg_hdr) + sizeof(pldm_rc)))
     {
-        fprintf(stderr, "MCTP Receive failed - Receive message is too small\n");
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_MCTP_SOCKET,
+                   "MCTP Receive failed - Receive message is too small\n");
         return PLDM_REQUESTER_RESP_MSG_TOO_SMALL;
     }
 
@@ -338,7 +344,8 @@ pldm_requester_rc_t pldm_recv_at_network(mctp_eid_t eid, int mctp_fd,
     struct pldm_msg_hdr* hdr = (struct pldm_msg_hdr*)(*pldm_resp_msg);
     if (hdr->instance_id != instance_id)
     {
-        fprintf(stderr, "MCTP Receive failed - Instance Id mismatch\n");
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_MCTP_SOCKET,
+                   "MCTP Receive failed - Instance Id mismatch\n");
         return PLDM_REQUESTER_INSTANCE_ID_MISMATCH;
     }
 
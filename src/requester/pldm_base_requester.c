@@ -3,6 +3,8 @@
 #include "libpldm/base.h"
 #include "libpldm/pldm.h"
 
+#include "requester-stats.h"
+
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -22,6 +24,21 @@ pldm_base_init_context(struct requester_base_context *ctx,
 	ctx->requester_status = PLDM_BASE_REQUESTER_NO_PENDING_ACTION;
 	strcpy(ctx->dev_name, device_id);
 	ctx->net_id = net_id;
+	ctx->stats = NULL;
+	ctx->stats_sample.pending = false;
+	return PLDM_BASE_REQUESTER_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+pldm_base_requester_rc_t
+pldm_base_set_stats(struct requester_base_context *ctx,
+		    struct pldm_requester_stats *stats)
+{
+	if (ctx == NULL || !ctx->initialized) {
+		return PLDM_BASE_CONTEXT_NOT_READY;
+	}
+	ctx->stats = stats;
+	ctx->stats_sample.pending = false;
 	return PLDM_BASE_REQUESTER_SUCCESS;
 }
 
@@ -43,6 +60,7 @@ pldm_base_requester_rc_t
 pldm_base_get_next_request(struct requester_base_context *ctx,
 			   uint8_t instance_id, struct pldm_msg *request)
 {
+	size_t payload_length = 0;
 	int rc;
 	switch (ctx->next_command) {
 	case PLDM_GET_TID: {
@@ -58,6 +76,7 @@ pldm_base_get_next_request(struct requester_base_context *ctx,
 		rc = encode_get_version_req(instance_id, /*transfer_handle=*/0,
 					    PLDM_GET_FIRSTPART, pldm_type,
 					    request);
+		payload_length = PLDM_GET_VERSION_REQ_BYTES;
 		break;
 	}
 
@@ -66,6 +85,7 @@ pldm_base_get_next_request(struct requester_base_context *ctx,
 		rc = encode_get_commands_req(instance_id, pldmType,
 					     ctx->pldm_versions[pldmType],
 					     request);
+		payload_length = PLDM_GET_COMMANDS_REQ_BYTES;
 		break;
 	}
 
@@ -77,6 +97,8 @@ pldm_base_get_next_request(struct requester_base_context *ctx,
 		fprintf(stderr, "Unable to encode request with rc: %d", rc);
 		return PLDM_BASE_REQUESTER_ENCODING_REQUEST_FAILURE;
 	}
+	requester_stats_request(ctx->stats, &ctx->stats_sample, request,
+				sizeof(struct pldm_msg_hdr) + payload_length);
 	return PLDM_BASE_REQUESTER_SUCCESS;
 }
 
@@ -125,6 +147,8 @@ pldm_base_requester_rc_t
 pldm_base_push_response(struct requester_base_context *ctx, void *resp_msg,
 			size_t resp_size)
 {
+	requester_stats_response(ctx->stats, &ctx->stats_sample, resp_msg,
+				 resp_size);
 	switch (ctx->next_command) {
 	case PLDM_GET_TID: {
 		uint8_t completionCode;
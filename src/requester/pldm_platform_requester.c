@@ -1,18 +1,20 @@
 #include "libpldm/requester/pldm_platform_requester.h"
 
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "libpldm/base.h"
 #include "libpldm/pldm.h"
+#include "requester-stats.h"
+#include "trace.h"
 
 LIBPLDM_ABI_STABLE
 pldm_platform_requester_rc_t pldm_platform_init_context(
     struct pldm_platform_requester_context* ctx, const char* device_id,
     int net_id, uint32_t negotiated_transfer_size) {
   if (ctx->initialized) {
-    fprintf(stderr, "No memory allocated for platform context\n");
+    pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_PLATFORM_REQUESTER,
+               "No memory allocated for platform context\n");
     return PLDM_PLATFORM_CONTEXT_INITIALIZATION_ERROR;
   }
 
@@ -22,6 +24,20 @@ pldm_platform_requester_rc_t pldm_platform_init_context(
   strcpy(ctx->device_name, device_id);
   ctx->net_id = net_id;
   ctx->negotiated_transfer_size = negotiated_transfer_size;
+  ctx->stats = NULL;
+  ctx->stats_sample.pending = false;
+  return PLDM_PLATFORM_REQUESTER_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+pldm_platform_requester_rc_t pldm_platform_set_stats(
+    struct pldm_platform_requester_context* ctx,
+    struct pldm_requester_stats* stats) {
+  if ((ctx == NULL) || !ctx->initialized) {
+    return PLDM_PLATFORM_CONTEXT_NOT_READY;
+  }
+  ctx->stats = stats;
+  ctx->stats_sample.pending = false;
   return PLDM_PLATFORM_REQUESTER_SUCCESS;
 }
 
@@ -66,7 +82,8 @@ pldm_platform_requester_rc_t pldm_platform_get_next_get_pdr_request(
     struct pldm_platform_requester_context* ctx, uint8_t instance_id,
     struct pldm_msg* request, size_t request_length) {
   if ((ctx == NULL) || (request == NULL)) {
-    fprintf(stderr, "Inputs cannot be NULL\n");
+    pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_PLATFORM_REQUESTER,
+               "Inputs cannot be NULL\n");
     return PLDM_PLATFORM_REQUESTER_IO_FAILURE;
   }
 
@@ -86,9 +103,12 @@ pldm_platform_requester_rc_t pldm_platform_get_next_get_pdr_request(
   }
 
   if (rc) {
-    fprintf(stderr, "Unable to encode request with rc: %d\n", rc);
+    pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_PLATFORM_REQUESTER,
+               "Unable to encode request with rc: %d\n", rc);
     return PLDM_PLATFORM_REQUESTER_ENCODING_REQUEST_FAILURE;
   }
+  requester_stats_request(ctx->stats, &ctx->stats_sample, request,
+                          sizeof(struct pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES);
   return PLDM_PLATFORM_REQUESTER_SUCCESS;
 }
 
@@ -97,6 +117,8 @@ pldm_platform_requester_rc_t pldm_platform_push_get_pdr_response(
     struct pldm_platform_requester_context* ctx, void* resp_msg,
     size_t resp_size, uint8_t expected_pdr_header_version, uint8_t* record_data,
     size_t record_data_length, bool* is_record_data_complete) {
+  requester_stats_response(ctx->stats, &ctx->stats_sample, resp_msg,
+                           resp_size);
   switch (ctx->next_command) {
     case PLDM_GET_PDR: {
       struct pldm_platform_get_pdr_operation* get_pdr_ctx = ctx->operation_ctx;
@@ -113,10 +135,9 @@ pldm_platform_requester_rc_t pldm_platform_push_get_pdr_response(
           &response_count, record_data, record_data_length, &transfer_crc);
       if (rc || completion_code) {
         ctx->requester_status = PLDM_PLATFORM_REQUESTER_REQUEST_FAILED;
-        fprintf(stderr,
-                "Response decode failed with rc: %d, "
-                "completion code: %d\n",
-                rc, completion_code);
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_PLATFORM_REQUESTER,
+                   "Response decode failed with rc: %d, completion code: %d\n",
+                   rc, completion_code);
         return PLDM_PLATFORM_REQUESTER_DECODING_RESPONSE_FAILURE;
       }
 
@@ -128,23 +149,22 @@ pldm_platform_requester_rc_t pldm_platform_push_get_pdr_response(
           &resp_record_handle, &resp_record_num, &actual_pdr_byte_count);
       if (rc) {
         ctx->requester_status = PLDM_PLATFORM_REQUESTER_REQUEST_FAILED;
-        fprintf(stderr,
-                "Response decode failed with rc: %d, "
-                "completion code: %d\n",
-                rc, completion_code);
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_PLATFORM_REQUESTER,
+                   "Response decode failed with rc: %d, completion code: %d\n",
+                   rc, completion_code);
         return PLDM_PLATFORM_REQUESTER_DECODING_RESPONSE_FAILURE;
       }
 
       if ((sizeof(struct pldm_pdr_hdr) + actual_pdr_byte_count) !=
           (response_count)) {
         ctx->requester_status = PLDM_PLATFORM_REQUESTER_REQUEST_FAILED;
-        fprintf(stderr,
-                "Sum of actual PDR bytes and common PDR header does not match "
-                "the Total PDR byte count in GetPDR response."
-                "(Actual PDR bytes + common PDR header bytes) : %u, Total PDR "
-                "bytes : %u\n",
-                (uint32_t)(sizeof(struct pldm_pdr_hdr) + actual_pdr_byte_count),
-                response_count);
+        pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_PLATFORM_REQUESTER,
+                   "Sum of actual PDR bytes and common PDR header does not match "
+                   "the Total PDR byte count in GetPDR response."
+                   "(Actual PDR bytes + common PDR header bytes) : %u, Total PDR "
+                   "bytes : %u\n",
+                   (uint32_t)(sizeof(struct pldm_pdr_hdr) + actual_pdr_byte_count),
+                   response_count);
         return PLDM_PLATFORM_REQUESTER_DECODING_RESPONSE_FAILURE;
       }
 
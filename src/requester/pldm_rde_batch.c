@@ -0,0 +1,194 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "libpldm/requester/pldm_rde_batch.h"
+
+#include "libpldm/requester/pldm_rde_engine.h"
+#include "libpldm/requester/pldm_rde_requester.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static void rde_batch_done(void *arg,
+			   struct pldm_rde_requester_manager *manager,
+			   struct pldm_rde_requester_context *ctx, int rc);
+
+static bool rde_batch_context_free(const struct pldm_rde_requester_context *ctx)
+{
+	return ctx->context_status != CONTEXT_BUSY &&
+	       ctx->current_pdr_resource == NULL && !ctx->operation.active;
+}
+
+static void rde_batch_finish(struct pldm_rde_batch *batch,
+			     struct pldm_rde_batch_item *item, int rc)
+{
+	item->ctx = NULL;
+	item->rc = rc;
+	if (++batch->finished == batch->count) {
+		free(batch->running);
+		batch->running = NULL;
+	}
+	if (batch->item_done) {
+		batch->item_done(batch->arg, batch, item);
+	}
+}
+
+static int rde_batch_prepare(struct pldm_rde_requester_context *ctx,
+			     struct pldm_rde_batch_item *item, size_t index)
+{
+	if (pldm_rde_init_rde_operation_context(
+		    ctx, (uint8_t)index, item->resource_id, item->operation_id,
+		    item->operation_type, item->operation_flags,
+		    item->query_options, 0, 0, item->request_payload_length,
+		    NULL, item->request_payload)) {
+		return -EINVAL;
+	}
+	if (item->reassembly != NULL &&
+	    pldm_rde_set_operation_reassembly(ctx, item->reassembly)) {
+		free_rde_op_init_context(ctx);
+		return -EINVAL;
+	}
+	return 0;
+}
+
+/*
+ * Starts the next item on @p ctx. Items that fail to start are done right
+ * away, and the one after is tried instead.
+ */
+static void rde_batch_start_next(struct pldm_rde_batch *batch,
+				 struct pldm_rde_requester_context *ctx)
+{
+	size_t index = ctx - batch->manager->ctx;
+
+	while (batch->next < batch->count) {
+		struct pldm_rde_batch_item *item = &batch->items[batch->next];
+		int rc;
+
+		rc = rde_batch_prepare(ctx, item, batch->next);
+		batch->next++;
+		if (!rc) {
+			// The engine may be done with the work before
+			// returning
+			item->ctx = ctx;
+			batch->running[index] = item;
+			rc = pldm_rde_engine_submit(
+				batch->engine, PLDM_RDE_ENGINE_OPERATION,
+				batch->manager, ctx, batch->tid,
+				batch->callback, rde_batch_done, batch);
+			if (!rc) {
+				return;
+			}
+			batch->running[index] = NULL;
+			free_rde_op_init_context(ctx);
+		}
+		rde_batch_finish(batch, item, rc);
+	}
+}
+
+static void rde_batch_done(void *arg,
+			   struct pldm_rde_requester_manager *manager,
+			   struct pldm_rde_requester_context *ctx, int rc)
+{
+	struct pldm_rde_batch *batch = arg;
+	size_t index = ctx - manager->ctx;
+	struct pldm_rde_batch_item *item = batch->running[index];
+
+	batch->running[index] = NULL;
+	free_rde_op_init_context(ctx);
+
+	if (rc == -ECANCELED) {
+		// The engine is going away, so nothing else can start
+		while (batch->next < batch->count) {
+			rde_batch_finish(batch, &batch->items[batch->next++],
+					 -ECANCELED);
+		}
+	} else {
+		// The next item goes out before this one is reported
+		rde_batch_start_next(batch, ctx);
+	}
+	rde_batch_finish(batch, item, rc);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_batch_start(struct pldm_rde_engine *engine,
+			 struct pldm_rde_batch *batch)
+{
+	struct pldm_rde_requester_manager *manager;
+	uint8_t concurrency;
+	uint8_t started = 0;
+
+	if (!engine || !batch || !batch->manager || !batch->callback ||
+	    (!batch->items && batch->count)) {
+		return -EINVAL;
+	}
+	manager = batch->manager;
+	if (!manager->initialized || !manager->ctx) {
+		return -EINVAL;
+	}
+	if (batch->running) {
+		return -EBUSY;
+	}
+
+	batch->engine = engine;
+	batch->next = 0;
+	batch->finished = 0;
+	for (size_t i = 0; i < batch->count; i++) {
+		batch->items[i].ctx = NULL;
+		batch->items[i].rc = 0;
+	}
+	if (!batch->count) {
+		return 0;
+	}
+
+	// As for pldm_rde_start_dictionary_download()
+	concurrency = manager->device.device_concurrency;
+	if (concurrency == 0) {
+		concurrency = 1;
+	}
+	if (concurrency > manager->mc_concurrency) {
+		concurrency = manager->mc_concurrency;
+	}
+
+	batch->running = calloc(manager->n_ctx, sizeof(*batch->running));
+	if (!batch->running) {
+		return -ENOMEM;
+	}
+
+	for (uint8_t i = 0; i < manager->n_ctx && started < concurrency &&
+			    batch->next < batch->count;
+	     i++) {
+		struct pldm_rde_requester_context *ctx = &manager->ctx[i];
+
+		if (!rde_batch_context_free(ctx)) {
+			continue;
+		}
+		rde_batch_start_next(batch, ctx);
+		started++;
+	}
+
+	if (!started) {
+		free(batch->running);
+		batch->running = NULL;
+		return -EBUSY;
+	}
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+struct pldm_rde_batch_item *
+pldm_rde_batch_item_of(struct pldm_rde_batch *batch,
+		       struct pldm_rde_requester_context *ctx)
+{
+	struct pldm_rde_requester_context *first;
+
+	if (!batch || !ctx || !batch->running) {
+		return NULL;
+	}
+
+	first = batch->manager->ctx;
+	if (ctx < first || ctx >= first + batch->manager->n_ctx) {
+		return NULL;
+	}
+	return batch->running[ctx - first];
+}
@@ -0,0 +1,858 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "libpldm/requester/pldm_rde_engine.h"
+
+#include "libpldm/base.h"
+#include "libpldm/instance-id.h"
+#include "libpldm/pldm_rde.h"
+#include "libpldm/transport.h"
+
+#include "rde-timer-wheel.h"
+#include "transport/container-of.h"
+#include "transport/transport.h"
+
+#include <errno.h>
+#include <limits.h>
+#ifdef PLDM_HAS_POLL
+#include <poll.h>
+#endif
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RDE_ENGINE_INSTANCE_IDS (PLDM_INSTANCE_MAX + 1)
+
+/*
+ * Requests are at most a transfer's worth of payload plus fixed fields, the
+ * operation locator and custom request parameters, which all fit in this.
+ */
+#define RDE_ENGINE_REQUEST_SLACK 1024
+
+/*
+ * How often works blocked on a shared instance ID database retry when none of
+ * their own requests are outstanding to free one up.
+ */
+#define RDE_ENGINE_RETRY_MS 10
+
+struct rde_engine_work {
+	struct rde_engine_work *prev;
+	struct rde_engine_work *next;
+	// Armed while an OperationStatus request waits for its turn
+	struct rde_timer timer;
+	enum pldm_rde_engine_work kind;
+	struct pldm_rde_requester_manager *manager;
+	struct pldm_rde_requester_context *ctx;
+	callback_funct callback;
+	pldm_rde_engine_done_fn done;
+	void *arg;
+	// Monotonic milliseconds by which the response must arrive
+	uint64_t deadline;
+	int rc;
+	pldm_tid_t tid;
+	uint8_t instance_id;
+	uint8_t command;
+	// Set once the status poll timer fired, until the request is sent
+	bool poll_due;
+	uint8_t polled_percentage;
+	// When the previous status arrived, for extrapolating progress
+	uint64_t polled_at;
+	uint32_t poll_backoff_ms;
+};
+
+struct rde_engine_list {
+	struct rde_engine_work *head;
+	struct rde_engine_work *tail;
+};
+
+struct rde_engine_device {
+	// Requests awaiting a response, by instance ID
+	struct rde_engine_work *in_flight[RDE_ENGINE_INSTANCE_IDS];
+	// Instance IDs are handed out round robin so that a late response to a
+	// timed out request is unlikely to match its successor
+	uint8_t next_instance_id;
+};
+
+struct pldm_rde_engine {
+	struct pldm_transport *transport;
+	struct pldm_instance_db *instance_db;
+	int timeout_ms;
+	uint32_t poll_min_ms;
+	uint32_t poll_max_ms;
+	unsigned int pending;
+	// Operations waiting to poll the device for their status
+	struct rde_timer_wheel polls;
+	// Works with a request to send but no instance ID to send it with
+	struct rde_engine_list waiting;
+	// Works awaiting a response, in the order the requests were sent. With
+	// a single timeout that is also deadline order.
+	struct rde_engine_list in_flight;
+	// Reads waiting on an identical read driven by another work
+	struct rde_engine_list coalesced;
+	// Allocated on first use, by TID
+	struct rde_engine_device *devices[PLDM_MAX_TIDS];
+	uint8_t *request;
+	size_t request_size;
+};
+
+static uint64_t rde_engine_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+static void rde_engine_list_append(struct rde_engine_list *list,
+				   struct rde_engine_work *work)
+{
+	work->prev = list->tail;
+	work->next = NULL;
+	if (list->tail) {
+		list->tail->next = work;
+	} else {
+		list->head = work;
+	}
+	list->tail = work;
+}
+
+static void rde_engine_list_remove(struct rde_engine_list *list,
+				   struct rde_engine_work *work)
+{
+	if (work->prev) {
+		work->prev->next = work->next;
+	} else {
+		list->head = work->next;
+	}
+	if (work->next) {
+		work->next->prev = work->prev;
+	} else {
+		list->tail = work->prev;
+	}
+	work->prev = NULL;
+	work->next = NULL;
+}
+
+static void rde_engine_step(struct pldm_rde_engine *engine,
+			    struct rde_engine_work *work);
+
+/* Steps the coalesced reads that the reads they joined are done with */
+static void rde_engine_settle(struct pldm_rde_engine *engine)
+{
+	struct rde_engine_work *work = engine->coalesced.head;
+
+	while (work) {
+		if (work->ctx->requester_status ==
+		    PLDM_RDE_REQUESTER_WAITING_FOR_RESPONSE) {
+			work = work->next;
+			continue;
+		}
+		rde_engine_list_remove(&engine->coalesced, work);
+		rde_engine_step(engine, work);
+		// Stepping may have completed any of the others
+		work = engine->coalesced.head;
+	}
+}
+
+static void rde_engine_complete(struct pldm_rde_engine *engine,
+				struct rde_engine_work *work, int rc)
+{
+	struct pldm_rde_requester_manager *manager = work->manager;
+	struct pldm_rde_requester_context *ctx = work->ctx;
+	pldm_rde_engine_done_fn done = work->done;
+	void *arg = work->arg;
+	bool abandoned = rc && work->kind == PLDM_RDE_ENGINE_OPERATION;
+	struct rde_engine_work *joined;
+
+	engine->pending--;
+	free(work);
+	if (abandoned) {
+		// Reads that joined this one fail the same way
+		for (joined = engine->coalesced.head; joined;
+		     joined = joined->next) {
+			struct rde_operation *operation =
+				&joined->ctx->operation;
+
+			if (operation->active &&
+			    operation->coalesce_leader == ctx) {
+				joined->rc = rc;
+			}
+		}
+		pldm_rde_abandon_coalesced_reads(manager, ctx);
+	}
+	if (done) {
+		done(arg, manager, ctx, rc);
+	}
+	if (abandoned) {
+		rde_engine_settle(engine);
+	}
+}
+
+static int rde_engine_alloc_instance_id(struct pldm_rde_engine *engine,
+					pldm_tid_t tid, uint8_t *instance_id)
+{
+	struct rde_engine_device *device = engine->devices[tid];
+	int rc;
+
+	if (!device) {
+		device = calloc(1, sizeof(*device));
+		if (!device) {
+			return -ENOMEM;
+		}
+		engine->devices[tid] = device;
+	}
+
+	if (engine->instance_db) {
+		pldm_instance_id_t iid;
+
+		rc = pldm_instance_id_alloc(engine->instance_db, tid, &iid);
+		if (rc) {
+			return rc;
+		}
+		*instance_id = iid;
+		return 0;
+	}
+
+	for (int i = 0; i < RDE_ENGINE_INSTANCE_IDS; i++) {
+		uint8_t candidate = (device->next_instance_id + i) %
+				    RDE_ENGINE_INSTANCE_IDS;
+
+		if (!device->in_flight[candidate]) {
+			device->next_instance_id =
+				(candidate + 1) % RDE_ENGINE_INSTANCE_IDS;
+			*instance_id = candidate;
+			return 0;
+		}
+	}
+	return -EAGAIN;
+}
+
+static void rde_engine_free_instance_id(struct pldm_rde_engine *engine,
+					pldm_tid_t tid, uint8_t instance_id)
+{
+	if (engine->instance_db) {
+		pldm_instance_id_free(engine->instance_db, tid, instance_id);
+	}
+}
+
+static int rde_engine_reserve_request(struct pldm_rde_engine *engine,
+				      struct rde_engine_work *work)
+{
+	struct pldm_rde_requester_manager *manager = work->manager;
+	size_t transfer = manager->mc_transfer_size;
+	size_t size;
+	uint8_t *request;
+
+	if (manager->negotiated_transfer_size > transfer) {
+		transfer = manager->negotiated_transfer_size;
+	}
+	// Without a negotiated transfer size the whole payload goes inline
+	if (work->kind == PLDM_RDE_ENGINE_OPERATION &&
+	    manager->negotiated_transfer_size == 0) {
+		struct rde_operation *operation = &work->ctx->operation;
+
+		if (operation->active &&
+		    operation->request_payload_length > transfer) {
+			transfer = operation->request_payload_length;
+		}
+	}
+
+	size = sizeof(struct pldm_msg_hdr) + RDE_ENGINE_REQUEST_SLACK +
+	       transfer;
+	if (size <= engine->request_size) {
+		return 0;
+	}
+
+	request = realloc(engine->request, size);
+	if (!request) {
+		return -ENOMEM;
+	}
+	engine->request = request;
+	engine->request_size = size;
+	return 0;
+}
+
+/*
+ * Encodes the context's next request. Returns 1 if the context moved on
+ * without needing one and 2 if it waits on another context's request.
+ */
+static int rde_engine_encode(struct pldm_rde_engine *engine,
+			     struct rde_engine_work *work, uint8_t instance_id,
+			     size_t *length)
+{
+	struct pldm_msg *request;
+	int rc;
+
+	rc = rde_engine_reserve_request(engine, work);
+	if (rc) {
+		return rc;
+	}
+
+	// Commands the requester declines to encode must not go out stale
+	request = (struct pldm_msg *)engine->request;
+	memset(&request->hdr, 0, sizeof(request->hdr));
+
+	switch (work->kind) {
+	case PLDM_RDE_ENGINE_DISCOVERY:
+		rc = pldm_rde_get_next_discovery_command(
+			instance_id, work->manager, work->ctx, request);
+		break;
+	case PLDM_RDE_ENGINE_DICTIONARY:
+		rc = pldm_rde_get_next_dictionary_schema_command(
+			instance_id, work->manager, work->ctx, request);
+		if (rc == PLDM_RDE_DICTIONARY_CACHE_HIT) {
+			return 1;
+		}
+		break;
+	case PLDM_RDE_ENGINE_OPERATION:
+		rc = pldm_rde_get_next_rde_operation(instance_id, work->manager,
+						     work->ctx, request);
+		if (rc == PLDM_RDE_OPERATION_COALESCED) {
+			return 2;
+		}
+		break;
+	default:
+		return -EINVAL;
+	}
+	if (rc) {
+		return -EPROTO;
+	}
+
+	if (pldm_rde_request_length(request, engine->request_size, length) !=
+	    PLDM_SUCCESS) {
+		return -EPROTO;
+	}
+	work->command = request->hdr.command;
+	return 0;
+}
+
+/*
+ * Picks the delay before polling a running operation again. An estimate from
+ * the device wins, then the progress rate seen between the previous two
+ * statuses, and otherwise the interval doubles on every poll.
+ */
+static uint32_t rde_engine_poll_delay(struct pldm_rde_engine *engine,
+				      struct rde_engine_work *work,
+				      const struct rde_operation *operation,
+				      uint64_t now)
+{
+	uint8_t percentage = operation->percentage_complete;
+	bool backoff = false;
+	uint64_t delay;
+
+	if (operation->completion_time != PLDM_RDE_COMP_TIME_NOT_SUPPORTED) {
+		delay = (uint64_t)operation->completion_time * 1000;
+	} else if (percentage < 100 && work->polled_at &&
+		   percentage > work->polled_percentage) {
+		delay = (now - work->polled_at) * (100 - percentage) /
+			(percentage - work->polled_percentage);
+	} else {
+		delay = (uint64_t)work->poll_backoff_ms * 2;
+		backoff = true;
+	}
+
+	if (delay < engine->poll_min_ms) {
+		delay = engine->poll_min_ms;
+	}
+	if (delay > engine->poll_max_ms) {
+		delay = engine->poll_max_ms;
+	}
+	work->poll_backoff_ms = backoff ? delay : 0;
+
+	work->polled_at = now;
+	work->polled_percentage = percentage;
+	return delay;
+}
+
+/*
+ * Holds back the OperationStatus request of an operation the device is still
+ * running until it is worth sending. Returns true if the request was deferred.
+ */
+static bool rde_engine_schedule_poll(struct pldm_rde_engine *engine,
+				     struct rde_engine_work *work)
+{
+	const struct rde_operation *operation = &work->ctx->operation;
+	uint64_t now;
+
+	if (work->kind != PLDM_RDE_ENGINE_OPERATION || work->poll_due ||
+	    work->ctx->next_command != PLDM_RDE_OPERATION_STATUS) {
+		return false;
+	}
+	// Status requests that follow a MultipartSend go out right away
+	if (!operation->active ||
+	    (operation->operation_status != PLDM_RDE_OPERATION_RUNNING &&
+	     operation->operation_status != PLDM_RDE_OPERATION_TRIGGERED)) {
+		return false;
+	}
+
+	now = rde_engine_now();
+	rde_timer_wheel_add(&engine->polls, &work->timer,
+			    now + rde_engine_poll_delay(engine, work, operation,
+							now));
+	return true;
+}
+
+static void rde_engine_step(struct pldm_rde_engine *engine,
+			    struct rde_engine_work *work)
+{
+	struct pldm_rde_requester_context *ctx = work->ctx;
+	uint8_t instance_id;
+	size_t length;
+	int rc;
+
+	for (;;) {
+		if (ctx->requester_status ==
+		    PLDM_RDE_REQUESTER_NO_PENDING_ACTION) {
+			rde_engine_complete(engine, work, work->rc);
+			return;
+		}
+
+		if ((int8_t)ctx->requester_status ==
+			    PLDM_RDE_REQUESTER_REQUEST_FAILED &&
+		    !work->rc) {
+			work->rc = -EPROTO;
+		}
+
+		// A failed operation is still closed on the device before the
+		// failure is reported
+		if (work->rc &&
+		    (work->kind != PLDM_RDE_ENGINE_OPERATION ||
+		     ctx->next_command != PLDM_RDE_OPERATION_COMPLETE ||
+		     work->command == PLDM_RDE_OPERATION_COMPLETE)) {
+			rde_engine_complete(engine, work, work->rc);
+			return;
+		}
+
+		if (rde_engine_schedule_poll(engine, work)) {
+			return;
+		}
+
+		rc = rde_engine_alloc_instance_id(engine, work->tid,
+						  &instance_id);
+		if (rc == -EAGAIN) {
+			rde_engine_list_append(&engine->waiting, work);
+			return;
+		}
+		if (rc) {
+			rde_engine_complete(engine, work, rc);
+			return;
+		}
+
+		rc = rde_engine_encode(engine, work, instance_id, &length);
+		if (rc == 1) {
+			rde_engine_free_instance_id(engine, work->tid,
+						    instance_id);
+			continue;
+		}
+		if (rc == 2) {
+			rde_engine_free_instance_id(engine, work->tid,
+						    instance_id);
+			rde_engine_list_append(&engine->coalesced, work);
+			return;
+		}
+		if (rc) {
+			rde_engine_free_instance_id(engine, work->tid,
+						    instance_id);
+			rde_engine_complete(engine, work, rc);
+			return;
+		}
+
+		if (pldm_transport_send_msg(engine->transport, work->tid,
+					    engine->request, length) !=
+		    PLDM_REQUESTER_SUCCESS) {
+			rde_engine_free_instance_id(engine, work->tid,
+						    instance_id);
+			rde_engine_complete(engine, work, -EIO);
+			return;
+		}
+
+		work->instance_id = instance_id;
+		work->poll_due = false;
+		work->deadline = rde_engine_now() + engine->timeout_ms;
+		engine->devices[work->tid]->in_flight[instance_id] = work;
+		rde_engine_list_append(&engine->in_flight, work);
+		return;
+	}
+}
+
+/* Takes @p work off the wire, making its instance ID available again */
+static void rde_engine_retire(struct pldm_rde_engine *engine,
+			      struct rde_engine_work *work)
+{
+	struct rde_engine_device *device = engine->devices[work->tid];
+	struct rde_engine_work *waiter;
+
+	rde_engine_list_remove(&engine->in_flight, work);
+	device->in_flight[work->instance_id] = NULL;
+	rde_engine_free_instance_id(engine, work->tid, work->instance_id);
+
+	for (waiter = engine->waiting.head; waiter; waiter = waiter->next) {
+		if (waiter->tid == work->tid) {
+			rde_engine_list_remove(&engine->waiting, waiter);
+			rde_engine_step(engine, waiter);
+			break;
+		}
+	}
+}
+
+static void rde_engine_expire(struct pldm_rde_engine *engine)
+{
+	uint64_t now = rde_engine_now();
+	struct rde_engine_work *work;
+	struct rde_engine_list waiting;
+	struct rde_timer *timer;
+	struct rde_timer *next;
+
+	while ((work = engine->in_flight.head) && work->deadline <= now) {
+		rde_engine_retire(engine, work);
+		// A lost result chunk is asked for again if retries are left
+		if (work->kind == PLDM_RDE_ENGINE_OPERATION &&
+		    work->command == PLDM_RDE_MULTIPART_RECEIVE &&
+		    pldm_rde_retry_multipart_receive(work->manager, work->ctx) ==
+			    PLDM_RDE_REQUESTER_SUCCESS) {
+			rde_engine_step(engine, work);
+			continue;
+		}
+		rde_engine_complete(engine, work, -ETIMEDOUT);
+	}
+
+	// Every poll due by now goes out in this one pass
+	for (timer = rde_timer_wheel_expire(&engine->polls, now); timer;
+	     timer = next) {
+		next = timer->next;
+		work = container_of(timer, struct rde_engine_work, timer);
+		work->poll_due = true;
+		rde_engine_step(engine, work);
+	}
+
+	if (!engine->instance_db) {
+		return;
+	}
+
+	// Instance IDs may have been released by other requesters
+	waiting = engine->waiting;
+	engine->waiting.head = NULL;
+	engine->waiting.tail = NULL;
+	while ((work = waiting.head)) {
+		rde_engine_list_remove(&waiting, work);
+		rde_engine_step(engine, work);
+	}
+}
+
+static void rde_engine_receive(struct pldm_rde_engine *engine,
+			       pldm_tid_t tid, struct pldm_msg *msg,
+			       size_t length)
+{
+	struct rde_engine_device *device = engine->devices[tid];
+	struct rde_engine_work *work;
+	int rc;
+
+	if (!device || msg->hdr.request || msg->hdr.type != PLDM_RDE) {
+		return;
+	}
+
+	work = device->in_flight[msg->hdr.instance_id];
+	if (!work || work->command != msg->hdr.command) {
+		return;
+	}
+
+	rde_engine_retire(engine, work);
+
+	switch (work->kind) {
+	case PLDM_RDE_ENGINE_DISCOVERY:
+		rc = pldm_rde_discovery_push_response(work->manager, work->ctx,
+						      msg, length);
+		break;
+	case PLDM_RDE_ENGINE_DICTIONARY:
+		rc = pldm_rde_push_get_dictionary_response(
+			work->manager, work->ctx, msg, length, work->callback);
+		break;
+	case PLDM_RDE_ENGINE_OPERATION:
+		rc = pldm_rde_push_read_operation_response(
+			work->manager, work->ctx, msg, length, work->callback);
+		break;
+	default:
+		rc = -EINVAL;
+		break;
+	}
+	if (rc) {
+		work->rc = -EPROTO;
+	}
+
+	rde_engine_step(engine, work);
+	rde_engine_settle(engine);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_engine_init(struct pldm_rde_engine **engine,
+			 struct pldm_transport *transport)
+{
+	struct pldm_rde_engine *new;
+
+	if (!engine || *engine || !transport) {
+		return -EINVAL;
+	}
+
+	new = calloc(1, sizeof(*new));
+	if (!new) {
+		return -ENOMEM;
+	}
+	new->transport = transport;
+	new->timeout_ms = PLDM_RDE_ENGINE_DEFAULT_TIMEOUT_MS;
+	new->poll_min_ms = PLDM_RDE_ENGINE_DEFAULT_POLL_MIN_MS;
+	new->poll_max_ms = PLDM_RDE_ENGINE_DEFAULT_POLL_MAX_MS;
+	rde_timer_wheel_init(&new->polls, rde_engine_now());
+
+	*engine = new;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_rde_engine_destroy(struct pldm_rde_engine *engine)
+{
+	struct rde_engine_work *work;
+	struct rde_timer *timer;
+	struct rde_timer *next;
+
+	if (!engine) {
+		return;
+	}
+
+	while ((work = engine->coalesced.head)) {
+		rde_engine_list_remove(&engine->coalesced, work);
+		rde_engine_complete(engine, work, -ECANCELED);
+	}
+	while ((work = engine->in_flight.head)) {
+		rde_engine_list_remove(&engine->in_flight, work);
+		rde_engine_free_instance_id(engine, work->tid,
+					    work->instance_id);
+		rde_engine_complete(engine, work, -ECANCELED);
+	}
+	while ((work = engine->waiting.head)) {
+		rde_engine_list_remove(&engine->waiting, work);
+		rde_engine_complete(engine, work, -ECANCELED);
+	}
+	for (timer = rde_timer_wheel_expire(&engine->polls, UINT64_MAX); timer;
+	     timer = next) {
+		next = timer->next;
+		work = container_of(timer, struct rde_engine_work, timer);
+		rde_engine_complete(engine, work, -ECANCELED);
+	}
+
+	for (size_t i = 0; i < PLDM_MAX_TIDS; i++) {
+		free(engine->devices[i]);
+	}
+	free(engine->request);
+	free(engine);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_engine_set_instance_db(struct pldm_rde_engine *engine,
+				    struct pldm_instance_db *db)
+{
+	if (!engine) {
+		return -EINVAL;
+	}
+	if (engine->pending) {
+		return -EBUSY;
+	}
+	engine->instance_db = db;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_engine_set_timeout(struct pldm_rde_engine *engine, int timeout_ms)
+{
+	if (!engine || timeout_ms <= 0) {
+		return -EINVAL;
+	}
+	engine->timeout_ms = timeout_ms;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_engine_set_poll_interval(struct pldm_rde_engine *engine,
+				      uint32_t min_ms, uint32_t max_ms)
+{
+	if (!engine || min_ms == 0 || min_ms > max_ms) {
+		return -EINVAL;
+	}
+	engine->poll_min_ms = min_ms;
+	engine->poll_max_ms = max_ms;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_engine_submit(struct pldm_rde_engine *engine,
+			   enum pldm_rde_engine_work kind,
+			   struct pldm_rde_requester_manager *manager,
+			   struct pldm_rde_requester_context *ctx,
+			   pldm_tid_t tid, callback_funct callback,
+			   pldm_rde_engine_done_fn done, void *arg)
+{
+	struct rde_engine_work *work;
+
+	if (!engine || !manager || !ctx) {
+		return -EINVAL;
+	}
+	if (kind != PLDM_RDE_ENGINE_DISCOVERY && !callback) {
+		return -EINVAL;
+	}
+	if (kind != PLDM_RDE_ENGINE_DISCOVERY &&
+	    kind != PLDM_RDE_ENGINE_DICTIONARY &&
+	    kind != PLDM_RDE_ENGINE_OPERATION) {
+		return -EINVAL;
+	}
+
+	work = calloc(1, sizeof(*work));
+	if (!work) {
+		return -ENOMEM;
+	}
+	work->kind = kind;
+	work->manager = manager;
+	work->ctx = ctx;
+	work->tid = tid;
+	work->callback = callback;
+	work->done = done;
+	work->arg = arg;
+
+	engine->pending++;
+	rde_engine_step(engine, work);
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+unsigned int pldm_rde_engine_pending(struct pldm_rde_engine *engine)
+{
+	return engine ? engine->pending : 0;
+}
+
+#ifdef PLDM_HAS_POLL
+LIBPLDM_ABI_TESTING
+int pldm_rde_engine_init_pollfd(struct pldm_rde_engine *engine,
+				struct pollfd *pollfd)
+{
+	if (!engine || !pollfd) {
+		return -EINVAL;
+	}
+	if (!engine->transport->init_pollfd) {
+		return -ENOTSUP;
+	}
+	if (engine->transport->init_pollfd(engine->transport, pollfd) < 0) {
+		return -EIO;
+	}
+	return 0;
+}
+#endif
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_engine_next_timeout(struct pldm_rde_engine *engine)
+{
+	uint64_t now;
+	uint64_t deadline;
+	int timeout = -1;
+	int poll;
+
+	if (!engine) {
+		return -1;
+	}
+
+	now = rde_engine_now();
+	if (engine->in_flight.head) {
+		deadline = engine->in_flight.head->deadline;
+		if (deadline <= now) {
+			return 0;
+		}
+		timeout = deadline - now > INT_MAX ? INT_MAX :
+						     (int)(deadline - now);
+	} else if (engine->waiting.head) {
+		timeout = RDE_ENGINE_RETRY_MS;
+	}
+
+	poll = rde_timer_wheel_next(&engine->polls, now);
+	if (poll >= 0 && (timeout < 0 || poll < timeout)) {
+		timeout = poll;
+	}
+	return timeout;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_engine_dispatch(struct pldm_rde_engine *engine)
+{
+	pldm_tid_t tid;
+	void *msg = NULL;
+	size_t length;
+	int ret = 0;
+	int rc;
+
+	if (!engine) {
+		return -EINVAL;
+	}
+
+	/* The socket transports block in recv until a message comes, and
+	 * callers also dispatch when a timeout elapses */
+	rc = pldm_transport_poll(engine->transport, 0);
+	if (rc < 0) {
+		ret = -EIO;
+	} else if (rc > 0) {
+		rc = pldm_transport_recv_msg(engine->transport, &tid, &msg,
+					     &length);
+		if (rc == PLDM_REQUESTER_SUCCESS) {
+			rde_engine_receive(engine, tid, msg, length);
+			pldm_transport_release_msg(engine->transport, msg);
+		} else if (rc == PLDM_REQUESTER_RECV_FAIL) {
+			ret = -EIO;
+		}
+	}
+
+	rde_engine_expire(engine);
+
+	return ret;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_engine_run(struct pldm_rde_engine *engine, int timeout_ms)
+{
+	uint64_t end = 0;
+	int rc;
+
+	if (!engine) {
+		return -EINVAL;
+	}
+	if (timeout_ms >= 0) {
+		end = rde_engine_now() + timeout_ms;
+	}
+
+	while (engine->pending) {
+		int wait = pldm_rde_engine_next_timeout(engine);
+
+		if (timeout_ms >= 0) {
+			uint64_t now = rde_engine_now();
+			int remaining = end > now ? (int)(end - now) : 0;
+
+			if (remaining == 0) {
+				return -ETIMEDOUT;
+			}
+			if (wait < 0 || remaining < wait) {
+				wait = remaining;
+			}
+		}
+
+		rc = pldm_transport_poll(engine->transport, wait);
+		if (rc < 0) {
+			return -EIO;
+		}
+		if (rc == 0) {
+			rde_engine_expire(engine);
+			continue;
+		}
+
+		rc = pldm_rde_engine_dispatch(engine);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
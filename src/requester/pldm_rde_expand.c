@@ -0,0 +1,282 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "libpldm/requester/pldm_rde_expand.h"
+
+#include "libpldm/bej.h"
+#include "libpldm/platform.h"
+#include "libpldm/pldm_rde.h"
+#include "libpldm/requester/pldm_rde_batch.h"
+#include "libpldm/requester/pldm_rde_engine.h"
+#include "libpldm/requester/pldm_rde_requester.h"
+
+#include "msgbuf.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* A resource to read, at the same index as its batch item */
+struct rde_expand_node {
+	uint32_t resource_id;
+	// Index of the containing resource, 0 for the requested one itself
+	size_t parent;
+	uint8_t level;
+	struct pldm_rde_reassembly reassembly;
+	// The payload with the links below it expanded, once it is
+	uint8_t *expanded;
+	size_t expanded_length;
+};
+
+/* Looks up the resources read below one of them */
+struct rde_expand_lookup {
+	const struct rde_expand_node *nodes;
+	size_t count;
+	size_t parent;
+};
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_resource_link_from_pdr(uint8_t *record_data,
+				    struct pldm_rde_resource_link *link)
+{
+	/* Only the fields ahead of the names are needed. They are read through
+	 * a msgbuf as PDRs are byte-packed and the record may sit at any
+	 * alignment. */
+	const size_t size =
+		offsetof(struct pldm_platform_redfish_resource_pdr_data,
+			 proposed_containing_resource_length);
+	struct pldm_msgbuf _buf;
+	struct pldm_msgbuf *buf = &_buf;
+	uint8_t resource_flags;
+
+	if (record_data == NULL || link == NULL) {
+		return -EINVAL;
+	}
+	if (pldm_msgbuf_init(buf, size, record_data, size)) {
+		return -EINVAL;
+	}
+	pldm_msgbuf_extract(buf, &link->resource_id);
+	pldm_msgbuf_extract(buf, &resource_flags);
+	pldm_msgbuf_extract(buf, &link->containing_resource_id);
+	return pldm_msgbuf_destroy(buf) ? -EINVAL : 0;
+}
+
+/* Resources land in their node's reassembly buffer, nothing to do here */
+static void rde_expand_payload(struct pldm_rde_requester_manager *manager,
+			       struct pldm_rde_requester_context *ctx,
+			       uint8_t **payload, uint32_t length,
+			       bool has_checksum)
+{
+	(void)manager;
+	(void)ctx;
+	(void)payload;
+	(void)length;
+	(void)has_checksum;
+}
+
+static bool rde_expand_known(const struct rde_expand_node *nodes, size_t count,
+			     uint32_t resource_id)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (nodes[i].resource_id == resource_id) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Lists the requested resource and those below it, level by level, so each
+ * resource comes after the one containing it. Every link adds one resource
+ * at most.
+ */
+static size_t rde_expand_collect(const struct pldm_rde_expand *expand,
+				 struct rde_expand_node *nodes)
+{
+	size_t count = 1;
+
+	nodes[0].resource_id = expand->resource_id;
+	for (size_t i = 0; i < count; i++) {
+		if (nodes[i].level >= expand->levels) {
+			continue;
+		}
+		for (size_t j = 0; j < expand->link_count; j++) {
+			const struct pldm_rde_resource_link *link =
+				&expand->links[j];
+
+			if (link->containing_resource_id !=
+				    nodes[i].resource_id ||
+			    rde_expand_known(nodes, count, link->resource_id)) {
+				continue;
+			}
+			nodes[count].resource_id = link->resource_id;
+			nodes[count].parent = i;
+			nodes[count].level = nodes[i].level + 1;
+			count++;
+		}
+	}
+	return count;
+}
+
+static bool rde_expand_resolve(void *arg, uint32_t resource_id,
+			       const uint8_t **encoding, size_t *length)
+{
+	const struct rde_expand_lookup *lookup = arg;
+
+	for (size_t i = lookup->parent + 1; i < lookup->count; i++) {
+		const struct rde_expand_node *node = &lookup->nodes[i];
+
+		if (node->parent == lookup->parent &&
+		    node->resource_id == resource_id && node->expanded) {
+			*encoding = node->expanded;
+			*length = node->expanded_length;
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Expands the links of resource @p index to the resources below it */
+static int rde_expand_node(struct pldm_rde_expand *expand, size_t index)
+{
+	struct rde_expand_node *node = &expand->nodes[index];
+	struct rde_expand_lookup lookup = { expand->nodes, expand->batch.count,
+					    index };
+	const uint8_t *payload = node->reassembly.dest.buffer.data;
+	size_t length;
+	int rc;
+
+	if (expand->batch.items[index].rc) {
+		return expand->batch.items[index].rc;
+	}
+
+	rc = pldm_bej_expand_links(payload, node->reassembly.length,
+				   rde_expand_resolve, &lookup, NULL, 0,
+				   &length);
+	if (rc != -ENOBUFS) {
+		return rc ? rc : -EPROTO;
+	}
+	node->expanded = malloc(length);
+	if (!node->expanded) {
+		return -ENOMEM;
+	}
+	rc = pldm_bej_expand_links(payload, node->reassembly.length,
+				   rde_expand_resolve, &lookup, node->expanded,
+				   length, &node->expanded_length);
+	if (rc) {
+		free(node->expanded);
+		node->expanded = NULL;
+	}
+	return rc;
+}
+
+static void rde_expand_item_done(void *arg, struct pldm_rde_batch *batch,
+				 struct pldm_rde_batch_item *item)
+{
+	struct pldm_rde_expand *expand = arg;
+	struct pldm_rde_batch_item *items = batch->items;
+	struct rde_expand_node *nodes = expand->nodes;
+	uint8_t *buffers = expand->buffers;
+	size_t count = batch->count;
+	int rc = 0;
+
+	(void)item;
+	if (batch->finished != count) {
+		return;
+	}
+
+	// The deepest resources first, so those above take them in whole
+	for (size_t i = count; i-- > 0;) {
+		rc = rde_expand_node(expand, i);
+	}
+
+	expand->nodes = NULL;
+	expand->buffers = NULL;
+	expand->batch.items = NULL;
+	expand->batch.count = 0;
+	expand->done(expand->arg, expand, rc, rc ? NULL : nodes[0].expanded,
+		     rc ? 0 : nodes[0].expanded_length);
+
+	for (size_t i = 0; i < count; i++) {
+		free(nodes[i].expanded);
+	}
+	free(nodes);
+	free(items);
+	free(buffers);
+}
+
+static void rde_expand_release(struct pldm_rde_expand *expand)
+{
+	free(expand->nodes);
+	free(expand->batch.items);
+	free(expand->buffers);
+	expand->nodes = NULL;
+	expand->batch.items = NULL;
+	expand->buffers = NULL;
+	expand->batch.count = 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_expand_start(struct pldm_rde_engine *engine,
+			  struct pldm_rde_expand *expand)
+{
+	struct pldm_rde_batch_item *items;
+	size_t capacity;
+	size_t count;
+	int rc;
+
+	if (!engine || !expand || !expand->manager || !expand->done ||
+	    !expand->resource_size || (!expand->links && expand->link_count) ||
+	    expand->link_count == SIZE_MAX) {
+		return -EINVAL;
+	}
+	if (expand->nodes) {
+		return -EBUSY;
+	}
+
+	capacity = expand->link_count + 1;
+	expand->nodes = calloc(capacity, sizeof(*expand->nodes));
+	if (!expand->nodes) {
+		return -ENOMEM;
+	}
+	count = rde_expand_collect(expand, expand->nodes);
+
+	items = calloc(count, sizeof(*items));
+	expand->batch.items = items;
+	expand->buffers = calloc(count, expand->resource_size);
+	if (!items || !expand->buffers) {
+		rde_expand_release(expand);
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		struct rde_expand_node *node = &expand->nodes[i];
+
+		node->reassembly.type = PLDM_RDE_REASSEMBLY_BUFFER;
+		node->reassembly.dest.buffer.data =
+			expand->buffers + i * expand->resource_size;
+		node->reassembly.dest.buffer.size = expand->resource_size;
+		items[i].resource_id = node->resource_id;
+		items[i].operation_id = expand->operation_id + i;
+		items[i].operation_type = PLDM_RDE_OPERATION_READ;
+		items[i].reassembly = &node->reassembly;
+	}
+
+	expand->batch.manager = expand->manager;
+	expand->batch.tid = expand->tid;
+	expand->batch.count = count;
+	expand->batch.callback = rde_expand_payload;
+	expand->batch.item_done = rde_expand_item_done;
+	expand->batch.arg = expand;
+	rc = pldm_rde_batch_start(engine, &expand->batch);
+	if (rc) {
+		rde_expand_release(expand);
+	}
+	return rc;
+}
+
+LIBPLDM_ABI_TESTING
+bool pldm_rde_expand_running(const struct pldm_rde_expand *expand)
+{
+	return expand && expand->nodes;
+}
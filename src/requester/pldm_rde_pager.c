@@ -0,0 +1,298 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "libpldm/requester/pldm_rde_pager.h"
+
+#include "libpldm/pldm_rde.h"
+#include "libpldm/requester/pldm_rde_engine.h"
+#include "libpldm/requester/pldm_rde_requester.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Holds page (page % depth) from its read until it is handed over */
+struct rde_pager_slot {
+	struct rde_query_options options;
+	struct pldm_rde_reassembly reassembly;
+	struct pldm_rde_requester_context *ctx;
+	uint32_t page;
+	int rc;
+	bool busy;
+	bool ready;
+};
+
+static void rde_pager_done(void *arg,
+			   struct pldm_rde_requester_manager *manager,
+			   struct pldm_rde_requester_context *ctx, int rc);
+
+static uint8_t rde_pager_depth(const struct pldm_rde_pager *pager)
+{
+	return pager->prefetch + 1;
+}
+
+/* Pages land in their slot's reassembly buffer, so there is nothing to do */
+static void rde_pager_payload(struct pldm_rde_requester_manager *manager,
+			      struct pldm_rde_requester_context *ctx,
+			      uint8_t **payload, uint32_t length,
+			      bool has_checksum)
+{
+	(void)manager;
+	(void)ctx;
+	(void)payload;
+	(void)length;
+	(void)has_checksum;
+}
+
+static bool rde_pager_context_free(const struct pldm_rde_requester_context *ctx)
+{
+	return ctx->context_status != CONTEXT_BUSY &&
+	       ctx->current_pdr_resource == NULL && !ctx->operation.active;
+}
+
+static struct pldm_rde_requester_context *
+rde_pager_free_context(struct pldm_rde_pager *pager)
+{
+	struct pldm_rde_requester_manager *manager = pager->manager;
+
+	for (uint8_t i = 0; i < manager->n_ctx; i++) {
+		if (rde_pager_context_free(&manager->ctx[i])) {
+			return &manager->ctx[i];
+		}
+	}
+	return NULL;
+}
+
+/* Whether another page is to be read, once a slot and a context allow it */
+static bool rde_pager_more(const struct pldm_rde_pager *pager)
+{
+	if (pager->stopped ||
+	    (pager->pages && pager->requested >= pager->pages)) {
+		return false;
+	}
+	// $skip cannot reach past the end of its field
+	if (pager->requested > UINT16_MAX / pager->top) {
+		return false;
+	}
+	return pager->skip + pager->requested * pager->top <= UINT16_MAX;
+}
+
+static int rde_pager_submit(struct pldm_rde_pager *pager,
+			    struct rde_pager_slot *slot,
+			    struct pldm_rde_requester_context *ctx)
+{
+	uint8_t depth = rde_pager_depth(pager);
+	union pldm_rde_operation_flags flags = { 0 };
+	int rc;
+
+	flags.bits.contains_custom_request_parameters = 1;
+	memset(&slot->options, 0, sizeof(slot->options));
+	slot->options.skip = true;
+	slot->options.top = true;
+	slot->options.skip_param = pager->skip + slot->page * pager->top;
+	slot->options.top_param = pager->top;
+
+	if (pldm_rde_init_rde_operation_context(
+		    ctx, 0, pager->resource_id,
+		    pager->operation_id + slot->page % depth,
+		    PLDM_RDE_OPERATION_READ, flags.byte, &slot->options, 0, 0,
+		    0, NULL, NULL)) {
+		return -EINVAL;
+	}
+
+	slot->reassembly.type = PLDM_RDE_REASSEMBLY_BUFFER;
+	slot->reassembly.dest.buffer.data =
+		pager->buffers + (slot->page % depth) * pager->page_size;
+	slot->reassembly.dest.buffer.size = pager->page_size;
+	if (pldm_rde_set_operation_reassembly(ctx, &slot->reassembly)) {
+		free_rde_op_init_context(ctx);
+		return -EINVAL;
+	}
+
+	slot->ctx = ctx;
+	pager->in_flight++;
+	rc = pldm_rde_engine_submit(pager->engine, PLDM_RDE_ENGINE_OPERATION,
+				    pager->manager, ctx, pager->tid,
+				    rde_pager_payload, rde_pager_done, pager);
+	if (rc) {
+		pager->in_flight--;
+		slot->ctx = NULL;
+		free_rde_op_init_context(ctx);
+	}
+	return rc;
+}
+
+/* Reads pages ahead for as long as slots and contexts are free */
+static void rde_pager_fill(struct pldm_rde_pager *pager)
+{
+	uint8_t depth = rde_pager_depth(pager);
+
+	while (rde_pager_more(pager) && pager->in_flight < pager->concurrency) {
+		struct rde_pager_slot *slot =
+			&pager->slots[pager->requested % depth];
+		struct pldm_rde_requester_context *ctx;
+		int rc;
+
+		if (slot->busy) {
+			break;
+		}
+		ctx = rde_pager_free_context(pager);
+		if (!ctx) {
+			break;
+		}
+
+		// Claimed before submitting, as the read may end right away
+		slot->page = pager->requested++;
+		slot->busy = true;
+		slot->ready = false;
+		rc = rde_pager_submit(pager, slot, ctx);
+		if (rc) {
+			slot->rc = rc;
+			slot->ready = true;
+		}
+	}
+}
+
+/* Hands over the pages that are next in line and read */
+static void rde_pager_deliver(struct pldm_rde_pager *pager)
+{
+	uint8_t depth = rde_pager_depth(pager);
+
+	for (;;) {
+		struct rde_pager_slot *slot =
+			&pager->slots[pager->delivered % depth];
+		bool more;
+
+		if (!slot->busy || !slot->ready) {
+			return;
+		}
+
+		slot->busy = false;
+		pager->delivered++;
+		if (pager->stopped) {
+			continue;
+		}
+		if (slot->rc) {
+			more = false;
+			pager->page(pager->arg, pager, slot->page, slot->rc,
+				    NULL, 0);
+		} else {
+			more = pager->page(
+				pager->arg, pager, slot->page, 0,
+				slot->reassembly.dest.buffer.data,
+				slot->reassembly.length);
+		}
+		if (!more) {
+			pager->stopped = true;
+		}
+	}
+}
+
+/* Moves the walk on, and ends it once nothing is left to wait for */
+static void rde_pager_advance(struct pldm_rde_pager *pager)
+{
+	pager->nesting++;
+	rde_pager_deliver(pager);
+	rde_pager_fill(pager);
+	rde_pager_deliver(pager);
+	pager->nesting--;
+
+	if (pager->nesting || pager->in_flight ||
+	    pager->delivered != pager->requested || rde_pager_more(pager)) {
+		return;
+	}
+	free(pager->slots);
+	free(pager->buffers);
+	pager->slots = NULL;
+	pager->buffers = NULL;
+}
+
+static void rde_pager_done(void *arg,
+			   struct pldm_rde_requester_manager *manager,
+			   struct pldm_rde_requester_context *ctx, int rc)
+{
+	struct pldm_rde_pager *pager = arg;
+	struct rde_pager_slot *slot = NULL;
+
+	(void)manager;
+	for (uint8_t i = 0; i < rde_pager_depth(pager); i++) {
+		if (pager->slots[i].busy && pager->slots[i].ctx == ctx) {
+			slot = &pager->slots[i];
+			break;
+		}
+	}
+
+	free_rde_op_init_context(ctx);
+	pager->in_flight--;
+	if (slot) {
+		slot->ctx = NULL;
+		slot->rc = rc;
+		slot->ready = true;
+	}
+	if (rc == -ECANCELED && !pager->stopped) {
+		// The engine is going away, so nothing else can be read
+		pager->stopped = true;
+		pager->page(pager->arg, pager, pager->delivered, rc, NULL, 0);
+	}
+	rde_pager_advance(pager);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_pager_start(struct pldm_rde_engine *engine,
+			 struct pldm_rde_pager *pager)
+{
+	struct pldm_rde_requester_manager *manager;
+	uint8_t depth;
+
+	if (!engine || !pager || !pager->manager || !pager->page ||
+	    !pager->top || !pager->page_size ||
+	    pager->prefetch == UINT8_MAX) {
+		return -EINVAL;
+	}
+	manager = pager->manager;
+	if (!manager->initialized || !manager->ctx) {
+		return -EINVAL;
+	}
+	if (pager->slots) {
+		return -EBUSY;
+	}
+	if (!rde_pager_free_context(pager)) {
+		return -EBUSY;
+	}
+
+	depth = rde_pager_depth(pager);
+	pager->slots = calloc(depth, sizeof(*pager->slots));
+	pager->buffers = calloc(depth, pager->page_size);
+	if (!pager->slots || !pager->buffers) {
+		free(pager->slots);
+		free(pager->buffers);
+		pager->slots = NULL;
+		pager->buffers = NULL;
+		return -ENOMEM;
+	}
+
+	// As for pldm_rde_start_dictionary_download()
+	pager->concurrency = manager->device.device_concurrency;
+	if (pager->concurrency == 0) {
+		pager->concurrency = 1;
+	}
+	if (pager->concurrency > manager->mc_concurrency) {
+		pager->concurrency = manager->mc_concurrency;
+	}
+
+	pager->engine = engine;
+	pager->in_flight = 0;
+	pager->requested = 0;
+	pager->delivered = 0;
+	pager->stopped = false;
+	pager->nesting = 0;
+	rde_pager_advance(pager);
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+bool pldm_rde_pager_walking(const struct pldm_rde_pager *pager)
+{
+	return pager && pager->slots;
+}
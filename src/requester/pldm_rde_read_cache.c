@@ -0,0 +1,334 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "libpldm/requester/pldm_rde_read_cache.h"
+
+#include "rde-read-cache.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RDE_READ_CACHE_MIN_BUCKETS 16
+
+/* Context Manager device IDs are at most this long */
+#define RDE_READ_CACHE_NAME_MAX 8
+
+struct rde_read_cache_node {
+	struct rde_read_cache_entry entry;
+	struct rde_read_cache_node *chain;
+	// Least recently used list, most recent first
+	struct rde_read_cache_node *prev;
+	struct rde_read_cache_node *next;
+	size_t hash;
+	size_t size;
+	int net_id;
+	uint32_t resource_id;
+	uint16_t expand_levels;
+	uint16_t skip;
+	uint16_t top;
+	char device_name[RDE_READ_CACHE_NAME_MAX + 1];
+	// The ETag, then the body
+	uint8_t data[];
+};
+
+/*
+ * Entries hash by device and resource only, so that every cached read of a
+ * resource shares a chain and can be dropped together.
+ */
+struct pldm_rde_read_cache {
+	struct rde_read_cache_node **buckets;
+	size_t mask;
+	size_t count;
+	size_t capacity;
+	struct rde_read_cache_node *head;
+	struct rde_read_cache_node *tail;
+	struct pldm_rde_read_cache_stats stats;
+};
+
+static size_t rde_read_cache_hash(int net_id, const char *device_name,
+				  uint32_t resource_id)
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	size_t length = strnlen(device_name, RDE_READ_CACHE_NAME_MAX);
+
+	// FNV-1a over the device ID, then a splitmix64 finalizer
+	for (size_t i = 0; i < length; i++) {
+		hash ^= (uint8_t)device_name[i];
+		hash *= 0x100000001b3ULL;
+	}
+	hash ^= ((uint64_t)(uint32_t)net_id << 32) | resource_id;
+	hash ^= hash >> 30;
+	hash *= 0xbf58476d1ce4e5b9ULL;
+	hash ^= hash >> 27;
+	hash *= 0x94d049bb133111ebULL;
+	hash ^= hash >> 31;
+	return (size_t)hash;
+}
+
+static bool rde_read_cache_same_resource(const struct rde_read_cache_node *node,
+					 int net_id, const char *device_name,
+					 uint32_t resource_id)
+{
+	return node->net_id == net_id && node->resource_id == resource_id &&
+	       !strncmp(node->device_name, device_name,
+			RDE_READ_CACHE_NAME_MAX);
+}
+
+static bool rde_read_cache_same_key(const struct rde_read_cache_node *node,
+				    const struct rde_read_cache_key *key)
+{
+	return rde_read_cache_same_resource(node, key->net_id,
+					    key->device_name,
+					    key->resource_id) &&
+	       node->expand_levels == key->expand_levels &&
+	       node->skip == key->skip && node->top == key->top;
+}
+
+static void rde_read_cache_unlink(struct pldm_rde_read_cache *cache,
+				  struct rde_read_cache_node *node)
+{
+	if (node->prev) {
+		node->prev->next = node->next;
+	} else {
+		cache->head = node->next;
+	}
+	if (node->next) {
+		node->next->prev = node->prev;
+	} else {
+		cache->tail = node->prev;
+	}
+}
+
+static void rde_read_cache_push(struct pldm_rde_read_cache *cache,
+				struct rde_read_cache_node *node)
+{
+	node->prev = NULL;
+	node->next = cache->head;
+	if (cache->head) {
+		cache->head->prev = node;
+	} else {
+		cache->tail = node;
+	}
+	cache->head = node;
+}
+
+static void rde_read_cache_remove(struct pldm_rde_read_cache *cache,
+				  struct rde_read_cache_node *node)
+{
+	struct rde_read_cache_node **link =
+		&cache->buckets[node->hash & cache->mask];
+
+	while (*link != node) {
+		link = &(*link)->chain;
+	}
+	*link = node->chain;
+
+	rde_read_cache_unlink(cache, node);
+	cache->stats.size -= node->size;
+	cache->count--;
+	free(node);
+}
+
+static int rde_read_cache_grow(struct pldm_rde_read_cache *cache)
+{
+	size_t mask = cache->mask * 2 + 1;
+	struct rde_read_cache_node **buckets;
+
+	buckets = calloc(mask + 1, sizeof(*buckets));
+	if (!buckets) {
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i <= cache->mask; i++) {
+		struct rde_read_cache_node *node = cache->buckets[i];
+
+		while (node) {
+			struct rde_read_cache_node *chain = node->chain;
+
+			node->chain = buckets[node->hash & mask];
+			buckets[node->hash & mask] = node;
+			node = chain;
+		}
+	}
+
+	free(cache->buckets);
+	cache->buckets = buckets;
+	cache->mask = mask;
+	return 0;
+}
+
+static struct rde_read_cache_node *
+rde_read_cache_find(struct pldm_rde_read_cache *cache,
+		    const struct rde_read_cache_key *key, size_t hash)
+{
+	struct rde_read_cache_node *node;
+
+	for (node = cache->buckets[hash & cache->mask]; node;
+	     node = node->chain) {
+		if (node->hash == hash && rde_read_cache_same_key(node, key)) {
+			return node;
+		}
+	}
+	return NULL;
+}
+
+const struct rde_read_cache_entry *
+rde_read_cache_lookup(struct pldm_rde_read_cache *cache,
+		      const struct rde_read_cache_key *key)
+{
+	struct rde_read_cache_node *node = rde_read_cache_find(
+		cache, key,
+		rde_read_cache_hash(key->net_id, key->device_name,
+				    key->resource_id));
+
+	if (!node) {
+		return NULL;
+	}
+	rde_read_cache_unlink(cache, node);
+	rde_read_cache_push(cache, node);
+	return &node->entry;
+}
+
+int rde_read_cache_store(struct pldm_rde_read_cache *cache,
+			 const struct rde_read_cache_key *key, const char *etag,
+			 const uint8_t *body, uint32_t length)
+{
+	size_t hash = rde_read_cache_hash(key->net_id, key->device_name,
+					  key->resource_id);
+	size_t etag_size = strlen(etag) + 1;
+	size_t size = sizeof(struct rde_read_cache_node) + etag_size + length;
+	struct rde_read_cache_node *node;
+
+	// The previous response is outdated whether or not this one fits
+	node = rde_read_cache_find(cache, key, hash);
+	if (node) {
+		rde_read_cache_remove(cache, node);
+	}
+
+	if (size > cache->capacity) {
+		return -ENOSPC;
+	}
+	if (cache->count >= cache->mask + 1 && rde_read_cache_grow(cache)) {
+		return -ENOMEM;
+	}
+
+	node = malloc(size);
+	if (!node) {
+		return -ENOMEM;
+	}
+	memset(node, 0, sizeof(*node));
+	node->hash = hash;
+	node->size = size;
+	node->net_id = key->net_id;
+	node->resource_id = key->resource_id;
+	node->expand_levels = key->expand_levels;
+	node->skip = key->skip;
+	node->top = key->top;
+	strncpy(node->device_name, key->device_name, RDE_READ_CACHE_NAME_MAX);
+	memcpy(node->data, etag, etag_size);
+	if (length) {
+		memcpy(node->data + etag_size, body, length);
+	}
+	node->entry.etag = (const char *)node->data;
+	node->entry.body = node->data + etag_size;
+	node->entry.length = length;
+
+	while (cache->tail && cache->stats.size + size > cache->capacity) {
+		rde_read_cache_remove(cache, cache->tail);
+		cache->stats.evictions++;
+	}
+
+	node->chain = cache->buckets[node->hash & cache->mask];
+	cache->buckets[node->hash & cache->mask] = node;
+	rde_read_cache_push(cache, node);
+	cache->stats.size += size;
+	cache->stats.stores++;
+	cache->count++;
+	return 0;
+}
+
+void rde_read_cache_hit(struct pldm_rde_read_cache *cache)
+{
+	cache->stats.hits++;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_read_cache_init(struct pldm_rde_read_cache **cache,
+			     size_t capacity)
+{
+	struct pldm_rde_read_cache *new;
+
+	if (!cache || *cache || capacity == 0) {
+		return -EINVAL;
+	}
+
+	new = calloc(1, sizeof(*new));
+	if (!new) {
+		return -ENOMEM;
+	}
+	new->buckets = calloc(RDE_READ_CACHE_MIN_BUCKETS,
+			      sizeof(*new->buckets));
+	if (!new->buckets) {
+		free(new);
+		return -ENOMEM;
+	}
+	new->mask = RDE_READ_CACHE_MIN_BUCKETS - 1;
+	new->capacity = capacity;
+
+	*cache = new;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_rde_read_cache_destroy(struct pldm_rde_read_cache *cache)
+{
+	struct rde_read_cache_node *node;
+
+	if (!cache) {
+		return;
+	}
+
+	while ((node = cache->head)) {
+		cache->head = node->next;
+		free(node);
+	}
+	free(cache->buckets);
+	free(cache);
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_rde_read_cache_invalidate(struct pldm_rde_read_cache *cache,
+				    int net_id, const char *device_name,
+				    uint32_t resource_id)
+{
+	struct rde_read_cache_node *node;
+	struct rde_read_cache_node *chain;
+	size_t hash;
+
+	if (!cache || !device_name) {
+		return;
+	}
+
+	hash = rde_read_cache_hash(net_id, device_name, resource_id);
+	for (node = cache->buckets[hash & cache->mask]; node; node = chain) {
+		chain = node->chain;
+		if (node->hash == hash &&
+		    rde_read_cache_same_resource(node, net_id, device_name,
+						 resource_id)) {
+			rde_read_cache_remove(cache, node);
+		}
+	}
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_read_cache_stats(struct pldm_rde_read_cache *cache,
+			      struct pldm_rde_read_cache_stats *stats)
+{
+	if (!cache || !stats) {
+		return -EINVAL;
+	}
+	*stats = cache->stats;
+	return 0;
+}
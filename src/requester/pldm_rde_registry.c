@@ -0,0 +1,436 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "libpldm/requester/pldm_rde_registry.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RDE_REGISTRY_MIN_SLOTS 16
+
+/* The devices exposing one resource ID */
+struct rde_registry_bucket {
+	uint32_t resource_id;
+	bool used;
+	size_t count;
+	size_t capacity;
+	struct pldm_rde_registry_device **devices;
+};
+
+/*
+ * Both tables use open addressing with linear probing, sized to a power of
+ * two and kept at most three quarters full. Buckets stay in place once a
+ * resource ID has been seen, so the device arrays they hold are reused when a
+ * device comes back.
+ */
+struct pldm_rde_registry {
+	struct pldm_rde_registry_device **devices;
+	size_t devices_mask;
+	size_t count;
+	struct rde_registry_bucket *buckets;
+	size_t buckets_mask;
+	size_t buckets_used;
+};
+
+static size_t rde_registry_device_hash(int net_id, uint8_t endpoint)
+{
+	uint64_t key = ((uint64_t)(uint32_t)net_id << 8) | endpoint;
+
+	// splitmix64 finalizer
+	key ^= key >> 30;
+	key *= 0xbf58476d1ce4e5b9ULL;
+	key ^= key >> 27;
+	key *= 0x94d049bb133111ebULL;
+	key ^= key >> 31;
+	return (size_t)key;
+}
+
+static size_t rde_registry_resource_hash(uint32_t resource_id)
+{
+	// murmur3 finalizer
+	resource_id ^= resource_id >> 16;
+	resource_id *= 0x85ebca6bU;
+	resource_id ^= resource_id >> 13;
+	resource_id *= 0xc2b2ae35U;
+	resource_id ^= resource_id >> 16;
+	return resource_id;
+}
+
+static bool rde_registry_over_load(size_t used, size_t mask)
+{
+	return (used + 1) * 4 > (mask + 1) * 3;
+}
+
+static size_t rde_registry_device_slot(struct pldm_rde_registry *registry,
+				       int net_id, uint8_t endpoint)
+{
+	size_t slot = rde_registry_device_hash(net_id, endpoint) &
+		      registry->devices_mask;
+	struct pldm_rde_registry_device *device;
+
+	while ((device = registry->devices[slot]) &&
+	       (device->net_id != net_id || device->endpoint != endpoint)) {
+		slot = (slot + 1) & registry->devices_mask;
+	}
+	return slot;
+}
+
+static int rde_registry_grow_devices(struct pldm_rde_registry *registry)
+{
+	size_t slots = (registry->devices_mask + 1) * 2;
+	struct pldm_rde_registry_device **old = registry->devices;
+	size_t old_slots = registry->devices_mask + 1;
+
+	registry->devices = calloc(slots, sizeof(*registry->devices));
+	if (!registry->devices) {
+		registry->devices = old;
+		return -ENOMEM;
+	}
+	registry->devices_mask = slots - 1;
+
+	for (size_t i = 0; i < old_slots; i++) {
+		if (old[i]) {
+			registry->devices[rde_registry_device_slot(
+				registry, old[i]->net_id, old[i]->endpoint)] =
+				old[i];
+		}
+	}
+	free(old);
+	return 0;
+}
+
+static struct rde_registry_bucket *
+rde_registry_bucket_slot(struct rde_registry_bucket *buckets, size_t mask,
+			 uint32_t resource_id)
+{
+	size_t slot = rde_registry_resource_hash(resource_id) & mask;
+
+	while (buckets[slot].used && buckets[slot].resource_id != resource_id) {
+		slot = (slot + 1) & mask;
+	}
+	return &buckets[slot];
+}
+
+static int rde_registry_grow_buckets(struct pldm_rde_registry *registry)
+{
+	size_t slots = (registry->buckets_mask + 1) * 2;
+	struct rde_registry_bucket *buckets;
+
+	buckets = calloc(slots, sizeof(*buckets));
+	if (!buckets) {
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i <= registry->buckets_mask; i++) {
+		struct rde_registry_bucket *bucket = &registry->buckets[i];
+
+		if (bucket->used) {
+			*rde_registry_bucket_slot(buckets, slots - 1,
+						  bucket->resource_id) =
+				*bucket;
+		}
+	}
+	free(registry->buckets);
+	registry->buckets = buckets;
+	registry->buckets_mask = slots - 1;
+	return 0;
+}
+
+static int rde_registry_index(struct pldm_rde_registry *registry,
+			      struct pldm_rde_registry_device *device,
+			      const uint32_t *resource_ids, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		struct rde_registry_bucket *bucket = rde_registry_bucket_slot(
+			registry->buckets, registry->buckets_mask,
+			resource_ids[i]);
+
+		if (!bucket->used) {
+			if (rde_registry_over_load(registry->buckets_used,
+						   registry->buckets_mask)) {
+				if (rde_registry_grow_buckets(registry)) {
+					return -ENOMEM;
+				}
+				bucket = rde_registry_bucket_slot(
+					registry->buckets,
+					registry->buckets_mask,
+					resource_ids[i]);
+			}
+			bucket->used = true;
+			bucket->resource_id = resource_ids[i];
+			registry->buckets_used++;
+		}
+
+		// Devices are only ever appended during one call, so a
+		// duplicate ID finds the device last
+		if (bucket->count &&
+		    bucket->devices[bucket->count - 1] == device) {
+			continue;
+		}
+
+		if (bucket->count == bucket->capacity) {
+			size_t capacity = bucket->capacity ? bucket->capacity * 2
+							   : 4;
+			struct pldm_rde_registry_device **devices;
+
+			devices = realloc(bucket->devices,
+					  capacity * sizeof(*devices));
+			if (!devices) {
+				return -ENOMEM;
+			}
+			bucket->devices = devices;
+			bucket->capacity = capacity;
+		}
+		bucket->devices[bucket->count++] = device;
+	}
+	return 0;
+}
+
+static void rde_registry_unindex(struct pldm_rde_registry *registry,
+				 struct pldm_rde_registry_device *device,
+				 const uint32_t *resource_ids, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		struct rde_registry_bucket *bucket = rde_registry_bucket_slot(
+			registry->buckets, registry->buckets_mask,
+			resource_ids[i]);
+
+		for (size_t j = 0; j < bucket->count; j++) {
+			if (bucket->devices[j] == device) {
+				bucket->devices[j] =
+					bucket->devices[--bucket->count];
+				break;
+			}
+		}
+	}
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_registry_init(struct pldm_rde_registry **registry)
+{
+	struct pldm_rde_registry *new;
+
+	if (!registry || *registry) {
+		return -EINVAL;
+	}
+
+	new = calloc(1, sizeof(*new));
+	if (!new) {
+		return -ENOMEM;
+	}
+	new->devices = calloc(RDE_REGISTRY_MIN_SLOTS, sizeof(*new->devices));
+	new->buckets = calloc(RDE_REGISTRY_MIN_SLOTS, sizeof(*new->buckets));
+	if (!new->devices || !new->buckets) {
+		free(new->devices);
+		free(new->buckets);
+		free(new);
+		return -ENOMEM;
+	}
+	new->devices_mask = RDE_REGISTRY_MIN_SLOTS - 1;
+	new->buckets_mask = RDE_REGISTRY_MIN_SLOTS - 1;
+
+	*registry = new;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_rde_registry_destroy(struct pldm_rde_registry *registry)
+{
+	if (!registry) {
+		return;
+	}
+
+	for (size_t i = 0; i <= registry->devices_mask; i++) {
+		if (registry->devices[i]) {
+			free(registry->devices[i]->resource_ids);
+			free(registry->devices[i]);
+		}
+	}
+	for (size_t i = 0; i <= registry->buckets_mask; i++) {
+		free(registry->buckets[i].devices);
+	}
+	free(registry->devices);
+	free(registry->buckets);
+	free(registry);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_registry_add(struct pldm_rde_registry *registry, int net_id,
+			  uint8_t endpoint,
+			  struct pldm_rde_requester_manager *manager, void *data,
+			  struct pldm_rde_registry_device **device)
+{
+	struct pldm_rde_registry_device *new;
+	size_t slot;
+
+	if (!registry) {
+		return -EINVAL;
+	}
+
+	slot = rde_registry_device_slot(registry, net_id, endpoint);
+	if (registry->devices[slot]) {
+		return -EEXIST;
+	}
+
+	if (rde_registry_over_load(registry->count, registry->devices_mask)) {
+		if (rde_registry_grow_devices(registry)) {
+			return -ENOMEM;
+		}
+		slot = rde_registry_device_slot(registry, net_id, endpoint);
+	}
+
+	new = calloc(1, sizeof(*new));
+	if (!new) {
+		return -ENOMEM;
+	}
+	new->net_id = net_id;
+	new->endpoint = endpoint;
+	new->manager = manager;
+	new->data = data;
+
+	registry->devices[slot] = new;
+	registry->count++;
+
+	if (manager && manager->number_of_resources) {
+		int rc = pldm_rde_registry_set_resources(
+			registry, new, manager->resource_ids,
+			manager->number_of_resources);
+		if (rc) {
+			pldm_rde_registry_remove(registry, net_id, endpoint);
+			return rc;
+		}
+	}
+
+	if (device) {
+		*device = new;
+	}
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_registry_remove(struct pldm_rde_registry *registry, int net_id,
+			     uint8_t endpoint)
+{
+	struct pldm_rde_registry_device *device;
+	size_t hole;
+	size_t slot;
+
+	if (!registry) {
+		return -EINVAL;
+	}
+
+	hole = rde_registry_device_slot(registry, net_id, endpoint);
+	device = registry->devices[hole];
+	if (!device) {
+		return -ENOENT;
+	}
+
+	rde_registry_unindex(registry, device, device->resource_ids,
+			     device->number_of_resources);
+	free(device->resource_ids);
+	free(device);
+	registry->devices[hole] = NULL;
+	registry->count--;
+
+	// Shift the rest of the probe sequence back over the hole
+	slot = hole;
+	for (;;) {
+		size_t home;
+
+		slot = (slot + 1) & registry->devices_mask;
+		device = registry->devices[slot];
+		if (!device) {
+			break;
+		}
+
+		home = rde_registry_device_hash(device->net_id,
+						device->endpoint) &
+		       registry->devices_mask;
+		// Leave entries whose home lies cyclically in (hole, slot]
+		if (((slot - home) & registry->devices_mask) <
+		    ((slot - hole) & registry->devices_mask)) {
+			continue;
+		}
+		registry->devices[hole] = device;
+		registry->devices[slot] = NULL;
+		hole = slot;
+	}
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+struct pldm_rde_registry_device *
+pldm_rde_registry_find(struct pldm_rde_registry *registry, int net_id,
+		       uint8_t endpoint)
+{
+	if (!registry) {
+		return NULL;
+	}
+	return registry->devices[rde_registry_device_slot(registry, net_id,
+							  endpoint)];
+}
+
+LIBPLDM_ABI_TESTING
+size_t pldm_rde_registry_count(struct pldm_rde_registry *registry)
+{
+	return registry ? registry->count : 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_rde_registry_set_resources(struct pldm_rde_registry *registry,
+				    struct pldm_rde_registry_device *device,
+				    const uint32_t *resource_ids, size_t count)
+{
+	uint32_t *copy = NULL;
+	int rc;
+
+	if (!registry || !device || (count && !resource_ids)) {
+		return -EINVAL;
+	}
+	if (count > SIZE_MAX / sizeof(*copy)) {
+		return -EINVAL;
+	}
+
+	if (count) {
+		copy = malloc(count * sizeof(*copy));
+		if (!copy) {
+			return -ENOMEM;
+		}
+		memcpy(copy, resource_ids, count * sizeof(*copy));
+	}
+
+	rde_registry_unindex(registry, device, device->resource_ids,
+			     device->number_of_resources);
+	rc = rde_registry_index(registry, device, copy, count);
+	if (rc) {
+		// The old entries fit where they were, so this cannot fail
+		rde_registry_unindex(registry, device, copy, count);
+		rde_registry_index(registry, device, device->resource_ids,
+				   device->number_of_resources);
+		free(copy);
+		return rc;
+	}
+
+	free(device->resource_ids);
+	device->resource_ids = copy;
+	device->number_of_resources = count;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+size_t pldm_rde_registry_find_resource(
+	struct pldm_rde_registry *registry, uint32_t resource_id,
+	struct pldm_rde_registry_device *const **devices)
+{
+	struct rde_registry_bucket *bucket;
+
+	if (!registry || !devices) {
+		return 0;
+	}
+
+	bucket = rde_registry_bucket_slot(registry->buckets,
+					  registry->buckets_mask, resource_id);
+	*devices = bucket->devices;
+	return bucket->used ? bucket->count : 0;
+}
@@ -2,10 +2,46 @@
 
 #include "libpldm/base.h"
 #include "libpldm/pldm.h"
-
-#include <stdio.h>
+#include "libpldm/utils.h"
+
+#include "rde-dictionary-cache.h"
+#include "rde-read-cache.h"
+#include "requester-stats.h"
+#include "trace.h"
+
+#include <endian.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+
+static atomic_ulong rde_allocations;
+
+static void rde_count_allocation(void)
+{
+	atomic_fetch_add_explicit(&rde_allocations, 1, memory_order_relaxed);
+}
+
+static void *rde_malloc(size_t size)
+{
+	rde_count_allocation();
+	return malloc(size);
+}
+
+static void *rde_realloc(void *ptr, size_t size)
+{
+	rde_count_allocation();
+	return realloc(ptr, size);
+}
+
+LIBPLDM_ABI_TESTING
+unsigned long pldm_rde_requester_allocations(void)
+{
+	return atomic_load_explicit(&rde_allocations, memory_order_relaxed);
+}
 
 LIBPLDM_ABI_STABLE
 pldm_rde_requester_rc_t
@@ -15,8 +51,11 @@ free_op_context_after_dictionary_extraction(struct pldm_rde_requester_context *c
 
 	if (current_pdr_resource != NULL)
 	{
-		fprintf(stderr, "Cleaning Dictionary PDR Object\n");
+		pldm_trace(PLDM_TRACE_DEBUG, PLDM_TRACE_RDE_REQUESTER,
+			   "Cleaning Dictionary PDR Object\n");
+		free(current_pdr_resource->dictionary);
 		free(current_pdr_resource);
+		ctx->current_pdr_resource = NULL;
 	}
 	return PLDM_RDE_REQUESTER_SUCCESS;
 }
@@ -31,31 +70,45 @@ pldm_rde_init_context(const char *device_id, int net_id,
 			  uint8_t number_of_ctx),
 		      void (*free_requester_ctx)(void *ctx_memory))
 {
-	fprintf(stdout, "Initializing Context Manager...\n");
+	pldm_trace(PLDM_TRACE_INFO, PLDM_TRACE_RDE_REQUESTER,
+		   "Initializing Context Manager...\n");
 	if (manager == NULL) {
-		fprintf(stderr, "Memory not allocated to context manager.\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+			   "Memory not allocated to context manager.\n");
 		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
 	}
 
 	if ((device_id == NULL) || (strlen(device_id) == 0) ||
 	    (strlen(device_id) > 8)) {
-		fprintf(stderr, "Incorrect device id provided\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+			   "Incorrect device id provided\n");
 		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
 	}
 
 	if ((alloc_requester_ctx == NULL) || (free_requester_ctx == NULL)) {
-		fprintf(stderr, "No callback functions for handling request "
-				"contexts found.\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+			   "No callback functions for handling request "
+			   "contexts found.\n");
 		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
 	}
 
 	manager->initialized = true;
+	manager->n_ctx = mc_concurrency;
 	manager->mc_concurrency = mc_concurrency;
 	manager->mc_transfer_size = mc_transfer_size;
 	manager->mc_feature_support = mc_features;
 	strcpy(manager->device_name, device_id);
 	manager->net_id = net_id;
 	manager->number_of_resources = 0;
+	manager->dictionary_cache_dir = NULL;
+	manager->dictionary_cache_callback = NULL;
+	manager->dictionary_download_scheduled = false;
+	manager->next_dictionary_index = 0;
+	manager->dictionary_downloads_in_flight = 0;
+	manager->read_cache = NULL;
+	manager->coalesce_reads = false;
+	manager->multipart_receive_retries = 0;
+	manager->stats = NULL;
 
 	manager->ctx = alloc_requester_ctx(mc_concurrency);
 
@@ -70,15 +123,18 @@ pldm_rde_set_resources_in_context(
 		      uint8_t number_of_resources,
 		      uint32_t *resource_id_address)
 {
-	fprintf(stdout, "Setting Resource IDs in Context Manager...\n");
+	pldm_trace(PLDM_TRACE_INFO, PLDM_TRACE_RDE_REQUESTER,
+		   "Setting Resource IDs in Context Manager...\n");
 	if (manager == NULL) {
-		fprintf(stderr, "Memory not allocated to context manager.\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+			   "Memory not allocated to context manager.\n");
 		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
 	}
 
 	if (resource_id_address == NULL)
 	{
-		fprintf(stderr, "Memory not allocated to resource id array.\n");
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+			   "Memory not allocated to resource id array.\n");
 		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
 	}
 
@@ -90,6 +146,91 @@ pldm_rde_set_resources_in_context(
 	return PLDM_RDE_REQUESTER_SUCCESS;
 }
 
+LIBPLDM_ABI_TESTING
+pldm_rde_requester_rc_t
+pldm_rde_set_dictionary_cache(struct pldm_rde_requester_manager *manager,
+			      const char *cache_dir, callback_funct callback)
+{
+	if (manager == NULL || (cache_dir != NULL && callback == NULL)) {
+		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+	}
+
+	manager->dictionary_cache_dir = cache_dir;
+	manager->dictionary_cache_callback = callback;
+	return PLDM_RDE_REQUESTER_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+pldm_rde_requester_rc_t
+pldm_rde_set_read_cache(struct pldm_rde_requester_manager *manager,
+			struct pldm_rde_read_cache *cache)
+{
+	if (manager == NULL) {
+		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+	}
+
+	manager->read_cache = cache;
+	return PLDM_RDE_REQUESTER_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+pldm_rde_requester_rc_t
+pldm_rde_set_read_coalescing(struct pldm_rde_requester_manager *manager,
+			     bool enable)
+{
+	if (manager == NULL) {
+		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+	}
+
+	manager->coalesce_reads = enable;
+	return PLDM_RDE_REQUESTER_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+pldm_rde_requester_rc_t
+pldm_rde_set_multipart_receive_retries(
+	struct pldm_rde_requester_manager *manager, uint8_t retries)
+{
+	if (manager == NULL) {
+		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+	}
+
+	manager->multipart_receive_retries = retries;
+	return PLDM_RDE_REQUESTER_SUCCESS;
+}
+
+LIBPLDM_ABI_TESTING
+pldm_rde_requester_rc_t
+pldm_rde_set_stats(struct pldm_rde_requester_manager *manager,
+		   struct pldm_requester_stats *stats)
+{
+	if (manager == NULL || !manager->initialized) {
+		return PLDM_RDE_CONTEXT_NOT_READY;
+	}
+	manager->stats = stats;
+	for (uint8_t i = 0; manager->ctx && i < manager->n_ctx; i++) {
+		manager->ctx[i].stats_sample.pending = false;
+	}
+	return PLDM_RDE_REQUESTER_SUCCESS;
+}
+
+static void rde_stats_request(struct pldm_rde_requester_manager *manager,
+			      struct pldm_rde_requester_context *ctx,
+			      const struct pldm_msg *request)
+{
+	size_t length;
+
+	if (!manager->stats) {
+		return;
+	}
+	// The request was just encoded, so it is its own bound
+	if (pldm_rde_request_length(request, SIZE_MAX, &length)) {
+		length = sizeof(struct pldm_msg_hdr);
+	}
+	requester_stats_request(manager->stats, &ctx->stats_sample, request,
+				length);
+}
+
 LIBPLDM_ABI_STABLE
 pldm_rde_requester_rc_t
 pldm_rde_start_discovery(struct pldm_rde_requester_context *ctx)
@@ -111,6 +252,10 @@ pldm_rde_create_context(struct pldm_rde_requester_context *ctx)
 	ctx->context_status = CONTEXT_FREE;
 	ctx->next_command = PLDM_RDE_REQUESTER_NO_NEXT_COMMAND_FOUND;
 	ctx->requester_status = PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
+	ctx->current_pdr_resource = NULL;
+	ctx->operation_ctx = NULL;
+	ctx->operation.active = false;
+	ctx->stats_sample.pending = false;
 	return PLDM_RDE_REQUESTER_SUCCESS;
 }
 
@@ -144,9 +289,11 @@ pldm_rde_requester_rc_t pldm_rde_get_next_discovery_command(
 		rc = PLDM_RDE_REQUESTER_NO_NEXT_COMMAND_FOUND;
 	}
 	if (rc) {
-		fprintf(stderr, "Unable to encode request with rc: %d\n", rc);
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+			   "Unable to encode request with rc: %d\n", rc);
 		return PLDM_RDE_REQUESTER_ENCODING_REQUEST_FAILURE;
 	}
+	rde_stats_request(manager, current_ctx, request);
 	return PLDM_RDE_REQUESTER_SUCCESS;
 }
 
@@ -157,6 +304,9 @@ pldm_rde_discovery_push_response(struct pldm_rde_requester_manager *manager,
 				 void *resp_msg, size_t resp_size)
 {
 	int rc = 0;
+
+	requester_stats_response(manager->stats, &ctx->stats_sample, resp_msg,
+				 resp_size);
 	switch (ctx->next_command) {
 	case PLDM_NEGOTIATE_REDFISH_PARAMETERS: {
 		uint8_t completion_code = DEFAULT_INIT;
@@ -166,6 +316,17 @@ pldm_rde_discovery_push_response(struct pldm_rde_requester_manager *manager,
 		if (rc || completion_code) {
 			ctx->requester_status =
 			    PLDM_RDE_REQUESTER_REQUEST_FAILED;
+		} else if (manager->dictionary_cache_dir != NULL) {
+			// Drop dictionaries cached for a previous configuration
+			rc = rde_dictionary_cache_validate(
+			    manager->dictionary_cache_dir, manager->device_name,
+			    &manager->device);
+			if (rc) {
+				pldm_trace(PLDM_TRACE_ERROR,
+					   PLDM_TRACE_RDE_REQUESTER,
+					   "Unable to validate dictionary cache: %d\n",
+					   rc);
+			}
 		}
 		ctx->next_command = PLDM_NEGOTIATE_MEDIUM_PARAMETERS;
 		ctx->context_status = CONTEXT_FREE;
@@ -202,6 +363,25 @@ pldm_rde_discovery_push_response(struct pldm_rde_requester_manager *manager,
 	}
 }
 
+static pldm_rde_requester_rc_t
+rde_init_dictionary_context(struct pldm_rde_requester_context *ctx,
+			    uint8_t resource_id_index)
+{
+	struct pdr_resource *current_pdr_resource =
+	    (struct pdr_resource *)rde_malloc(sizeof(struct pdr_resource));
+	if (current_pdr_resource == NULL) {
+		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+	}
+	ctx->next_command = PLDM_GET_SCHEMA_DICTIONARY;
+	ctx->current_pdr_resource = current_pdr_resource;
+	current_pdr_resource->resource_id_index = resource_id_index;
+	current_pdr_resource->schema_class = PLDM_RDE_SCHEMA_MAJOR;
+	current_pdr_resource->dictionary = NULL;
+	current_pdr_resource->dictionary_length = 0;
+	ctx->requester_status = PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
+	return PLDM_RDE_REQUESTER_SUCCESS;
+}
+
 LIBPLDM_ABI_STABLE
 pldm_rde_requester_rc_t
 pldm_rde_init_get_dictionary_schema(struct pldm_rde_requester_context *ctx)
@@ -209,17 +389,197 @@ pldm_rde_init_get_dictionary_schema(struct pldm_rde_requester_context *ctx)
 	if (ctx->context_status == CONTEXT_BUSY) {
 		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
 	}
-	ctx->next_command = PLDM_GET_SCHEMA_DICTIONARY;
-	struct pdr_resource *current_pdr_resource =
-	    (struct pdr_resource *)malloc(sizeof(struct pdr_resource));
-	ctx->current_pdr_resource = current_pdr_resource;
 	// start with 0th index of resource id array
-	current_pdr_resource->resource_id_index = 0;
-	current_pdr_resource->schema_class = PLDM_RDE_SCHEMA_MAJOR;
-	ctx->requester_status = PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
+	return rde_init_dictionary_context(ctx, 0);
+}
+
+/*
+ * Picks the resource a context fetches after its current one. Scheduled
+ * downloads share a cursor across all contexts, otherwise a context walks the
+ * resource list on its own.
+ */
+static uint8_t
+rde_next_dictionary_index(struct pldm_rde_requester_manager *manager,
+			  struct pdr_resource *resource)
+{
+	if (!manager->dictionary_download_scheduled) {
+		return resource->resource_id_index + 1;
+	}
+	if (manager->next_dictionary_index < manager->number_of_resources) {
+		return manager->next_dictionary_index++;
+	}
+	return manager->number_of_resources;
+}
+
+LIBPLDM_ABI_TESTING
+pldm_rde_requester_rc_t
+pldm_rde_start_dictionary_download(struct pldm_rde_requester_manager *manager,
+				   uint8_t *contexts_started)
+{
+	uint8_t concurrency;
+	uint8_t started = 0;
+
+	if (manager == NULL || contexts_started == NULL ||
+	    !manager->initialized || manager->ctx == NULL) {
+		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+	}
+	if (manager->number_of_resources == 0) {
+		return PLDM_RDE_NO_PDR_RESOURCES_FOUND;
+	}
+	if (manager->dictionary_download_scheduled) {
+		return PLDM_RDE_CONTEXT_NOT_READY;
+	}
+
+	// A device that has not been negotiated with gets a single chain
+	concurrency = manager->device.device_concurrency;
+	if (concurrency == 0) {
+		concurrency = 1;
+	}
+	if (concurrency > manager->mc_concurrency) {
+		concurrency = manager->mc_concurrency;
+	}
+
+	manager->next_dictionary_index = 0;
+	for (uint8_t i = 0; i < manager->n_ctx && started < concurrency &&
+			    manager->next_dictionary_index <
+				manager->number_of_resources;
+	     i++) {
+		struct pldm_rde_requester_context *ctx = &manager->ctx[i];
+
+		if (ctx->context_status == CONTEXT_BUSY ||
+		    ctx->current_pdr_resource != NULL ||
+		    ctx->operation.active) {
+			continue;
+		}
+
+		if (rde_init_dictionary_context(
+			ctx, manager->next_dictionary_index)) {
+			break;
+		}
+		manager->next_dictionary_index++;
+		started++;
+	}
+
+	*contexts_started = started;
+	if (started == 0) {
+		return PLDM_RDE_CONTEXT_NOT_READY;
+	}
+
+	manager->dictionary_download_scheduled = true;
+	manager->dictionary_downloads_in_flight = started;
 	return PLDM_RDE_REQUESTER_SUCCESS;
 }
 
+static void
+rde_finish_dictionary_extraction(struct pldm_rde_requester_manager *manager,
+				 struct pldm_rde_requester_context *ctx)
+{
+	ctx->next_command = PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
+	ctx->current_pdr_resource->transfer_operation = PLDM_XFER_COMPLETE;
+	ctx->requester_status = PLDM_RDE_REQUESTER_NO_PENDING_ACTION;
+	ctx->context_status = CONTEXT_FREE;
+	free_op_context_after_dictionary_extraction(ctx);
+
+	if (manager->dictionary_download_scheduled &&
+	    --manager->dictionary_downloads_in_flight == 0) {
+		manager->dictionary_download_scheduled = false;
+	}
+}
+
+static void
+rde_dictionary_cache_key_init(struct rde_dictionary_cache_key *key,
+			      struct pldm_rde_requester_manager *manager,
+			      struct pdr_resource *resource)
+{
+	key->cache_dir = manager->dictionary_cache_dir;
+	key->device_name = manager->device_name;
+	key->device = &manager->device;
+	key->resource_id = manager->resource_ids[resource->resource_id_index];
+	key->schema_class = resource->schema_class;
+}
+
+/*
+ * Hands every cached dictionary from the current resource index onwards to the
+ * cache callback, stopping at the first resource that must be fetched from the
+ * device. Returns true if no resources are left to fetch.
+ */
+static bool
+rde_serve_cached_dictionaries(struct pldm_rde_requester_manager *manager,
+			      struct pldm_rde_requester_context *ctx)
+{
+	struct pdr_resource *resource = ctx->current_pdr_resource;
+	struct rde_dictionary_cache_key key;
+	uint32_t length;
+	uint8_t *dictionary;
+	uint8_t *payload;
+
+	if (manager->dictionary_cache_dir == NULL) {
+		return false;
+	}
+
+	while (resource->resource_id_index < manager->number_of_resources) {
+		rde_dictionary_cache_key_init(&key, manager, resource);
+		if (rde_dictionary_cache_load(&key, &dictionary, &length)) {
+			return false;
+		}
+		rde_count_allocation();
+
+		payload = dictionary;
+		manager->dictionary_cache_callback(manager, ctx, &payload,
+						   length, true);
+		free(dictionary);
+
+		resource->resource_id_index =
+		    rde_next_dictionary_index(manager, resource);
+		resource->schema_class = PLDM_RDE_SCHEMA_MAJOR;
+	}
+
+	return true;
+}
+
+/*
+ * Appends a MultipartReceive chunk to the dictionary being collected for the
+ * cache. Collection restarts on every START chunk and is abandoned if a chunk
+ * does not fit in the response, so only complete transfers are ever stored.
+ */
+static void rde_collect_dictionary_chunk(struct pdr_resource *resource,
+					 uint8_t transfer_flag,
+					 const uint8_t *payload,
+					 uint32_t length, size_t available)
+{
+	uint8_t *dictionary;
+
+	if ((transfer_flag == PLDM_RDE_START) ||
+	    (transfer_flag == PLDM_RDE_START_AND_END)) {
+		free(resource->dictionary);
+		resource->dictionary = NULL;
+		resource->dictionary_length = 0;
+	} else if (resource->dictionary == NULL) {
+		return;
+	}
+
+	if ((length > available) ||
+	    (length > UINT32_MAX - resource->dictionary_length)) {
+		goto abandon;
+	}
+
+	dictionary = rde_realloc(resource->dictionary,
+			     resource->dictionary_length + length + 1);
+	if (dictionary == NULL) {
+		goto abandon;
+	}
+
+	memcpy(dictionary + resource->dictionary_length, payload, length);
+	resource->dictionary = dictionary;
+	resource->dictionary_length += length;
+	return;
+
+abandon:
+	free(resource->dictionary);
+	resource->dictionary = NULL;
+	resource->dictionary_length = 0;
+}
+
 LIBPLDM_ABI_STABLE
 pldm_rde_requester_rc_t pldm_rde_get_next_dictionary_schema_command(
     uint8_t instance_id, struct pldm_rde_requester_manager *manager,
@@ -239,6 +599,10 @@ pldm_rde_requester_rc_t pldm_rde_get_next_dictionary_schema_command(
 	int rc = 0;
 	switch (current_ctx->next_command) {
 	case PLDM_GET_SCHEMA_DICTIONARY: {
+		if (rde_serve_cached_dictionaries(manager, current_ctx)) {
+			rde_finish_dictionary_extraction(manager, current_ctx);
+			return PLDM_RDE_DICTIONARY_CACHE_HIT;
+		}
 		uint32_t resource_id =
 		    current_ctx->current_pdr_resource->resource_id_index;
 		rc = encode_get_schema_dictionary_req(
@@ -258,32 +622,32 @@ pldm_rde_requester_rc_t pldm_rde_get_next_dictionary_schema_command(
 		break;
 	}
 	if (rc) {
-		fprintf(stderr, "Unable to encode request with rc: %d\n", rc);
+		pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+			   "Unable to encode request with rc: %d\n", rc);
 		return PLDM_RDE_REQUESTER_ENCODING_REQUEST_FAILURE;
 	}
+	rde_stats_request(manager, current_ctx, request);
 	return rc;
 }
 
 int set_next_dictionary_index(struct pldm_rde_requester_manager *manager,
 			      struct pldm_rde_requester_context *ctx)
 {
-	uint8_t new_rid_idx = ctx->current_pdr_resource->resource_id_index + 1;
-
-	if (new_rid_idx == manager->number_of_resources) {
-		fprintf(stdout,
-			"Processed all resources for dictionaries: %x \n",
-			(uint8_t)new_rid_idx);
-		ctx->next_command =
-		    PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
-		ctx->current_pdr_resource->transfer_operation =
-		    PLDM_XFER_COMPLETE;
-		ctx->requester_status = PLDM_RDE_REQUESTER_NO_PENDING_ACTION;
-		ctx->context_status = CONTEXT_FREE;
-		free_op_context_after_dictionary_extraction(ctx);
+	uint8_t new_rid_idx =
+	    rde_next_dictionary_index(manager, ctx->current_pdr_resource);
+
+	if (new_rid_idx >= manager->number_of_resources) {
+		pldm_trace(PLDM_TRACE_INFO, PLDM_TRACE_RDE_REQUESTER,
+			   "Processed all resources for dictionaries: %x \n",
+			   (uint8_t)new_rid_idx);
+		rde_finish_dictionary_extraction(manager, ctx);
 	} else {
 		ctx->next_command = PLDM_GET_SCHEMA_DICTIONARY;
 		ctx->current_pdr_resource->resource_id_index = new_rid_idx;
 		ctx->current_pdr_resource->schema_class = PLDM_RDE_SCHEMA_MAJOR;
+		free(ctx->current_pdr_resource->dictionary);
+		ctx->current_pdr_resource->dictionary = NULL;
+		ctx->current_pdr_resource->dictionary_length = 0;
 		ctx->requester_status =
 		    PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
 	}
@@ -297,6 +661,9 @@ pldm_rde_requester_rc_t pldm_rde_push_get_dictionary_response(
     callback_funct callback)
 {
 	int rc = 0;
+
+	requester_stats_response(manager->stats, &ctx->stats_sample, resp_msg,
+				 resp_size);
 	switch (ctx->next_command) {
 	case PLDM_GET_SCHEMA_DICTIONARY: {
 		uint8_t completion_code = DEFAULT_INIT;
@@ -336,6 +703,19 @@ pldm_rde_requester_rc_t pldm_rde_push_get_dictionary_response(
 			set_next_dictionary_index(manager, ctx);
 			break;
 		}
+		if (manager->dictionary_cache_dir != NULL) {
+			// The END chunk carries the dictionary checksum, which
+			// is kept so cache hits replay the same bytes
+			size_t offset =
+			    sizeof(struct pldm_msg_hdr) +
+			    offsetof(struct pldm_rde_multipart_receive_resp,
+				     payload);
+			size_t available =
+			    resp_size > offset ? resp_size - offset : 0;
+			rde_collect_dictionary_chunk(
+			    ctx->current_pdr_resource, ret_transfer_flag,
+			    payload, data_length_bytes, available);
+		}
 		if ((ret_transfer_flag == PLDM_RDE_START) ||
 		    (ret_transfer_flag == PLDM_RDE_MIDDLE)) {
 			// Call the callback method to send back response
@@ -353,6 +733,20 @@ pldm_rde_requester_rc_t pldm_rde_push_get_dictionary_response(
 			   (ret_transfer_flag == PLDM_RDE_END)) {
 			callback(manager, ctx, &payload, data_length_bytes,
 				 true);
+			if (ctx->current_pdr_resource->dictionary != NULL) {
+				struct rde_dictionary_cache_key key;
+				rde_dictionary_cache_key_init(
+				    &key, manager, ctx->current_pdr_resource);
+				rc = rde_dictionary_cache_store(
+				    &key, ctx->current_pdr_resource->dictionary,
+				    ctx->current_pdr_resource->dictionary_length);
+				if (rc) {
+					pldm_trace(PLDM_TRACE_ERROR,
+						   PLDM_TRACE_RDE_REQUESTER,
+						   "Unable to cache dictionary: %d\n",
+						   rc);
+				}
+			}
 			// find the next resource id from the resource id array
 			// if exists
 			set_next_dictionary_index(manager, ctx);
@@ -364,6 +758,107 @@ pldm_rde_requester_rc_t pldm_rde_push_get_dictionary_response(
 	return rc;
 }
 
+static void rde_read_cache_key_init(struct rde_read_cache_key *key,
+				    struct pldm_rde_requester_manager *manager,
+				    const struct rde_operation *operation)
+{
+	const struct rde_query_options *options = operation->query_options;
+
+	memset(key, 0, sizeof(*key));
+	key->net_id = manager->net_id;
+	key->device_name = manager->device_name;
+	key->resource_id = operation->resource_id;
+	// $skip and $top select different members even without $expand
+	if (options != NULL) {
+		key->expand_levels = options->expand_levels;
+		key->skip = options->skip_param;
+		key->top = options->top_param;
+	}
+}
+
+static void rde_read_cache_release(struct rde_operation *operation)
+{
+	free(operation->cache_body);
+	operation->cache_body = NULL;
+	operation->cache_body_length = 0;
+}
+
+/*
+ * Decides whether an operation about to start goes through the read cache.
+ * Reads of a cached resource become If-None-Match requests for the cached
+ * ETag, while any other operation may change the resource and drops its
+ * cached reads.
+ */
+static void rde_read_cache_prepare(struct pldm_rde_requester_manager *manager,
+				   struct rde_operation *operation)
+{
+	struct rde_query_options *options = operation->query_options;
+	const struct rde_read_cache_entry *entry;
+	struct rde_read_cache_key key;
+	uint8_t *body = NULL;
+
+	if (manager->read_cache == NULL || operation->cache_revalidate) {
+		return;
+	}
+	if (operation->operation_type != PLDM_RDE_OPERATION_READ) {
+		pldm_rde_read_cache_invalidate(manager->read_cache,
+					       manager->net_id,
+					       manager->device_name,
+					       operation->resource_id);
+		return;
+	}
+	if (operation->operation_locator_length ||
+	    (options != NULL && (options->etag_count || options->header_count))) {
+		return;
+	}
+
+	operation->cache_fill = true;
+	rde_read_cache_key_init(&key, manager, operation);
+	entry = rde_read_cache_lookup(manager->read_cache, &key);
+	if (entry == NULL) {
+		return;
+	}
+
+	// Other reads may evict the entry before the device answers, so the
+	// body served on a match is kept with the operation
+	if (entry->length) {
+		body = rde_realloc(operation->cache_body, entry->length);
+		if (body == NULL) {
+			return;
+		}
+		memcpy(body, entry->body, entry->length);
+		operation->cache_body = body;
+	}
+	operation->cache_body_length = entry->length;
+
+	if (options == NULL) {
+		options = &operation->query_options_data;
+		memset(options, 0, sizeof(*options));
+		operation->query_options = options;
+	}
+	strncpy(operation->cache_etag, entry->etag,
+		sizeof(operation->cache_etag) - 1);
+	options->etag_operation = PLDM_RDE_ETAG_IF_NONE_MATCH;
+	options->etag_count = 1;
+	options->etag_formats[0] = PLDM_RDE_VARSTRING_UTF_8;
+	options->etags[0] = operation->cache_etag;
+	operation->operation_flags.bits.contains_custom_request_parameters = 1;
+	operation->cache_revalidate = true;
+}
+
+/*
+ * Stops an operation taking part in read coalescing before its record is
+ * reused. Reads that joined it are left to pldm_rde_abandon_coalesced_reads().
+ */
+static void rde_coalesce_detach(struct rde_operation *operation)
+{
+	if (operation->coalesce_leader != NULL) {
+		operation->coalesce_leader->operation.coalesce_followers--;
+		operation->coalesce_leader = NULL;
+	}
+	operation->coalesce_open = false;
+}
+
 LIBPLDM_ABI_STABLE
 pldm_rde_requester_rc_t pldm_rde_init_rde_operation_context(
 	struct pldm_rde_requester_context *ctx, uint8_t request_id,
@@ -378,8 +873,12 @@ pldm_rde_requester_rc_t pldm_rde_init_rde_operation_context(
 	}
 	ctx->next_command = PLDM_RDE_OPERATION_INIT;
 
-	struct rde_operation *operation =
-		(struct rde_operation *)malloc(sizeof(struct rde_operation));
+	struct rde_operation *operation = &ctx->operation;
+	if (operation->active) {
+		rde_read_cache_release(operation);
+		rde_coalesce_detach(operation);
+	}
+	memset(operation, 0, sizeof(*operation));
 	operation->request_id = request_id;
 	operation->resource_id = resource_id;
 	operation->operation_id = operation_id;
@@ -394,41 +893,220 @@ pldm_rde_requester_rc_t pldm_rde_init_rde_operation_context(
 	operation->operation_locator_length = operation_locator_length;
 	operation->request_payload_length = request_payload_length;
 	operation->send_data_transfer_handle = send_data_transfer_handle;
+	operation->multipart_send = false;
+	operation->send_transfer_handle = send_data_transfer_handle;
+	operation->send_offset = 0;
+	operation->send_chunk_length = 0;
+	operation->reassembly = NULL;
 	operation->resp_permission_flags =
-		(union pldm_rde_permission_flags *)malloc(
-			sizeof(union pldm_rde_permission_flags));
-	operation->resp_operation_flags =
-		(union pldm_rde_op_execution_flags *)malloc(
-			sizeof(union pldm_rde_op_execution_flags));
+		&operation->resp_permission_flags_data;
+	operation->resp_operation_flags = &operation->resp_operation_flags_data;
 	if (request_payload != NULL) {
 		operation->request_payload = request_payload;
 	}
     operation->query_options = NULL;
     if (operation->operation_flags.bits.contains_custom_request_parameters &&
-        query_options && query_options->expand == true) {
-        // This is freed in free_rde_op_init_context in all success/error
-        // conditions
-        operation->query_options =
-            (struct rde_query_options *) malloc(sizeof(struct rde_query_options));
-        operation->query_options->expand = true;
-        operation->query_options->skip_param = query_options->skip_param;
-        operation->query_options->top_param = query_options->top_param;
-        operation->query_options->etag_count = query_options->etag_count;
-        operation->query_options->header_count = query_options->header_count;
-        for (uint8_t i = 0; i < query_options->etag_count; i++) {
-            operation->query_options->etags[i] = query_options->etags[i];
-        }
-        for (uint8_t i = 0; i < query_options->header_count; i++) {
-            operation->query_options->hdrnames[i] = query_options->hdrnames[i];
-            operation->query_options->hdrparams[i] = query_options->hdrparams[i];
-        }
-        operation->query_options->expand_levels = query_options->expand_levels;
+        query_options) {
+        operation->query_options_data = *query_options;
+        operation->query_options = &operation->query_options_data;
     }
-	ctx->operation_ctx = operation;
+	operation->active = true;
 	ctx->requester_status = PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
 	return PLDM_RDE_REQUESTER_SUCCESS;
 }
 
+LIBPLDM_ABI_TESTING
+pldm_rde_requester_rc_t
+pldm_rde_set_operation_reassembly(struct pldm_rde_requester_context *ctx,
+				  struct pldm_rde_reassembly *reassembly)
+{
+	struct rde_operation *operation;
+
+	if (ctx == NULL || !ctx->operation.active) {
+		return PLDM_RDE_CONTEXT_NOT_READY;
+	}
+	operation = &ctx->operation;
+
+	if (reassembly != NULL) {
+		switch (reassembly->type) {
+		case PLDM_RDE_REASSEMBLY_BUFFER:
+			if (reassembly->dest.buffer.size &&
+			    reassembly->dest.buffer.data == NULL) {
+				return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+			}
+			break;
+		case PLDM_RDE_REASSEMBLY_IOVEC:
+			if (reassembly->dest.iovec.iovcnt < 0 ||
+			    (reassembly->dest.iovec.iovcnt &&
+			     reassembly->dest.iovec.iov == NULL)) {
+				return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+			}
+			break;
+		case PLDM_RDE_REASSEMBLY_FD:
+			if (reassembly->dest.file.fd < 0 ||
+			    reassembly->dest.file.offset < 0) {
+				return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+			}
+			break;
+		default:
+			return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+		}
+	}
+
+	operation->reassembly = reassembly;
+	return PLDM_RDE_REQUESTER_SUCCESS;
+}
+
+/*
+ * Bytes of payload that fit in a message of the negotiated transfer size
+ * after the PLDM header and the command's fixed fields.
+ */
+static uint32_t
+rde_transfer_payload_budget(struct pldm_rde_requester_manager *manager,
+			    uint32_t fixed_size)
+{
+	uint32_t overhead = sizeof(struct pldm_msg_hdr) + fixed_size;
+
+	if (manager->negotiated_transfer_size == 0) {
+		return UINT32_MAX;
+	}
+	return manager->negotiated_transfer_size > overhead
+		   ? manager->negotiated_transfer_size - overhead
+		   : 0;
+}
+
+static int rde_encode_multipart_send(uint8_t instance_id,
+				     struct pldm_rde_requester_manager *manager,
+				     struct rde_operation *operation,
+				     struct pldm_msg *request)
+{
+	uint32_t budget = rde_transfer_payload_budget(
+		manager, PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE);
+	uint32_t remaining =
+		operation->request_payload_length - operation->send_offset;
+	uint32_t checksum = 0;
+	uint32_t length;
+	uint8_t transfer_flag;
+	bool last;
+
+	if (budget <= sizeof(checksum)) {
+		return PLDM_ERROR_INVALID_LENGTH;
+	}
+
+	// Fill every chunk, keeping room for the checksum in the last one
+	if (remaining <= budget - sizeof(checksum)) {
+		length = remaining;
+		last = true;
+	} else if (remaining > budget) {
+		length = budget;
+		last = false;
+	} else {
+		length = budget - sizeof(checksum);
+		last = false;
+	}
+
+	if (operation->send_offset == 0) {
+		transfer_flag = last ? PLDM_RDE_START_AND_END : PLDM_RDE_START;
+	} else {
+		transfer_flag = last ? PLDM_RDE_END : PLDM_RDE_MIDDLE;
+	}
+
+	// Chunks sent again, as the device asks, are already in the checksum
+	if (operation->send_offset == 0) {
+		pldm_crc32_init(&operation->send_crc);
+		operation->send_crc_length = 0;
+	}
+	if (length && operation->request_payload &&
+	    operation->send_crc_length == operation->send_offset) {
+		pldm_crc32_update(&operation->send_crc,
+				  operation->request_payload +
+					  operation->send_offset,
+				  length);
+		operation->send_crc_length += length;
+	}
+	if (last) {
+		checksum = pldm_crc32_final(&operation->send_crc);
+	}
+
+	operation->send_chunk_length = length;
+	return encode_rde_multipart_send_req(
+		instance_id, operation->send_transfer_handle,
+		operation->operation_id, transfer_flag,
+		last ? PLD_RDE_NULL_TRANSFER_HANDLE
+		     : operation->send_transfer_handle + 1,
+		length, last, checksum,
+		operation->request_payload
+			? operation->request_payload + operation->send_offset
+			: NULL,
+		request);
+}
+
+/*
+ * Reads carrying nothing of their own beyond the resource, locator and
+ * $expand parameters return the same result, so one can answer the others.
+ */
+static bool rde_coalesce_eligible(const struct rde_operation *operation)
+{
+	const struct rde_query_options *options = operation->query_options;
+
+	return operation->operation_type == PLDM_RDE_OPERATION_READ &&
+	       operation->request_payload_length == 0 &&
+	       (options == NULL ||
+		(options->etag_count == 0 && options->header_count == 0));
+}
+
+static bool rde_coalesce_same_read(const struct rde_operation *a,
+				   const struct rde_operation *b)
+{
+	const struct rde_query_options *x = a->query_options;
+	const struct rde_query_options *y = b->query_options;
+
+	if (a->resource_id != b->resource_id ||
+	    a->operation_locator_length != b->operation_locator_length ||
+	    (x == NULL) != (y == NULL)) {
+		return false;
+	}
+	if (a->operation_locator_length != 0 &&
+	    memcmp(a->operation_locator, b->operation_locator,
+		   a->operation_locator_length)) {
+		return false;
+	}
+	return x == NULL ||
+	       (x->expand_levels == y->expand_levels &&
+		x->skip_param == y->skip_param && x->top_param == y->top_param);
+}
+
+/*
+ * Joins the read on @p ctx to an identical one already sent on another of
+ * the manager's contexts. Returns true if it joined one.
+ */
+static bool rde_coalesce_attach(struct pldm_rde_requester_manager *manager,
+				struct pldm_rde_requester_context *ctx)
+{
+	struct rde_operation *operation = &ctx->operation;
+
+	if (!manager->coalesce_reads || manager->ctx == NULL ||
+	    !rde_coalesce_eligible(operation)) {
+		return false;
+	}
+
+	for (uint8_t i = 0; i < manager->n_ctx; i++) {
+		struct pldm_rde_requester_context *leader = &manager->ctx[i];
+
+		if (leader == ctx || !leader->operation.active ||
+		    !leader->operation.coalesce_open ||
+		    leader->operation.coalesce_followers == UINT8_MAX ||
+		    !rde_coalesce_same_read(&leader->operation, operation)) {
+			continue;
+		}
+		operation->coalesce_leader = leader;
+		leader->operation.coalesce_followers++;
+		ctx->requester_status = PLDM_RDE_REQUESTER_WAITING_FOR_RESPONSE;
+		return true;
+	}
+	return false;
+}
+
 LIBPLDM_ABI_STABLE
 pldm_rde_requester_rc_t
 pldm_rde_get_next_rde_operation(uint8_t instance_id,
@@ -448,10 +1126,40 @@ pldm_rde_get_next_rde_operation(uint8_t instance_id,
 	}
 
 	int rc = 0;
-	struct rde_operation *operation_ctx =
-		(struct rde_operation *)current_ctx->operation_ctx;
+	struct rde_operation *operation_ctx = &current_ctx->operation;
 	switch (current_ctx->next_command) {
 	case PLDM_RDE_OPERATION_INIT: {
+		uint32_t request_payload_length =
+			operation_ctx->request_payload_length;
+		uint8_t *request_payload = operation_ctx->request_payload;
+
+		if (operation_ctx->coalesce_leader != NULL ||
+		    rde_coalesce_attach(manager, current_ctx)) {
+			return PLDM_RDE_OPERATION_COALESCED;
+		}
+
+		// Payloads too large for RDEOperationInit follow in
+		// RDEMultipartSend once the device asks for them
+		operation_ctx->multipart_send =
+			request_payload_length >
+			rde_transfer_payload_budget(
+				manager, PLDM_RDE_OPERATION_INIT_REQ_HDR_SIZE +
+						 operation_ctx
+							 ->operation_locator_length);
+		rde_read_cache_prepare(manager, operation_ctx);
+		// Reads revalidating a cached body may get nothing back
+		operation_ctx->coalesce_open =
+			manager->coalesce_reads &&
+			rde_coalesce_eligible(operation_ctx);
+
+		if (operation_ctx->multipart_send) {
+			request_payload_length = 0;
+			request_payload = NULL;
+			if (operation_ctx->send_data_transfer_handle ==
+			    PLD_RDE_NULL_TRANSFER_HANDLE) {
+				operation_ctx->send_data_transfer_handle = 1;
+			}
+		}
 		rc = encode_rde_operation_init_req(
 			instance_id, operation_ctx->resource_id,
 			operation_ctx->operation_id,
@@ -459,14 +1167,14 @@ pldm_rde_get_next_rde_operation(uint8_t instance_id,
 			&(operation_ctx->operation_flags),
 			operation_ctx->send_data_transfer_handle,
 			operation_ctx->operation_locator_length,
-			operation_ctx->request_payload_length,
-			operation_ctx->operation_locator,
-			operation_ctx->request_payload, request);
+			request_payload_length,
+			operation_ctx->operation_locator, request_payload,
+			request);
 		break;
 	}
     case PLDM_SUPPLY_CUSTOM_REQUEST_PARAMETERS: {
         if(operation_ctx->operation_flags.bits.contains_custom_request_parameters) {
-            if (operation_ctx->query_options->expand) {
+            if (operation_ctx->query_options) {
 
                 rc = encode_supply_custom_request_parameters_req(
                     instance_id, operation_ctx->resource_id,
@@ -477,7 +1185,9 @@ pldm_rde_get_next_rde_operation(uint8_t instance_id,
                     0, request);
                 if (rc != PLDM_SUCCESS)
                 {
-                    fprintf(stderr, "Encoding of suppy custom req failed : %u\n", rc);
+                    pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+                               "Encoding of supply custom req failed : %u\n",
+                               rc);
                     return rc;
                 }
 
@@ -489,7 +1199,9 @@ pldm_rde_get_next_rde_operation(uint8_t instance_id,
                     operation_ctx->query_options->etags, &offset, request);
                 if (rc != PLDM_SUCCESS)
                 {
-                    fprintf(stderr, "Encoding of suppy custom req failed : %u\n", rc);
+                    pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+                               "Encoding of supply custom req failed : %u\n",
+                               rc);
                     return rc;
                 }
 
@@ -501,7 +1213,9 @@ pldm_rde_get_next_rde_operation(uint8_t instance_id,
                     operation_ctx->query_options->hdrparams, &offset, request);
                 if (rc != PLDM_SUCCESS)
                 {
-                    fprintf(stderr, "Encoding of suppy custom req failed : %u\n", rc);
+                    pldm_trace(PLDM_TRACE_ERROR, PLDM_TRACE_RDE_REQUESTER,
+                               "Encoding of supply custom req failed : %u\n",
+                               rc);
                     return rc;
                 }
             }
@@ -528,25 +1242,520 @@ pldm_rde_get_next_rde_operation(uint8_t instance_id,
 			operation_ctx->transfer_operation, request);
 		break;
 	}
+	case PLDM_RDE_MULTIPART_SEND: {
+		rc = rde_encode_multipart_send(instance_id, manager,
+					       operation_ctx, request);
+		break;
+	}
+	}
+	if (rc == PLDM_SUCCESS) {
+		rde_stats_request(manager, current_ctx, request);
 	}
 	return rc;
 }
 
+static void rde_reassembly_reset(struct pldm_rde_reassembly *reassembly,
+				 uint32_t transfer_handle)
+{
+	reassembly->length = 0;
+	pldm_crc32_init(&reassembly->checksum);
+	reassembly->transfer_handle = transfer_handle;
+	reassembly->iov_index = 0;
+	reassembly->iov_offset = 0;
+}
+
+static int rde_reassembly_write_iovec(struct pldm_rde_reassembly *reassembly,
+				      const uint8_t *data, size_t length)
+{
+	const struct iovec *iov;
+	size_t room;
+	size_t n;
+
+	while (length) {
+		if (reassembly->iov_index >= reassembly->dest.iovec.iovcnt) {
+			return -EOVERFLOW;
+		}
+		iov = &reassembly->dest.iovec.iov[reassembly->iov_index];
+		room = iov->iov_len - reassembly->iov_offset;
+		n = length < room ? length : room;
+		if (n) {
+			memcpy((uint8_t *)iov->iov_base + reassembly->iov_offset,
+			       data, n);
+		}
+		data += n;
+		length -= n;
+		reassembly->iov_offset += n;
+		if (reassembly->iov_offset == iov->iov_len) {
+			reassembly->iov_index++;
+			reassembly->iov_offset = 0;
+		}
+	}
+
+	return 0;
+}
+
+static int rde_reassembly_write_fd(struct pldm_rde_reassembly *reassembly,
+				   const uint8_t *data, size_t length)
+{
+	off_t offset;
+	ssize_t put;
+
+	if (length > reassembly->dest.file.size - reassembly->length) {
+		return -EOVERFLOW;
+	}
+
+	offset = reassembly->dest.file.offset + (off_t)reassembly->length;
+	while (length) {
+		put = pwrite(reassembly->dest.file.fd, data, length, offset);
+		if (put < 0 && errno == EINTR) {
+			continue;
+		}
+		if (put < 0) {
+			return -errno;
+		}
+		data += put;
+		length -= put;
+		offset += put;
+	}
+
+	return 0;
+}
+
+/*
+ * Write payload bytes at the current end of the reassembled data and fold
+ * them into the running checksum.
+ */
+static int rde_reassembly_land(struct pldm_rde_reassembly *reassembly,
+			       const uint8_t *data, size_t length)
+{
+	int rc = 0;
+
+	if (length == 0) {
+		return 0;
+	}
+
+	switch (reassembly->type) {
+	case PLDM_RDE_REASSEMBLY_BUFFER:
+		if (length >
+		    reassembly->dest.buffer.size - reassembly->length) {
+			return -EOVERFLOW;
+		}
+		memcpy(reassembly->dest.buffer.data + reassembly->length, data,
+		       length);
+		break;
+	case PLDM_RDE_REASSEMBLY_IOVEC:
+		rc = rde_reassembly_write_iovec(reassembly, data, length);
+		break;
+	case PLDM_RDE_REASSEMBLY_FD:
+		rc = rde_reassembly_write_fd(reassembly, data, length);
+		break;
+	default:
+		return -EINVAL;
+	}
+	if (rc) {
+		return rc;
+	}
+
+	pldm_crc32_update(&reassembly->checksum, data, length);
+	reassembly->length += length;
+	return 0;
+}
+
+/*
+ * Land one MultipartReceive chunk. The chunk must answer the transfer handle
+ * the previous one pointed at, and must point past it: a chunk naming the
+ * handle it was asked for is the answer to an earlier request. The final
+ * chunk's trailing checksum must match the CRC-32 accumulated over the whole
+ * payload.
+ */
+static int rde_reassemble_chunk(struct rde_operation *operation,
+				uint8_t transfer_flag, uint32_t next_handle,
+				const uint8_t *payload, uint32_t length,
+				size_t available)
+{
+	struct pldm_rde_reassembly *reassembly = operation->reassembly;
+	bool first = transfer_flag == PLDM_RDE_START ||
+		     transfer_flag == PLDM_RDE_START_AND_END;
+	bool last = transfer_flag == PLDM_RDE_END ||
+		    transfer_flag == PLDM_RDE_START_AND_END;
+	uint32_t checksum = 0;
+	int rc;
+
+	if (length > available) {
+		return -EPROTO;
+	}
+
+	if (first != (operation->transfer_operation == PLDM_XFER_FIRST_PART)) {
+		return -EPROTO;
+	}
+	if (first) {
+		rde_reassembly_reset(reassembly,
+				     operation->result_transfer_handle);
+	} else if (operation->result_transfer_handle !=
+		   reassembly->transfer_handle) {
+		return -EPROTO;
+	}
+
+	if (!last && next_handle == reassembly->transfer_handle) {
+		return -EPROTO;
+	}
+
+	if (last) {
+		if (length < sizeof(checksum)) {
+			return -EPROTO;
+		}
+		length -= sizeof(checksum);
+		memcpy(&checksum, payload + length, sizeof(checksum));
+		checksum = le32toh(checksum);
+	}
+
+	rc = rde_reassembly_land(reassembly, payload, length);
+	if (rc) {
+		return rc;
+	}
+
+	if (last && pldm_crc32_final(&reassembly->checksum) != checksum) {
+		return -EBADMSG;
+	}
+
+	reassembly->transfer_handle = next_handle;
+	return 0;
+}
+
+static void rde_reassembly_notify(struct pldm_rde_requester_manager *manager,
+				  struct pldm_rde_requester_context *ctx,
+				  struct pldm_rde_reassembly *reassembly,
+				  callback_funct callback)
+{
+	uint8_t *payload = NULL;
+
+	if (reassembly->type == PLDM_RDE_REASSEMBLY_BUFFER) {
+		payload = reassembly->dest.buffer.data;
+	}
+	callback(manager, ctx, &payload, reassembly->length, false);
+}
+
+static struct pldm_rde_requester_context *
+rde_coalesce_next(struct pldm_rde_requester_manager *manager,
+		  struct pldm_rde_requester_context *leader, uint8_t *i)
+{
+	if (leader->operation.coalesce_followers == 0) {
+		return NULL;
+	}
+
+	while (*i < manager->n_ctx) {
+		struct pldm_rde_requester_context *ctx = &manager->ctx[(*i)++];
+
+		if (ctx->operation.active &&
+		    ctx->operation.coalesce_leader == leader) {
+			return ctx;
+		}
+	}
+	return NULL;
+}
+
+static void rde_coalesce_finish(struct pldm_rde_requester_context *ctx,
+				bool failed)
+{
+	ctx->operation.coalesce_leader->operation.coalesce_followers--;
+	ctx->operation.coalesce_leader = NULL;
+	ctx->next_command = PLDM_RDE_REQUESTER_NO_NEXT_COMMAND_FOUND;
+	ctx->context_status = CONTEXT_FREE;
+	ctx->requester_status = failed ? PLDM_RDE_REQUESTER_REQUEST_FAILED
+				       : PLDM_RDE_REQUESTER_NO_PENDING_ACTION;
+}
+
+/* Hands a result returned inline to the reads that joined @p ctx's */
+static void rde_coalesce_forward_inline(struct pldm_rde_requester_manager *manager,
+					struct pldm_rde_requester_context *ctx,
+					callback_funct callback)
+{
+	struct rde_operation *operation = &ctx->operation;
+	struct pldm_rde_requester_context *follower;
+	uint8_t i = 0;
+
+	while ((follower = rde_coalesce_next(manager, ctx, &i))) {
+		struct pldm_rde_reassembly *reassembly =
+			follower->operation.reassembly;
+		uint8_t *payload = operation->response_data;
+
+		if (reassembly == NULL) {
+			callback(manager, follower, &payload,
+				 operation->resp_payload_length, false);
+		} else {
+			rde_reassembly_reset(reassembly, 0);
+			if (rde_reassembly_land(reassembly, payload,
+						operation->resp_payload_length)) {
+				rde_coalesce_finish(follower, true);
+				continue;
+			}
+			rde_reassembly_notify(manager, follower, reassembly,
+					      callback);
+		}
+		rde_coalesce_finish(follower, false);
+	}
+}
+
+/*
+ * Hands a MultipartReceive chunk to the reads that joined @p ctx's, before
+ * @p ctx moves on to the next one. Reads landing the result in a
+ * reassembly destination check the chunk sequence and checksum themselves.
+ */
+static void rde_coalesce_forward_chunk(struct pldm_rde_requester_manager *manager,
+				       struct pldm_rde_requester_context *ctx,
+				       callback_funct callback,
+				       uint8_t transfer_flag,
+				       uint32_t next_handle, uint8_t *payload,
+				       uint32_t length, size_t available)
+{
+	struct rde_operation *operation = &ctx->operation;
+	bool last = transfer_flag == PLDM_RDE_END ||
+		    transfer_flag == PLDM_RDE_START_AND_END;
+	struct pldm_rde_requester_context *follower;
+	uint8_t i = 0;
+
+	while ((follower = rde_coalesce_next(manager, ctx, &i))) {
+		struct rde_operation *joined = &follower->operation;
+		uint8_t *data = payload;
+
+		if (joined->reassembly == NULL) {
+			callback(manager, follower, &data, length, last);
+		} else {
+			joined->transfer_operation =
+				operation->transfer_operation;
+			joined->result_transfer_handle =
+				operation->result_transfer_handle;
+			if (rde_reassemble_chunk(joined, transfer_flag,
+						 next_handle, payload, length,
+						 available)) {
+				rde_coalesce_finish(follower, true);
+				continue;
+			}
+			if (last) {
+				rde_reassembly_notify(manager, follower,
+						      joined->reassembly,
+						      callback);
+			}
+		}
+		if (last) {
+			rde_coalesce_finish(follower, false);
+		}
+	}
+}
+
+/*
+ * A read that got to its end without handing its result on leaves the reads
+ * that joined it with nothing to wait for.
+ */
+static void rde_coalesce_settle(struct pldm_rde_requester_manager *manager,
+				struct pldm_rde_requester_context *ctx)
+{
+	struct pldm_rde_requester_context *follower;
+	uint8_t i = 0;
+
+	if (!ctx->operation.active ||
+	    ((int8_t)ctx->requester_status !=
+		     PLDM_RDE_REQUESTER_REQUEST_FAILED &&
+	     ctx->next_command != PLDM_RDE_OPERATION_COMPLETE &&
+	     ctx->next_command != PLDM_RDE_REQUESTER_NO_NEXT_COMMAND_FOUND)) {
+		return;
+	}
+
+	ctx->operation.coalesce_open = false;
+	while ((follower = rde_coalesce_next(manager, ctx, &i))) {
+		rde_coalesce_finish(follower, true);
+	}
+}
+
+LIBPLDM_ABI_TESTING
+pldm_rde_requester_rc_t
+pldm_rde_abandon_coalesced_reads(struct pldm_rde_requester_manager *manager,
+				 struct pldm_rde_requester_context *ctx)
+{
+	struct pldm_rde_requester_context *follower;
+	uint8_t i = 0;
+
+	if (manager == NULL || ctx == NULL) {
+		return PLDM_RDE_CONTEXT_INITIALIZATION_ERROR;
+	}
+	if (!ctx->operation.active) {
+		return PLDM_RDE_REQUESTER_SUCCESS;
+	}
+
+	ctx->operation.coalesce_open = false;
+	while ((follower = rde_coalesce_next(manager, ctx, &i))) {
+		rde_coalesce_finish(follower, true);
+	}
+	return PLDM_RDE_REQUESTER_SUCCESS;
+}
+
+/*
+ * Keeps the ETag of a read's response, which only lives as long as the
+ * response does. Without one the read cannot be revalidated, so it is not
+ * cached. Returns true if the read is still to be cached.
+ */
+static bool rde_read_cache_capture_etag(struct rde_operation *operation)
+{
+	const struct pldm_rde_varstring *etag = operation->resp_etag;
+	size_t length;
+
+	if (etag == NULL) {
+		operation->cache_fill = false;
+		return false;
+	}
+
+	length = strnlen((const char *)etag->string_data,
+			 etag->string_length_bytes);
+	if (length >= sizeof(operation->cache_etag)) {
+		length = sizeof(operation->cache_etag) - 1;
+	}
+	memcpy(operation->cache_etag, etag->string_data, length);
+	operation->cache_etag[length] = '\0';
+	operation->cache_fill = length != 0;
+	return operation->cache_fill;
+}
+
+static void rde_read_cache_fill(struct pldm_rde_requester_manager *manager,
+				struct rde_operation *operation,
+				const uint8_t *body, uint32_t length)
+{
+	struct rde_read_cache_key key;
+	int rc;
+
+	rde_read_cache_key_init(&key, manager, operation);
+	rc = rde_read_cache_store(manager->read_cache, &key,
+				  operation->cache_etag, body, length);
+	if (rc && rc != -ENOSPC) {
+		pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE_REQUESTER,
+			   "Unable to cache read: %d\n", rc);
+	}
+}
+
+/*
+ * Collects a MultipartReceive chunk of a read to cache. Reads landing in a
+ * reassembly buffer are cached from there instead.
+ */
+static void rde_read_cache_collect(struct rde_operation *operation,
+				   uint8_t transfer_flag, const uint8_t *payload,
+				   uint32_t length, size_t available)
+{
+	bool last = transfer_flag == PLDM_RDE_END ||
+		    transfer_flag == PLDM_RDE_START_AND_END;
+	uint8_t *body;
+
+	if (operation->reassembly != NULL &&
+	    operation->reassembly->type == PLDM_RDE_REASSEMBLY_BUFFER) {
+		return;
+	}
+	if ((transfer_flag == PLDM_RDE_START) ||
+	    (transfer_flag == PLDM_RDE_START_AND_END)) {
+		operation->cache_body_length = 0;
+		pldm_crc32_init(&operation->cache_crc);
+	}
+	if (length > available ||
+	    length > UINT32_MAX - operation->cache_body_length ||
+	    (last && length < sizeof(uint32_t))) {
+		operation->cache_fill = false;
+		rde_read_cache_release(operation);
+		return;
+	}
+	if (length == 0) {
+		return;
+	}
+
+	body = rde_realloc(operation->cache_body,
+			   operation->cache_body_length + length);
+	if (body == NULL) {
+		operation->cache_fill = false;
+		rde_read_cache_release(operation);
+		return;
+	}
+	memcpy(body + operation->cache_body_length, payload, length);
+	operation->cache_body = body;
+	operation->cache_body_length += length;
+	// The checksum is taken while the chunk is at hand, short of its own
+	// trailing copy
+	pldm_crc32_update(&operation->cache_crc, payload,
+			  last ? length - sizeof(uint32_t) : length);
+}
+
+/* Caches a read received through MultipartReceive once it is complete */
+static void
+rde_read_cache_fill_received(struct pldm_rde_requester_manager *manager,
+			     struct rde_operation *operation)
+{
+	struct pldm_rde_reassembly *reassembly = operation->reassembly;
+	uint32_t checksum;
+	uint32_t length;
+
+	// The reassembly already checked the checksum
+	if (reassembly != NULL &&
+	    reassembly->type == PLDM_RDE_REASSEMBLY_BUFFER) {
+		rde_read_cache_fill(manager, operation,
+				    reassembly->dest.buffer.data,
+				    reassembly->length);
+		return;
+	}
+
+	if (operation->cache_body_length < sizeof(checksum)) {
+		return;
+	}
+	length = operation->cache_body_length - sizeof(checksum);
+	memcpy(&checksum, operation->cache_body + length, sizeof(checksum));
+	if (pldm_crc32_final(&operation->cache_crc) == le32toh(checksum)) {
+		rde_read_cache_fill(manager, operation, operation->cache_body,
+				    length);
+	}
+	rde_read_cache_release(operation);
+}
+
+/*
+ * Answers a read from the body kept when it was cached, once the device
+ * matched the ETag, the same way a response carrying the body inline would
+ * have been.
+ */
+static int rde_read_cache_serve(struct pldm_rde_requester_manager *manager,
+				struct pldm_rde_requester_context *ctx,
+				callback_funct callback)
+{
+	struct rde_operation *operation = &ctx->operation;
+	struct pldm_rde_reassembly *reassembly = operation->reassembly;
+	uint8_t *payload = operation->cache_body;
+
+	if (reassembly != NULL) {
+		rde_reassembly_reset(reassembly, 0);
+		if (rde_reassembly_land(reassembly, payload,
+					operation->cache_body_length)) {
+			return -EOVERFLOW;
+		}
+		rde_read_cache_hit(manager->read_cache);
+		rde_reassembly_notify(manager, ctx, reassembly, callback);
+		return 0;
+	}
+
+	rde_read_cache_hit(manager->read_cache);
+	callback(manager, ctx, &payload, operation->cache_body_length, false);
+	return 0;
+}
+
 int set_next_rde_operation(struct pldm_rde_requester_manager **manager,
 			   struct pldm_rde_requester_context *ctx,
 			   callback_funct callback)
 {
-	struct rde_operation *operation_ctx =
-		(struct rde_operation *)ctx->operation_ctx;
+	struct rde_operation *operation_ctx = &ctx->operation;
 
 	int rc = PLDM_RDE_REQUESTER_SUCCESS;
 	switch (operation_ctx->operation_status) {
     case PLDM_RDE_OPERATION_NEEDS_INPUT: {
-        if (operation_ctx->operation_flags.bits.contains_custom_request_parameters)
+        if (operation_ctx->operation_flags.bits.contains_custom_request_parameters &&
+            !operation_ctx->custom_request_parameters_supplied)
         {
                 ctx->next_command = PLDM_SUPPLY_CUSTOM_REQUEST_PARAMETERS;
         } else {
                 ctx->next_command = PLDM_RDE_MULTIPART_SEND;
+                operation_ctx->send_offset = 0;
+                operation_ctx->send_transfer_handle =
+                        operation_ctx->send_data_transfer_handle;
         }
         ctx->context_status = CONTEXT_CONTINUE;
         ctx->requester_status =
@@ -573,12 +1782,42 @@ int set_next_rde_operation(struct pldm_rde_requester_manager **manager,
 		ctx->requester_status =
 			PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
 		operation_ctx->transfer_operation = PLDM_XFER_FIRST_PART;
+		if (operation_ctx->cache_fill) {
+			rde_read_cache_capture_etag(operation_ctx);
+		}
 		break;
 	}
 	case PLDM_RDE_OPERATION_COMPLETED: {
-		// skip the etag bytes and then call callback on the payloads
-		callback(*manager, ctx, &(operation_ctx->response_data),
-			 operation_ctx->resp_payload_length, false);
+		struct pldm_rde_reassembly *reassembly =
+			operation_ctx->reassembly;
+
+		if (operation_ctx->cache_fill &&
+		    rde_read_cache_capture_etag(operation_ctx)) {
+			rde_read_cache_fill(*manager, operation_ctx,
+					    operation_ctx->response_data,
+					    operation_ctx->resp_payload_length);
+		}
+		rde_coalesce_forward_inline(*manager, ctx, callback);
+
+		if (reassembly != NULL) {
+			// Inline responses carry no checksum
+			rde_reassembly_reset(reassembly, 0);
+			if (rde_reassembly_land(
+				    reassembly, operation_ctx->response_data,
+				    operation_ctx->resp_payload_length)) {
+				ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
+				ctx->context_status = CONTEXT_CONTINUE;
+				rc = PLDM_RDE_REASSEMBLY_ERROR;
+				break;
+			}
+			rde_reassembly_notify(*manager, ctx, reassembly,
+					      callback);
+		} else {
+			// skip the etag bytes and then call callback on the
+			// payloads
+			callback(*manager, ctx, &(operation_ctx->response_data),
+				 operation_ctx->resp_payload_length, false);
+		}
 		ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
 		ctx->context_status = CONTEXT_FREE;
 		ctx->requester_status =
@@ -601,23 +1840,53 @@ int set_next_rde_operation(struct pldm_rde_requester_manager **manager,
 	}
 	default: {
 		rc = PLDM_RDE_OPERATION_FAILED;
-		fprintf(stderr, "Received default operation_status : %u\n",
-			operation_ctx->operation_status);
+		pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE_REQUESTER,
+			   "Received default operation_status : %u\n",
+			   operation_ctx->operation_status);
 	}
 	}
 	return rc;
 }
 
 
-LIBPLDM_ABI_STABLE
-pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
+/*
+ * Asks for the chunk that was lost again, if the read has retries left. The
+ * transfer handle of the last chunk received is still the one to ask with.
+ */
+static bool rde_retry_multipart_receive(
+	struct pldm_rde_requester_manager *manager,
+	struct pldm_rde_requester_context *ctx)
+{
+	struct rde_operation *operation = &ctx->operation;
+
+	if (operation->receive_retries >= manager->multipart_receive_retries) {
+		return false;
+	}
+
+	operation->receive_retries++;
+	// The first chunk is simply asked for again, which also keeps
+	// reassembly starting over with it
+	if (operation->transfer_operation != PLDM_XFER_FIRST_PART) {
+		operation->transfer_operation = PLDM_XFER_CURRENT_PART;
+	}
+	pldm_trace(PLDM_TRACE_WARNING, PLDM_TRACE_RDE_REQUESTER,
+		   "Retrying MultipartReceive of transfer handle %u (%u/%u)\n",
+		   (unsigned int)operation->result_transfer_handle,
+		   (unsigned int)operation->receive_retries,
+		   (unsigned int)manager->multipart_receive_retries);
+	ctx->next_command = PLDM_RDE_MULTIPART_RECEIVE;
+	ctx->context_status = CONTEXT_CONTINUE;
+	ctx->requester_status = PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
+	return true;
+}
+
+static pldm_rde_requester_rc_t rde_push_read_operation_response(
 	struct pldm_rde_requester_manager *manager,
 	struct pldm_rde_requester_context *ctx, void *resp_msg,
 	size_t resp_size, callback_funct callback)
 {
 	int rc = 0;
-	struct rde_operation *operation_ctx =
-		(struct rde_operation *)ctx->operation_ctx;
+	struct rde_operation *operation_ctx = &ctx->operation;
 	IGNORE(operation_ctx);
 	switch (ctx->next_command) {
 	case PLDM_RDE_OPERATION_INIT: {
@@ -651,6 +1920,7 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
 			ctx->requester_status =
 				PLDM_RDE_REQUESTER_REQUEST_FAILED;
 			ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
+			return rc;
 		}
 		ctx->requester_status =
 			PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
@@ -670,6 +1940,17 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
                 &(operation_ctx->resp_etag),
                 &(operation_ctx->response_data));
 
+        // The resource is unchanged since it was cached
+        if (!rc && completion_code == PLDM_RDE_ERROR_ETAG_MATCH &&
+            operation_ctx->cache_revalidate &&
+            !rde_read_cache_serve(manager, ctx, callback)) {
+                ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
+                ctx->context_status = CONTEXT_FREE;
+                ctx->requester_status =
+                        PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
+                return PLDM_RDE_REQUESTER_SUCCESS;
+        }
+
         if (rc || completion_code) {
                 // If operation init failed, then there is not need to
                 // send the rest of the requests for the resource.
@@ -680,6 +1961,7 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
                 ctx->context_status = CONTEXT_FREE;
                 break;
         }
+        operation_ctx->custom_request_parameters_supplied = true;
 
         rc = set_next_rde_operation(&manager, ctx, callback);
 
@@ -687,6 +1969,7 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
                 ctx->requester_status =
                         PLDM_RDE_REQUESTER_REQUEST_FAILED;
                 ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
+                return rc;
         }
         ctx->requester_status =
                 PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
@@ -720,6 +2003,7 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
 			ctx->requester_status =
 				PLDM_RDE_REQUESTER_REQUEST_FAILED;
 			ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
+			return rc;
 		}
 		ctx->requester_status =
 			PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
@@ -730,6 +2014,14 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
 		rc = decode_rde_operation_complete_resp(
 			resp_msg, resp_size - sizeof(struct pldm_msg_hdr),
 			&(operation_ctx->completion_code));
+		rde_read_cache_release(operation_ctx);
+		if (manager->read_cache != NULL &&
+		    operation_ctx->operation_type != PLDM_RDE_OPERATION_READ) {
+			pldm_rde_read_cache_invalidate(
+				manager->read_cache, manager->net_id,
+				manager->device_name,
+				operation_ctx->resource_id);
+		}
 		ctx->next_command = PLDM_RDE_REQUESTER_NO_NEXT_COMMAND_FOUND;
 		ctx->context_status = CONTEXT_FREE;
 		ctx->requester_status = PLDM_RDE_REQUESTER_NO_PENDING_ACTION;
@@ -737,28 +2029,73 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
 		break;
 	}
 	case PLDM_RDE_MULTIPART_RECEIVE: {
-		uint8_t completion_code, ret_transfer_flag;
+		uint8_t completion_code = PLDM_SUCCESS, ret_transfer_flag;
 		uint8_t *payload = NULL;
-		uint32_t ret_data_transfer_handle, data_length_bytes;
+		uint32_t ret_data_transfer_handle, data_length_bytes = 0;
 
 		rc = decode_rde_multipart_receive_resp(
 			resp_msg, resp_size - sizeof(struct pldm_msg_hdr),
 			&completion_code, &ret_transfer_flag,
 			&ret_data_transfer_handle, &data_length_bytes,
 			&payload);
-		if (rc || completion_code) {
+
+		size_t offset = sizeof(struct pldm_msg_hdr) +
+				offsetof(struct pldm_rde_multipart_receive_resp,
+					 payload);
+		size_t available = resp_size > offset ? resp_size - offset : 0;
+
+		// Lost chunks are retried, but RDE errors end the operation
+		if (rc || completion_code || data_length_bytes > available) {
+			if (completion_code <
+				    PLDM_RDE_ERROR_CANNOT_CREATE_OPERATION &&
+			    rde_retry_multipart_receive(manager, ctx)) {
+				rc = PLDM_RDE_REQUESTER_SUCCESS;
+				break;
+			}
 			ctx->requester_status =
 				PLDM_RDE_REQUESTER_REQUEST_FAILED;
 			ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
 			ctx->context_status = CONTEXT_FREE;
 			break;
 		}
+		operation_ctx->receive_retries = 0;
+
+		// Reads joining from here on would miss the chunks so far
+		operation_ctx->coalesce_open = false;
+		rde_coalesce_forward_chunk(manager, ctx, callback,
+					   ret_transfer_flag,
+					   ret_data_transfer_handle, payload,
+					   data_length_bytes, available);
+
+		if (operation_ctx->cache_fill) {
+			rde_read_cache_collect(operation_ctx, ret_transfer_flag,
+					       payload, data_length_bytes,
+					       available);
+		}
+
+		if (operation_ctx->reassembly != NULL) {
+			if (rde_reassemble_chunk(operation_ctx,
+						 ret_transfer_flag,
+						 ret_data_transfer_handle,
+						 payload, data_length_bytes,
+						 available)) {
+				ctx->requester_status =
+					PLDM_RDE_REQUESTER_REQUEST_FAILED;
+				ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
+				ctx->context_status = CONTEXT_FREE;
+				rc = PLDM_RDE_REASSEMBLY_ERROR;
+				rde_read_cache_release(operation_ctx);
+				break;
+			}
+		}
 
 		if (ret_transfer_flag == PLDM_RDE_START ||
 		    ret_transfer_flag == PLDM_RDE_MIDDLE) {
 			// next command is MULTIPART
-			callback(manager, ctx, &payload, data_length_bytes,
-				 false);
+			if (operation_ctx->reassembly == NULL) {
+				callback(manager, ctx, &payload,
+					 data_length_bytes, false);
+			}
 			ctx->next_command = PLDM_RDE_MULTIPART_RECEIVE;
 			operation_ctx->transfer_operation = PLDM_XFER_NEXT_PART;
 			operation_ctx->result_transfer_handle =
@@ -766,8 +2103,18 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
 		} else if (ret_transfer_flag == PLDM_RDE_START_AND_END ||
 			   ret_transfer_flag == PLDM_RDE_END) {
 			// next command is Opertaion Complete
-			callback(manager, ctx, &payload, data_length_bytes,
-				 true);
+			if (operation_ctx->cache_fill) {
+				rde_read_cache_fill_received(manager,
+							     operation_ctx);
+			}
+			if (operation_ctx->reassembly != NULL) {
+				rde_reassembly_notify(manager, ctx,
+						      operation_ctx->reassembly,
+						      callback);
+			} else {
+				callback(manager, ctx, &payload,
+					 data_length_bytes, true);
+			}
 			ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
 		}
 		ctx->context_status = CONTEXT_CONTINUE;
@@ -775,36 +2122,104 @@ pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
 			PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
 		break;
 	}
+	case PLDM_RDE_MULTIPART_SEND: {
+		uint8_t completion_code, transfer_operation;
+		bool last_chunk;
+
+		rc = decode_rde_multipart_send_resp(
+			resp_msg, resp_size - sizeof(struct pldm_msg_hdr),
+			&completion_code, &transfer_operation);
+		if (rc || completion_code) {
+			ctx->requester_status =
+				PLDM_RDE_REQUESTER_REQUEST_FAILED;
+			ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
+			ctx->context_status = CONTEXT_FREE;
+			break;
+		}
+
+		last_chunk = operation_ctx->send_offset +
+				     operation_ctx->send_chunk_length ==
+			     operation_ctx->request_payload_length;
+		if (transfer_operation == PLDM_XFER_NEXT_PART && !last_chunk) {
+			operation_ctx->send_offset +=
+				operation_ctx->send_chunk_length;
+			operation_ctx->send_transfer_handle++;
+			ctx->next_command = PLDM_RDE_MULTIPART_SEND;
+		} else if (transfer_operation == PLDM_XFER_FIRST_PART) {
+			// The device lost track, start the payload over
+			operation_ctx->send_offset = 0;
+			operation_ctx->send_transfer_handle =
+				operation_ctx->send_data_transfer_handle;
+			ctx->next_command = PLDM_RDE_MULTIPART_SEND;
+		} else if (transfer_operation == PLDM_XFER_COMPLETE &&
+			   last_chunk) {
+			// The operation carries on with the full payload
+			ctx->next_command = PLDM_RDE_OPERATION_STATUS;
+		} else {
+			ctx->requester_status =
+				PLDM_RDE_REQUESTER_REQUEST_FAILED;
+			ctx->next_command = PLDM_RDE_OPERATION_COMPLETE;
+			ctx->context_status = CONTEXT_FREE;
+			break;
+		}
+		ctx->context_status = CONTEXT_CONTINUE;
+		ctx->requester_status =
+			PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST;
+		break;
+	}
 	}
 
 	return rc;
 }
 
 LIBPLDM_ABI_STABLE
-pldm_rde_requester_rc_t
-free_rde_op_init_context(struct pldm_rde_requester_context *ctx)
+pldm_rde_requester_rc_t pldm_rde_push_read_operation_response(
+	struct pldm_rde_requester_manager *manager,
+	struct pldm_rde_requester_context *ctx, void *resp_msg,
+	size_t resp_size, callback_funct callback)
 {
-	struct rde_operation *operation =
-		(struct rde_operation *)ctx->operation_ctx;
+	pldm_rde_requester_rc_t rc;
 
-	if (operation != NULL) {
-		if (operation->resp_permission_flags != NULL) {
-			free(operation->resp_permission_flags);
-			operation->resp_permission_flags = NULL;
-		}
+	requester_stats_response(manager->stats, &ctx->stats_sample, resp_msg,
+				 resp_size);
+	rc = rde_push_read_operation_response(manager, ctx, resp_msg,
+					      resp_size, callback);
+	rde_coalesce_settle(manager, ctx);
+	return rc;
+}
 
-		if (operation->resp_operation_flags != NULL) {
-			free(operation->resp_operation_flags);
-			operation->resp_operation_flags = NULL;
-		}
+LIBPLDM_ABI_TESTING
+pldm_rde_requester_rc_t
+pldm_rde_retry_multipart_receive(struct pldm_rde_requester_manager *manager,
+				 struct pldm_rde_requester_context *ctx)
+{
+	if (manager == NULL || ctx == NULL || !ctx->operation.active ||
+	    ctx->next_command != PLDM_RDE_MULTIPART_RECEIVE ||
+	    ctx->requester_status !=
+		    PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST) {
+		return PLDM_RDE_CONTEXT_NOT_READY;
+	}
 
-		if (operation->query_options != NULL) {
-			free(operation->query_options);
-			operation->query_options = NULL;
-		}
+	if (!rde_retry_multipart_receive(manager, ctx)) {
+		return PLDM_RDE_REQUESTER_RECV_FAIL;
+	}
+	return PLDM_RDE_REQUESTER_SUCCESS;
+}
 
-		free(operation);
-		ctx->operation_ctx = NULL;
+LIBPLDM_ABI_STABLE
+pldm_rde_requester_rc_t
+free_rde_op_init_context(struct pldm_rde_requester_context *ctx)
+{
+	struct rde_operation *operation = &ctx->operation;
+
+	if (operation->active) {
+		rde_read_cache_release(operation);
+		rde_coalesce_detach(operation);
+		operation->resp_permission_flags = NULL;
+		operation->resp_operation_flags = NULL;
+		operation->query_options = NULL;
+		operation->reassembly = NULL;
+		operation->active = false;
 	}
 	return PLDM_RDE_REQUESTER_SUCCESS;
 }
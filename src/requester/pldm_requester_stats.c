@@ -0,0 +1,261 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "libpldm/requester/pldm_requester_stats.h"
+
+#include "requester-stats.h"
+
+#include <libpldm/base.h>
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Set in claimed slots, so that type 0 command 0 is not mistaken for free
+#define REQUESTER_STATS_USED 0x8000
+
+struct requester_stats_slot {
+	_Atomic uint16_t key;
+	_Atomic uint8_t last_error;
+	_Atomic uint64_t requests;
+	_Atomic uint64_t responses;
+	_Atomic uint64_t errors;
+	_Atomic uint64_t request_bytes;
+	_Atomic uint64_t response_bytes;
+	_Atomic uint64_t latency[PLDM_REQUESTER_STATS_BUCKETS];
+};
+
+/*
+ * Slots are claimed for commands as they are first seen and never released,
+ * so lookups probe linearly from the command's hash and may stop at the first
+ * free slot.
+ */
+struct pldm_requester_stats {
+	struct requester_stats_slot slots[PLDM_REQUESTER_STATS_COMMANDS];
+	// Claim order, so snapshots list commands as they were first seen
+	_Atomic uint8_t order[PLDM_REQUESTER_STATS_COMMANDS];
+	_Atomic unsigned int count;
+	_Atomic uint64_t dropped;
+};
+
+static uint64_t requester_stats_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+static void requester_stats_add(_Atomic uint64_t *counter, uint64_t value)
+{
+	atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+static struct requester_stats_slot *
+requester_stats_slot(struct pldm_requester_stats *stats, uint8_t type,
+		     uint8_t command)
+{
+	uint16_t key = REQUESTER_STATS_USED | (uint16_t)(type << 8) | command;
+	unsigned int start =
+		(type * 31u + command) % PLDM_REQUESTER_STATS_COMMANDS;
+
+	for (unsigned int i = 0; i < PLDM_REQUESTER_STATS_COMMANDS; i++) {
+		unsigned int index = (start + i) % PLDM_REQUESTER_STATS_COMMANDS;
+		struct requester_stats_slot *slot = &stats->slots[index];
+		uint16_t found = atomic_load_explicit(&slot->key,
+						      memory_order_acquire);
+
+		if (!found) {
+			if (atomic_compare_exchange_strong_explicit(
+				    &slot->key, &found, key,
+				    memory_order_acq_rel,
+				    memory_order_acquire)) {
+				unsigned int position;
+
+				position = atomic_fetch_add_explicit(
+					&stats->count, 1, memory_order_relaxed);
+
+				atomic_store_explicit(&stats->order[position],
+						      (uint8_t)(index + 1),
+						      memory_order_release);
+				return slot;
+			}
+			// Lost the race, found now holds the winner's key
+		}
+		if (found == key) {
+			return slot;
+		}
+	}
+
+	requester_stats_add(&stats->dropped, 1);
+	return NULL;
+}
+
+static unsigned int requester_stats_bucket(uint64_t elapsed_ns)
+{
+	uint64_t us = elapsed_ns / 1000;
+	unsigned int bucket;
+
+	if (!us) {
+		return 0;
+	}
+	bucket = 64 - __builtin_clzll(us);
+	return bucket < PLDM_REQUESTER_STATS_BUCKETS
+		       ? bucket
+		       : PLDM_REQUESTER_STATS_BUCKETS - 1;
+}
+
+void requester_stats_request(struct pldm_requester_stats *stats,
+			     struct pldm_requester_stats_sample *sample,
+			     const struct pldm_msg *request, size_t length)
+{
+	struct requester_stats_slot *slot;
+
+	if (!stats) {
+		return;
+	}
+
+	sample->type = request->hdr.type;
+	sample->command = request->hdr.command;
+	sample->pending = true;
+	sample->sent_ns = requester_stats_now();
+
+	slot = requester_stats_slot(stats, sample->type, sample->command);
+	if (!slot) {
+		return;
+	}
+	requester_stats_add(&slot->requests, 1);
+	requester_stats_add(&slot->request_bytes, length);
+}
+
+void requester_stats_response(struct pldm_requester_stats *stats,
+			      struct pldm_requester_stats_sample *sample,
+			      const void *response, size_t length)
+{
+	const struct pldm_msg *msg = response;
+	struct requester_stats_slot *slot;
+	uint8_t type = sample->type;
+	uint8_t command = sample->command;
+	bool timed = sample->pending;
+
+	if (!stats) {
+		return;
+	}
+	if (!msg) {
+		length = 0;
+	}
+
+	sample->pending = false;
+	if (length >= sizeof(struct pldm_msg_hdr)) {
+		timed = timed && msg->hdr.type == type &&
+			msg->hdr.command == command;
+		type = msg->hdr.type;
+		command = msg->hdr.command;
+	} else if (!timed) {
+		// Nothing to attribute the response to
+		requester_stats_add(&stats->dropped, 1);
+		return;
+	}
+
+	slot = requester_stats_slot(stats, type, command);
+	if (!slot) {
+		return;
+	}
+	requester_stats_add(&slot->responses, 1);
+	requester_stats_add(&slot->response_bytes, length);
+	if (length <= sizeof(struct pldm_msg_hdr) ||
+	    msg->payload[0] != PLDM_SUCCESS) {
+		requester_stats_add(&slot->errors, 1);
+		if (length > sizeof(struct pldm_msg_hdr)) {
+			atomic_store_explicit(&slot->last_error,
+					      msg->payload[0],
+					      memory_order_relaxed);
+		}
+	}
+	if (timed) {
+		uint64_t elapsed = requester_stats_now() - sample->sent_ns;
+
+		requester_stats_add(
+			&slot->latency[requester_stats_bucket(elapsed)], 1);
+	}
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_requester_stats_init(struct pldm_requester_stats **stats)
+{
+	struct pldm_requester_stats *new;
+
+	if (!stats || *stats) {
+		return -EINVAL;
+	}
+
+	new = calloc(1, sizeof(*new));
+	if (!new) {
+		return -ENOMEM;
+	}
+
+	*stats = new;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_requester_stats_destroy(struct pldm_requester_stats *stats)
+{
+	free(stats);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_requester_stats_snapshot(struct pldm_requester_stats *stats,
+				  struct pldm_requester_stats_snapshot *snapshot)
+{
+	unsigned int count;
+
+	if (!stats || !snapshot) {
+		return -EINVAL;
+	}
+
+	memset(snapshot, 0, sizeof(*snapshot));
+	count = atomic_load_explicit(&stats->count, memory_order_relaxed);
+	for (unsigned int i = 0; i < count; i++) {
+		struct pldm_requester_command_stats *out =
+			&snapshot->commands[snapshot->count];
+		struct requester_stats_slot *slot;
+		uint8_t index;
+		uint16_t key;
+
+		// Zero while the claiming thread is yet to record it
+		index = atomic_load_explicit(&stats->order[i],
+					     memory_order_acquire);
+		if (!index) {
+			continue;
+		}
+		slot = &stats->slots[index - 1];
+		key = atomic_load_explicit(&slot->key, memory_order_relaxed);
+
+		out->type = (key >> 8) & 0x3f;
+		out->command = key & 0xff;
+		out->last_error = atomic_load_explicit(&slot->last_error,
+						       memory_order_relaxed);
+		out->requests = atomic_load_explicit(&slot->requests,
+						     memory_order_relaxed);
+		out->responses = atomic_load_explicit(&slot->responses,
+						      memory_order_relaxed);
+		out->errors = atomic_load_explicit(&slot->errors,
+						   memory_order_relaxed);
+		out->request_bytes = atomic_load_explicit(&slot->request_bytes,
+							  memory_order_relaxed);
+		out->response_bytes = atomic_load_explicit(
+			&slot->response_bytes, memory_order_relaxed);
+		for (int j = 0; j < PLDM_REQUESTER_STATS_BUCKETS; j++) {
+			out->latency[j] = atomic_load_explicit(
+				&slot->latency[j], memory_order_relaxed);
+		}
+		snapshot->count++;
+	}
+	snapshot->dropped =
+		atomic_load_explicit(&stats->dropped, memory_order_relaxed);
+	return 0;
+}
@@ -0,0 +1,330 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "rde-dictionary-cache.h"
+
+#include <libpldm/utils.h>
+
+#include <dirent.h>
+#include <endian.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* "RDEC", little-endian */
+#define RDE_DICTIONARY_CACHE_MAGIC 0x43454452
+#define RDE_DICTIONARY_CACHE_SUFFIX ".dict"
+
+struct rde_dictionary_cache_entry {
+	uint32_t magic;
+	uint32_t device_configuration_signature;
+	uint32_t resource_id;
+	uint32_t length;
+	uint32_t checksum;
+	uint8_t schema_class;
+	uint8_t provider_name_format;
+	uint8_t provider_name_length;
+	uint8_t provider_name_data;
+} __attribute__((packed));
+
+static int rde_dictionary_cache_device_path(char *buf, size_t len,
+					    const char *cache_dir,
+					    const char *device_name)
+{
+	int rc;
+
+	if (!cache_dir || !device_name || strchr(device_name, '/')) {
+		return -EINVAL;
+	}
+
+	rc = snprintf(buf, len, "%s/%s", cache_dir, device_name);
+	if (rc < 0 || (size_t)rc >= len) {
+		return -ENAMETOOLONG;
+	}
+
+	return 0;
+}
+
+static int rde_dictionary_cache_entry_path(
+	char *buf, size_t len, const struct rde_dictionary_cache_key *key)
+{
+	char dir[PATH_MAX];
+	int rc;
+
+	rc = rde_dictionary_cache_device_path(dir, sizeof(dir), key->cache_dir,
+					      key->device_name);
+	if (rc) {
+		return rc;
+	}
+
+	rc = snprintf(buf, len, "%s/%08x-%u" RDE_DICTIONARY_CACHE_SUFFIX, dir,
+		      key->resource_id, key->schema_class);
+	if (rc < 0 || (size_t)rc >= len) {
+		return -ENAMETOOLONG;
+	}
+
+	return 0;
+}
+
+static bool
+rde_dictionary_cache_entry_valid(const struct rde_dictionary_cache_entry *entry,
+				 const struct pldm_rde_device_info *device)
+{
+	const struct pldm_rde_varstring *name = &device->device_provider_name;
+
+	return le32toh(entry->magic) == RDE_DICTIONARY_CACHE_MAGIC &&
+	       le32toh(entry->device_configuration_signature) ==
+		       device->device_configuration_signature &&
+	       entry->provider_name_format == name->string_format &&
+	       entry->provider_name_length == name->string_length_bytes &&
+	       entry->provider_name_data == name->string_data[0];
+}
+
+static int read_full(int fd, void *buf, size_t len)
+{
+	uint8_t *cursor = buf;
+	ssize_t got;
+
+	while (len) {
+		got = read(fd, cursor, len);
+		if (got < 0 && errno == EINTR) {
+			continue;
+		}
+		if (got < 0) {
+			return -errno;
+		}
+		if (got == 0) {
+			return -EIO;
+		}
+		cursor += got;
+		len -= got;
+	}
+
+	return 0;
+}
+
+static int write_full(int fd, const void *buf, size_t len)
+{
+	const uint8_t *cursor = buf;
+	ssize_t put;
+
+	while (len) {
+		put = write(fd, cursor, len);
+		if (put < 0 && errno == EINTR) {
+			continue;
+		}
+		if (put < 0) {
+			return -errno;
+		}
+		cursor += put;
+		len -= put;
+	}
+
+	return 0;
+}
+
+int rde_dictionary_cache_validate(const char *cache_dir,
+				  const char *device_name,
+				  const struct pldm_rde_device_info *device)
+{
+	struct rde_dictionary_cache_entry entry;
+	char dir[PATH_MAX];
+	struct dirent *ent;
+	DIR *handle;
+	size_t len;
+	int rc;
+	int fd;
+
+	if (!device) {
+		return -EINVAL;
+	}
+
+	rc = rde_dictionary_cache_device_path(dir, sizeof(dir), cache_dir,
+					      device_name);
+	if (rc) {
+		return rc;
+	}
+
+	handle = opendir(dir);
+	if (!handle) {
+		return errno == ENOENT ? 0 : -errno;
+	}
+
+	while ((ent = readdir(handle))) {
+		len = strlen(ent->d_name);
+		if (len < sizeof(RDE_DICTIONARY_CACHE_SUFFIX) ||
+		    strcmp(ent->d_name + len -
+				   (sizeof(RDE_DICTIONARY_CACHE_SUFFIX) - 1),
+			   RDE_DICTIONARY_CACHE_SUFFIX)) {
+			continue;
+		}
+
+		fd = openat(dirfd(handle), ent->d_name, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			continue;
+		}
+		rc = read_full(fd, &entry, sizeof(entry));
+		close(fd);
+
+		if (rc || !rde_dictionary_cache_entry_valid(&entry, device)) {
+			unlinkat(dirfd(handle), ent->d_name, 0);
+		}
+	}
+
+	closedir(handle);
+
+	return 0;
+}
+
+int rde_dictionary_cache_load(const struct rde_dictionary_cache_key *key,
+			      uint8_t **data, uint32_t *length)
+{
+	struct rde_dictionary_cache_entry entry;
+	char path[PATH_MAX];
+	struct stat st;
+	uint32_t len;
+	uint8_t *buf;
+	int rc;
+	int fd;
+
+	if (!key || !key->device || !data || !length) {
+		return -EINVAL;
+	}
+
+	rc = rde_dictionary_cache_entry_path(path, sizeof(path), key);
+	if (rc) {
+		return rc;
+	}
+
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	rc = read_full(fd, &entry, sizeof(entry));
+	if (rc) {
+		goto cleanup_fd;
+	}
+
+	len = le32toh(entry.length);
+	if (!rde_dictionary_cache_entry_valid(&entry, key->device) ||
+	    le32toh(entry.resource_id) != key->resource_id ||
+	    entry.schema_class != key->schema_class) {
+		rc = -ENOENT;
+		goto cleanup_fd;
+	}
+
+	/* Reject truncated or padded entries rather than replaying them */
+	if (fstat(fd, &st) || (uint64_t)st.st_size != sizeof(entry) + len) {
+		rc = -ENOENT;
+		goto cleanup_corrupt;
+	}
+
+	buf = malloc(len ? len : 1);
+	if (!buf) {
+		rc = -ENOMEM;
+		goto cleanup_fd;
+	}
+
+	rc = read_full(fd, buf, len);
+	if (rc) {
+		free(buf);
+		goto cleanup_fd;
+	}
+
+	if (crc32(buf, len) != le32toh(entry.checksum)) {
+		free(buf);
+		rc = -ENOENT;
+		goto cleanup_corrupt;
+	}
+
+	*data = buf;
+	*length = len;
+
+cleanup_fd:
+	close(fd);
+
+	return rc;
+
+cleanup_corrupt:
+	close(fd);
+	unlink(path);
+
+	return rc;
+}
+
+int rde_dictionary_cache_store(const struct rde_dictionary_cache_key *key,
+			       const uint8_t *data, uint32_t length)
+{
+	const struct pldm_rde_varstring *name;
+	struct rde_dictionary_cache_entry entry;
+	char path[PATH_MAX];
+	char tmp[PATH_MAX];
+	char dir[PATH_MAX];
+	int rc;
+	int fd;
+
+	if (!key || !key->device || (length && !data)) {
+		return -EINVAL;
+	}
+
+	rc = rde_dictionary_cache_device_path(dir, sizeof(dir), key->cache_dir,
+					      key->device_name);
+	if (rc) {
+		return rc;
+	}
+
+	if (mkdir(dir, 0755) && errno != EEXIST) {
+		return -errno;
+	}
+
+	rc = rde_dictionary_cache_entry_path(path, sizeof(path), key);
+	if (rc) {
+		return rc;
+	}
+
+	rc = snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+	if (rc < 0 || (size_t)rc >= sizeof(tmp)) {
+		return -ENAMETOOLONG;
+	}
+
+	name = &key->device->device_provider_name;
+	entry.magic = htole32(RDE_DICTIONARY_CACHE_MAGIC);
+	entry.device_configuration_signature =
+		htole32(key->device->device_configuration_signature);
+	entry.resource_id = htole32(key->resource_id);
+	entry.length = htole32(length);
+	entry.checksum = htole32(crc32(data, length));
+	entry.schema_class = key->schema_class;
+	entry.provider_name_format = name->string_format;
+	entry.provider_name_length = name->string_length_bytes;
+	entry.provider_name_data = name->string_data[0];
+
+	fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	rc = write_full(fd, &entry, sizeof(entry));
+	if (!rc) {
+		rc = write_full(fd, data, length);
+	}
+	if (close(fd) && !rc) {
+		rc = -errno;
+	}
+
+	/* Readers either see the previous entry or the complete new one */
+	if (!rc && rename(tmp, path)) {
+		rc = -errno;
+	}
+
+	if (rc) {
+		unlink(tmp);
+	}
+
+	return rc;
+}
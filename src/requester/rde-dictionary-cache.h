@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef LIBPLDM_SRC_REQUESTER_RDE_DICTIONARY_CACHE_H
+#define LIBPLDM_SRC_REQUESTER_RDE_DICTIONARY_CACHE_H
+
+#include <libpldm/pldm_rde.h>
+
+#include <stdint.h>
+
+/**
+ * @brief Identifies a cached dictionary
+ *
+ * Entries live under <cache_dir>/<device_name>/ and carry the provider name
+ * and configuration signature reported by NegotiateRedfishParameters. An
+ * entry only matches if every field agrees with the device's current state.
+ */
+struct rde_dictionary_cache_key {
+	const char *cache_dir;
+	const char *device_name;
+	const struct pldm_rde_device_info *device;
+	uint32_t resource_id;
+	uint8_t schema_class;
+};
+
+/**
+ * @brief Drop every entry of a device that does not match its current
+ * configuration signature
+ *
+ * @return 0 on success, a negative errno value otherwise
+ */
+int rde_dictionary_cache_validate(const char *cache_dir,
+				  const char *device_name,
+				  const struct pldm_rde_device_info *device);
+
+/**
+ * @brief Look up a cached dictionary
+ *
+ * @param[in] key - Entry to look up
+ * @param[out] data - Set to a malloc()'d copy of the dictionary on a hit. The
+ * caller owns the memory.
+ * @param[out] length - Length of @p data in bytes
+ *
+ * Entries whose length or CRC-32 does not match the dictionary they hold are
+ * removed and reported as a miss.
+ *
+ * @return 0 on a hit, -ENOENT on a miss or a stale entry, another negative
+ * errno value on failure
+ */
+int rde_dictionary_cache_load(const struct rde_dictionary_cache_key *key,
+			      uint8_t **data, uint32_t *length);
+
+/**
+ * @brief Atomically insert or replace a cached dictionary
+ *
+ * @return 0 on success, a negative errno value otherwise
+ */
+int rde_dictionary_cache_store(const struct rde_dictionary_cache_key *key,
+			       const uint8_t *data, uint32_t length);
+
+#endif
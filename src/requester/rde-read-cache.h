@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef LIBPLDM_SRC_REQUESTER_RDE_READ_CACHE_H
+#define LIBPLDM_SRC_REQUESTER_RDE_READ_CACHE_H
+
+#include <libpldm/requester/pldm_rde_read_cache.h>
+
+#include <stdint.h>
+
+/**
+ * @brief Identifies a cached read
+ *
+ * The device is identified by the network ID and device ID of its Context
+ * Manager. Reads without $expand use zero for all three parameters.
+ */
+struct rde_read_cache_key {
+	int net_id;
+	const char *device_name;
+	uint32_t resource_id;
+	uint16_t expand_levels;
+	uint16_t skip;
+	uint16_t top;
+};
+
+/**
+ * @brief A cached read, owned by the cache
+ */
+struct rde_read_cache_entry {
+	// NUL terminated
+	const char *etag;
+	uint8_t *body;
+	uint32_t length;
+};
+
+/**
+ * @brief Look up a cached read and mark it most recently used
+ *
+ * @return The entry, valid until the cache is next modified, or NULL on a
+ * miss
+ */
+const struct rde_read_cache_entry *
+rde_read_cache_lookup(struct pldm_rde_read_cache *cache,
+		      const struct rde_read_cache_key *key);
+
+/**
+ * @brief Insert or replace a cached read
+ *
+ * @return 0 on success, -ENOSPC if the entry alone exceeds the capacity,
+ * -ENOMEM otherwise
+ */
+int rde_read_cache_store(struct pldm_rde_read_cache *cache,
+			 const struct rde_read_cache_key *key, const char *etag,
+			 const uint8_t *body, uint32_t length);
+
+/**
+ * @brief Count a read answered from the cache
+ */
+void rde_read_cache_hit(struct pldm_rde_read_cache *cache);
+
+#endif
@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "rde-timer-wheel.h"
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+void rde_timer_wheel_init(struct rde_timer_wheel *wheel, uint64_t now_ms)
+{
+	memset(wheel, 0, sizeof(*wheel));
+	wheel->tick = now_ms / RDE_TIMER_WHEEL_TICK_MS;
+}
+
+void rde_timer_wheel_add(struct rde_timer_wheel *wheel, struct rde_timer *timer,
+			 uint64_t expiry_ms)
+{
+	uint64_t expiry = (expiry_ms + RDE_TIMER_WHEEL_TICK_MS - 1) /
+			  RDE_TIMER_WHEEL_TICK_MS;
+	struct rde_timer **slot;
+
+	// Ticks already processed are never looked at again
+	if (expiry <= wheel->tick) {
+		expiry = wheel->tick + 1;
+	}
+
+	slot = &wheel->slots[expiry % RDE_TIMER_WHEEL_SLOTS];
+	timer->expiry = expiry;
+	timer->prev = NULL;
+	timer->next = *slot;
+	if (*slot) {
+		(*slot)->prev = timer;
+	}
+	*slot = timer;
+	wheel->count++;
+}
+
+void rde_timer_wheel_cancel(struct rde_timer_wheel *wheel,
+			    struct rde_timer *timer)
+{
+	struct rde_timer **slot =
+		&wheel->slots[timer->expiry % RDE_TIMER_WHEEL_SLOTS];
+
+	if (timer->prev) {
+		timer->prev->next = timer->next;
+	} else {
+		*slot = timer->next;
+	}
+	if (timer->next) {
+		timer->next->prev = timer->prev;
+	}
+	timer->prev = NULL;
+	timer->next = NULL;
+	wheel->count--;
+}
+
+struct rde_timer *rde_timer_wheel_expire(struct rde_timer_wheel *wheel,
+					 uint64_t now_ms)
+{
+	uint64_t now = now_ms / RDE_TIMER_WHEEL_TICK_MS;
+	struct rde_timer *fired = NULL;
+	struct rde_timer **tail = &fired;
+	uint64_t ticks;
+
+	if (now <= wheel->tick) {
+		return NULL;
+	}
+
+	ticks = now - wheel->tick;
+	if (ticks > RDE_TIMER_WHEEL_SLOTS) {
+		ticks = RDE_TIMER_WHEEL_SLOTS;
+	}
+
+	for (uint64_t i = 1; i <= ticks && wheel->count; i++) {
+		struct rde_timer *timer =
+			wheel->slots[(wheel->tick + i) % RDE_TIMER_WHEEL_SLOTS];
+
+		while (timer) {
+			struct rde_timer *next = timer->next;
+
+			if (timer->expiry <= now) {
+				rde_timer_wheel_cancel(wheel, timer);
+				*tail = timer;
+				tail = &timer->next;
+			}
+			timer = next;
+		}
+	}
+
+	wheel->tick = now;
+	return fired;
+}
+
+int rde_timer_wheel_next(struct rde_timer_wheel *wheel, uint64_t now_ms)
+{
+	uint64_t earliest = UINT64_MAX;
+	uint64_t at;
+
+	if (!wheel->count) {
+		return -1;
+	}
+
+	for (uint64_t tick = wheel->tick + 1;
+	     tick <= wheel->tick + RDE_TIMER_WHEEL_SLOTS; tick++) {
+		struct rde_timer *timer =
+			wheel->slots[tick % RDE_TIMER_WHEEL_SLOTS];
+
+		for (; timer; timer = timer->next) {
+			if (timer->expiry < earliest) {
+				earliest = timer->expiry;
+			}
+		}
+		// Nothing in a later slot can fire before this tick
+		if (earliest == tick) {
+			break;
+		}
+	}
+
+	at = earliest * RDE_TIMER_WHEEL_TICK_MS;
+	if (at <= now_ms) {
+		return 0;
+	}
+	return at - now_ms > INT_MAX ? INT_MAX : (int)(at - now_ms);
+}
@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef LIBPLDM_SRC_REQUESTER_RDE_TIMER_WHEEL_H
+#define LIBPLDM_SRC_REQUESTER_RDE_TIMER_WHEEL_H
+
+#include <stdint.h>
+
+#define RDE_TIMER_WHEEL_TICK_MS 10
+#define RDE_TIMER_WHEEL_SLOTS	512
+
+/**
+ * @brief A timer, embedded in whatever it wakes up
+ */
+struct rde_timer {
+	struct rde_timer *prev;
+	struct rde_timer *next;
+	// Tick at which the timer fires
+	uint64_t expiry;
+};
+
+/**
+ * @brief Hashed timing wheel
+ *
+ * Timers hash into slots by expiry tick, so arming and cancelling are O(1)
+ * and every timer due in the same tick fires in one pass. Timers further out
+ * than one revolution share slots with nearer ones and are skipped until
+ * their turn comes around.
+ */
+struct rde_timer_wheel {
+	struct rde_timer *slots[RDE_TIMER_WHEEL_SLOTS];
+	// Every tick up to and including this one has been processed
+	uint64_t tick;
+	unsigned int count;
+};
+
+/**
+ * @brief Start the wheel at @p now_ms, in monotonic milliseconds
+ */
+void rde_timer_wheel_init(struct rde_timer_wheel *wheel, uint64_t now_ms);
+
+/**
+ * @brief Arm @p timer to fire at @p expiry_ms, rounded up to the next tick
+ */
+void rde_timer_wheel_add(struct rde_timer_wheel *wheel, struct rde_timer *timer,
+			 uint64_t expiry_ms);
+
+/**
+ * @brief Disarm @p timer
+ */
+void rde_timer_wheel_cancel(struct rde_timer_wheel *wheel,
+			    struct rde_timer *timer);
+
+/**
+ * @brief Disarm the timers due by @p now_ms
+ *
+ * @return The timers that fired, linked through their next members
+ */
+struct rde_timer *rde_timer_wheel_expire(struct rde_timer_wheel *wheel,
+					 uint64_t now_ms);
+
+/**
+ * @brief Milliseconds from @p now_ms until the wheel next needs to turn
+ *
+ * @return The delay, or -1 if no timer is armed
+ */
+int rde_timer_wheel_next(struct rde_timer_wheel *wheel, uint64_t now_ms);
+
+#endif
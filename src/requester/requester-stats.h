@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef LIBPLDM_SRC_REQUESTER_REQUESTER_STATS_H
+#define LIBPLDM_SRC_REQUESTER_REQUESTER_STATS_H
+
+#include <libpldm/base.h>
+#include <libpldm/requester/pldm_requester_stats.h>
+
+#include <stddef.h>
+
+/**
+ * @brief Count an encoded request and start timing it
+ *
+ * Does nothing if @p stats is NULL.
+ *
+ * @param[in] length - Size of @p request, including the PLDM header
+ */
+void requester_stats_request(struct pldm_requester_stats *stats,
+			     struct pldm_requester_stats_sample *sample,
+			     const struct pldm_msg *request, size_t length);
+
+/**
+ * @brief Count a response pushed to a requester context
+ *
+ * The response is attributed to the request in @p sample, and timed against
+ * it. Does nothing if @p stats is NULL.
+ *
+ * @param[in] length - Size of @p response, including the PLDM header
+ */
+void requester_stats_response(struct pldm_requester_stats *stats,
+			      struct pldm_requester_stats_sample *sample,
+			      const void *response, size_t length);
+
+#endif
@@ -0,0 +1,145 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "trace.h"
+
+#include <libpldm/trace.h>
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Longer messages are truncated
+#define PLDM_TRACE_MESSAGE_MAX 256
+
+#ifdef PLDM_TRACE
+
+#ifdef PLDM_HAS_SDT
+__extension__ unsigned short libpldm_trace_semaphore
+	__attribute__((unused)) __attribute__((section(".probes")));
+#endif
+
+_Atomic uint32_t pldm_trace_masks[PLDM_TRACE_DEBUG + 1];
+
+// The sink is only ever called with its own argument. Odd while the pair is
+// being replaced, so readers retry rather than mixing the old and the new.
+static _Atomic unsigned int pldm_trace_sink_seq;
+static _Atomic(pldm_trace_sink_fn) pldm_trace_sink;
+static _Atomic(void *) pldm_trace_sink_arg;
+
+static pldm_trace_sink_fn pldm_trace_sink_load(void **arg)
+{
+	pldm_trace_sink_fn sink;
+	unsigned int seq;
+
+	do {
+		seq = atomic_load_explicit(&pldm_trace_sink_seq,
+					   memory_order_acquire);
+		sink = atomic_load_explicit(&pldm_trace_sink,
+					    memory_order_relaxed);
+		*arg = atomic_load_explicit(&pldm_trace_sink_arg,
+					    memory_order_relaxed);
+		atomic_thread_fence(memory_order_acquire);
+	} while ((seq & 1) || seq != atomic_load_explicit(&pldm_trace_sink_seq,
+							  memory_order_relaxed));
+
+	return sink;
+}
+
+void pldm_trace_emit(enum pldm_trace_level level, uint32_t category,
+		     const char *fmt, ...)
+{
+	char message[PLDM_TRACE_MESSAGE_MAX];
+	pldm_trace_sink_fn sink;
+	va_list ap;
+	void *arg;
+	int len;
+
+	va_start(ap, fmt);
+	len = vsnprintf(message, sizeof(message), fmt, ap);
+	va_end(ap);
+	if (len < 0) {
+		return;
+	}
+
+	len = (int)strnlen(message, sizeof(message));
+	if (len && message[len - 1] == '\n') {
+		message[len - 1] = '\0';
+	}
+
+#ifdef PLDM_HAS_SDT
+	STAP_PROBE3(libpldm, trace, level, category, message);
+#endif
+
+	if (!(atomic_load_explicit(&pldm_trace_masks[level],
+				   memory_order_relaxed) &
+	      category)) {
+		return;
+	}
+
+	sink = pldm_trace_sink_load(&arg);
+	if (sink) {
+		sink(arg, level, category, message);
+	}
+}
+
+#endif
+
+LIBPLDM_ABI_TESTING
+void pldm_trace_set_sink(pldm_trace_sink_fn sink, void *arg)
+{
+#ifdef PLDM_TRACE
+	unsigned int seq;
+
+	// Concurrent installs take turns making the sequence odd
+	seq = atomic_load_explicit(&pldm_trace_sink_seq, memory_order_relaxed);
+	do {
+		seq &= ~1u;
+	} while (!atomic_compare_exchange_weak_explicit(
+		&pldm_trace_sink_seq, &seq, seq + 1, memory_order_acquire,
+		memory_order_relaxed));
+	atomic_thread_fence(memory_order_release);
+
+	atomic_store_explicit(&pldm_trace_sink, sink, memory_order_relaxed);
+	atomic_store_explicit(&pldm_trace_sink_arg, arg, memory_order_relaxed);
+
+	atomic_store_explicit(&pldm_trace_sink_seq, seq + 2,
+			      memory_order_release);
+#else
+	(void)sink;
+	(void)arg;
+#endif
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_trace_set_level(enum pldm_trace_level level, uint32_t categories)
+{
+#ifdef PLDM_TRACE
+	for (int i = PLDM_TRACE_ERROR; i <= PLDM_TRACE_DEBUG; i++) {
+		atomic_store_explicit(&pldm_trace_masks[i],
+				      i <= (int)level ? categories : 0,
+				      memory_order_relaxed);
+	}
+#else
+	(void)level;
+	(void)categories;
+#endif
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_trace_sink_stderr(void *arg, enum pldm_trace_level level,
+			    uint32_t category, const char *message)
+{
+	static const char *const levels[] = {
+		[PLDM_TRACE_ERROR] = "error",
+		[PLDM_TRACE_WARNING] = "warning",
+		[PLDM_TRACE_INFO] = "info",
+		[PLDM_TRACE_DEBUG] = "debug",
+	};
+
+	(void)arg;
+	(void)category;
+	fprintf(stderr, "libpldm: %s: %s\n",
+		(unsigned int)level <= PLDM_TRACE_DEBUG ? levels[level] : "?",
+		message);
+}
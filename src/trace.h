@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef LIBPLDM_SRC_TRACE_H
+#define LIBPLDM_SRC_TRACE_H
+
+#include <libpldm/trace.h>
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * pldm_trace(level, category, fmt, ...) formats and emits a message only when
+ * it is wanted, leaving a relaxed load and a branch on the path when it is not.
+ * Built without PLDM_TRACE the arguments are still type checked against the
+ * format, but no code is generated.
+ */
+
+__attribute__((format(printf, 1, 2))) static inline void
+pldm_trace_check(const char *fmt, ...)
+{
+	(void)fmt;
+}
+
+#ifdef PLDM_TRACE
+
+#ifdef PLDM_HAS_SDT
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+// Non-zero while a tracer is attached to the libpldm:trace probe
+extern unsigned short libpldm_trace_semaphore;
+#define pldm_trace_probed() __builtin_expect(libpldm_trace_semaphore, 0)
+#else
+#define pldm_trace_probed() false
+#endif
+
+// The categories passed on at each level
+extern _Atomic uint32_t pldm_trace_masks[PLDM_TRACE_DEBUG + 1];
+
+static inline bool pldm_trace_wanted(enum pldm_trace_level level,
+				     uint32_t category)
+{
+	return (atomic_load_explicit(&pldm_trace_masks[level],
+				     memory_order_relaxed) &
+		category) ||
+	       pldm_trace_probed();
+}
+
+__attribute__((format(printf, 3, 4))) void
+pldm_trace_emit(enum pldm_trace_level level, uint32_t category,
+		const char *fmt, ...);
+
+#define pldm_trace(level, category, ...)                                       \
+	do {                                                                   \
+		if (__builtin_expect(pldm_trace_wanted(level, category), 0)) { \
+			pldm_trace_emit(level, category, __VA_ARGS__);         \
+		}                                                              \
+	} while (0)
+
+#else
+
+#define pldm_trace(level, category, ...)                                       \
+	do {                                                                   \
+		if (0) {                                                       \
+			(void)(level);                                         \
+			(void)(category);                                      \
+			pldm_trace_check(__VA_ARGS__);                         \
+		}                                                              \
+	} while (0)
+
+#endif
+
+#endif
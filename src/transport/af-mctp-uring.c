@@ -0,0 +1,819 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "container-of.h"
+#include "mctp-defines.h"
+#include "socket.h"
+#include "tid-map.h"
+#include "transport.h"
+
+#include <libpldm/base.h>
+#include <libpldm/pldm.h>
+#include <libpldm/transport.h>
+#include <libpldm/transport/af-mctp-uring.h>
+
+#include <errno.h>
+#include <limits.h>
+#include <linux/io_uring.h>
+#include <linux/mctp.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#define AF_MCTP_URING_NAME "AF_MCTP io_uring"
+/* Entries of each ring, and buffers provided to the receive */
+#define AF_MCTP_URING_ENTRIES 64
+#define AF_MCTP_URING_BGID    0
+
+/* user_data of the receive ring's submissions */
+enum {
+	AF_MCTP_URING_RECV = 1,
+	AF_MCTP_URING_CANCEL,
+};
+
+struct af_mctp_uring_ring {
+	int fd;
+	unsigned int entries;
+	void *sq_map;
+	size_t sq_map_len;
+	void *cq_map;
+	size_t cq_map_len;
+	struct io_uring_sqe *sqes;
+	size_t sqes_len;
+	unsigned int *sq_head;
+	unsigned int *sq_tail;
+	unsigned int *sq_mask;
+	unsigned int *sq_array;
+	unsigned int *cq_head;
+	unsigned int *cq_tail;
+	unsigned int *cq_mask;
+	struct io_uring_cqe *cqes;
+	/* Submissions queued but not handed to the kernel yet */
+	unsigned int queued;
+};
+
+/* A send in flight, holding its own copy of the message */
+struct af_mctp_uring_send {
+	struct msghdr msg;
+	struct iovec iov;
+	struct sockaddr_mctp addr;
+	uint8_t data[];
+};
+
+struct pldm_transport_af_mctp_uring {
+	struct pldm_transport transport;
+	int socket;
+	struct pldm_tid_map tid_map;
+	struct pldm_socket_sndbuf socket_send_buf;
+	/* The multishot receive, on its own so sends do not wake the poller */
+	struct af_mctp_uring_ring rx;
+	struct af_mctp_uring_ring tx;
+	unsigned int sends;
+	struct io_uring_buf_ring *buf_ring;
+	size_t buf_ring_len;
+	uint16_t buf_tail;
+	uint8_t *bufs;
+	size_t buf_size;
+	struct msghdr recv_hdr;
+	bool armed;
+};
+
+#define transport_to_af_mctp_uring(ptr)                                        \
+	container_of(ptr, struct pldm_transport_af_mctp_uring, transport)
+
+static int af_mctp_uring_setup(unsigned int entries, struct io_uring_params *p)
+{
+	return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int af_mctp_uring_enter(int fd, unsigned int to_submit,
+			       unsigned int min_complete, unsigned int flags)
+{
+	return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+			    flags, NULL, 0);
+}
+
+static int af_mctp_uring_register(int fd, unsigned int opcode, void *arg,
+				  unsigned int nr_args)
+{
+	return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static void af_mctp_uring_ring_destroy(struct af_mctp_uring_ring *ring)
+{
+	if (ring->sqes) {
+		munmap(ring->sqes, ring->sqes_len);
+	}
+	if (ring->cq_map && ring->cq_map != ring->sq_map) {
+		munmap(ring->cq_map, ring->cq_map_len);
+	}
+	if (ring->sq_map) {
+		munmap(ring->sq_map, ring->sq_map_len);
+	}
+	if (ring->fd >= 0) {
+		close(ring->fd);
+	}
+	memset(ring, 0, sizeof(*ring));
+	ring->fd = -1;
+}
+
+static int af_mctp_uring_ring_init(struct af_mctp_uring_ring *ring,
+				   unsigned int entries)
+{
+	struct io_uring_params p;
+	uint8_t *sq;
+	uint8_t *cq;
+	void *map;
+	int rc;
+
+	memset(&p, 0, sizeof(p));
+	ring->fd = af_mctp_uring_setup(entries, &p);
+	if (ring->fd < 0) {
+		return -errno;
+	}
+
+	ring->entries = p.sq_entries;
+	ring->sq_map_len = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+	ring->cq_map_len = p.cq_off.cqes +
+			   p.cq_entries * sizeof(struct io_uring_cqe);
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		if (ring->cq_map_len > ring->sq_map_len) {
+			ring->sq_map_len = ring->cq_map_len;
+		}
+		ring->cq_map_len = ring->sq_map_len;
+	}
+
+	map = mmap(NULL, ring->sq_map_len, PROT_READ | PROT_WRITE,
+		   MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	if (map == MAP_FAILED) {
+		goto cleanup_ring;
+	}
+	ring->sq_map = map;
+
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		ring->cq_map = ring->sq_map;
+	} else {
+		map = mmap(NULL, ring->cq_map_len, PROT_READ | PROT_WRITE,
+			   MAP_SHARED | MAP_POPULATE, ring->fd,
+			   IORING_OFF_CQ_RING);
+		if (map == MAP_FAILED) {
+			goto cleanup_ring;
+		}
+		ring->cq_map = map;
+	}
+
+	ring->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+	map = mmap(NULL, ring->sqes_len, PROT_READ | PROT_WRITE,
+		   MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if (map == MAP_FAILED) {
+		goto cleanup_ring;
+	}
+	ring->sqes = map;
+
+	sq = ring->sq_map;
+	ring->sq_head = (unsigned int *)(sq + p.sq_off.head);
+	ring->sq_tail = (unsigned int *)(sq + p.sq_off.tail);
+	ring->sq_mask = (unsigned int *)(sq + p.sq_off.ring_mask);
+	ring->sq_array = (unsigned int *)(sq + p.sq_off.array);
+
+	cq = ring->cq_map;
+	ring->cq_head = (unsigned int *)(cq + p.cq_off.head);
+	ring->cq_tail = (unsigned int *)(cq + p.cq_off.tail);
+	ring->cq_mask = (unsigned int *)(cq + p.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+	ring->queued = 0;
+
+	return 0;
+
+cleanup_ring:
+	rc = -errno;
+	af_mctp_uring_ring_destroy(ring);
+	return rc;
+}
+
+/* The next free submission entry, or NULL if the ring is full */
+static struct io_uring_sqe *af_mctp_uring_sqe(struct af_mctp_uring_ring *ring)
+{
+	unsigned int head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+	unsigned int tail = *ring->sq_tail;
+	struct io_uring_sqe *sqe;
+	unsigned int index;
+
+	if (tail - head >= ring->entries) {
+		return NULL;
+	}
+
+	index = tail & *ring->sq_mask;
+	sqe = &ring->sqes[index];
+	memset(sqe, 0, sizeof(*sqe));
+	ring->sq_array[index] = index;
+
+	return sqe;
+}
+
+/* Makes the entry from af_mctp_uring_sqe() visible to the kernel */
+static void af_mctp_uring_queue(struct af_mctp_uring_ring *ring)
+{
+	__atomic_store_n(ring->sq_tail, *ring->sq_tail + 1, __ATOMIC_RELEASE);
+	ring->queued++;
+}
+
+/* Takes back the entry queued last, which the kernel has not seen yet */
+static struct io_uring_sqe *
+af_mctp_uring_unqueue(struct af_mctp_uring_ring *ring)
+{
+	unsigned int tail = *ring->sq_tail - 1;
+
+	__atomic_store_n(ring->sq_tail, tail, __ATOMIC_RELEASE);
+	ring->queued--;
+
+	return &ring->sqes[ring->sq_array[tail & *ring->sq_mask]];
+}
+
+/* Submits the queued entries, then waits for @p wait completions */
+static int af_mctp_uring_submit(struct af_mctp_uring_ring *ring,
+				unsigned int wait)
+{
+	int rc;
+
+	do {
+		rc = af_mctp_uring_enter(ring->fd, ring->queued, wait,
+					 wait ? IORING_ENTER_GETEVENTS : 0);
+	} while (rc < 0 && errno == EINTR);
+	if (rc < 0) {
+		return -errno;
+	}
+
+	ring->queued -= rc;
+
+	return 0;
+}
+
+/* The oldest completion not seen yet, or NULL */
+static struct io_uring_cqe *af_mctp_uring_cqe(struct af_mctp_uring_ring *ring)
+{
+	unsigned int head = *ring->cq_head;
+
+	if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+		return NULL;
+	}
+
+	return &ring->cqes[head & *ring->cq_mask];
+}
+
+static void af_mctp_uring_seen(struct af_mctp_uring_ring *ring)
+{
+	__atomic_store_n(ring->cq_head, *ring->cq_head + 1, __ATOMIC_RELEASE);
+}
+
+/* Hands a receive buffer (back) to the kernel */
+static void af_mctp_uring_provide(struct pldm_transport_af_mctp_uring *ctx,
+				  uint16_t bid)
+{
+	struct io_uring_buf *buf;
+
+	buf = &ctx->buf_ring->bufs[ctx->buf_tail & (AF_MCTP_URING_ENTRIES - 1)];
+	buf->addr = (uintptr_t)(ctx->bufs + bid * ctx->buf_size);
+	buf->len = ctx->buf_size;
+	buf->bid = bid;
+	ctx->buf_tail++;
+	__atomic_store_n(&ctx->buf_ring->tail, ctx->buf_tail, __ATOMIC_RELEASE);
+}
+
+/* Frees the copies of the messages the kernel is done sending */
+static void
+af_mctp_uring_reap_sends(struct pldm_transport_af_mctp_uring *ctx)
+{
+	struct io_uring_cqe *cqe;
+
+	while ((cqe = af_mctp_uring_cqe(&ctx->tx))) {
+		free((void *)(uintptr_t)cqe->user_data);
+		af_mctp_uring_seen(&ctx->tx);
+		ctx->sends--;
+	}
+}
+
+static int af_mctp_uring_arm(struct pldm_transport_af_mctp_uring *ctx)
+{
+	struct io_uring_sqe *sqe;
+	int rc;
+
+	sqe = af_mctp_uring_sqe(&ctx->rx);
+	if (!sqe) {
+		return -EBUSY;
+	}
+
+	sqe->opcode = IORING_OP_RECVMSG;
+	sqe->fd = ctx->socket;
+	sqe->addr = (uintptr_t)&ctx->recv_hdr;
+	sqe->len = 1;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = AF_MCTP_URING_BGID;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->user_data = AF_MCTP_URING_RECV;
+	af_mctp_uring_queue(&ctx->rx);
+
+	rc = af_mctp_uring_submit(&ctx->rx, 0);
+	if (rc) {
+		af_mctp_uring_unqueue(&ctx->rx);
+		return rc;
+	}
+
+	ctx->armed = true;
+
+	return 0;
+}
+
+/* Cancels the receive and waits for it to end, before its buffers go */
+static void af_mctp_uring_disarm(struct pldm_transport_af_mctp_uring *ctx)
+{
+	struct io_uring_sqe *sqe;
+
+	sqe = af_mctp_uring_sqe(&ctx->rx);
+	if (!sqe) {
+		return;
+	}
+
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->addr = AF_MCTP_URING_RECV;
+	sqe->user_data = AF_MCTP_URING_CANCEL;
+	af_mctp_uring_queue(&ctx->rx);
+	if (af_mctp_uring_submit(&ctx->rx, 0)) {
+		af_mctp_uring_unqueue(&ctx->rx);
+		return;
+	}
+
+	while (ctx->armed) {
+		struct io_uring_cqe *cqe = af_mctp_uring_cqe(&ctx->rx);
+
+		if (!cqe) {
+			if (af_mctp_uring_submit(&ctx->rx, 1)) {
+				return;
+			}
+			continue;
+		}
+		if (cqe->user_data == AF_MCTP_URING_RECV &&
+		    !(cqe->flags & IORING_CQE_F_MORE)) {
+			ctx->armed = false;
+		}
+		af_mctp_uring_seen(&ctx->rx);
+	}
+}
+
+static bool af_mctp_uring_readable(struct pldm_transport_af_mctp_uring *ctx)
+{
+	struct pollfd pollfd = { .fd = ctx->socket, .events = POLLIN };
+
+	return poll(&pollfd, 1, 0) == 1;
+}
+
+/* Copies out the message of a receive completion, and recycles its buffer */
+static pldm_requester_rc_t
+af_mctp_uring_take(struct pldm_transport_af_mctp_uring *ctx,
+		   const struct io_uring_cqe *cqe, struct pldm_transport_msg *msg)
+{
+	const struct io_uring_recvmsg_out *out;
+	const struct sockaddr_mctp *addr;
+	pldm_requester_rc_t res;
+	const uint8_t *payload;
+	uint8_t *buf;
+	uint16_t bid;
+	size_t size;
+	void *copy;
+
+	if (cqe->user_data != AF_MCTP_URING_RECV) {
+		return PLDM_REQUESTER_RECV_FAIL;
+	}
+	if (!(cqe->flags & IORING_CQE_F_MORE)) {
+		ctx->armed = false;
+	}
+	/* No buffer if the receive failed, e.g. as all were in use */
+	if (!(cqe->flags & IORING_CQE_F_BUFFER)) {
+		return PLDM_REQUESTER_RECV_FAIL;
+	}
+
+	bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+	if (bid >= AF_MCTP_URING_ENTRIES) {
+		return PLDM_REQUESTER_RECV_FAIL;
+	}
+	buf = ctx->bufs + bid * ctx->buf_size;
+	out = (const struct io_uring_recvmsg_out *)buf;
+	addr = (const struct sockaddr_mctp *)(buf + sizeof(*out));
+	payload = buf + sizeof(*out) + ctx->recv_hdr.msg_namelen;
+
+	if (cqe->res < 0 || (out->flags & MSG_TRUNC) ||
+	    out->payloadlen < sizeof(struct pldm_msg_hdr)) {
+		res = PLDM_REQUESTER_INVALID_RECV_LEN;
+		goto provide_buf;
+	}
+
+	if (out->namelen < sizeof(*addr) ||
+	    pldm_tid_map_lookup_tid(&ctx->tid_map, addr->smctp_network,
+				    addr->smctp_addr.s_addr, &msg->tid)) {
+		res = PLDM_REQUESTER_RECV_FAIL;
+		goto provide_buf;
+	}
+
+	/* As the other socket transports, drop messages larger than the
+	 * pool's buffers */
+	copy = pldm_transport_rx_lease(&ctx->transport, &size);
+	if (copy && out->payloadlen > size) {
+		pldm_transport_release_msg(&ctx->transport, copy);
+		res = PLDM_REQUESTER_INVALID_RECV_LEN;
+		goto provide_buf;
+	}
+	if (!copy) {
+		copy = malloc(out->payloadlen);
+	}
+	if (!copy) {
+		res = PLDM_REQUESTER_RECV_FAIL;
+		goto provide_buf;
+	}
+
+	memcpy(copy, payload, out->payloadlen);
+	msg->pldm_msg = copy;
+	msg->msg_len = out->payloadlen;
+	res = PLDM_REQUESTER_SUCCESS;
+
+provide_buf:
+	af_mctp_uring_provide(ctx, bid);
+
+	return res;
+}
+
+static int af_mctp_uring_recv_batch(struct pldm_transport *t,
+				    struct pldm_transport_msg *msgs,
+				    size_t count)
+{
+	struct pldm_transport_af_mctp_uring *ctx =
+		transport_to_af_mctp_uring(t);
+	pldm_requester_rc_t res = PLDM_REQUESTER_RECV_FAIL;
+	struct io_uring_cqe *cqe;
+	size_t received = 0;
+
+	for (;;) {
+		while (received < count && (cqe = af_mctp_uring_cqe(&ctx->rx))) {
+			pldm_requester_rc_t taken;
+
+			taken = af_mctp_uring_take(ctx, cqe, &msgs[received]);
+			af_mctp_uring_seen(&ctx->rx);
+			if (taken == PLDM_REQUESTER_SUCCESS) {
+				received++;
+			} else if (!received) {
+				res = taken;
+			}
+		}
+
+		if (ctx->armed) {
+			break;
+		}
+
+		/* The receive ends if the kernel ran out of buffers, leaving
+		 * messages queued on the socket. Once rearmed, take those
+		 * rather than failing the wakeup they caused. */
+		if (af_mctp_uring_arm(ctx) || received) {
+			break;
+		}
+		if (!af_mctp_uring_cqe(&ctx->rx) &&
+		    (!af_mctp_uring_readable(ctx) ||
+		     af_mctp_uring_submit(&ctx->rx, 1))) {
+			break;
+		}
+	}
+
+	return received ? (int)received : res;
+}
+
+static pldm_requester_rc_t af_mctp_uring_recv(struct pldm_transport *t,
+					      pldm_tid_t *tid, void **pldm_msg,
+					      size_t *msg_len)
+{
+	struct pldm_transport_msg msg;
+	int rc;
+
+	rc = af_mctp_uring_recv_batch(t, &msg, 1);
+	if (rc < 0) {
+		return rc;
+	}
+
+	*tid = msg.tid;
+	*pldm_msg = msg.pldm_msg;
+	*msg_len = msg.msg_len;
+
+	return PLDM_REQUESTER_SUCCESS;
+}
+
+/* Queues a send of a copy of @p msg */
+static pldm_requester_rc_t
+af_mctp_uring_prepare(struct pldm_transport_af_mctp_uring *ctx,
+		      const struct pldm_transport_msg *msg)
+{
+	struct af_mctp_uring_send *send;
+	uint32_t network = MCTP_NET_ANY;
+	struct io_uring_sqe *sqe;
+	mctp_eid_t eid = 0;
+
+	if (msg->msg_len < sizeof(struct pldm_msg_hdr) ||
+	    msg->msg_len > INT_MAX) {
+		return PLDM_REQUESTER_SEND_FAIL;
+	}
+
+	if (pldm_tid_map_lookup_eid(&ctx->tid_map, msg->tid, &network, &eid)) {
+		return PLDM_REQUESTER_SEND_FAIL;
+	}
+
+	if (pldm_socket_sndbuf_accomodate(&(ctx->socket_send_buf),
+					  (int)msg->msg_len)) {
+		return PLDM_REQUESTER_SEND_FAIL;
+	}
+
+	sqe = af_mctp_uring_sqe(&ctx->tx);
+	if (!sqe) {
+		return PLDM_REQUESTER_SEND_FAIL;
+	}
+
+	send = malloc(sizeof(*send) + msg->msg_len);
+	if (!send) {
+		return PLDM_REQUESTER_SEND_FAIL;
+	}
+
+	memcpy(send->data, msg->pldm_msg, msg->msg_len);
+	memset(&send->addr, 0, sizeof(send->addr));
+	send->addr.smctp_family = AF_MCTP;
+	send->addr.smctp_network = network;
+	send->addr.smctp_addr.s_addr = eid;
+	send->addr.smctp_type = MCTP_MSG_TYPE_PLDM;
+	send->addr.smctp_tag = MCTP_TAG_OWNER;
+	send->iov.iov_base = send->data;
+	send->iov.iov_len = msg->msg_len;
+	memset(&send->msg, 0, sizeof(send->msg));
+	send->msg.msg_name = &send->addr;
+	send->msg.msg_namelen = sizeof(send->addr);
+	send->msg.msg_iov = &send->iov;
+	send->msg.msg_iovlen = 1;
+
+	sqe->opcode = IORING_OP_SENDMSG;
+	sqe->fd = ctx->socket;
+	sqe->addr = (uintptr_t)&send->msg;
+	sqe->len = 1;
+	sqe->user_data = (uintptr_t)send;
+	af_mctp_uring_queue(&ctx->tx);
+	ctx->sends++;
+
+	return PLDM_REQUESTER_SUCCESS;
+}
+
+static int af_mctp_uring_send_batch(struct pldm_transport *t,
+				    struct pldm_transport_msg *msgs,
+				    size_t count)
+{
+	struct pldm_transport_af_mctp_uring *ctx =
+		transport_to_af_mctp_uring(t);
+	pldm_requester_rc_t res = PLDM_REQUESTER_SUCCESS;
+	size_t sent = 0;
+
+	af_mctp_uring_reap_sends(ctx);
+
+	while (sent < count && res == PLDM_REQUESTER_SUCCESS) {
+		size_t queued = 0;
+
+		/* Fill the ring, then hand the sends over together */
+		while (sent + queued < count && ctx->tx.queued < ctx->tx.entries) {
+			res = af_mctp_uring_prepare(ctx, &msgs[sent + queued]);
+			if (res) {
+				break;
+			}
+			queued++;
+		}
+		if (!queued) {
+			break;
+		}
+
+		if (af_mctp_uring_submit(&ctx->tx, 0)) {
+			while (ctx->tx.queued) {
+				struct io_uring_sqe *sqe;
+
+				sqe = af_mctp_uring_unqueue(&ctx->tx);
+				free((void *)(uintptr_t)sqe->user_data);
+				ctx->sends--;
+			}
+			res = PLDM_REQUESTER_SEND_FAIL;
+			break;
+		}
+		sent += queued;
+	}
+
+	return sent ? (int)sent : res;
+}
+
+static pldm_requester_rc_t af_mctp_uring_send(struct pldm_transport *t,
+					      pldm_tid_t tid,
+					      const void *pldm_msg,
+					      size_t msg_len)
+{
+	struct pldm_transport_msg msg = {
+		.tid = tid,
+		.pldm_msg = (void *)pldm_msg,
+		.msg_len = msg_len,
+	};
+	int rc;
+
+	rc = af_mctp_uring_send_batch(t, &msg, 1);
+
+	return rc == 1 ? PLDM_REQUESTER_SUCCESS : rc;
+}
+
+LIBPLDM_ABI_TESTING
+struct pldm_transport *
+pldm_transport_af_mctp_uring_core(struct pldm_transport_af_mctp_uring *ctx)
+{
+	return &ctx->transport;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_af_mctp_uring_init_pollfd(struct pldm_transport *t,
+					     struct pollfd *pollfd)
+{
+	struct pldm_transport_af_mctp_uring *ctx =
+		transport_to_af_mctp_uring(t);
+
+	/* The ring is readable once it holds receive completions */
+	pollfd->fd = ctx->rx.fd;
+	pollfd->events = POLLIN;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_af_mctp_uring_map_tid(
+	struct pldm_transport_af_mctp_uring *ctx, pldm_tid_t tid,
+	mctp_eid_t eid)
+{
+	return pldm_transport_af_mctp_uring_map_tid_network(ctx, tid,
+							    MCTP_NET_ANY, eid);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_af_mctp_uring_unmap_tid(
+	struct pldm_transport_af_mctp_uring *ctx, pldm_tid_t tid,
+	mctp_eid_t eid)
+{
+	return pldm_transport_af_mctp_uring_unmap_tid_network(
+		ctx, tid, MCTP_NET_ANY, eid);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_af_mctp_uring_map_tid_network(
+	struct pldm_transport_af_mctp_uring *ctx, pldm_tid_t tid,
+	uint32_t network, mctp_eid_t eid)
+{
+	pldm_tid_map_insert(&ctx->tid_map, tid, network, eid);
+
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_af_mctp_uring_unmap_tid_network(
+	struct pldm_transport_af_mctp_uring *ctx,
+	__attribute__((unused)) pldm_tid_t tid, uint32_t network,
+	mctp_eid_t eid)
+{
+	pldm_tid_map_remove(&ctx->tid_map, network, eid);
+
+	return 0;
+}
+
+static void af_mctp_uring_release(struct pldm_transport_af_mctp_uring *ctx)
+{
+	if (ctx->armed) {
+		af_mctp_uring_disarm(ctx);
+	}
+
+	af_mctp_uring_reap_sends(ctx);
+	while (ctx->sends && !af_mctp_uring_submit(&ctx->tx, 1)) {
+		af_mctp_uring_reap_sends(ctx);
+	}
+
+	af_mctp_uring_ring_destroy(&ctx->rx);
+	af_mctp_uring_ring_destroy(&ctx->tx);
+	if (ctx->buf_ring) {
+		munmap(ctx->buf_ring, ctx->buf_ring_len);
+	}
+	free(ctx->bufs);
+	if (ctx->socket >= 0) {
+		close(ctx->socket);
+	}
+	pldm_transport_rx_pool_destroy(&ctx->transport);
+	free(ctx);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_af_mctp_uring_init(struct pldm_transport_af_mctp_uring **ctx,
+				      size_t msg_size)
+{
+	const size_t overhead = sizeof(struct io_uring_recvmsg_out) +
+				sizeof(struct sockaddr_mctp);
+	struct pldm_transport_af_mctp_uring *uring;
+	struct io_uring_buf_reg reg;
+	void *map;
+	int rc;
+
+	if (!ctx || *ctx || !msg_size ||
+	    msg_size > INT_MAX / AF_MCTP_URING_ENTRIES - overhead - 8) {
+		return -EINVAL;
+	}
+
+	uring = calloc(1, sizeof(*uring));
+	if (!uring) {
+		return -ENOMEM;
+	}
+
+	uring->transport.name = AF_MCTP_URING_NAME;
+	uring->transport.version = 1;
+	uring->transport.recv = af_mctp_uring_recv;
+	uring->transport.send = af_mctp_uring_send;
+	uring->transport.init_pollfd = pldm_transport_af_mctp_uring_init_pollfd;
+	uring->transport.send_batch = af_mctp_uring_send_batch;
+	uring->transport.recv_batch = af_mctp_uring_recv_batch;
+	uring->rx.fd = -1;
+	uring->tx.fd = -1;
+
+	uring->socket = socket(AF_MCTP, SOCK_DGRAM, 0);
+	if (uring->socket == -1) {
+		rc = -errno;
+		goto cleanup_uring;
+	}
+
+	if (pldm_socket_sndbuf_init(&uring->socket_send_buf, uring->socket)) {
+		rc = -EIO;
+		goto cleanup_uring;
+	}
+
+	rc = af_mctp_uring_ring_init(&uring->rx, AF_MCTP_URING_ENTRIES);
+	if (rc) {
+		goto cleanup_uring;
+	}
+
+	rc = af_mctp_uring_ring_init(&uring->tx, AF_MCTP_URING_ENTRIES);
+	if (rc) {
+		goto cleanup_uring;
+	}
+
+	/* Room for what recvmsg() lays out ahead of the message */
+	uring->buf_size = (overhead + msg_size + 7) & ~(size_t)7;
+	uring->bufs = malloc(AF_MCTP_URING_ENTRIES * uring->buf_size);
+	if (!uring->bufs) {
+		rc = -ENOMEM;
+		goto cleanup_uring;
+	}
+
+	uring->buf_ring_len = AF_MCTP_URING_ENTRIES * sizeof(struct io_uring_buf);
+	map = mmap(NULL, uring->buf_ring_len, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED) {
+		rc = -ENOMEM;
+		goto cleanup_uring;
+	}
+	uring->buf_ring = map;
+
+	memset(&reg, 0, sizeof(reg));
+	reg.ring_addr = (uintptr_t)uring->buf_ring;
+	reg.ring_entries = AF_MCTP_URING_ENTRIES;
+	reg.bgid = AF_MCTP_URING_BGID;
+	if (af_mctp_uring_register(uring->rx.fd, IORING_REGISTER_PBUF_RING,
+				   &reg, 1) < 0) {
+		rc = -errno;
+		goto cleanup_uring;
+	}
+
+	for (uint16_t bid = 0; bid < AF_MCTP_URING_ENTRIES; bid++) {
+		af_mctp_uring_provide(uring, bid);
+	}
+
+	uring->recv_hdr.msg_namelen = sizeof(struct sockaddr_mctp);
+	rc = af_mctp_uring_arm(uring);
+	if (rc) {
+		goto cleanup_uring;
+	}
+
+	*ctx = uring;
+	return 0;
+
+cleanup_uring:
+	af_mctp_uring_release(uring);
+	return rc;
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_transport_af_mctp_uring_destroy(
+	struct pldm_transport_af_mctp_uring *ctx)
+{
+	if (!ctx) {
+		return;
+	}
+	af_mctp_uring_release(ctx);
+}
@@ -1,8 +1,11 @@
 /* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+/* NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp) */
+#define _GNU_SOURCE
 #include "container-of.h"
 #include "mctp-defines.h"
 #include "responder.h"
 #include "socket.h"
+#include "tid-map.h"
 #include "transport.h"
 
 #include <libpldm/base.h>
@@ -31,10 +34,12 @@ struct pldm_responder_cookie_af_mctp {
 	container_of((c), struct pldm_responder_cookie_af_mctp, req)
 
 #define AF_MCTP_NAME "AF_MCTP"
+/* Messages moved by each sendmmsg() or recvmmsg() */
+#define AF_MCTP_BATCH_MAX 32
 struct pldm_transport_af_mctp {
 	struct pldm_transport transport;
 	int socket;
-	pldm_tid_t tid_eid_map[MCTP_MAX_NUM_EID];
+	struct pldm_tid_map tid_map;
 	struct pldm_socket_sndbuf socket_send_buf;
 	bool bound;
 	struct pldm_responder_cookie cookie_jar;
@@ -60,86 +65,61 @@ int pldm_transport_af_mctp_init_pollfd(struct pldm_transport *t,
 	return 0;
 }
 
-static int pldm_transport_af_mctp_get_eid(struct pldm_transport_af_mctp *ctx,
-					  pldm_tid_t tid, mctp_eid_t *eid)
+LIBPLDM_ABI_STABLE
+int pldm_transport_af_mctp_map_tid(struct pldm_transport_af_mctp *ctx,
+				   pldm_tid_t tid, mctp_eid_t eid)
 {
-	int i;
-	for (i = 0; i < MCTP_MAX_NUM_EID; i++) {
-		if (ctx->tid_eid_map[i] == tid) {
-			*eid = i;
-			return 0;
-		}
-	}
-	*eid = -1;
-	return -1;
+	return pldm_transport_af_mctp_map_tid_network(ctx, tid, MCTP_NET_ANY,
+						      eid);
 }
 
-static int pldm_transport_af_mctp_get_tid(struct pldm_transport_af_mctp *ctx,
-					  mctp_eid_t eid, pldm_tid_t *tid)
+LIBPLDM_ABI_STABLE
+int pldm_transport_af_mctp_unmap_tid(struct pldm_transport_af_mctp *ctx,
+				     pldm_tid_t tid, mctp_eid_t eid)
 {
-	if (ctx->tid_eid_map[eid] != 0) {
-		*tid = ctx->tid_eid_map[eid];
-		return 0;
-	}
-	return -1;
+	return pldm_transport_af_mctp_unmap_tid_network(ctx, tid, MCTP_NET_ANY,
+							eid);
 }
 
-LIBPLDM_ABI_STABLE
-int pldm_transport_af_mctp_map_tid(struct pldm_transport_af_mctp *ctx,
-				   pldm_tid_t tid, mctp_eid_t eid)
+LIBPLDM_ABI_TESTING
+int pldm_transport_af_mctp_map_tid_network(struct pldm_transport_af_mctp *ctx,
+					   pldm_tid_t tid, uint32_t network,
+					   mctp_eid_t eid)
 {
-	ctx->tid_eid_map[eid] = tid;
+	pldm_tid_map_insert(&ctx->tid_map, tid, network, eid);
 
 	return 0;
 }
 
-LIBPLDM_ABI_STABLE
-int pldm_transport_af_mctp_unmap_tid(struct pldm_transport_af_mctp *ctx,
-				     __attribute__((unused)) pldm_tid_t tid,
-				     mctp_eid_t eid)
+LIBPLDM_ABI_TESTING
+int pldm_transport_af_mctp_unmap_tid_network(
+	struct pldm_transport_af_mctp *ctx, __attribute__((unused)) pldm_tid_t tid,
+	uint32_t network, mctp_eid_t eid)
 {
-	ctx->tid_eid_map[eid] = 0;
+	pldm_tid_map_remove(&ctx->tid_map, network, eid);
 
 	return 0;
 }
 
-static pldm_requester_rc_t pldm_transport_af_mctp_recv(struct pldm_transport *t,
-						       pldm_tid_t *tid,
-						       void **pldm_msg,
-						       size_t *msg_len)
+/* Resolves the sender and tracks requests to respond to, once received */
+static pldm_requester_rc_t
+pldm_transport_af_mctp_accept(struct pldm_transport_af_mctp *af_mctp,
+			      const struct sockaddr_mctp *addr, const void *msg,
+			      ssize_t length, pldm_tid_t *tid)
 {
-	struct pldm_transport_af_mctp *af_mctp = transport_to_af_mctp(t);
-	struct sockaddr_mctp addr = { 0 };
-	socklen_t addrlen = sizeof(addr);
-	struct pldm_msg_hdr *hdr;
-	pldm_requester_rc_t res;
+	const struct pldm_msg_hdr *hdr;
 	mctp_eid_t eid = 0;
-	ssize_t length;
-	void *msg;
 	int rc;
 
-	length = recv(af_mctp->socket, NULL, 0, MSG_PEEK | MSG_TRUNC);
-	if (length <= 0) {
-		return PLDM_REQUESTER_RECV_FAIL;
-	}
-
-	msg = malloc(length);
-	if (!msg) {
-		return PLDM_REQUESTER_RECV_FAIL;
-	}
-
-	length = recvfrom(af_mctp->socket, msg, length, MSG_TRUNC,
-			  (struct sockaddr *)&addr, &addrlen);
 	if (length < (ssize_t)sizeof(struct pldm_msg_hdr)) {
-		res = PLDM_REQUESTER_INVALID_RECV_LEN;
-		goto cleanup_msg;
+		return PLDM_REQUESTER_INVALID_RECV_LEN;
 	}
 
-	eid = addr.smctp_addr.s_addr;
-	rc = pldm_transport_af_mctp_get_tid(af_mctp, eid, tid);
+	eid = addr->smctp_addr.s_addr;
+	rc = pldm_tid_map_lookup_tid(&af_mctp->tid_map, addr->smctp_network,
+				     eid, tid);
 	if (rc) {
-		res = PLDM_REQUESTER_RECV_FAIL;
-		goto cleanup_msg;
+		return PLDM_REQUESTER_RECV_FAIL;
 	}
 
 	hdr = msg;
@@ -149,22 +129,71 @@ static pldm_requester_rc_t pldm_transport_af_mctp_recv(struct pldm_transport *t,
 
 		cookie = malloc(sizeof(*cookie));
 		if (!cookie) {
-			res = PLDM_REQUESTER_RECV_FAIL;
-			goto cleanup_msg;
+			return PLDM_REQUESTER_RECV_FAIL;
 		}
 
 		cookie->req.tid = *tid,
 		cookie->req.instance_id = hdr->instance_id,
 		cookie->req.type = hdr->type,
 		cookie->req.command = hdr->command;
-		cookie->smctp = addr;
+		cookie->smctp = *addr;
 
 		rc = pldm_responder_cookie_track(&af_mctp->cookie_jar,
 						 &cookie->req);
 		if (rc) {
+			free(cookie);
+			return PLDM_REQUESTER_RECV_FAIL;
+		}
+	}
+
+	return PLDM_REQUESTER_SUCCESS;
+}
+
+static pldm_requester_rc_t pldm_transport_af_mctp_recv(struct pldm_transport *t,
+						       pldm_tid_t *tid,
+						       void **pldm_msg,
+						       size_t *msg_len)
+{
+	struct pldm_transport_af_mctp *af_mctp = transport_to_af_mctp(t);
+	struct sockaddr_mctp addr = { 0 };
+	socklen_t addrlen = sizeof(addr);
+	pldm_requester_rc_t res;
+	ssize_t length;
+	size_t size;
+	void *msg;
+
+	msg = pldm_transport_rx_lease(t, &size);
+	if (msg) {
+		/* A single recvfrom() into the pool's buffer, which is as
+		 * large as any message expected */
+		length = recvfrom(af_mctp->socket, msg, size, MSG_TRUNC,
+				  (struct sockaddr *)&addr, &addrlen);
+		if (length <= 0) {
 			res = PLDM_REQUESTER_RECV_FAIL;
 			goto cleanup_msg;
 		}
+		if ((size_t)length > size) {
+			res = PLDM_REQUESTER_INVALID_RECV_LEN;
+			goto cleanup_msg;
+		}
+	} else {
+		length = recv(af_mctp->socket, NULL, 0, MSG_PEEK | MSG_TRUNC);
+		if (length <= 0) {
+			return PLDM_REQUESTER_RECV_FAIL;
+		}
+
+		msg = malloc(length);
+		if (!msg) {
+			return PLDM_REQUESTER_RECV_FAIL;
+		}
+
+		length = recvfrom(af_mctp->socket, msg, length, MSG_TRUNC,
+				  (struct sockaddr *)&addr, &addrlen);
+	}
+
+	res = pldm_transport_af_mctp_accept(af_mctp, &addr, msg, length, tid);
+	if (res) {
+		goto cleanup_msg;
 	}
 
 	*pldm_msg = msg;
@@ -173,27 +202,105 @@ static pldm_requester_rc_t pldm_transport_af_mctp_recv(struct pldm_transport *t,
 	return PLDM_REQUESTER_SUCCESS;
 
 cleanup_msg:
-	free(msg);
+	pldm_transport_release_msg(t, msg);
 
 	return res;
 }
 
-static pldm_requester_rc_t pldm_transport_af_mctp_send(struct pldm_transport *t,
-						       pldm_tid_t tid,
-						       const void *pldm_msg,
-						       size_t msg_len)
+static int pldm_transport_af_mctp_recv_batch(struct pldm_transport *t,
+					     struct pldm_transport_msg *msgs,
+					     size_t count)
 {
 	struct pldm_transport_af_mctp *af_mctp = transport_to_af_mctp(t);
+	struct sockaddr_mctp addrs[AF_MCTP_BATCH_MAX];
+	struct mmsghdr hdrs[AF_MCTP_BATCH_MAX];
+	struct iovec iovs[AF_MCTP_BATCH_MAX];
+	pldm_requester_rc_t res = PLDM_REQUESTER_RECV_FAIL;
+	size_t received = 0;
+	size_t n;
+	int rc;
+
+	/* Without a pool there is no bound on the size of a message, so each
+	 * has to be peeked at first */
+	if (!t->rx_pool) {
+		return pldm_transport_recv_batch_loop(t, msgs, count);
+	}
+
+	n = count < AF_MCTP_BATCH_MAX ? count : AF_MCTP_BATCH_MAX;
+	memset(hdrs, 0, sizeof(hdrs));
+	for (size_t i = 0; i < n; i++) {
+		iovs[i].iov_base = pldm_transport_rx_lease(t, &iovs[i].iov_len);
+		if (!iovs[i].iov_base) {
+			n = i;
+			break;
+		}
+		hdrs[i].msg_hdr.msg_name = &addrs[i];
+		hdrs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+		hdrs[i].msg_hdr.msg_iov = &iovs[i];
+		hdrs[i].msg_hdr.msg_iovlen = 1;
+	}
+	if (!n) {
+		return PLDM_REQUESTER_RECV_FAIL;
+	}
+
+	/* Waits for the first message only, then takes those queued behind
+	 * it */
+	rc = recvmmsg(af_mctp->socket, hdrs, n, MSG_WAITFORONE, NULL);
+	for (size_t i = 0; i < n; i++) {
+		struct pldm_transport_msg *msg = &msgs[received];
+		pldm_requester_rc_t accepted;
+
+		if (rc < 0 || i >= (size_t)rc) {
+			pldm_transport_release_msg(t, iovs[i].iov_base);
+			continue;
+		}
+
+		if (hdrs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+			accepted = PLDM_REQUESTER_INVALID_RECV_LEN;
+		} else {
+			accepted = pldm_transport_af_mctp_accept(
+				af_mctp, &addrs[i], iovs[i].iov_base,
+				hdrs[i].msg_len, &msg->tid);
+		}
+		if (accepted) {
+			if (!received) {
+				res = accepted;
+			}
+			pldm_transport_release_msg(t, iovs[i].iov_base);
+			continue;
+		}
+
+		msg->pldm_msg = iovs[i].iov_base;
+		msg->msg_len = hdrs[i].msg_len;
+		received++;
+	}
+
+	return received ? (int)received : res;
+}
+
+/*
+ * Works out where a message goes, the sender of the request if a response.
+ * The cookie of a response is untracked and handed back in @p cookie, to be
+ * settled once it is known whether the response went out.
+ */
+static pldm_requester_rc_t
+pldm_transport_af_mctp_address(struct pldm_transport_af_mctp *af_mctp,
+			       pldm_tid_t tid, const void *pldm_msg,
+			       size_t msg_len, struct sockaddr_mctp *addr,
+			       struct pldm_responder_cookie_af_mctp **cookie)
+{
 	const struct pldm_msg_hdr *hdr;
-	struct sockaddr_mctp addr = { 0 };
 
-	if (msg_len < (ssize_t)sizeof(struct pldm_msg_hdr)) {
+	*cookie = NULL;
+
+	if (msg_len < (ssize_t)sizeof(struct pldm_msg_hdr) ||
+	    msg_len > INT_MAX) {
 		return PLDM_REQUESTER_SEND_FAIL;
 	}
 
+	memset(addr, 0, sizeof(*addr));
 	hdr = pldm_msg;
 	if (af_mctp->bound && !hdr->request) {
-		struct pldm_responder_cookie_af_mctp *cookie;
 		struct pldm_responder_cookie *req;
 
 		req = pldm_responder_cookie_untrack(&af_mctp->cookie_jar, tid,
@@ -203,31 +310,69 @@ static pldm_requester_rc_t pldm_transport_af_mctp_send(struct pldm_transport *t,
 			return PLDM_REQUESTER_SEND_FAIL;
 		}
 
-		cookie = cookie_to_af_mctp(req);
-		addr = cookie->smctp;
+		*cookie = cookie_to_af_mctp(req);
+		*addr = (*cookie)->smctp;
 		/* Clear the TO to indicate a response */
-		addr.smctp_tag &= ~MCTP_TAG_OWNER;
-		free(cookie);
+		addr->smctp_tag &= ~MCTP_TAG_OWNER;
 	} else {
+		uint32_t network = MCTP_NET_ANY;
 		mctp_eid_t eid = 0;
-		if (pldm_transport_af_mctp_get_eid(af_mctp, tid, &eid)) {
+		if (pldm_tid_map_lookup_eid(&af_mctp->tid_map, tid, &network,
+					    &eid)) {
 			return PLDM_REQUESTER_SEND_FAIL;
 		}
 
-		addr.smctp_family = AF_MCTP;
-		addr.smctp_addr.s_addr = eid;
-		addr.smctp_type = MCTP_MSG_TYPE_PLDM;
-		addr.smctp_tag = MCTP_TAG_OWNER;
+		addr->smctp_family = AF_MCTP;
+		addr->smctp_network = network;
+		addr->smctp_addr.s_addr = eid;
+		addr->smctp_type = MCTP_MSG_TYPE_PLDM;
+		addr->smctp_tag = MCTP_TAG_OWNER;
+	}
+
+	return PLDM_REQUESTER_SUCCESS;
+}
+
+/* Drops the cookie of a response that was sent. The request of one that was
+ * not stays tracked, so the response can be sent again. */
+static void
+pldm_transport_af_mctp_settle(struct pldm_transport_af_mctp *af_mctp,
+			      struct pldm_responder_cookie_af_mctp *cookie,
+			      bool sent)
+{
+	if (!cookie) {
+		return;
+	}
+	if (sent ||
+	    pldm_responder_cookie_track(&af_mctp->cookie_jar, &cookie->req)) {
+		free(cookie);
+	}
+}
+
+static pldm_requester_rc_t pldm_transport_af_mctp_send(struct pldm_transport *t,
+						       pldm_tid_t tid,
+						       const void *pldm_msg,
+						       size_t msg_len)
+{
+	struct pldm_transport_af_mctp *af_mctp = transport_to_af_mctp(t);
+	struct pldm_responder_cookie_af_mctp *cookie;
+	struct sockaddr_mctp addr;
+	pldm_requester_rc_t res;
+
+	res = pldm_transport_af_mctp_address(af_mctp, tid, pldm_msg, msg_len,
+					     &addr, &cookie);
+	if (res) {
+		return res;
 	}
 
-	if (msg_len > INT_MAX ||
-	    pldm_socket_sndbuf_accomodate(&(af_mctp->socket_send_buf),
+	if (pldm_socket_sndbuf_accomodate(&(af_mctp->socket_send_buf),
 					  (int)msg_len)) {
+		pldm_transport_af_mctp_settle(af_mctp, cookie, false);
 		return PLDM_REQUESTER_SEND_FAIL;
 	}
 
 	ssize_t rc = sendto(af_mctp->socket, pldm_msg, msg_len, 0,
 			    (struct sockaddr *)&addr, sizeof(addr));
+	pldm_transport_af_mctp_settle(af_mctp, cookie, rc != -1);
 	if (rc == -1) {
 		return PLDM_REQUESTER_SEND_FAIL;
 	}
@@ -235,6 +380,75 @@ static pldm_requester_rc_t pldm_transport_af_mctp_send(struct pldm_transport *t,
 	return PLDM_REQUESTER_SUCCESS;
 }
 
+static int pldm_transport_af_mctp_send_batch(struct pldm_transport *t,
+					     struct pldm_transport_msg *msgs,
+					     size_t count)
+{
+	struct pldm_transport_af_mctp *af_mctp = transport_to_af_mctp(t);
+	struct pldm_responder_cookie_af_mctp *cookies[AF_MCTP_BATCH_MAX];
+	struct sockaddr_mctp addrs[AF_MCTP_BATCH_MAX];
+	struct mmsghdr hdrs[AF_MCTP_BATCH_MAX];
+	struct iovec iovs[AF_MCTP_BATCH_MAX];
+	pldm_requester_rc_t res = PLDM_REQUESTER_SUCCESS;
+	size_t sent = 0;
+
+	while (sent < count && res == PLDM_REQUESTER_SUCCESS) {
+		size_t n = count - sent;
+		size_t largest = 0;
+		int rc = 0;
+
+		if (n > AF_MCTP_BATCH_MAX) {
+			n = AF_MCTP_BATCH_MAX;
+		}
+
+		memset(hdrs, 0, sizeof(hdrs));
+		for (size_t i = 0; i < n; i++) {
+			struct pldm_transport_msg *msg = &msgs[sent + i];
+
+			res = pldm_transport_af_mctp_address(
+				af_mctp, msg->tid, msg->pldm_msg, msg->msg_len,
+				&addrs[i], &cookies[i]);
+			if (res) {
+				n = i;
+				break;
+			}
+			iovs[i].iov_base = msg->pldm_msg;
+			iovs[i].iov_len = msg->msg_len;
+			hdrs[i].msg_hdr.msg_name = &addrs[i];
+			hdrs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+			hdrs[i].msg_hdr.msg_iov = &iovs[i];
+			hdrs[i].msg_hdr.msg_iovlen = 1;
+			if (msg->msg_len > largest) {
+				largest = msg->msg_len;
+			}
+		}
+		if (!n) {
+			break;
+		}
+
+		if (!pldm_socket_sndbuf_accomodate(&(af_mctp->socket_send_buf),
+						   (int)largest)) {
+			rc = sendmmsg(af_mctp->socket, hdrs, n, 0);
+		}
+		if (rc < 0) {
+			rc = 0;
+		}
+
+		/* Responses that did not go out keep their requests tracked */
+		for (size_t i = 0; i < n; i++) {
+			pldm_transport_af_mctp_settle(af_mctp, cookies[i],
+						      i < (size_t)rc);
+		}
+
+		sent += rc;
+		if ((size_t)rc < n) {
+			res = PLDM_REQUESTER_SEND_FAIL;
+		}
+	}
+
+	return sent ? (int)sent : res;
+}
+
 LIBPLDM_ABI_STABLE
 int pldm_transport_af_mctp_init(struct pldm_transport_af_mctp **ctx)
 {
@@ -253,6 +467,8 @@ int pldm_transport_af_mctp_init(struct pldm_transport_af_mctp **ctx)
 	af_mctp->transport.recv = pldm_transport_af_mctp_recv;
 	af_mctp->transport.send = pldm_transport_af_mctp_send;
 	af_mctp->transport.init_pollfd = pldm_transport_af_mctp_init_pollfd;
+	af_mctp->transport.send_batch = pldm_transport_af_mctp_send_batch;
+	af_mctp->transport.recv_batch = pldm_transport_af_mctp_recv_batch;
 	af_mctp->bound = false;
 	af_mctp->cookie_jar.next = NULL;
 	af_mctp->socket = socket(AF_MCTP, SOCK_DGRAM, 0);
@@ -279,6 +495,7 @@ void pldm_transport_af_mctp_destroy(struct pldm_transport_af_mctp *ctx)
 		return;
 	}
 	close(ctx->socket);
+	pldm_transport_rx_pool_destroy(&ctx->transport);
 	free(ctx);
 }
 
@@ -0,0 +1,335 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "array.h"
+
+#include <libpldm/base.h>
+#include <libpldm/pldm.h>
+#include <libpldm/transport.h>
+#include <libpldm/transport/async.h>
+
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Messages taken off the transport per dispatch */
+#define PLDM_TRANSPORT_ASYNC_BATCH 16
+
+struct pldm_transport_async_request {
+	// In the order sent, which with a single timeout is deadline order
+	struct pldm_transport_async_request *prev;
+	struct pldm_transport_async_request *next;
+	// The others outstanding with the same TID and instance ID
+	struct pldm_transport_async_request *chain;
+	uint64_t deadline;
+	struct pldm_msg_hdr hdr;
+	pldm_tid_t tid;
+	pldm_transport_async_response_fn callback;
+	void *arg;
+};
+
+struct pldm_transport_async_device {
+	// Outstanding requests, by instance ID
+	struct pldm_transport_async_request *in_flight[PLDM_INSTANCE_MAX + 1];
+};
+
+struct pldm_transport_async {
+	struct pldm_transport *transport;
+	int timeout_ms;
+	unsigned int pending;
+	pldm_transport_async_request_fn handler;
+	void *handler_arg;
+	struct pldm_transport_async_request *head;
+	struct pldm_transport_async_request *tail;
+	// Allocated on first use, by TID
+	struct pldm_transport_async_device *devices[PLDM_MAX_TIDS];
+};
+
+static uint64_t pldm_transport_async_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+/* The slot of the request matching @p hdr, or the NULL one ending its chain */
+static struct pldm_transport_async_request **
+pldm_transport_async_find(struct pldm_transport_async_device *device,
+			  const struct pldm_msg_hdr *hdr)
+{
+	struct pldm_transport_async_request **slot =
+		&device->in_flight[hdr->instance_id];
+
+	while (*slot && ((*slot)->hdr.type != hdr->type ||
+			 (*slot)->hdr.command != hdr->command)) {
+		slot = &(*slot)->chain;
+	}
+
+	return slot;
+}
+
+/* Stops tracking @p req, whose slot is @p slot */
+static void
+pldm_transport_async_unlink(struct pldm_transport_async *async,
+			    struct pldm_transport_async_request **slot,
+			    struct pldm_transport_async_request *req)
+{
+	*slot = req->chain;
+
+	if (req->prev) {
+		req->prev->next = req->next;
+	} else {
+		async->head = req->next;
+	}
+	if (req->next) {
+		req->next->prev = req->prev;
+	} else {
+		async->tail = req->prev;
+	}
+
+	async->pending--;
+}
+
+static void
+pldm_transport_async_complete(struct pldm_transport_async *async,
+			      struct pldm_transport_async_request *req,
+			      const void *pldm_msg, size_t msg_len, int rc)
+{
+	struct pldm_transport_async_device *device = async->devices[req->tid];
+
+	pldm_transport_async_unlink(
+		async, pldm_transport_async_find(device, &req->hdr), req);
+	req->callback(req->arg, req->tid, pldm_msg, msg_len, rc);
+	free(req);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_async_init(struct pldm_transport_async **async,
+			      struct pldm_transport *transport)
+{
+	struct pldm_transport_async *new;
+
+	if (!async || *async || !transport) {
+		return -EINVAL;
+	}
+
+	new = calloc(1, sizeof(*new));
+	if (!new) {
+		return -ENOMEM;
+	}
+	new->transport = transport;
+	new->timeout_ms = PLDM_TRANSPORT_ASYNC_DEFAULT_TIMEOUT_MS;
+
+	*async = new;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_transport_async_destroy(struct pldm_transport_async *async)
+{
+	if (!async) {
+		return;
+	}
+
+	while (async->head) {
+		pldm_transport_async_complete(async, async->head, NULL, 0,
+					      -ECANCELED);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(async->devices); i++) {
+		free(async->devices[i]);
+	}
+	free(async);
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_async_set_timeout(struct pldm_transport_async *async,
+				     int timeout_ms)
+{
+	if (!async || timeout_ms <= 0) {
+		return -EINVAL;
+	}
+
+	async->timeout_ms = timeout_ms;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_async_set_request_handler(
+	struct pldm_transport_async *async,
+	pldm_transport_async_request_fn handler, void *arg)
+{
+	if (!async) {
+		return -EINVAL;
+	}
+
+	async->handler = handler;
+	async->handler_arg = arg;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_async_send_request(struct pldm_transport_async *async,
+				      pldm_tid_t tid, const void *pldm_msg,
+				      size_t msg_len,
+				      pldm_transport_async_response_fn callback,
+				      void *arg)
+{
+	struct pldm_transport_async_request **slot;
+	struct pldm_transport_async_device *device;
+	struct pldm_transport_async_request *req;
+	const struct pldm_msg_hdr *hdr = pldm_msg;
+	pldm_requester_rc_t rc;
+
+	if (!async || !pldm_msg || msg_len < sizeof(*hdr) || !callback) {
+		return -EINVAL;
+	}
+	if (!hdr->request || hdr->datagram) {
+		return -EINVAL;
+	}
+
+	device = async->devices[tid];
+	if (!device) {
+		device = calloc(1, sizeof(*device));
+		if (!device) {
+			return -ENOMEM;
+		}
+		async->devices[tid] = device;
+	}
+
+	slot = pldm_transport_async_find(device, hdr);
+	if (*slot) {
+		return -EBUSY;
+	}
+
+	req = malloc(sizeof(*req));
+	if (!req) {
+		return -ENOMEM;
+	}
+
+	rc = pldm_transport_send_msg(async->transport, tid, pldm_msg, msg_len);
+	if (rc != PLDM_REQUESTER_SUCCESS) {
+		free(req);
+		return -EIO;
+	}
+
+	req->hdr = *hdr;
+	req->tid = tid;
+	req->callback = callback;
+	req->arg = arg;
+	req->deadline = pldm_transport_async_now() + async->timeout_ms;
+	req->chain = NULL;
+	*slot = req;
+
+	req->prev = async->tail;
+	req->next = NULL;
+	if (async->tail) {
+		async->tail->next = req;
+	} else {
+		async->head = req;
+	}
+	async->tail = req;
+
+	async->pending++;
+	return 0;
+}
+
+LIBPLDM_ABI_TESTING
+unsigned int pldm_transport_async_pending(struct pldm_transport_async *async)
+{
+	return async ? async->pending : 0;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_async_next_timeout(struct pldm_transport_async *async)
+{
+	uint64_t deadline;
+	uint64_t now;
+
+	if (!async || !async->head) {
+		return -1;
+	}
+
+	now = pldm_transport_async_now();
+	deadline = async->head->deadline;
+	if (deadline <= now) {
+		return 0;
+	}
+	return deadline - now > INT_MAX ? INT_MAX : (int)(deadline - now);
+}
+
+static void pldm_transport_async_receive(struct pldm_transport_async *async,
+					 const struct pldm_transport_msg *msg)
+{
+	const struct pldm_msg_hdr *hdr = msg->pldm_msg;
+	struct pldm_transport_async_request **slot;
+	struct pldm_transport_async_device *device;
+	struct pldm_transport_async_request *req;
+
+	if (hdr->request) {
+		if (async->handler) {
+			async->handler(async->handler_arg, msg->tid,
+				       msg->pldm_msg, msg->msg_len);
+		}
+		return;
+	}
+
+	device = async->devices[msg->tid];
+	if (!device) {
+		return;
+	}
+
+	slot = pldm_transport_async_find(device, hdr);
+	req = *slot;
+	if (!req) {
+		return;
+	}
+
+	pldm_transport_async_unlink(async, slot, req);
+	req->callback(req->arg, req->tid, msg->pldm_msg, msg->msg_len, 0);
+	free(req);
+}
+
+static void pldm_transport_async_expire(struct pldm_transport_async *async)
+{
+	uint64_t now = pldm_transport_async_now();
+
+	while (async->head && async->head->deadline <= now) {
+		pldm_transport_async_complete(async, async->head, NULL, 0,
+					      -ETIMEDOUT);
+	}
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_async_dispatch(struct pldm_transport_async *async)
+{
+	struct pldm_transport_msg msgs[PLDM_TRANSPORT_ASYNC_BATCH];
+	int ret = 0;
+	int rc;
+
+	if (!async) {
+		return -EINVAL;
+	}
+
+	/* The socket transports block in recv until a message comes */
+	rc = pldm_transport_poll(async->transport, 0);
+	if (rc < 0) {
+		ret = -EIO;
+	} else if (rc > 0) {
+		rc = pldm_transport_recv_batch(async->transport, msgs,
+					       ARRAY_SIZE(msgs));
+		if (rc == PLDM_REQUESTER_RECV_FAIL) {
+			ret = -EIO;
+		}
+		for (int i = 0; i < rc; i++) {
+			pldm_transport_async_receive(async, &msgs[i]);
+			pldm_transport_release_msg(async->transport,
+						   msgs[i].pldm_msg);
+		}
+	}
+
+	pldm_transport_async_expire(async);
+
+	return ret;
+}
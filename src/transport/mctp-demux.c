@@ -2,6 +2,7 @@
 #include "container-of.h"
 #include "mctp-defines.h"
 #include "socket.h"
+#include "tid-map.h"
 #include "transport.h"
 
 #include <libpldm/base.h>
@@ -25,9 +26,9 @@ const uint8_t mctp_msg_type = MCTP_MSG_TYPE_PLDM;
 struct pldm_transport_mctp_demux {
 	struct pldm_transport transport;
 	int socket;
-	/* In the future this probably needs to move to a tid-eid-uuid/network
-	 * id mapping for multi mctp networks */
-	pldm_tid_t tid_eid_map[MCTP_MAX_NUM_EID];
+	/* The demux daemon serves a single network, so endpoints are all
+	 * mapped on PLDM_TID_MAP_ANY_NETWORK */
+	struct pldm_tid_map tid_map;
 	struct pldm_socket_sndbuf socket_send_buf;
 };
 
@@ -78,38 +79,11 @@ int pldm_transport_mctp_demux_init_pollfd(struct pldm_transport *t,
 	return 0;
 }
 
-static int
-pldm_transport_mctp_demux_get_eid(struct pldm_transport_mctp_demux *ctx,
-				  pldm_tid_t tid, mctp_eid_t *eid)
-{
-	int i;
-	for (i = 0; i < MCTP_MAX_NUM_EID; i++) {
-		if (ctx->tid_eid_map[i] == tid) {
-			*eid = i;
-			return 0;
-		}
-	}
-	*eid = -1;
-	return -1;
-}
-
-static int
-pldm_transport_mctp_demux_get_tid(struct pldm_transport_mctp_demux *ctx,
-				  mctp_eid_t eid, pldm_tid_t *tid)
-{
-	/* mapping exists */
-	if (ctx->tid_eid_map[eid] != 0) {
-		*tid = ctx->tid_eid_map[eid];
-		return 0;
-	}
-	return -1;
-}
-
 LIBPLDM_ABI_STABLE
 int pldm_transport_mctp_demux_map_tid(struct pldm_transport_mctp_demux *ctx,
 				      pldm_tid_t tid, mctp_eid_t eid)
 {
-	ctx->tid_eid_map[eid] = tid;
+	pldm_tid_map_insert(&ctx->tid_map, tid, PLDM_TID_MAP_ANY_NETWORK, eid);
 
 	return 0;
 }
@@ -119,7 +93,7 @@ int pldm_transport_mctp_demux_unmap_tid(struct pldm_transport_mctp_demux *ctx,
 					__attribute__((unused)) pldm_tid_t tid,
 					mctp_eid_t eid)
 {
-	ctx->tid_eid_map[eid] = 0;
+	pldm_tid_map_remove(&ctx->tid_map, PLDM_TID_MAP_ANY_NETWORK, eid);
 
 	return 0;
 }
@@ -144,36 +118,56 @@ pldm_transport_mctp_demux_recv(struct pldm_transport *t, pldm_tid_t *tid,
 
 	min_len = sizeof(eid) + sizeof(mctp_msg_type) +
 		  sizeof(struct pldm_msg_hdr);
-	length = recv(demux->socket, NULL, 0, MSG_PEEK | MSG_TRUNC);
-	if (length <= 0) {
-		return PLDM_REQUESTER_RECV_FAIL;
-	}
 
-	buf = malloc(length);
-	if (buf == NULL) {
-		return PLDM_REQUESTER_RECV_FAIL;
-	}
-
-	if (length < min_len) {
-		/* read and discard */
-		recv(demux->socket, buf, length, 0);
-		res = PLDM_REQUESTER_INVALID_RECV_LEN;
-		goto cleanup_buf;
-	}
-
-	pldm_len = length - mctp_prefix_len;
 	iov[0].iov_len = mctp_prefix_len;
 	iov[0].iov_base = mctp_prefix;
-	iov[1].iov_len = pldm_len;
-	iov[1].iov_base = buf;
-
 	msg.msg_iov = iov;
 	msg.msg_iovlen = sizeof(iov) / sizeof(iov[0]);
 
-	bytes = recvmsg(demux->socket, &msg, 0);
-	if (length != bytes) {
-		res = PLDM_REQUESTER_INVALID_RECV_LEN;
-		goto cleanup_buf;
+	buf = pldm_transport_rx_lease(t, &pldm_len);
+	if (buf) {
+		/* A single recvmsg() into the pool's buffer, which is as large
+		 * as any message expected */
+		iov[1].iov_len = pldm_len;
+		iov[1].iov_base = buf;
+
+		bytes = recvmsg(demux->socket, &msg, 0);
+		if (bytes <= 0) {
+			res = PLDM_REQUESTER_RECV_FAIL;
+			goto cleanup_buf;
+		}
+		if (bytes < min_len || (msg.msg_flags & MSG_TRUNC)) {
+			res = PLDM_REQUESTER_INVALID_RECV_LEN;
+			goto cleanup_buf;
+		}
+		pldm_len = bytes - mctp_prefix_len;
+	} else {
+		length = recv(demux->socket, NULL, 0, MSG_PEEK | MSG_TRUNC);
+		if (length <= 0) {
+			return PLDM_REQUESTER_RECV_FAIL;
+		}
+
+		buf = malloc(length);
+		if (buf == NULL) {
+			return PLDM_REQUESTER_RECV_FAIL;
+		}
+
+		if (length < min_len) {
+			/* read and discard */
+			recv(demux->socket, buf, length, 0);
+			res = PLDM_REQUESTER_INVALID_RECV_LEN;
+			goto cleanup_buf;
+		}
+
+		pldm_len = length - mctp_prefix_len;
+		iov[1].iov_len = pldm_len;
+		iov[1].iov_base = buf;
+
+		bytes = recvmsg(demux->socket, &msg, 0);
+		if (length != bytes) {
+			res = PLDM_REQUESTER_INVALID_RECV_LEN;
+			goto cleanup_buf;
+		}
 	}
 
 	if (mctp_prefix[1] != mctp_msg_type) {
@@ -182,7 +176,8 @@ pldm_transport_mctp_demux_recv(struct pldm_transport *t, pldm_tid_t *tid,
 	}
 
 	eid = mctp_prefix[0];
-	rc = pldm_transport_mctp_demux_get_tid(demux, eid, tid);
+	rc = pldm_tid_map_lookup_tid(&demux->tid_map, PLDM_TID_MAP_ANY_NETWORK,
+				     eid, tid);
 	if (rc) {
 		res = PLDM_REQUESTER_RECV_FAIL;
 		goto cleanup_buf;
@@ -194,7 +189,7 @@ pldm_transport_mctp_demux_recv(struct pldm_transport *t, pldm_tid_t *tid,
 	return PLDM_REQUESTER_SUCCESS;
 
 cleanup_buf:
-	free(buf);
+	pldm_transport_release_msg(t, buf);
 
 	return res;
 }
@@ -204,8 +199,9 @@ pldm_transport_mctp_demux_send(struct pldm_transport *t, pldm_tid_t tid,
 			       const void *pldm_msg, size_t msg_len)
 {
 	struct pldm_transport_mctp_demux *demux = transport_to_demux(t);
+	uint32_t network;
 	mctp_eid_t eid = 0;
-	if (pldm_transport_mctp_demux_get_eid(demux, tid, &eid)) {
+	if (pldm_tid_map_lookup_eid(&demux->tid_map, tid, &network, &eid)) {
 		return PLDM_REQUESTER_SEND_FAIL;
 	}
 
@@ -275,6 +271,7 @@ void pldm_transport_mctp_demux_destroy(struct pldm_transport_mctp_demux *ctx)
 		return;
 	}
 	close(ctx->socket);
+	pldm_transport_rx_pool_destroy(&ctx->transport);
 	free(ctx);
 }
 
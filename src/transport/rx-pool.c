@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "transport.h"
+
+#include <libpldm/transport.h>
+
+#include <errno.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+ * count buffers of size bytes carved from one slab, each stride bytes apart.
+ * The free ones are kept on a stack of their indices.
+ */
+struct pldm_transport_rx_pool {
+	uint8_t *slab;
+	size_t count;
+	size_t size;
+	size_t stride;
+	size_t *free;
+	size_t nfree;
+};
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_rx_pool_init(struct pldm_transport *transport,
+				size_t count, size_t size)
+{
+	struct pldm_transport_rx_pool *pool;
+	size_t stride;
+
+	if (!transport || !count || size < sizeof(struct pldm_msg_hdr)) {
+		return -EINVAL;
+	}
+	if (transport->rx_pool) {
+		return -EBUSY;
+	}
+
+	// Keeps each buffer as aligned as one from malloc()
+	if (size > SIZE_MAX - alignof(max_align_t)) {
+		return -EINVAL;
+	}
+	stride = (size + alignof(max_align_t) - 1) &
+		 ~(alignof(max_align_t) - 1);
+	if (count > SIZE_MAX / stride) {
+		return -EINVAL;
+	}
+
+	pool = calloc(1, sizeof(*pool));
+	if (!pool) {
+		return -ENOMEM;
+	}
+	pool->slab = malloc(count * stride);
+	pool->free = calloc(count, sizeof(*pool->free));
+	if (!pool->slab || !pool->free) {
+		free(pool->slab);
+		free(pool->free);
+		free(pool);
+		return -ENOMEM;
+	}
+
+	pool->count = count;
+	pool->size = size;
+	pool->stride = stride;
+	// Hands out the start of the slab first
+	for (size_t i = 0; i < count; i++) {
+		pool->free[i] = count - 1 - i;
+	}
+	pool->nfree = count;
+
+	transport->rx_pool = pool;
+	return 0;
+}
+
+void *pldm_transport_rx_lease(struct pldm_transport *transport, size_t *size)
+{
+	struct pldm_transport_rx_pool *pool = transport->rx_pool;
+
+	if (!pool) {
+		return NULL;
+	}
+
+	*size = pool->size;
+	if (!pool->nfree) {
+		return malloc(pool->size);
+	}
+	return pool->slab + pool->free[--pool->nfree] * pool->stride;
+}
+
+LIBPLDM_ABI_TESTING
+void pldm_transport_release_msg(struct pldm_transport *transport,
+				void *pldm_msg)
+{
+	struct pldm_transport_rx_pool *pool;
+	uintptr_t offset;
+
+	if (!pldm_msg) {
+		return;
+	}
+
+	pool = transport ? transport->rx_pool : NULL;
+	if (!pool) {
+		free(pldm_msg);
+		return;
+	}
+
+	// Wraps around for buffers below the slab, which came from the heap too
+	offset = (uintptr_t)pldm_msg - (uintptr_t)pool->slab;
+	if (offset >= pool->count * pool->stride) {
+		free(pldm_msg);
+		return;
+	}
+
+	pool->free[pool->nfree++] = offset / pool->stride;
+}
+
+void pldm_transport_rx_pool_destroy(struct pldm_transport *transport)
+{
+	struct pldm_transport_rx_pool *pool = transport->rx_pool;
+
+	if (!pool) {
+		return;
+	}
+
+	free(pool->slab);
+	free(pool->free);
+	free(pool);
+	transport->rx_pool = NULL;
+}
@@ -6,6 +6,8 @@
 #include "transport.h"
 #include "test.h"
 
+#include <libpldm/transport.h>
+
 #include <errno.h>
 #include <poll.h>
 #include <stdlib.h>
@@ -105,6 +107,7 @@ static pldm_requester_rc_t pldm_transport_test_recv(struct pldm_transport *ctx,
 {
 	struct pldm_transport_test *test = transport_to_test(ctx);
 	const struct pldm_transport_test_descriptor *desc;
+	size_t size;
 	void *msg;
 
 	if (test->cursor >= test->count) {
@@ -117,7 +120,17 @@ static pldm_requester_rc_t pldm_transport_test_recv(struct pldm_transport *ctx,
 		return PLDM_REQUESTER_RECV_FAIL;
 	}
 
-	msg = malloc(desc->recv_msg.len);
+	/* As the socket transports, drop messages larger than the pool's
+	 * buffers */
+	msg = pldm_transport_rx_lease(ctx, &size);
+	if (msg && desc->recv_msg.len > size) {
+		pldm_transport_release_msg(ctx, msg);
+		test->cursor++;
+		return PLDM_REQUESTER_INVALID_RECV_LEN;
+	}
+	if (!msg) {
+		msg = malloc(desc->recv_msg.len);
+	}
 	if (!msg) {
 		return PLDM_REQUESTER_RECV_FAIL;
 	}
@@ -140,7 +153,7 @@ static pldm_requester_rc_t pldm_transport_test_send(struct pldm_transport *ctx,
 	struct pldm_transport_test *test = transport_to_test(ctx);
 	const struct pldm_transport_test_descriptor *desc;
 
-	if (test->cursor > test->count) {
+	if (test->cursor >= test->count) {
 		return PLDM_REQUESTER_SEND_FAIL;
 	}
 
@@ -188,6 +201,9 @@ int pldm_transport_test_init(struct pldm_transport_test **ctx,
 	test->transport.recv = pldm_transport_test_recv;
 	test->transport.send = pldm_transport_test_send;
 	test->transport.init_pollfd = pldm_transport_test_init_pollfd;
+	test->transport.send_batch = NULL;
+	test->transport.recv_batch = NULL;
+	test->transport.rx_pool = NULL;
 	test->seq = seq;
 	test->count = count;
 	test->cursor = 0;
@@ -210,5 +226,6 @@ LIBPLDM_ABI_TESTING
 void pldm_transport_test_destroy(struct pldm_transport_test *ctx)
 {
 	close(ctx->timerfd);
+	pldm_transport_rx_pool_destroy(&ctx->transport);
 	free(ctx);
 }
@@ -0,0 +1,134 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#include "tid-map.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+static size_t pldm_tid_map_hash(uint32_t network, mctp_eid_t eid)
+{
+	uint32_t h = (network * 2654435761U) ^ eid;
+
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+
+	return h & (PLDM_TID_MAP_SLOTS - 1);
+}
+
+static bool pldm_tid_map_slot_is(const struct pldm_tid_map *map, size_t slot,
+				 uint32_t network, mctp_eid_t eid)
+{
+	const struct pldm_tid_map_entry *entry = &map->tids[map->slots[slot]];
+
+	return entry->network == network && entry->eid == eid;
+}
+
+/* The slot holding (network, eid), or the free slot ending its probe */
+static size_t pldm_tid_map_find(const struct pldm_tid_map *map,
+				uint32_t network, mctp_eid_t eid)
+{
+	size_t slot = pldm_tid_map_hash(network, eid);
+
+	while (map->slots[slot] &&
+	       !pldm_tid_map_slot_is(map, slot, network, eid)) {
+		slot = (slot + 1) & (PLDM_TID_MAP_SLOTS - 1);
+	}
+
+	return slot;
+}
+
+/* Frees @p slot, moving up the entries probed past it */
+static void pldm_tid_map_free_slot(struct pldm_tid_map *map, size_t slot)
+{
+	size_t next = slot;
+
+	map->tids[map->slots[slot]].mapped = false;
+	map->slots[slot] = 0;
+
+	for (;;) {
+		const struct pldm_tid_map_entry *entry;
+		size_t home;
+
+		next = (next + 1) & (PLDM_TID_MAP_SLOTS - 1);
+		if (!map->slots[next]) {
+			return;
+		}
+
+		entry = &map->tids[map->slots[next]];
+		home = pldm_tid_map_hash(entry->network, entry->eid);
+		/* Stays put if its home lies cyclically in (slot, next] */
+		if (((next - home) & (PLDM_TID_MAP_SLOTS - 1)) <
+		    ((next - slot) & (PLDM_TID_MAP_SLOTS - 1))) {
+			continue;
+		}
+
+		map->slots[slot] = map->slots[next];
+		map->slots[next] = 0;
+		slot = next;
+	}
+}
+
+void pldm_tid_map_remove(struct pldm_tid_map *map, uint32_t network,
+			 mctp_eid_t eid)
+{
+	size_t slot = pldm_tid_map_find(map, network, eid);
+
+	if (map->slots[slot]) {
+		pldm_tid_map_free_slot(map, slot);
+	}
+}
+
+void pldm_tid_map_insert(struct pldm_tid_map *map, pldm_tid_t tid,
+			 uint32_t network, mctp_eid_t eid)
+{
+	struct pldm_tid_map_entry *entry = &map->tids[tid];
+	size_t slot;
+
+	if (entry->mapped) {
+		pldm_tid_map_remove(map, entry->network, entry->eid);
+	}
+
+	pldm_tid_map_remove(map, network, eid);
+	if (!tid) {
+		return;
+	}
+
+	slot = pldm_tid_map_find(map, network, eid);
+	entry->network = network;
+	entry->eid = eid;
+	entry->mapped = true;
+	map->slots[slot] = tid;
+}
+
+int pldm_tid_map_lookup_eid(const struct pldm_tid_map *map, pldm_tid_t tid,
+			    uint32_t *network, mctp_eid_t *eid)
+{
+	const struct pldm_tid_map_entry *entry = &map->tids[tid];
+
+	if (!entry->mapped) {
+		return -1;
+	}
+
+	*network = entry->network;
+	*eid = entry->eid;
+
+	return 0;
+}
+
+int pldm_tid_map_lookup_tid(const struct pldm_tid_map *map, uint32_t network,
+			    mctp_eid_t eid, pldm_tid_t *tid)
+{
+	size_t slot = pldm_tid_map_find(map, network, eid);
+
+	if (!map->slots[slot] && network != PLDM_TID_MAP_ANY_NETWORK) {
+		slot = pldm_tid_map_find(map, PLDM_TID_MAP_ANY_NETWORK, eid);
+	}
+	if (!map->slots[slot]) {
+		return -1;
+	}
+
+	*tid = map->slots[slot];
+
+	return 0;
+}
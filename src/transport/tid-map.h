@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: Apache-2.0 OR GPL-2.0-or-later */
+#ifndef LIBPLDM_SRC_TRANSPORT_TID_MAP_H
+#define LIBPLDM_SRC_TRANSPORT_TID_MAP_H
+
+#include <libpldm/base.h>
+#include <libpldm/pldm.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* As MCTP_NET_ANY, a mapping on it matches the EID on every network */
+#define PLDM_TID_MAP_ANY_NETWORK 0
+
+/* Twice the TIDs there can be, keeping probe sequences short */
+#define PLDM_TID_MAP_SLOTS 512
+
+struct pldm_tid_map_entry {
+	uint32_t network;
+	mctp_eid_t eid;
+	bool mapped;
+};
+
+/*
+ * Maps TIDs to the (network, EID) of their endpoints and back, each way in
+ * constant time. A TID is mapped to one endpoint at most, and the other way
+ * around. Zeroed memory is an empty map.
+ */
+struct pldm_tid_map {
+	/* Indexed by TID */
+	struct pldm_tid_map_entry tids[PLDM_MAX_TIDS];
+	/* Open addressed on (network, EID), holding the TID or 0 if free */
+	pldm_tid_t slots[PLDM_TID_MAP_SLOTS];
+};
+
+/*
+ * Maps @p tid to @p eid on @p network, replacing the mappings either had.
+ * Mapping TID 0 removes the endpoint's mapping, as for the transports'
+ * map_tid().
+ */
+void pldm_tid_map_insert(struct pldm_tid_map *map, pldm_tid_t tid,
+			 uint32_t network, mctp_eid_t eid);
+
+/* Removes the mapping of @p eid on @p network, if any */
+void pldm_tid_map_remove(struct pldm_tid_map *map, uint32_t network,
+			 mctp_eid_t eid);
+
+/* Returns 0 and the endpoint of @p tid, or -1 if it is not mapped */
+int pldm_tid_map_lookup_eid(const struct pldm_tid_map *map, pldm_tid_t tid,
+			    uint32_t *network, mctp_eid_t *eid);
+
+/*
+ * Returns 0 and the TID of @p eid on @p network, falling back to a mapping on
+ * PLDM_TID_MAP_ANY_NETWORK, or -1 if it is not mapped
+ */
+int pldm_tid_map_lookup_tid(const struct pldm_tid_map *map, uint32_t network,
+			    mctp_eid_t eid, pldm_tid_t *tid);
+
+#endif // LIBPLDM_SRC_TRANSPORT_TID_MAP_H
@@ -92,13 +92,91 @@ pldm_requester_rc_t pldm_transport_recv_msg(struct pldm_transport *transport,
 	}
 
 	if (*msg_len < sizeof(struct pldm_msg_hdr)) {
-		free(*pldm_msg);
+		pldm_transport_release_msg(transport, *pldm_msg);
 		*pldm_msg = NULL;
 		return PLDM_REQUESTER_INVALID_RECV_LEN;
 	}
 	return PLDM_REQUESTER_SUCCESS;
 }
 
+LIBPLDM_ABI_TESTING
+int pldm_transport_send_batch(struct pldm_transport *transport,
+			      struct pldm_transport_msg *msgs, size_t count)
+{
+	size_t sent;
+
+	if (!transport || !msgs || count > INT_MAX) {
+		return PLDM_REQUESTER_INVALID_SETUP;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (!msgs[i].pldm_msg) {
+			return PLDM_REQUESTER_INVALID_SETUP;
+		}
+		if (msgs[i].msg_len < sizeof(struct pldm_msg_hdr)) {
+			return PLDM_REQUESTER_NOT_REQ_MSG;
+		}
+	}
+
+	if (transport->send_batch) {
+		return transport->send_batch(transport, msgs, count);
+	}
+
+	for (sent = 0; sent < count; sent++) {
+		pldm_requester_rc_t rc =
+			transport->send(transport, msgs[sent].tid,
+					msgs[sent].pldm_msg, msgs[sent].msg_len);
+		if (rc != PLDM_REQUESTER_SUCCESS) {
+			return sent ? (int)sent : rc;
+		}
+	}
+
+	return (int)sent;
+}
+
+int pldm_transport_recv_batch_loop(struct pldm_transport *transport,
+				   struct pldm_transport_msg *msgs,
+				   size_t count)
+{
+	size_t received;
+
+	for (received = 0; received < count; received++) {
+		struct pldm_transport_msg *msg = &msgs[received];
+		pldm_requester_rc_t rc;
+
+		/* Only the first message is waited for */
+		if (received && pldm_transport_poll(transport, 0) <= 0) {
+			break;
+		}
+
+		rc = pldm_transport_recv_msg(transport, &msg->tid,
+					     &msg->pldm_msg, &msg->msg_len);
+		if (rc != PLDM_REQUESTER_SUCCESS) {
+			if (!received) {
+				return rc;
+			}
+			break;
+		}
+	}
+
+	return (int)received;
+}
+
+LIBPLDM_ABI_TESTING
+int pldm_transport_recv_batch(struct pldm_transport *transport,
+			      struct pldm_transport_msg *msgs, size_t count)
+{
+	if (!transport || !msgs || !count || count > INT_MAX) {
+		return PLDM_REQUESTER_INVALID_SETUP;
+	}
+
+	if (transport->recv_batch) {
+		return transport->recv_batch(transport, msgs, count);
+	}
+
+	return pldm_transport_recv_batch_loop(transport, msgs, count);
+}
+
 static void timespec_to_timeval(const struct timespec *ts, struct timeval *tv)
 {
 	tv->tv_sec = ts->tv_sec;
@@ -183,7 +261,7 @@ pldm_transport_send_recv_msg(struct pldm_transport *transport, pldm_tid_t tid,
 					     resp_msg_len);
 		if (rc == PLDM_REQUESTER_SUCCESS) {
 			/* This isn't the message we wanted */
-			free(*pldm_resp_msg);
+			pldm_transport_release_msg(transport, *pldm_resp_msg);
 		}
 	}
 	if (cnt == (PLDM_INSTANCE_MAX + 1) * PLDM_MAX_TIDS) {
@@ -230,7 +308,7 @@ pldm_transport_send_recv_msg(struct pldm_transport *transport, pldm_tid_t tid,
 
 		if (src_tid != tid || !pldm_msg_hdr_correlate_response(
 					      pldm_req_msg, *pldm_resp_msg)) {
-			free(*pldm_resp_msg);
+			pldm_transport_release_msg(transport, *pldm_resp_msg);
 			continue;
 		}
 
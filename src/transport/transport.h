@@ -4,7 +4,11 @@
 
 #include <libpldm/base.h>
 #include <libpldm/pldm.h>
+
+#include <stddef.h>
 struct pollfd;
+struct pldm_transport_msg;
+struct pldm_transport_rx_pool;
 
 /**
  * @brief Generic PLDM transport struct
@@ -14,6 +18,12 @@ struct pollfd;
  * @var recv - pointer to the transport specific function to receive a message
  * @var send - pointer to the transport specific function to send a message
  * @var init_pollfd - pointer to the transport specific init_pollfd function
+ * @var send_batch - pointer to the transport specific function to send several
+ * messages, or NULL to send them one at a time
+ * @var recv_batch - pointer to the transport specific function to receive
+ * several messages, or NULL to receive them one at a time
+ * @var rx_pool - receive buffers set up by pldm_transport_rx_pool_init(), or
+ * NULL
  */
 struct pldm_transport {
 	const char *name;
@@ -26,6 +36,32 @@ struct pldm_transport {
 				    size_t msg_len);
 	int (*init_pollfd)(struct pldm_transport *transport,
 			   struct pollfd *pollfd);
+	int (*send_batch)(struct pldm_transport *transport,
+			  struct pldm_transport_msg *msgs, size_t count);
+	int (*recv_batch)(struct pldm_transport *transport,
+			  struct pldm_transport_msg *msgs, size_t count);
+	struct pldm_transport_rx_pool *rx_pool;
 };
 
+/* pldm_transport_recv_batch() one message at a time, for any transport */
+int pldm_transport_recv_batch_loop(struct pldm_transport *transport,
+				   struct pldm_transport_msg *msgs,
+				   size_t count);
+
+/**
+ * @brief Lease a receive buffer of the transport's pool
+ *
+ * Falls back to the heap once every buffer of the pool is out. Either way the
+ * buffer goes back through pldm_transport_release_msg().
+ *
+ * @param[in] transport - Transport with a pool
+ * @param[out] size - Set to the size of the buffer
+ *
+ * @return The buffer, or NULL if the transport has no pool or memory ran out
+ */
+void *pldm_transport_rx_lease(struct pldm_transport *transport, size_t *size);
+
+/* Release the transport's pool, for the backends' destroy functions */
+void pldm_transport_rx_pool_destroy(struct pldm_transport *transport);
+
 #endif // LIBPLDM_SRC_TRANSPORT_TRANSPORT_H
@@ -0,0 +1,806 @@
+#include <libpldm/bej.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+struct DictionaryNode
+{
+    uint8_t format;
+    uint16_t sequence;
+    std::string name;
+    std::vector<DictionaryNode> children;
+};
+
+void put16(std::vector<uint8_t>& out, size_t at, uint16_t value)
+{
+    out[at] = value & 0xff;
+    out[at + 1] = value >> 8;
+}
+
+// Lay out a dictionary as DSP0218 describes it: entries in breadth-first
+// order so siblings are contiguous, followed by the names
+std::vector<uint8_t> buildDictionary(const DictionaryNode& root)
+{
+    std::vector<const DictionaryNode*> order = {&root};
+    std::vector<size_t> firstChild;
+
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        firstChild.push_back(order.size());
+        for (const auto& child : order[i]->children)
+        {
+            order.push_back(&child);
+        }
+    }
+
+    size_t entries = 12;
+    size_t names = entries + order.size() * 10;
+    std::vector<uint8_t> out(names);
+    out[0] = 0x00;
+    out[1] = 0x00;
+    put16(out, 2, order.size());
+    out[4] = out[5] = out[6] = out[7] = 0xff;
+
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const DictionaryNode* node = order[i];
+        size_t at = entries + i * 10;
+
+        out[at] = node->format << 4;
+        put16(out, at + 1, node->sequence);
+        put16(out, at + 3,
+              node->children.empty() ? 0 : entries + firstChild[i] * 10);
+        put16(out, at + 5, node->children.size());
+        if (node->name.empty())
+        {
+            out[at + 7] = 0;
+            put16(out, at + 8, 0);
+            continue;
+        }
+        out[at + 7] = node->name.size() + 1;
+        put16(out, at + 8, out.size());
+        out.insert(out.end(), node->name.begin(), node->name.end());
+        out.push_back('\0');
+    }
+
+    uint32_t size = out.size();
+    memcpy(&out[8], &size, sizeof(size));
+    return out;
+}
+
+std::vector<uint8_t> nnint(uint64_t value)
+{
+    std::vector<uint8_t> out = {0};
+    while (value)
+    {
+        out.push_back(value & 0xff);
+        out[0]++;
+        value >>= 8;
+    }
+    if (out[0] == 0)
+    {
+        out = {1, 0};
+    }
+    return out;
+}
+
+std::vector<uint8_t> tuple(uint16_t sequence, bool annotation, uint8_t format,
+                           const std::vector<uint8_t>& value)
+{
+    std::vector<uint8_t> out = nnint((sequence << 1) | annotation);
+    out.push_back(format << 4);
+    auto length = nnint(value.size());
+    out.insert(out.end(), length.begin(), length.end());
+    out.insert(out.end(), value.begin(), value.end());
+    return out;
+}
+
+std::vector<uint8_t> container(const std::vector<std::vector<uint8_t>>& members)
+{
+    std::vector<uint8_t> out = nnint(members.size());
+    for (const auto& member : members)
+    {
+        out.insert(out.end(), member.begin(), member.end());
+    }
+    return out;
+}
+
+std::vector<uint8_t> string(const std::string& value)
+{
+    std::vector<uint8_t> out(value.begin(), value.end());
+    out.push_back('\0');
+    return out;
+}
+
+std::vector<uint8_t> encoding(const std::vector<uint8_t>& root)
+{
+    std::vector<uint8_t> out = {0x00, 0xf0, 0xf0, 0xf1, 0x00, 0x00, 0x00};
+    out.insert(out.end(), root.begin(), root.end());
+    return out;
+}
+
+const DictionaryNode schemaTree = {
+    PLDM_BEJ_FORMAT_SET,
+    0,
+    "DummySimple",
+    {
+        {PLDM_BEJ_FORMAT_ARRAY,
+         0,
+         "ChildArrayProperty",
+         {{PLDM_BEJ_FORMAT_SET,
+           0,
+           "",
+           {{PLDM_BEJ_FORMAT_BOOLEAN, 0, "AnotherBoolean", {}},
+            {PLDM_BEJ_FORMAT_ENUM,
+             1,
+             "LinkStatus",
+             {{PLDM_BEJ_FORMAT_STRING, 0, "LinkDown", {}},
+              {PLDM_BEJ_FORMAT_STRING, 1, "LinkUp", {}},
+              {PLDM_BEJ_FORMAT_STRING, 2, "NoLink", {}}}}}}}},
+        {PLDM_BEJ_FORMAT_STRING, 1, "Id", {}},
+        {PLDM_BEJ_FORMAT_INTEGER, 2, "SampleIntegerProperty", {}},
+        {PLDM_BEJ_FORMAT_REAL, 3, "SampleRealProperty", {}},
+        {PLDM_BEJ_FORMAT_BYTE_STRING, 4, "Blob", {}},
+        {PLDM_BEJ_FORMAT_RESOURCE_LINK, 5, "Chassis", {}},
+        {PLDM_BEJ_FORMAT_STRING, 6, "Description", {}},
+    }};
+
+const DictionaryNode annotationTree = {
+    PLDM_BEJ_FORMAT_SET,
+    0,
+    "Annotations",
+    {
+        {PLDM_BEJ_FORMAT_STRING, 0, "@odata.id", {}},
+        {PLDM_BEJ_FORMAT_INTEGER, 1, "@odata.count", {}},
+    }};
+
+std::vector<uint8_t> dummySimple()
+{
+    // Array members are numbered by position
+    auto member = [](uint16_t index, bool flag, uint8_t status) {
+        return tuple(index, false, PLDM_BEJ_FORMAT_SET,
+                     container({tuple(0, false, PLDM_BEJ_FORMAT_BOOLEAN,
+                                      {flag}),
+                                tuple(1, false, PLDM_BEJ_FORMAT_ENUM,
+                                      nnint(status))}));
+    };
+
+    return encoding(tuple(
+        0, false, PLDM_BEJ_FORMAT_SET,
+        container({
+            tuple(0, true, PLDM_BEJ_FORMAT_STRING,
+                  string("/redfish/v1/Dummy/1")),
+            tuple(0, false, PLDM_BEJ_FORMAT_ARRAY,
+                  container({member(0, true, 1), member(1, false, 2)})),
+            tuple(0, false, PLDM_BEJ_FORMAT_PROPERTY_ANNOTATION,
+                  tuple(1, true, PLDM_BEJ_FORMAT_INTEGER, {2})),
+            tuple(1, false, PLDM_BEJ_FORMAT_STRING, string("Dummy \"1\"\n")),
+            tuple(2, false, PLDM_BEJ_FORMAT_INTEGER, {0x18, 0xfc}),
+            // 1.05e2: whole 1, one leading zero, fraction 5, exponent 2
+            tuple(3, false, PLDM_BEJ_FORMAT_REAL,
+                  {1, 1, 1, 1, 1, 1, 5, 1, 1, 2}),
+            tuple(4, false, PLDM_BEJ_FORMAT_BYTE_STRING, {'a', 'b', 'c', 'd'}),
+            tuple(5, false, PLDM_BEJ_FORMAT_RESOURCE_LINK, nnint(0x1234)),
+        })));
+}
+
+const std::string dummySimpleJson =
+    "{\"@odata.id\":\"/redfish/v1/Dummy/1\","
+    "\"ChildArrayProperty\":[{\"AnotherBoolean\":true,\"LinkStatus\":"
+    "\"LinkUp\"},{\"AnotherBoolean\":false,\"LinkStatus\":\"NoLink\"}],"
+    "\"ChildArrayProperty@odata.count\":2,"
+    "\"Id\":\"Dummy \\\"1\\\"\\n\","
+    "\"SampleIntegerProperty\":-1000,"
+    "\"SampleRealProperty\":1.05e2,"
+    "\"Blob\":\"YWJjZA==\","
+    "\"Chassis\":\"4660\"}";
+
+class BejDecoder : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        schemaData = buildDictionary(schemaTree);
+        annotationData = buildDictionary(annotationTree);
+        schema = {schemaData.data(), schemaData.size()};
+        annotation = {annotationData.data(), annotationData.size()};
+        ASSERT_EQ(pldm_bej_json_writer_init(&writer, append, &json), 0);
+        ASSERT_EQ(pldm_bej_decoder_init(&decoder, &schema, &annotation,
+                                        pldm_bej_json_writer_token, &writer),
+                  0);
+    }
+
+    static int append(void* arg, const char* data, size_t length)
+    {
+        static_cast<std::string*>(arg)->append(data, length);
+        return 0;
+    }
+
+    int decode(const std::vector<uint8_t>& payload, size_t chunk)
+    {
+        for (size_t i = 0; i < payload.size(); i += chunk)
+        {
+            int rc = pldm_bej_decoder_push(
+                &decoder, payload.data() + i,
+                std::min(chunk, payload.size() - i));
+            if (rc)
+            {
+                return rc;
+            }
+        }
+        int rc = pldm_bej_decoder_finish(&decoder);
+        return rc ? rc : pldm_bej_json_writer_flush(&writer);
+    }
+
+    std::vector<uint8_t> schemaData;
+    std::vector<uint8_t> annotationData;
+    struct pldm_bej_dictionary schema;
+    struct pldm_bej_dictionary annotation;
+    struct pldm_bej_json_writer writer;
+    struct pldm_bej_decoder decoder;
+    std::string json;
+};
+
+} // namespace
+
+TEST_F(BejDecoder, DecodesToJson)
+{
+    EXPECT_EQ(decode(dummySimple(), SIZE_MAX), 0);
+    EXPECT_EQ(json, dummySimpleJson);
+}
+
+TEST_F(BejDecoder, ChunkBoundariesDoNotMatter)
+{
+    auto payload = dummySimple();
+
+    for (size_t chunk : {1, 2, 3, 7, 64})
+    {
+        json.clear();
+        ASSERT_EQ(pldm_bej_json_writer_init(&writer, append, &json), 0);
+        ASSERT_EQ(pldm_bej_decoder_init(&decoder, &schema, &annotation,
+                                        pldm_bej_json_writer_token, &writer),
+                  0);
+        EXPECT_EQ(decode(payload, chunk), 0);
+        EXPECT_EQ(json, dummySimpleJson) << "chunk size " << chunk;
+    }
+}
+
+TEST_F(BejDecoder, LongStringsStreamInFragments)
+{
+    std::string description(1000, 'x');
+    auto payload = encoding(
+        tuple(0, false, PLDM_BEJ_FORMAT_SET,
+              container({tuple(6, false, PLDM_BEJ_FORMAT_STRING,
+                               string(description))})));
+    struct Fragments
+    {
+        size_t tokens;
+        std::string value;
+        bool sawMore;
+    } fragments = {};
+
+    ASSERT_EQ(pldm_bej_decoder_init(
+                  &decoder, &schema, NULL,
+                  [](void* arg, const struct pldm_bej_token* token) {
+                      auto f = static_cast<Fragments*>(arg);
+                      if (token->type != PLDM_BEJ_TOKEN_STRING)
+                      {
+                          return 0;
+                      }
+                      EXPECT_EQ(token->continued, f->tokens != 0);
+                      f->tokens++;
+                      f->sawMore |= token->more;
+                      f->value.append(
+                          reinterpret_cast<const char*>(token->value.bytes.data),
+                          token->value.bytes.length);
+                      return 0;
+                  },
+                  &fragments),
+              0);
+
+    for (size_t i = 0; i < payload.size(); i += 100)
+    {
+        ASSERT_EQ(pldm_bej_decoder_push(&decoder, payload.data() + i,
+                                        std::min<size_t>(100,
+                                                         payload.size() - i)),
+                  0);
+    }
+    ASSERT_EQ(pldm_bej_decoder_finish(&decoder), 0);
+    EXPECT_GT(fragments.tokens, 1);
+    EXPECT_TRUE(fragments.sawMore);
+    EXPECT_EQ(fragments.value, description);
+}
+
+TEST_F(BejDecoder, TruncatedPayloadFails)
+{
+    auto payload = dummySimple();
+    payload.pop_back();
+
+    EXPECT_EQ(decode(payload, SIZE_MAX), -EPROTO);
+}
+
+TEST_F(BejDecoder, MemberOverrunningContainerFails)
+{
+    // The set's length does not cover its member
+    auto member = tuple(2, false, PLDM_BEJ_FORMAT_INTEGER, {1});
+    std::vector<uint8_t> root = {0x01, 0x00, PLDM_BEJ_FORMAT_SET << 4};
+    auto length = nnint(member.size());
+    root.insert(root.end(), length.begin(), length.end());
+    auto count = nnint(1);
+    root.insert(root.end(), count.begin(), count.end());
+    root.insert(root.end(), member.begin(), member.end());
+
+    EXPECT_EQ(decode(encoding(root), SIZE_MAX), -EPROTO);
+}
+
+TEST_F(BejDecoder, UnknownPropertyFails)
+{
+    auto payload = encoding(tuple(
+        0, false, PLDM_BEJ_FORMAT_SET,
+        container({tuple(42, false, PLDM_BEJ_FORMAT_INTEGER, {1})})));
+
+    EXPECT_EQ(decode(payload, SIZE_MAX), -EPROTO);
+    // Errors stick
+    EXPECT_EQ(pldm_bej_decoder_push(&decoder, payload.data(), 1), -EPROTO);
+}
+
+TEST_F(BejDecoder, DeepNestingIsBounded)
+{
+    // An array whose members are arrays of the same kind
+    DictionaryNode nested = {PLDM_BEJ_FORMAT_ARRAY, 0, "Nested", {}};
+    auto data = buildDictionary(nested);
+    put16(data, 12 + 3, 12);
+    put16(data, 12 + 5, 1);
+    struct pldm_bej_dictionary dictionary = {data.data(), data.size()};
+
+    std::vector<uint8_t> value = tuple(0, false, PLDM_BEJ_FORMAT_ARRAY,
+                                       nnint(0));
+    for (int i = 0; i < PLDM_BEJ_MAX_DEPTH; i++)
+    {
+        value = tuple(0, false, PLDM_BEJ_FORMAT_ARRAY, container({value}));
+    }
+
+    ASSERT_EQ(pldm_bej_decoder_init(&decoder, &dictionary, NULL,
+                                    pldm_bej_json_writer_token, &writer),
+              0);
+    EXPECT_EQ(decode(encoding(value), SIZE_MAX), -EOVERFLOW);
+}
+
+TEST_F(BejDecoder, LeadingZerosAreBounded)
+{
+    auto real = [](uint64_t leadingZeros) {
+        // whole 1, fraction 5, no exponent
+        std::vector<uint8_t> value = {1, 1, 1};
+        auto zeros = nnint(leadingZeros);
+        value.insert(value.end(), zeros.begin(), zeros.end());
+        value.insert(value.end(), {1, 5, 1, 0});
+        return encoding(tuple(
+            0, false, PLDM_BEJ_FORMAT_SET,
+            container({tuple(3, false, PLDM_BEJ_FORMAT_REAL, value)})));
+    };
+
+    EXPECT_EQ(decode(real(PLDM_BEJ_MAX_LEADING_ZEROS), SIZE_MAX), 0);
+    EXPECT_EQ(json, "{\"SampleRealProperty\":1." +
+                        std::string(PLDM_BEJ_MAX_LEADING_ZEROS, '0') + "5}");
+
+    ASSERT_EQ(pldm_bej_decoder_init(&decoder, &schema, &annotation,
+                                    pldm_bej_json_writer_token, &writer),
+              0);
+    EXPECT_EQ(decode(real(PLDM_BEJ_MAX_LEADING_ZEROS + 1), SIZE_MAX),
+              -EOVERFLOW);
+    EXPECT_EQ(decode(real(UINT64_MAX), SIZE_MAX), -EOVERFLOW);
+}
+
+TEST_F(BejDecoder, EmptyByteString)
+{
+    auto payload = encoding(
+        tuple(0, false, PLDM_BEJ_FORMAT_SET,
+              container({tuple(4, false, PLDM_BEJ_FORMAT_BYTE_STRING, {})})));
+
+    EXPECT_EQ(decode(payload, SIZE_MAX), 0);
+    EXPECT_EQ(json, "{\"Blob\":\"\"}");
+}
+
+TEST(BejDictionary, RejectsEntriesOutsideTheDictionary)
+{
+    auto data = buildDictionary(schemaTree);
+    struct pldm_bej_dictionary dictionary = {data.data(), data.size()};
+
+    EXPECT_EQ(pldm_bej_dictionary_validate(&dictionary), 0);
+    EXPECT_EQ(pldm_bej_dictionary_validate(NULL), -EINVAL);
+
+    // Child pointer past the entry table
+    auto broken = data;
+    put16(broken, 12 + 3, 0xfff0);
+    dictionary.data = broken.data();
+    EXPECT_EQ(pldm_bej_dictionary_validate(&dictionary), -EPROTO);
+
+    // Dictionary size larger than the blob
+    dictionary.data = data.data();
+    dictionary.length = data.size() - 1;
+    EXPECT_EQ(pldm_bej_dictionary_validate(&dictionary), -EPROTO);
+}
+
+namespace
+{
+
+class BejEncoder : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        schemaData = buildDictionary(schemaTree);
+        annotationData = buildDictionary(annotationTree);
+        struct pldm_bej_dictionary schema = {schemaData.data(),
+                                             schemaData.size()};
+        struct pldm_bej_dictionary annotation = {annotationData.data(),
+                                                 annotationData.size()};
+        ASSERT_EQ(pldm_bej_dictionary_index_build(&schema, &schemaIndex), 0);
+        ASSERT_EQ(
+            pldm_bej_dictionary_index_build(&annotation, &annotationIndex),
+            0);
+        buffer.resize(512);
+        ASSERT_EQ(pldm_bej_encoder_init(&encoder, schemaIndex,
+                                        annotationIndex, buffer.data(),
+                                        buffer.size()),
+                  0);
+    }
+
+    void TearDown() override
+    {
+        pldm_bej_dictionary_index_free(schemaIndex);
+        pldm_bej_dictionary_index_free(annotationIndex);
+    }
+
+    std::vector<uint8_t> encoded()
+    {
+        size_t length = 0;
+        EXPECT_EQ(pldm_bej_encoder_finish(&encoder, &length), 0);
+        return {buffer.begin(), buffer.begin() + length};
+    }
+
+    std::vector<uint8_t> schemaData;
+    std::vector<uint8_t> annotationData;
+    struct pldm_bej_dictionary_index* schemaIndex = nullptr;
+    struct pldm_bej_dictionary_index* annotationIndex = nullptr;
+    std::vector<uint8_t> buffer;
+    struct pldm_bej_encoder encoder;
+};
+
+} // namespace
+
+TEST_F(BejEncoder, EncodesDummySimple)
+{
+    const uint8_t blob[] = {'a', 'b', 'c', 'd'};
+
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_string(&encoder, "@odata.id",
+                                      "/redfish/v1/Dummy/1"),
+              0);
+    EXPECT_EQ(pldm_bej_encoder_begin_array(&encoder, "ChildArrayProperty"),
+              0);
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_boolean(&encoder, "AnotherBoolean", true), 0);
+    EXPECT_EQ(pldm_bej_encoder_enum(&encoder, "LinkStatus", "LinkUp"), 0);
+    EXPECT_EQ(pldm_bej_encoder_end(&encoder), 0);
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_boolean(&encoder, "AnotherBoolean", false), 0);
+    EXPECT_EQ(pldm_bej_encoder_enum(&encoder, "LinkStatus", "NoLink"), 0);
+    EXPECT_EQ(pldm_bej_encoder_end(&encoder), 0);
+    EXPECT_EQ(pldm_bej_encoder_end(&encoder), 0);
+    EXPECT_EQ(pldm_bej_encoder_integer(&encoder,
+                                       "ChildArrayProperty@odata.count", 2),
+              0);
+    EXPECT_EQ(pldm_bej_encoder_string(&encoder, "Id", "Dummy \"1\"\n"), 0);
+    EXPECT_EQ(
+        pldm_bej_encoder_integer(&encoder, "SampleIntegerProperty", -1000), 0);
+    EXPECT_EQ(
+        pldm_bej_encoder_real(&encoder, "SampleRealProperty", 1, 1, 5, 2), 0);
+    EXPECT_EQ(pldm_bej_encoder_byte_string(&encoder, "Blob", blob,
+                                           sizeof(blob)),
+              0);
+    EXPECT_EQ(pldm_bej_encoder_resource_link(&encoder, "Chassis", 0x1234), 0);
+    EXPECT_EQ(pldm_bej_encoder_end(&encoder), 0);
+
+    EXPECT_EQ(encoded(), dummySimple());
+}
+
+TEST_F(BejEncoder, UnknownNamesFail)
+{
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_string(&encoder, "Name", "x"), -ENOENT);
+    // Errors stick
+    EXPECT_EQ(pldm_bej_encoder_string(&encoder, "Id", "x"), -ENOENT);
+
+    ASSERT_EQ(pldm_bej_encoder_init(&encoder, schemaIndex, annotationIndex,
+                                    buffer.data(), buffer.size()),
+              0);
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_begin_array(&encoder, "ChildArrayProperty"),
+              0);
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_enum(&encoder, "LinkStatus", "Unplugged"),
+              -ENOENT);
+}
+
+TEST_F(BejEncoder, MismatchedFormatsFail)
+{
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_null(&encoder, "Id"), 0);
+    EXPECT_EQ(pldm_bej_encoder_integer(&encoder, "Id", 1), -EINVAL);
+}
+
+TEST_F(BejEncoder, IncompleteDocumentsFail)
+{
+    size_t length;
+
+    EXPECT_EQ(pldm_bej_encoder_finish(&encoder, &length), -EINVAL);
+
+    ASSERT_EQ(pldm_bej_encoder_init(&encoder, schemaIndex, annotationIndex,
+                                    buffer.data(), buffer.size()),
+              0);
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_finish(&encoder, &length), -EINVAL);
+
+    ASSERT_EQ(pldm_bej_encoder_init(&encoder, schemaIndex, annotationIndex,
+                                    buffer.data(), buffer.size()),
+              0);
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_end(&encoder), 0);
+    EXPECT_EQ(pldm_bej_encoder_end(&encoder), -EINVAL);
+}
+
+TEST_F(BejEncoder, SmallBufferFails)
+{
+    ASSERT_EQ(pldm_bej_encoder_init(&encoder, schemaIndex, annotationIndex,
+                                    buffer.data(), 32),
+              0);
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    EXPECT_EQ(pldm_bej_encoder_string(&encoder, "Id", "a long identifier"),
+              -ENOBUFS);
+}
+
+TEST(BejEncoderLarge, ManyPropertiesRoundTrip)
+{
+    DictionaryNode root = {PLDM_BEJ_FORMAT_SET, 0, "Large", {}};
+    for (uint16_t i = 0; i < 2000; i++)
+    {
+        root.children.push_back({PLDM_BEJ_FORMAT_INTEGER, i,
+                                 "Property" + std::to_string(i), {}});
+    }
+    auto data = buildDictionary(root);
+    struct pldm_bej_dictionary dictionary = {data.data(), data.size()};
+    struct pldm_bej_dictionary_index* index;
+    ASSERT_EQ(pldm_bej_dictionary_index_build(&dictionary, &index), 0);
+
+    std::vector<uint8_t> buffer(64 * 1024);
+    struct pldm_bej_encoder encoder;
+    ASSERT_EQ(pldm_bej_encoder_init(&encoder, index, NULL, buffer.data(),
+                                    buffer.size()),
+              0);
+    std::string expected = "{";
+    EXPECT_EQ(pldm_bej_encoder_begin_object(&encoder, NULL), 0);
+    for (int i = 1999; i >= 0; i--)
+    {
+        std::string name = "Property" + std::to_string(i);
+        EXPECT_EQ(pldm_bej_encoder_integer(&encoder, name.c_str(), i * 1000),
+                  0);
+        expected += (i == 1999 ? "\"" : ",\"") + name +
+                    "\":" + std::to_string(i * 1000);
+    }
+    expected += "}";
+    EXPECT_EQ(pldm_bej_encoder_end(&encoder), 0);
+    size_t length;
+    ASSERT_EQ(pldm_bej_encoder_finish(&encoder, &length), 0);
+    pldm_bej_dictionary_index_free(index);
+
+    std::string json;
+    struct pldm_bej_json_writer writer;
+    struct pldm_bej_decoder decoder;
+    auto append = [](void* arg, const char* data, size_t length) {
+        static_cast<std::string*>(arg)->append(data, length);
+        return 0;
+    };
+    ASSERT_EQ(pldm_bej_json_writer_init(&writer, append, &json), 0);
+    ASSERT_EQ(pldm_bej_decoder_init(&decoder, &dictionary, NULL,
+                                    pldm_bej_json_writer_token, &writer),
+              0);
+    EXPECT_EQ(pldm_bej_decoder_push(&decoder, buffer.data(), length), 0);
+    EXPECT_EQ(pldm_bej_decoder_finish(&decoder), 0);
+    EXPECT_EQ(pldm_bej_json_writer_flush(&writer), 0);
+    EXPECT_EQ(json, expected);
+}
+
+TEST(BejDictionaryIndex, ResolvesChildren)
+{
+    // Children listed out of sequence number order
+    DictionaryNode root = {PLDM_BEJ_FORMAT_SET,
+                           0,
+                           "Shuffled",
+                           {{PLDM_BEJ_FORMAT_STRING, 2, "Two", {}},
+                            {PLDM_BEJ_FORMAT_STRING, 0, "Zero", {}},
+                            {PLDM_BEJ_FORMAT_BOOLEAN, 1, "One", {}}}};
+    auto data = buildDictionary(root);
+    struct pldm_bej_dictionary dictionary = {data.data(), data.size()};
+    struct pldm_bej_dictionary_index* index;
+    struct pldm_bej_dictionary_entry entry;
+    uint16_t child;
+
+    ASSERT_EQ(pldm_bej_dictionary_index_build(&dictionary, &index), 0);
+
+    ASSERT_EQ(pldm_bej_dictionary_index_entry(index, PLDM_BEJ_DICTIONARY_ROOT,
+                                              &entry),
+              0);
+    EXPECT_EQ(entry.format, PLDM_BEJ_FORMAT_SET);
+    EXPECT_STREQ(entry.name, "Shuffled");
+    EXPECT_EQ(entry.children, 1);
+    EXPECT_EQ(entry.child_count, 3);
+
+    for (uint16_t sequence = 0; sequence < 3; sequence++)
+    {
+        ASSERT_EQ(pldm_bej_dictionary_index_child(
+                      index, PLDM_BEJ_DICTIONARY_ROOT, sequence, &child),
+                  0);
+        ASSERT_EQ(pldm_bej_dictionary_index_entry(index, child, &entry), 0);
+        EXPECT_EQ(entry.sequence, sequence);
+    }
+    EXPECT_EQ(pldm_bej_dictionary_index_child(index, PLDM_BEJ_DICTIONARY_ROOT,
+                                              3, &child),
+              -ENOENT);
+
+    ASSERT_EQ(pldm_bej_dictionary_index_find(index, PLDM_BEJ_DICTIONARY_ROOT,
+                                             "One", &child),
+              0);
+    ASSERT_EQ(pldm_bej_dictionary_index_entry(index, child, &entry), 0);
+    EXPECT_EQ(entry.format, PLDM_BEJ_FORMAT_BOOLEAN);
+    EXPECT_EQ(entry.sequence, 1);
+    EXPECT_EQ(pldm_bej_dictionary_index_find(index, PLDM_BEJ_DICTIONARY_ROOT,
+                                             "On", &child),
+              -ENOENT);
+    EXPECT_EQ(pldm_bej_dictionary_index_entry(index, 4, &entry), -ENOENT);
+
+    pldm_bej_dictionary_index_free(index);
+}
+
+TEST(BejDictionaryIndex, LoadsImageInPlace)
+{
+    auto data = buildDictionary(schemaTree);
+    struct pldm_bej_dictionary dictionary = {data.data(), data.size()};
+    struct pldm_bej_dictionary_index* built;
+    const struct pldm_bej_dictionary_index* loaded;
+    uint16_t child;
+
+    ASSERT_EQ(pldm_bej_dictionary_index_build(&dictionary, &built), 0);
+    size_t size = pldm_bej_dictionary_index_size(built);
+    std::vector<uint64_t> image((size + 7) / 8 + 1);
+    memcpy(image.data(), built, size);
+    pldm_bej_dictionary_index_free(built);
+
+    ASSERT_EQ(pldm_bej_dictionary_index_load(image.data(), size, &loaded), 0);
+    EXPECT_EQ(pldm_bej_dictionary_index_find(loaded, PLDM_BEJ_DICTIONARY_ROOT,
+                                             "Chassis", &child),
+              0);
+
+    EXPECT_EQ(pldm_bej_dictionary_index_load(image.data(), size - 1, &loaded),
+              -EPROTO);
+    EXPECT_EQ(pldm_bej_dictionary_index_load(
+                  reinterpret_cast<uint8_t*>(image.data()) + 1, size, &loaded),
+              -EINVAL);
+
+    // The entry arrays must agree with the dictionary they were built from
+    auto* bytes = reinterpret_cast<uint8_t*>(image.data());
+    struct pldm_bej_dictionary copy;
+    ASSERT_EQ(pldm_bej_dictionary_index_load(image.data(), size, &loaded), 0);
+    ASSERT_EQ(pldm_bej_dictionary_index_dictionary(loaded, &copy), 0);
+    size_t sequence = copy.data - bytes + 12 + 10 + 1;
+    bytes[sequence] ^= 1;
+    EXPECT_EQ(pldm_bej_dictionary_index_load(image.data(), size, &loaded),
+              -EPROTO);
+}
+
+TEST_F(BejDecoder, DecodesThroughIndexes)
+{
+    struct pldm_bej_dictionary_index* schemaIndex;
+    struct pldm_bej_dictionary_index* annotationIndex;
+
+    ASSERT_EQ(pldm_bej_dictionary_index_build(&schema, &schemaIndex), 0);
+    ASSERT_EQ(pldm_bej_dictionary_index_build(&annotation, &annotationIndex),
+              0);
+    ASSERT_EQ(pldm_bej_decoder_init_indexed(&decoder, schemaIndex,
+                                            annotationIndex,
+                                            pldm_bej_json_writer_token,
+                                            &writer),
+              0);
+
+    EXPECT_EQ(decode(dummySimple(), SIZE_MAX), 0);
+    EXPECT_EQ(json, dummySimpleJson);
+
+    pldm_bej_dictionary_index_free(schemaIndex);
+    pldm_bej_dictionary_index_free(annotationIndex);
+}
+
+static bool resolve_chassis(void* arg, uint32_t resource_id,
+                            const uint8_t** encoding, size_t* length)
+{
+    auto chassis = static_cast<const std::vector<uint8_t>*>(arg);
+    if (resource_id != 0x1234)
+    {
+        return false;
+    }
+    *encoding = chassis->data();
+    *length = chassis->size();
+    return true;
+}
+
+TEST(BejExpand, ReplacesResolvedLinks)
+{
+    auto chassis = encoding(tuple(
+        0, false, PLDM_BEJ_FORMAT_SET,
+        container({tuple(1, false, PLDM_BEJ_FORMAT_STRING, string("1U"))})));
+    auto parent = [](const std::vector<uint8_t>& link) {
+        return encoding(tuple(
+            0, false, PLDM_BEJ_FORMAT_SET,
+            container({
+                tuple(1, false, PLDM_BEJ_FORMAT_STRING, string("Dummy")),
+                tuple(0, false, PLDM_BEJ_FORMAT_ARRAY,
+                      container({tuple(0, false, PLDM_BEJ_FORMAT_SET,
+                                       container({link}))})),
+                tuple(5, false, PLDM_BEJ_FORMAT_RESOURCE_LINK,
+                      nnint(0x99)),
+            })));
+    };
+    auto payload =
+        parent(tuple(5, false, PLDM_BEJ_FORMAT_RESOURCE_LINK, nnint(0x1234)));
+    auto expected = parent(
+        tuple(5, false, PLDM_BEJ_FORMAT_RESOURCE_LINK_EXPANSION, chassis));
+    std::vector<uint8_t> buffer(expected.size());
+    size_t used = 0;
+
+    // The lengths of the enclosing set, array and member are rewritten
+    EXPECT_EQ(pldm_bej_expand_links(payload.data(), payload.size(),
+                                    resolve_chassis, &chassis, NULL, 0, &used),
+              -ENOBUFS);
+    EXPECT_EQ(used, expected.size());
+    EXPECT_EQ(pldm_bej_expand_links(payload.data(), payload.size(),
+                                    resolve_chassis, &chassis, buffer.data(),
+                                    buffer.size(), &used),
+              0);
+    EXPECT_EQ(buffer, expected);
+}
+
+TEST(BejExpand, RejectsMalformedPayloads)
+{
+    std::vector<uint8_t> chassis;
+    std::vector<uint8_t> buffer(64);
+    size_t used;
+
+    auto overrun = encoding(
+        tuple(0, false, PLDM_BEJ_FORMAT_SET,
+              container({tuple(1, false, PLDM_BEJ_FORMAT_STRING,
+                               string("Dummy"))})));
+    overrun.pop_back();
+    EXPECT_EQ(pldm_bej_expand_links(overrun.data(), overrun.size(),
+                                    resolve_chassis, &chassis, buffer.data(),
+                                    buffer.size(), &used),
+              -EPROTO);
+
+    auto deep = tuple(0, false, PLDM_BEJ_FORMAT_NULL, {});
+    for (int i = 0; i <= PLDM_BEJ_MAX_DEPTH; i++)
+    {
+        deep = tuple(0, false, PLDM_BEJ_FORMAT_ARRAY, container({deep}));
+    }
+    deep = encoding(deep);
+    EXPECT_EQ(pldm_bej_expand_links(deep.data(), deep.size(), resolve_chassis,
+                                    &chassis, buffer.data(), buffer.size(),
+                                    &used),
+              -EOVERFLOW);
+}
@@ -155,6 +155,49 @@ TEST(DecodePackageHeaderInfo, errorPaths)
     EXPECT_EQ(rc, PLDM_ERROR_INVALID_DATA);
 }
 
+#ifdef LIBPLDM_API_TESTING
+TEST(VerifyPackageHeaderChecksum, goodPath)
+{
+    std::vector<uint8_t> header{
+        0xf0, 0x18, 0x87, 0x8c, 0xcb, 0x7d, 0x49, 0x43, 0x98, 0x00, 0xa0, 0x2f,
+        0x05, 0x9a, 0xca, 0x02, 0x01, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x19, 0x0c, 0xe5, 0x07, 0x00, 0x08, 0x00, 0x01, 0x0b,
+        0x4f, 0x70, 0x65, 0x6e, 0x42, 0x4d, 0x43, 0x76, 0x31, 0x2e, 0x30};
+    uint32_t checksum = htole32(crc32(header.data(), header.size()));
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&checksum);
+
+    header.insert(header.end(), bytes, bytes + sizeof(checksum));
+    ASSERT_EQ(header.size(), 0x33u);
+    EXPECT_EQ(verify_pldm_package_header_checksum(header.data(), header.size()),
+              PLDM_SUCCESS);
+
+    // Component images follow the header
+    header.push_back(0xaa);
+    EXPECT_EQ(verify_pldm_package_header_checksum(header.data(), header.size()),
+              PLDM_SUCCESS);
+}
+
+TEST(VerifyPackageHeaderChecksum, errorPaths)
+{
+    std::vector<uint8_t> header(0x33);
+
+    header[17] = 0x33;
+    EXPECT_EQ(verify_pldm_package_header_checksum(nullptr, header.size()),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(verify_pldm_package_header_checksum(header.data(), 10),
+              PLDM_ERROR_INVALID_LENGTH);
+    EXPECT_EQ(verify_pldm_package_header_checksum(header.data(), 0x32),
+              PLDM_ERROR_INVALID_LENGTH);
+    EXPECT_EQ(verify_pldm_package_header_checksum(header.data(), header.size()),
+              PLDM_ERROR_INVALID_DATA);
+
+    // Too small to hold a checksum after the fixed fields
+    header[17] = sizeof(pldm_package_header_information) + 3;
+    EXPECT_EQ(verify_pldm_package_header_checksum(header.data(), header.size()),
+              PLDM_ERROR_INVALID_DATA);
+}
+#endif
+
 TEST(DecodeFirmwareDeviceIdRecord, goodPath)
 {
     constexpr uint8_t descriptorCount = 1;
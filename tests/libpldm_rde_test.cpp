@@ -1,5 +1,8 @@
 #include <endian.h>
 
+#include <array>
+#include <cstring>
+
 #include "libpldm/pldm_rde.h"
 
 #include <gmock/gmock-matchers.h>
@@ -456,6 +459,136 @@ TEST(MultipartReceive, DecodeResponseSuccess)
     EXPECT_EQ(returnDataLenBytes, payloadSize);
 }
 
+#ifdef LIBPLDM_API_TESTING
+TEST(MultipartSend, EncodeRequestSuccess)
+{
+    uint8_t instanceId = 11;
+    uint32_t transferHandle = 0xABCDEF12;
+    uint32_t nextTransferHandle = 0xABCDEF13;
+    uint16_t operationId = 0x8001;
+    uint8_t payload[] = {0x01, 0x02, 0x03};
+    constexpr int reqLength = sizeof(struct pldm_msg_hdr) +
+                              PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE +
+                              sizeof(payload);
+    std::array<uint8_t, reqLength> requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto reqPayload =
+        reinterpret_cast<pldm_rde_multipart_send_req*>(request->payload);
+
+    EXPECT_EQ(encode_rde_multipart_send_req(
+                  instanceId, transferHandle, operationId, PLDM_RDE_START,
+                  nextTransferHandle, sizeof(payload), /*addChecksum*/ false,
+                  /*checksum*/ 0, payload, request),
+              PLDM_SUCCESS);
+    EXPECT_EQ(request->hdr.instance_id, instanceId);
+    EXPECT_EQ(request->hdr.type, PLDM_RDE);
+    EXPECT_EQ(request->hdr.request, 1);
+    EXPECT_EQ(request->hdr.command, PLDM_RDE_MULTIPART_SEND);
+    EXPECT_EQ(le32toh(reqPayload->data_transfer_handle), transferHandle);
+    EXPECT_EQ(le16toh(reqPayload->operation_id), operationId);
+    EXPECT_EQ(reqPayload->transfer_flag, PLDM_RDE_START);
+    EXPECT_EQ(le32toh(reqPayload->next_data_transfer_handle),
+              nextTransferHandle);
+    EXPECT_EQ(le32toh(reqPayload->data_length_bytes), sizeof(payload));
+    EXPECT_EQ(memcmp(reqPayload->payload, payload, sizeof(payload)), 0);
+}
+TEST(MultipartSend, EncodeRequestBadChecksumPlacement)
+{
+    uint8_t payload[] = {0x01, 0x02, 0x03};
+    std::array<uint8_t, sizeof(struct pldm_msg_hdr) +
+                            PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE +
+                            sizeof(payload) + sizeof(uint32_t)>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    EXPECT_EQ(encode_rde_multipart_send_req(0, 1, 0x8001, PLDM_RDE_MIDDLE, 2,
+                                            sizeof(payload), true, 0, payload,
+                                            request),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(encode_rde_multipart_send_req(0, 1, 0x8001, PLDM_RDE_END, 0,
+                                            sizeof(payload), false, 0, NULL,
+                                            request),
+              PLDM_ERROR_INVALID_DATA);
+}
+TEST(MultipartSend, DecodeRequestSuccess)
+{
+    uint8_t instanceId = 11;
+    uint32_t transferHandle = 0xABCDEF12;
+    uint16_t operationId = 0x8001;
+    uint32_t checksum = 0x11223344;
+    uint8_t payload[] = {0x01, 0x02, 0x03};
+    constexpr size_t payloadLength = PLDM_RDE_MULTIPART_SEND_REQ_HDR_SIZE +
+                                     sizeof(payload) + sizeof(checksum);
+    std::array<uint8_t, sizeof(struct pldm_msg_hdr) + payloadLength>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+
+    EXPECT_EQ(encode_rde_multipart_send_req(
+                  instanceId, transferHandle, operationId, PLDM_RDE_END, 0,
+                  sizeof(payload), /*addChecksum*/ true, checksum, payload,
+                  request),
+              PLDM_SUCCESS);
+
+    uint32_t returnTransferHandle;
+    uint16_t returnOperationId;
+    uint8_t returnTransferFlag;
+    uint32_t returnNextTransferHandle;
+    uint32_t returnDataLength;
+    const uint8_t* returnPayload;
+    EXPECT_EQ(decode_rde_multipart_send_req(
+                  request, payloadLength, &returnTransferHandle,
+                  &returnOperationId, &returnTransferFlag,
+                  &returnNextTransferHandle, &returnDataLength,
+                  &returnPayload),
+              PLDM_SUCCESS);
+    EXPECT_EQ(returnTransferHandle, transferHandle);
+    EXPECT_EQ(returnOperationId, operationId);
+    EXPECT_EQ(returnTransferFlag, PLDM_RDE_END);
+    EXPECT_EQ(returnNextTransferHandle, 0);
+    EXPECT_EQ(returnDataLength, sizeof(payload) + sizeof(checksum));
+    EXPECT_EQ(memcmp(returnPayload, payload, sizeof(payload)), 0);
+    uint32_t returnChecksum;
+    memcpy(&returnChecksum, returnPayload + sizeof(payload),
+           sizeof(returnChecksum));
+    EXPECT_EQ(le32toh(returnChecksum), checksum);
+
+    EXPECT_EQ(decode_rde_multipart_send_req(
+                  request, payloadLength - 1, &returnTransferHandle,
+                  &returnOperationId, &returnTransferFlag,
+                  &returnNextTransferHandle, &returnDataLength,
+                  &returnPayload),
+              PLDM_ERROR_INVALID_LENGTH);
+}
+TEST(MultipartSend, EncodeDecodeResponseSuccess)
+{
+    uint8_t instanceId = 11;
+    std::array<uint8_t, sizeof(struct pldm_msg_hdr) +
+                            sizeof(struct pldm_rde_multipart_send_resp)>
+        responseMsg{};
+    auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+
+    EXPECT_EQ(encode_rde_multipart_send_resp(instanceId, PLDM_SUCCESS,
+                                             PLDM_XFER_NEXT_PART, response),
+              PLDM_SUCCESS);
+    EXPECT_EQ(response->hdr.instance_id, instanceId);
+    EXPECT_EQ(response->hdr.request, 0);
+    EXPECT_EQ(response->hdr.command, PLDM_RDE_MULTIPART_SEND);
+
+    uint8_t cc;
+    uint8_t transferOperation;
+    EXPECT_EQ(decode_rde_multipart_send_resp(response,
+                                             RDE_MULTIPART_SEND_RESP_BYTES,
+                                             &cc, &transferOperation),
+              PLDM_SUCCESS);
+    EXPECT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(transferOperation, PLDM_XFER_NEXT_PART);
+
+    EXPECT_EQ(decode_rde_multipart_send_resp(response, 1, &cc,
+                                             &transferOperation),
+              PLDM_ERROR_INVALID_LENGTH);
+}
+#endif
+
 TEST(RDEOperationInit, EncodeRequestSuccess)
 {
     uint8_t instanceId = 11;
@@ -1333,3 +1466,93 @@ TEST(SupplyCustomRequestParameters, DecodeResponseSuccess)
     EXPECT_EQ(0, memcmp(responsePayload, varPayload, responsePayloadLength));
 }
 
+
+#ifdef LIBPLDM_API_TESTING
+TEST(RDERequestLength, FixedSizeRequests)
+{
+    std::array<uint8_t, sizeof(struct pldm_msg_hdr) + 32> requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    size_t length = 0;
+
+    ASSERT_EQ(encode_rde_operation_complete_req(1, 0x1000, 0x8000, request),
+              PLDM_SUCCESS);
+    EXPECT_EQ(pldm_rde_request_length(request, requestMsg.size(), &length),
+              PLDM_SUCCESS);
+    EXPECT_EQ(length, sizeof(struct pldm_msg_hdr) +
+                          sizeof(struct pldm_rde_operation_complete_req));
+
+    ASSERT_EQ(encode_rde_multipart_receive_req(1, 2, 0x8000,
+                                               PLDM_XFER_FIRST_PART, request),
+              PLDM_SUCCESS);
+    EXPECT_EQ(pldm_rde_request_length(request, requestMsg.size(), &length),
+              PLDM_SUCCESS);
+    EXPECT_EQ(length, sizeof(struct pldm_msg_hdr) + 7);
+
+    // Responses are not requests
+    ASSERT_EQ(encode_rde_operation_complete_resp(1, PLDM_SUCCESS, request),
+              PLDM_SUCCESS);
+    EXPECT_EQ(pldm_rde_request_length(request, requestMsg.size(), &length),
+              PLDM_ERROR_INVALID_DATA);
+}
+
+TEST(RDERequestLength, OperationInitCountsLocatorAndPayload)
+{
+    std::array<uint8_t, sizeof(struct pldm_msg_hdr) + 64> requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    union pldm_rde_operation_flags flags = {};
+    std::array<uint8_t, 3> locator = {1, 2, 3};
+    std::array<uint8_t, 10> payload = {};
+    size_t length = 0;
+
+    flags.bits.locator_valid = 1;
+    flags.bits.contains_request_payload = 1;
+    ASSERT_EQ(encode_rde_operation_init_req(
+                  1, 0x1000, 0x8000, PLDM_RDE_OPERATION_UPDATE, &flags, 0,
+                  locator.size(), payload.size(), locator.data(),
+                  payload.data(), request),
+              PLDM_SUCCESS);
+    EXPECT_EQ(pldm_rde_request_length(request, requestMsg.size(), &length),
+              PLDM_SUCCESS);
+    EXPECT_EQ(length, sizeof(struct pldm_msg_hdr) +
+                          PLDM_RDE_OPERATION_INIT_REQ_HDR_SIZE +
+                          locator.size() + payload.size());
+
+    // The buffer must hold all of it
+    EXPECT_EQ(pldm_rde_request_length(request, length - 1, &length),
+              PLDM_ERROR_INVALID_LENGTH);
+}
+
+TEST(RDERequestLength, CustomParametersWalkVarstrings)
+{
+    std::array<uint8_t, sizeof(struct pldm_msg_hdr) + 128> requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    enum pldm_rde_varstring_format formats[1] = {PLDM_RDE_VARSTRING_UTF_8};
+    char etag[] = "etag1";
+    char* etags[1] = {etag};
+    char* hdrnames[1] = {const_cast<char*>(PLDM_RDE_EXPAND_TYPE)};
+    char* hdrparams[1] = {const_cast<char*>(EXPAND_DOT)};
+    uint8_t offset = 0;
+    size_t length = 0;
+
+    ASSERT_EQ(encode_supply_custom_request_parameters_req(1, 0x1000, 0x8000, 1,
+                                                          0, 0, 0, request),
+              PLDM_SUCCESS);
+    ASSERT_EQ(encode_etags_in_supply_custom_request_parameters_req(
+                  PLDM_RDE_ETAG_IF_NONE_MATCH, 1, formats, etags, &offset,
+                  request),
+              PLDM_SUCCESS);
+    ASSERT_EQ(encode_headers_in_supply_custom_request_parameters_req(
+                  1, formats, hdrnames, formats, hdrparams, &offset, request),
+              PLDM_SUCCESS);
+
+    EXPECT_EQ(pldm_rde_request_length(request, requestMsg.size(), &length),
+              PLDM_SUCCESS);
+    // Fixed fields, the etag, the header count, then the header name and
+    // its parameter
+    EXPECT_EQ(length, sizeof(struct pldm_msg_hdr) + 16 + (2 + 6) + 1 +
+                          (2 + 21) + (2 + 2));
+
+    EXPECT_EQ(pldm_rde_request_length(request, length - 1, &length),
+              PLDM_ERROR_INVALID_LENGTH);
+}
+#endif
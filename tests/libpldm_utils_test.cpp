@@ -20,6 +20,65 @@ TEST(Crc8, CheckSumTest)
     EXPECT_EQ(checksum, 0xf4);
 }
 
+#ifdef LIBPLDM_API_TESTING
+static uint32_t referenceCrc32(const std::vector<uint8_t>& data)
+{
+    uint32_t crc = ~0U;
+
+    for (auto byte : data)
+    {
+        crc ^= byte;
+        for (int i = 0; i < 8; i++)
+        {
+            crc = (crc >> 1) ^ (0xedb88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+TEST(Crc32, StreamingMatchesWholeBuffer)
+{
+    std::vector<uint8_t> data(1031);
+
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = (i * 131 + 7) & 0xff;
+    }
+
+    // Sizes either side of every kernel's block size
+    for (size_t size : {0, 1, 7, 8, 15, 16, 63, 64, 65, 127, 128, 200, 1031})
+    {
+        std::vector<uint8_t> head(data.begin(), data.begin() + size);
+        uint32_t expected = referenceCrc32(head);
+
+        EXPECT_EQ(crc32(data.data(), size), expected) << size;
+        for (size_t split : {size_t(0), size / 3, size})
+        {
+            struct pldm_crc32 crc;
+
+            pldm_crc32_init(&crc);
+            pldm_crc32_update(&crc, data.data(), split);
+            pldm_crc32_update(&crc, data.data() + split, size - split);
+            EXPECT_EQ(pldm_crc32_final(&crc), expected) << size;
+        }
+    }
+}
+
+TEST(Crc8, StreamingMatchesWholeBuffer)
+{
+    const char* data = "123456789abcdefghijklmnopqrstuvwxyz";
+    struct pldm_crc8 crc;
+
+    pldm_crc8_init(&crc);
+    EXPECT_EQ(pldm_crc8_final(&crc), 0);
+    pldm_crc8_update(&crc, data, 4);
+    pldm_crc8_update(&crc, data + 4, 5);
+    EXPECT_EQ(pldm_crc8_final(&crc), 0xf4);
+    pldm_crc8_update(&crc, data + 9, strlen(data) - 9);
+    EXPECT_EQ(pldm_crc8_final(&crc), crc8(data, strlen(data)));
+}
+#endif
+
 TEST(Ver2string, Ver2string)
 {
     ver32_t version{0x61, 0x10, 0xf7, 0xf3};
@@ -0,0 +1,1154 @@
+#include <errno.h>
+#include <string.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "libpldm/requester/pldm_rde_batch.h"
+#include "libpldm/bej.h"
+#include "libpldm/requester/pldm_rde_engine.h"
+#include "libpldm/requester/pldm_rde_expand.h"
+#include "libpldm/requester/pldm_rde_pager.h"
+#include "libpldm/requester/pldm_rde_requester.h"
+#include "transport/test.h"
+
+#include <gtest/gtest.h>
+
+static std::vector<struct pldm_rde_requester_context> engineContexts;
+
+static struct pldm_rde_requester_context*
+    allocate_engine_contexts(uint8_t number_of_contexts)
+{
+    engineContexts.assign(number_of_contexts, {});
+    for (auto& ctx : engineContexts)
+    {
+        if (pldm_rde_create_context(&ctx))
+        {
+            return NULL;
+        }
+    }
+    return engineContexts.data();
+}
+
+static void free_engine_contexts(void* /*contexts*/) {}
+
+struct EngineCompletion
+{
+    struct pldm_rde_requester_context* ctx;
+    int rc;
+};
+
+static void record_completion(void* arg,
+                              struct pldm_rde_requester_manager* /*manager*/,
+                              struct pldm_rde_requester_context* ctx, int rc)
+{
+    auto completions = static_cast<std::vector<EngineCompletion>*>(arg);
+    completions->push_back({ctx, rc});
+}
+
+static std::vector<std::vector<uint8_t>> enginePayloads;
+
+static void record_payload(struct pldm_rde_requester_manager* /*manager*/,
+                           struct pldm_rde_requester_context* /*ctx*/,
+                           uint8_t** payload, uint32_t length,
+                           bool /*has_checksum*/)
+{
+    enginePayloads.emplace_back(*payload, *payload + length);
+}
+
+class TestRdeEngine : public ::testing::Test
+{
+  protected:
+    void init(uint8_t concurrency)
+    {
+        enginePayloads.clear();
+        ASSERT_EQ(pldm_rde_init_context(
+                      "rde_dev", 9, &manager, concurrency, mcTransferSize,
+                      &mcFeatures, allocate_engine_contexts,
+                      free_engine_contexts),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_set_resources_in_context(&manager, 1, &resourceId),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        pldm_rde_engine_destroy(engine);
+        if (test)
+        {
+            pldm_transport_test_destroy(test);
+        }
+    }
+
+    void start()
+    {
+        ASSERT_EQ(pldm_transport_test_init(&test, seq.data(), seq.size()), 0);
+        ASSERT_EQ(
+            pldm_rde_engine_init(&engine, pldm_transport_test_core(test)), 0);
+    }
+
+    void startRead(uint8_t index)
+    {
+        ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                      &manager.ctx[index], index, resourceId, 0x8000 + index,
+                      PLDM_RDE_OPERATION_READ, 0, NULL, 0, 0, 0, NULL, NULL),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_engine_submit(
+                      engine, PLDM_RDE_ENGINE_OPERATION, &manager,
+                      &manager.ctx[index], tid, record_payload,
+                      record_completion, &completions),
+                  0);
+    }
+
+    std::vector<uint8_t>& message(size_t length)
+    {
+        return messages.emplace_back(sizeof(pldm_msg_hdr) + length);
+    }
+
+    void expectSend(const std::vector<uint8_t>& msg)
+    {
+        struct pldm_transport_test_descriptor desc = {};
+        desc.type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_SEND;
+        desc.send_msg = {tid, msg.data(), msg.size()};
+        seq.push_back(desc);
+    }
+
+    void reply(const std::vector<uint8_t>& msg)
+    {
+        struct pldm_transport_test_descriptor desc = {};
+        desc.type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV;
+        desc.recv_msg = {tid, msg.data(), msg.size()};
+        seq.push_back(desc);
+    }
+
+    void expectOperationInit(uint8_t instanceId, uint8_t index)
+    {
+        union pldm_rde_operation_flags flags = {};
+        auto& msg = message(PLDM_RDE_OPERATION_INIT_REQ_HDR_SIZE);
+        ASSERT_EQ(encode_rde_operation_init_req(
+                      instanceId, resourceId, 0x8000 + index,
+                      PLDM_RDE_OPERATION_READ, &flags, 0, 0, 0, NULL, NULL,
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        expectSend(msg);
+    }
+
+    void replyOperationInit(uint8_t instanceId, uint8_t value)
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+        std::array<uint8_t, 4> result = {0xde, 0xad, 0xbe, value};
+        auto& msg = message(PLDM_RDE_OPERATION_INIT_RESP_HDR_SIZE + 3 +
+                            result.size());
+        ASSERT_EQ(encode_rde_operation_init_resp(
+                      instanceId, PLDM_SUCCESS, PLDM_RDE_OPERATION_COMPLETED,
+                      100, 0, &execFlags, 0, &permFlags, result.size(),
+                      PLDM_RDE_VARSTRING_UTF_8, "", result.data(),
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        reply(msg);
+    }
+
+    void replyOperationRunning(uint8_t instanceId, uint32_t seconds)
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+        auto& msg = message(PLDM_RDE_OPERATION_INIT_RESP_HDR_SIZE + 3);
+        ASSERT_EQ(encode_rde_operation_init_resp(
+                      instanceId, PLDM_SUCCESS, PLDM_RDE_OPERATION_RUNNING,
+                      PLDM_RDE_COMP_PERCENTAGE_NOT_SUPPORTED, seconds,
+                      &execFlags, 0, &permFlags, 0, PLDM_RDE_VARSTRING_UTF_8,
+                      "", NULL, reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        reply(msg);
+    }
+
+    // Status requests held back by the engine follow a pause on the wire
+    void expectOperationStatus(uint8_t instanceId, uint8_t index)
+    {
+        struct pldm_transport_test_descriptor latency = {};
+        latency.type = PLDM_TRANSPORT_TEST_ELEMENT_LATENCY;
+        latency.latency.it_value = {10, 0};
+        seq.push_back(latency);
+
+        auto& msg = message(sizeof(struct pldm_rde_operation_status_req));
+        ASSERT_EQ(encode_rde_operation_status_req(
+                      instanceId, resourceId, 0x8000 + index,
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        expectSend(msg);
+    }
+
+    void replyOperationStatus(uint8_t instanceId, uint8_t status)
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+        std::array<uint8_t, 2> result = {0xca, 0xfe};
+        size_t length = status == PLDM_RDE_OPERATION_COMPLETED ? result.size()
+                                                               : 0;
+        auto& msg =
+            message(PLDM_RDE_OPERATION_STATUS_RESP_HDR_SIZE + 3 + length);
+        ASSERT_EQ(encode_rde_operation_status_resp(
+                      instanceId, PLDM_SUCCESS, status,
+                      PLDM_RDE_COMP_PERCENTAGE_NOT_SUPPORTED,
+                      PLDM_RDE_COMP_TIME_NOT_SUPPORTED, &execFlags, 0,
+                      &permFlags, length, PLDM_RDE_VARSTRING_UTF_8, "",
+                      result.data(), reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        reply(msg);
+    }
+
+    void expectOperationComplete(uint8_t instanceId, uint8_t index)
+    {
+        auto& msg = message(sizeof(struct pldm_rde_operation_complete_req));
+        ASSERT_EQ(encode_rde_operation_complete_req(
+                      instanceId, resourceId, 0x8000 + index,
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        expectSend(msg);
+    }
+
+    void replyOperationComplete(uint8_t instanceId)
+    {
+        auto& msg = message(1);
+        ASSERT_EQ(encode_rde_operation_complete_resp(
+                      instanceId, PLDM_SUCCESS,
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        reply(msg);
+    }
+
+    static constexpr pldm_tid_t tid = 1;
+    static constexpr uint32_t mcTransferSize = 256;
+    uint32_t resourceId = 0x00010000;
+    bitfield16_t mcFeatures = {};
+    struct pldm_rde_requester_manager manager = {};
+    struct pldm_transport_test* test = nullptr;
+    struct pldm_rde_engine* engine = nullptr;
+    std::deque<std::vector<uint8_t>> messages;
+    std::vector<struct pldm_transport_test_descriptor> seq;
+    std::vector<EngineCompletion> completions;
+};
+
+TEST_F(TestRdeEngine, InterleavesOperationsByInstanceId)
+{
+    init(2);
+
+    // Responses arrive in a different order than the requests went out
+    expectOperationInit(0, 0);
+    expectOperationInit(1, 1);
+    replyOperationInit(1, 1);
+    expectOperationComplete(2, 1);
+    replyOperationInit(0, 0);
+    expectOperationComplete(3, 0);
+    replyOperationComplete(2);
+    replyOperationComplete(3);
+    start();
+
+    startRead(0);
+    startRead(1);
+    EXPECT_EQ(pldm_rde_engine_pending(engine), 2u);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    ASSERT_EQ(completions.size(), 2u);
+    EXPECT_EQ(completions[0].ctx, &manager.ctx[1]);
+    EXPECT_EQ(completions[0].rc, 0);
+    EXPECT_EQ(completions[1].ctx, &manager.ctx[0]);
+    EXPECT_EQ(completions[1].rc, 0);
+    ASSERT_EQ(enginePayloads.size(), 2u);
+    EXPECT_EQ(enginePayloads[0], std::vector<uint8_t>({0xde, 0xad, 0xbe, 1}));
+    EXPECT_EQ(enginePayloads[1], std::vector<uint8_t>({0xde, 0xad, 0xbe, 0}));
+    EXPECT_EQ(manager.ctx[0].requester_status,
+              PLDM_RDE_REQUESTER_NO_PENDING_ACTION);
+    EXPECT_EQ(pldm_rde_engine_pending(engine), 0u);
+}
+
+TEST_F(TestRdeEngine, DropsUnmatchedResponses)
+{
+    init(1);
+
+    expectOperationInit(0, 0);
+    // Wrong instance ID, then the wrong command for the right one
+    replyOperationComplete(7);
+    replyOperationComplete(0);
+    replyOperationInit(0, 0);
+    expectOperationComplete(1, 0);
+    replyOperationComplete(1);
+    start();
+
+    startRead(0);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].rc, 0);
+    EXPECT_EQ(enginePayloads.size(), 1u);
+}
+
+TEST_F(TestRdeEngine, RunsDiscovery)
+{
+    bitfield8_t capabilities = {};
+    bitfield16_t features = {};
+
+    init(1);
+
+    auto& redfish = message(sizeof(pldm_rde_negotiate_redfish_parameters_req));
+    ASSERT_EQ(encode_negotiate_redfish_parameters_req(
+                  0, 1, &mcFeatures,
+                  reinterpret_cast<pldm_msg*>(redfish.data())),
+              PLDM_SUCCESS);
+    expectSend(redfish);
+    auto& redfishResp = message(16);
+    ASSERT_EQ(encode_negotiate_redfish_parameters_resp(
+                  0, PLDM_SUCCESS, 4, capabilities, features, 0x1234, "V",
+                  PLDM_RDE_VARSTRING_ASCII,
+                  reinterpret_cast<pldm_msg*>(redfishResp.data())),
+              PLDM_SUCCESS);
+    reply(redfishResp);
+    auto& medium = message(sizeof(pldm_rde_negotiate_medium_parameters_req));
+    ASSERT_EQ(encode_negotiate_medium_parameters_req(
+                  1, mcTransferSize,
+                  reinterpret_cast<pldm_msg*>(medium.data())),
+              PLDM_SUCCESS);
+    expectSend(medium);
+    auto& mediumResp =
+        message(sizeof(pldm_rde_negotiate_medium_parameters_resp));
+    ASSERT_EQ(encode_negotiate_medium_parameters_resp(
+                  1, PLDM_SUCCESS, 128,
+                  reinterpret_cast<pldm_msg*>(mediumResp.data())),
+              PLDM_SUCCESS);
+    reply(mediumResp);
+    start();
+
+    ASSERT_EQ(pldm_rde_start_discovery(&manager.ctx[0]),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_engine_submit(engine, PLDM_RDE_ENGINE_DISCOVERY,
+                                     &manager, &manager.ctx[0], tid, NULL,
+                                     record_completion, &completions),
+              0);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].rc, 0);
+    EXPECT_EQ(manager.device.device_concurrency, 4);
+    EXPECT_EQ(manager.negotiated_transfer_size, 128u);
+}
+
+TEST_F(TestRdeEngine, TimesOutSilentDevices)
+{
+    struct pldm_transport_test_descriptor latency = {};
+
+    init(1);
+
+    expectOperationInit(0, 0);
+    latency.type = PLDM_TRANSPORT_TEST_ELEMENT_LATENCY;
+    latency.latency.it_value = {1, 0};
+    seq.push_back(latency);
+    start();
+
+    ASSERT_EQ(pldm_rde_engine_set_timeout(engine, 10), 0);
+    startRead(0);
+    EXPECT_GE(pldm_rde_engine_next_timeout(engine), 0);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].rc, -ETIMEDOUT);
+    EXPECT_EQ(pldm_rde_engine_next_timeout(engine), -1);
+}
+
+TEST_F(TestRdeEngine, TimesOutOnDispatchWithNothingToRead)
+{
+    struct pldm_transport_test_descriptor latency = {};
+
+    init(1);
+
+    expectOperationInit(0, 0);
+    latency.type = PLDM_TRANSPORT_TEST_ELEMENT_LATENCY;
+    latency.latency.it_value = {1, 0};
+    seq.push_back(latency);
+    start();
+
+    ASSERT_EQ(pldm_rde_engine_set_timeout(engine, 10), 0);
+    startRead(0);
+    int timeout = pldm_rde_engine_next_timeout(engine);
+    ASSERT_GE(timeout, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout + 1));
+
+    // Nothing is waiting, so dispatch must not block in recv
+    auto begin = std::chrono::steady_clock::now();
+    EXPECT_EQ(pldm_rde_engine_dispatch(engine), 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin,
+              std::chrono::milliseconds(500));
+
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].rc, -ETIMEDOUT);
+    EXPECT_EQ(pldm_rde_engine_next_timeout(engine), -1);
+}
+
+TEST_F(TestRdeEngine, AsksAgainForTimedOutChunks)
+{
+    union pldm_rde_op_execution_flags execFlags = {};
+    union pldm_rde_permission_flags permFlags = {};
+    struct pldm_transport_test_descriptor latency = {};
+    std::array<uint8_t, 4> result = {0xfe, 0xed, 0xfa, 0xce};
+
+    init(1);
+    ASSERT_EQ(pldm_rde_set_multipart_receive_retries(&manager, 1),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    expectOperationInit(0, 0);
+    auto& haveResults = message(PLDM_RDE_OPERATION_INIT_RESP_HDR_SIZE + 3);
+    ASSERT_EQ(encode_rde_operation_init_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_OPERATION_HAVE_RESULTS, 100, 0,
+                  &execFlags, 0x42, &permFlags, 0, PLDM_RDE_VARSTRING_UTF_8,
+                  "", NULL, reinterpret_cast<pldm_msg*>(haveResults.data())),
+              PLDM_SUCCESS);
+    reply(haveResults);
+
+    // The first request goes unanswered, the second uses a new instance ID
+    for (uint8_t instanceId = 1; instanceId <= 2; instanceId++)
+    {
+        auto& receive = message(sizeof(struct pldm_rde_multipart_receive_req));
+        ASSERT_EQ(encode_rde_multipart_receive_req(
+                      instanceId, 0x42, 0x8000, PLDM_XFER_FIRST_PART,
+                      reinterpret_cast<pldm_msg*>(receive.data())),
+                  PLDM_SUCCESS);
+        expectSend(receive);
+        if (instanceId == 1)
+        {
+            latency.type = PLDM_TRANSPORT_TEST_ELEMENT_LATENCY;
+            latency.latency.it_value = {1, 0};
+            seq.push_back(latency);
+        }
+    }
+    auto& chunk =
+        message(PLDM_RDE_MULTIPART_RECEIVE_RESP_HDR_SIZE + result.size());
+    ASSERT_EQ(encode_rde_multipart_receive_resp(
+                  2, PLDM_SUCCESS, PLDM_RDE_START_AND_END, 0, result.size(),
+                  false, 0, result.data(),
+                  reinterpret_cast<pldm_msg*>(chunk.data())),
+              PLDM_SUCCESS);
+    reply(chunk);
+    expectOperationComplete(3, 0);
+    replyOperationComplete(3);
+    start();
+
+    ASSERT_EQ(pldm_rde_engine_set_timeout(engine, 10), 0);
+    startRead(0);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 5000), 0);
+
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].rc, 0);
+    ASSERT_EQ(enginePayloads.size(), 1u);
+    EXPECT_EQ(enginePayloads[0],
+              std::vector<uint8_t>(result.begin(), result.end()));
+}
+
+TEST_F(TestRdeEngine, QueuesWorkUntilAnInstanceIdFrees)
+{
+    constexpr uint8_t operations = PLDM_INSTANCE_MAX + 2;
+
+    init(operations);
+
+    for (uint8_t i = 0; i <= PLDM_INSTANCE_MAX; i++)
+    {
+        expectOperationInit(i, i);
+    }
+    // Freeing instance ID 5 lets the queued operation go, while the
+    // completion of operation 5 has to queue in turn
+    replyOperationInit(5, 5);
+    expectOperationInit(5, PLDM_INSTANCE_MAX + 1);
+    start();
+
+    for (uint8_t i = 0; i < operations; i++)
+    {
+        startRead(i);
+    }
+    EXPECT_EQ(pldm_rde_engine_pending(engine), operations);
+    EXPECT_EQ(pldm_rde_engine_dispatch(engine), 0);
+    EXPECT_TRUE(completions.empty());
+    EXPECT_EQ(enginePayloads.size(), 1u);
+
+    pldm_rde_engine_destroy(engine);
+    engine = nullptr;
+    ASSERT_EQ(completions.size(), operations);
+    for (const auto& completion : completions)
+    {
+        EXPECT_EQ(completion.rc, -ECANCELED);
+    }
+}
+
+TEST_F(TestRdeEngine, BacksOffPollingWithoutAnEstimate)
+{
+    init(1);
+
+    expectOperationInit(0, 0);
+    replyOperationRunning(0, PLDM_RDE_COMP_TIME_NOT_SUPPORTED);
+    expectOperationStatus(1, 0);
+    replyOperationStatus(1, PLDM_RDE_OPERATION_RUNNING);
+    expectOperationStatus(2, 0);
+    replyOperationStatus(2, PLDM_RDE_OPERATION_RUNNING);
+    expectOperationStatus(3, 0);
+    replyOperationStatus(3, PLDM_RDE_OPERATION_COMPLETED);
+    expectOperationComplete(4, 0);
+    replyOperationComplete(4);
+    start();
+
+    ASSERT_EQ(pldm_rde_engine_set_poll_interval(engine, 20, 1000), 0);
+    auto begin = std::chrono::steady_clock::now();
+    startRead(0);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 2000), 0);
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    // 20, 40 and 80 milliseconds between the polls
+    EXPECT_GE(elapsed, std::chrono::milliseconds(140));
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].rc, 0);
+    ASSERT_EQ(enginePayloads.size(), 1u);
+    EXPECT_EQ(enginePayloads[0], std::vector<uint8_t>({0xca, 0xfe}));
+}
+
+TEST_F(TestRdeEngine, PollsOnceTheEstimateElapses)
+{
+    init(1);
+
+    expectOperationInit(0, 0);
+    replyOperationRunning(0, 1);
+    expectOperationStatus(1, 0);
+    replyOperationStatus(1, PLDM_RDE_OPERATION_COMPLETED);
+    expectOperationComplete(2, 0);
+    replyOperationComplete(2);
+    start();
+
+    // The one second estimate is capped by the longest interval
+    ASSERT_EQ(pldm_rde_engine_set_poll_interval(engine, 1, 200), 0);
+    auto begin = std::chrono::steady_clock::now();
+    startRead(0);
+    EXPECT_GT(pldm_rde_engine_next_timeout(engine), 0);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 2000), 0);
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    EXPECT_GE(elapsed, std::chrono::milliseconds(200));
+    ASSERT_EQ(completions.size(), 1u);
+    EXPECT_EQ(completions[0].rc, 0);
+}
+
+TEST_F(TestRdeEngine, CompletesIdenticalReadsWithOneOperation)
+{
+    init(2);
+    ASSERT_EQ(pldm_rde_set_read_coalescing(&manager, true),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    // The joined read passes over instance ID 1 without sending anything
+    expectOperationInit(0, 0);
+    replyOperationInit(0, 0);
+    expectOperationComplete(2, 0);
+    replyOperationComplete(2);
+    start();
+
+    startRead(0);
+    startRead(1);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    // The joined read is done as soon as the result arrives
+    ASSERT_EQ(completions.size(), 2u);
+    EXPECT_EQ(completions[0].ctx, &manager.ctx[1]);
+    EXPECT_EQ(completions[0].rc, 0);
+    EXPECT_EQ(completions[1].ctx, &manager.ctx[0]);
+    EXPECT_EQ(completions[1].rc, 0);
+    ASSERT_EQ(enginePayloads.size(), 2u);
+    EXPECT_EQ(enginePayloads[0], enginePayloads[1]);
+}
+
+TEST_F(TestRdeEngine, FailsJoinedReadsWithTheirOperation)
+{
+    struct pldm_transport_test_descriptor latency = {};
+
+    init(2);
+    ASSERT_EQ(pldm_rde_set_read_coalescing(&manager, true),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    expectOperationInit(0, 0);
+    latency.type = PLDM_TRANSPORT_TEST_ELEMENT_LATENCY;
+    latency.latency.it_value = {1, 0};
+    seq.push_back(latency);
+    start();
+
+    ASSERT_EQ(pldm_rde_engine_set_timeout(engine, 10), 0);
+    startRead(0);
+    startRead(1);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    ASSERT_EQ(completions.size(), 2u);
+    EXPECT_EQ(completions[0].ctx, &manager.ctx[0]);
+    EXPECT_EQ(completions[0].rc, -ETIMEDOUT);
+    EXPECT_EQ(completions[1].ctx, &manager.ctx[1]);
+    EXPECT_EQ(completions[1].rc, -ETIMEDOUT);
+    EXPECT_EQ(pldm_rde_engine_pending(engine), 0u);
+}
+
+static std::vector<size_t> batchPayloads;
+static std::vector<size_t> batchDone;
+static struct pldm_rde_batch* currentBatch;
+
+static void record_batch_payload(struct pldm_rde_requester_manager* /*manager*/,
+                                 struct pldm_rde_requester_context* ctx,
+                                 uint8_t** /*payload*/, uint32_t /*length*/,
+                                 bool /*has_checksum*/)
+{
+    auto item = pldm_rde_batch_item_of(currentBatch, ctx);
+    ASSERT_NE(item, nullptr);
+    batchPayloads.push_back(item - currentBatch->items);
+}
+
+static void record_batch_item(void* /*arg*/, struct pldm_rde_batch* batch,
+                              struct pldm_rde_batch_item* item)
+{
+    EXPECT_EQ(item->ctx, nullptr);
+    batchDone.push_back(item - batch->items);
+}
+
+class TestRdeBatch : public TestRdeEngine
+{
+  protected:
+    void SetUp() override
+    {
+        batchPayloads.clear();
+        batchDone.clear();
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            items[i].resource_id = resourceId;
+            items[i].operation_id = 0x8000 + i;
+            items[i].operation_type = PLDM_RDE_OPERATION_READ;
+        }
+        batch.tid = tid;
+        batch.items = items.data();
+        batch.count = items.size();
+        batch.callback = record_batch_payload;
+        batch.item_done = record_batch_item;
+        currentBatch = &batch;
+    }
+
+    std::array<struct pldm_rde_batch_item, 3> items = {};
+    struct pldm_rde_batch batch = {};
+};
+
+TEST_F(TestRdeBatch, KeepsTheDeviceWindowFull)
+{
+    init(2);
+    manager.device.device_concurrency = 2;
+    batch.manager = &manager;
+
+    // The third read goes out as soon as the first one is closed
+    expectOperationInit(0, 0);
+    expectOperationInit(1, 1);
+    replyOperationInit(0, 0);
+    expectOperationComplete(2, 0);
+    replyOperationComplete(2);
+    expectOperationInit(3, 2);
+    replyOperationInit(1, 1);
+    expectOperationComplete(4, 1);
+    replyOperationComplete(4);
+    replyOperationInit(3, 2);
+    expectOperationComplete(5, 2);
+    replyOperationComplete(5);
+    start();
+
+    ASSERT_EQ(pldm_rde_batch_start(engine, &batch), 0);
+    EXPECT_EQ(pldm_rde_batch_start(engine, &batch), -EBUSY);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    EXPECT_EQ(batchPayloads, (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(batchDone, (std::vector<size_t>{0, 1, 2}));
+    for (const auto& item : items)
+    {
+        EXPECT_EQ(item.rc, 0);
+    }
+    EXPECT_EQ(batch.finished, items.size());
+    EXPECT_EQ(batch.running, nullptr);
+    EXPECT_FALSE(manager.ctx[0].operation.active);
+    EXPECT_FALSE(manager.ctx[1].operation.active);
+}
+
+TEST_F(TestRdeBatch, StaysWithinTheNegotiatedConcurrency)
+{
+    init(3);
+    batch.manager = &manager;
+
+    // Not negotiated with, so the reads run one after the other
+    for (uint8_t i = 0; i < items.size(); i++)
+    {
+        expectOperationInit(2 * i, i);
+        replyOperationInit(2 * i, i);
+        expectOperationComplete(2 * i + 1, i);
+        replyOperationComplete(2 * i + 1);
+    }
+    start();
+
+    ASSERT_EQ(pldm_rde_batch_start(engine, &batch), 0);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+    EXPECT_EQ(batchDone, (std::vector<size_t>{0, 1, 2}));
+}
+
+TEST_F(TestRdeBatch, FailsItemsThatCannotStart)
+{
+    struct pldm_rde_reassembly badReassembly = {};
+
+    init(1);
+    batch.manager = &manager;
+    badReassembly.type = PLDM_RDE_REASSEMBLY_FD;
+    badReassembly.dest.file.fd = -1;
+    items[0].reassembly = &badReassembly;
+    items[2].reassembly = &badReassembly;
+
+    expectOperationInit(0, 1);
+    replyOperationInit(0, 1);
+    expectOperationComplete(1, 1);
+    replyOperationComplete(1);
+    start();
+
+    EXPECT_EQ(pldm_rde_batch_start(nullptr, &batch), -EINVAL);
+    EXPECT_EQ(pldm_rde_batch_item_of(&batch, &manager.ctx[0]), nullptr);
+
+    // The only context is taken
+    ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                  &manager.ctx[0], 0, resourceId, 0x8000,
+                  PLDM_RDE_OPERATION_READ, 0, NULL, 0, 0, 0, NULL, NULL),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_batch_start(engine, &batch), -EBUSY);
+    free_rde_op_init_context(&manager.ctx[0]);
+
+    // Items that fail to start are done on the spot, and the context moves
+    // on to the next one
+    ASSERT_EQ(pldm_rde_batch_start(engine, &batch), 0);
+    EXPECT_EQ(batchDone, (std::vector<size_t>{0}));
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    EXPECT_EQ(batchDone, (std::vector<size_t>{0, 2, 1}));
+    EXPECT_EQ(items[0].rc, -EINVAL);
+    EXPECT_EQ(items[1].rc, 0);
+    EXPECT_EQ(items[2].rc, -EINVAL);
+}
+
+struct PagerPage
+{
+    uint32_t page;
+    int rc;
+    std::vector<uint8_t> payload;
+};
+
+static bool record_page(void* arg, struct pldm_rde_pager* /*pager*/,
+                        uint32_t page, int rc, const uint8_t* payload,
+                        size_t length)
+{
+    auto pages = static_cast<std::vector<PagerPage>*>(arg);
+    pages->push_back({page, rc, std::vector<uint8_t>(payload,
+                                                     payload + length)});
+    return true;
+}
+
+class TestRdePager : public TestRdeEngine
+{
+  protected:
+    void SetUp() override
+    {
+        pager.tid = tid;
+        pager.resource_id = resourceId;
+        pager.operation_id = 0x8000;
+        pager.skip = 10;
+        pager.top = 2;
+        pager.prefetch = 1;
+        pager.page_size = 16;
+        pager.page = record_page;
+        pager.arg = &pages;
+    }
+
+    void expectPageInit(uint8_t instanceId, uint16_t operationId)
+    {
+        union pldm_rde_operation_flags flags = {};
+        auto& msg = message(PLDM_RDE_OPERATION_INIT_REQ_HDR_SIZE);
+
+        flags.bits.contains_custom_request_parameters = 1;
+        ASSERT_EQ(encode_rde_operation_init_req(
+                      instanceId, resourceId, operationId,
+                      PLDM_RDE_OPERATION_READ, &flags, 0, 0, 0, NULL, NULL,
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        expectSend(msg);
+    }
+
+    void replyNeedsInput(uint8_t instanceId)
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+        auto& msg = message(PLDM_RDE_OPERATION_INIT_RESP_HDR_SIZE + 3);
+        ASSERT_EQ(encode_rde_operation_init_resp(
+                      instanceId, PLDM_SUCCESS,
+                      PLDM_RDE_OPERATION_NEEDS_INPUT, 0, 0, &execFlags, 0,
+                      &permFlags, 0, PLDM_RDE_VARSTRING_UTF_8, "", NULL,
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        reply(msg);
+    }
+
+    void expectPageParameters(uint8_t instanceId, uint16_t operationId,
+                              uint16_t skip)
+    {
+        std::vector<uint8_t> encoded(256);
+        auto request = reinterpret_cast<pldm_msg*>(encoded.data());
+        uint8_t offset = 0;
+        size_t length;
+
+        ASSERT_EQ(encode_supply_custom_request_parameters_req(
+                      instanceId, resourceId, operationId, 0, skip, pager.top,
+                      0, request),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(encode_etags_in_supply_custom_request_parameters_req(
+                      PLDM_RDE_ETAG_IGNORE, 0, NULL, NULL, &offset, request),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(encode_headers_in_supply_custom_request_parameters_req(
+                      0, NULL, NULL, NULL, NULL, &offset, request),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(pldm_rde_request_length(request, encoded.size(), &length),
+                  0);
+        encoded.resize(length);
+        expectSend(messages.emplace_back(encoded));
+    }
+
+    void replyPage(uint8_t instanceId, uint8_t value)
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+        std::array<uint8_t, 2> result = {0xaa, value};
+        auto& msg = message(PLDM_RDE_OPERATION_INIT_RESP_HDR_SIZE + 3 +
+                            result.size());
+        execFlags.bits.have_result_payload = 1;
+        ASSERT_EQ(encode_supply_custom_request_parameters_resp(
+                      instanceId, PLDM_SUCCESS, PLDM_RDE_OPERATION_COMPLETED,
+                      100, 0, &execFlags, 0, &permFlags, result.size(),
+                      PLDM_RDE_VARSTRING_UTF_8, const_cast<char*>(""),
+                      result.data(), reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        reply(msg);
+    }
+
+    struct pldm_rde_pager pager = {};
+    std::vector<PagerPage> pages;
+};
+
+TEST_F(TestRdePager, ReadsAheadAndHandsPagesOverInOrder)
+{
+    init(2);
+    manager.device.device_concurrency = 2;
+    pager.manager = &manager;
+    pager.pages = 3;
+
+    // The first two pages are read together
+    expectPageInit(0, 0x8000);
+    expectPageInit(1, 0x8001);
+    replyNeedsInput(0);
+    expectPageParameters(2, 0x8000, 10);
+    replyNeedsInput(1);
+    expectPageParameters(3, 0x8001, 12);
+    replyPage(2, 0);
+    expectOperationComplete(4, 0);
+    replyOperationComplete(4);
+    // Handing over the first page frees its slot for the third
+    expectPageInit(5, 0x8000);
+    replyPage(3, 1);
+    expectOperationComplete(6, 1);
+    replyOperationComplete(6);
+    replyNeedsInput(5);
+    expectPageParameters(7, 0x8000, 14);
+    replyPage(7, 2);
+    expectOperationComplete(8, 0);
+    replyOperationComplete(8);
+    start();
+
+    ASSERT_EQ(pldm_rde_pager_start(engine, &pager), 0);
+    EXPECT_TRUE(pldm_rde_pager_walking(&pager));
+    EXPECT_EQ(pldm_rde_pager_start(engine, &pager), -EBUSY);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    EXPECT_FALSE(pldm_rde_pager_walking(&pager));
+    ASSERT_EQ(pages.size(), 3u);
+    for (uint32_t i = 0; i < pages.size(); i++)
+    {
+        EXPECT_EQ(pages[i].page, i);
+        EXPECT_EQ(pages[i].rc, 0);
+        EXPECT_EQ(pages[i].payload, (std::vector<uint8_t>{0xaa, (uint8_t)i}));
+    }
+}
+
+static bool first_page_only(void* arg, struct pldm_rde_pager* pager,
+                            uint32_t page, int rc, const uint8_t* payload,
+                            size_t length)
+{
+    record_page(arg, pager, page, rc, payload, length);
+    return false;
+}
+
+TEST_F(TestRdePager, StopsWhenTheConsumerDoes)
+{
+    init(2);
+    manager.device.device_concurrency = 2;
+    pager.manager = &manager;
+    pager.page = first_page_only;
+
+    expectPageInit(0, 0x8000);
+    expectPageInit(1, 0x8001);
+    replyNeedsInput(0);
+    expectPageParameters(2, 0x8000, 10);
+    replyNeedsInput(1);
+    expectPageParameters(3, 0x8001, 12);
+    replyPage(2, 0);
+    expectOperationComplete(4, 0);
+    replyOperationComplete(4);
+    // The page read ahead is still waited for, but not handed over
+    replyPage(3, 1);
+    expectOperationComplete(5, 1);
+    replyOperationComplete(5);
+    start();
+
+    ASSERT_EQ(pldm_rde_pager_start(engine, &pager), 0);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    EXPECT_FALSE(pldm_rde_pager_walking(&pager));
+    ASSERT_EQ(pages.size(), 1u);
+    EXPECT_EQ(pages[0].page, 0u);
+}
+
+TEST_F(TestRdePager, RejectsInvalidArguments)
+{
+    init(1);
+    start();
+
+    EXPECT_EQ(pldm_rde_pager_start(engine, &pager), -EINVAL);
+    pager.manager = &manager;
+    pager.top = 0;
+    EXPECT_EQ(pldm_rde_pager_start(engine, &pager), -EINVAL);
+    pager.top = 2;
+    pager.prefetch = UINT8_MAX;
+    EXPECT_EQ(pldm_rde_pager_start(engine, &pager), -EINVAL);
+    EXPECT_FALSE(pldm_rde_pager_walking(&pager));
+}
+
+TEST(RdeEngine, RejectsInvalidArguments)
+{
+    struct pldm_rde_engine* engine = nullptr;
+
+    EXPECT_EQ(pldm_rde_engine_init(&engine, NULL), -EINVAL);
+    EXPECT_EQ(pldm_rde_engine_init(NULL, NULL), -EINVAL);
+    EXPECT_EQ(pldm_rde_engine_run(NULL, 0), -EINVAL);
+    EXPECT_EQ(pldm_rde_engine_dispatch(NULL), -EINVAL);
+    EXPECT_EQ(pldm_rde_engine_pending(NULL), 0u);
+    EXPECT_EQ(pldm_rde_engine_set_poll_interval(NULL, 1, 2), -EINVAL);
+}
+
+static std::vector<uint8_t> bejTuple(uint8_t sequence, uint8_t format,
+                                     const std::vector<uint8_t>& value)
+{
+    std::vector<uint8_t> out = {1, (uint8_t)(sequence << 1),
+                                (uint8_t)(format << 4), 1,
+                                (uint8_t)value.size()};
+    out.insert(out.end(), value.begin(), value.end());
+    return out;
+}
+
+static std::vector<uint8_t> bejEncoding(const std::vector<uint8_t>& root)
+{
+    std::vector<uint8_t> out = {0x00, 0xf0, 0xf0, 0xf1, 0x00, 0x00, 0x00};
+    out.insert(out.end(), root.begin(), root.end());
+    return out;
+}
+
+static std::vector<uint8_t>
+    bejSet(const std::vector<std::vector<uint8_t>>& members)
+{
+    std::vector<uint8_t> value = {1, (uint8_t)members.size()};
+    for (const auto& member : members)
+    {
+        value.insert(value.end(), member.begin(), member.end());
+    }
+    return bejTuple(0, PLDM_BEJ_FORMAT_SET, value);
+}
+
+struct ExpandResult
+{
+    int rc;
+    std::vector<uint8_t> payload;
+};
+
+static void record_expand(void* arg, struct pldm_rde_expand* /*expand*/,
+                          int rc, const uint8_t* payload, size_t length)
+{
+    auto results = static_cast<std::vector<ExpandResult>*>(arg);
+    results->push_back({rc, std::vector<uint8_t>(payload, payload + length)});
+}
+
+class TestRdeExpand : public TestRdeEngine
+{
+  protected:
+    void SetUp() override
+    {
+        expand.tid = tid;
+        expand.resource_id = 1;
+        expand.levels = 1;
+        expand.links = links.data();
+        expand.link_count = links.size();
+        expand.operation_id = 0x8000;
+        expand.resource_size = 64;
+        expand.done = record_expand;
+        expand.arg = &results;
+    }
+
+    void expectRead(uint8_t instanceId, uint32_t resource,
+                    uint16_t operationId)
+    {
+        union pldm_rde_operation_flags flags = {};
+        auto& msg = message(PLDM_RDE_OPERATION_INIT_REQ_HDR_SIZE);
+        ASSERT_EQ(encode_rde_operation_init_req(
+                      instanceId, resource, operationId,
+                      PLDM_RDE_OPERATION_READ, &flags, 0, 0, 0, NULL, NULL,
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        expectSend(msg);
+    }
+
+    void replyResource(uint8_t instanceId, const std::vector<uint8_t>& body)
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+        auto& msg =
+            message(PLDM_RDE_OPERATION_INIT_RESP_HDR_SIZE + 3 + body.size());
+        execFlags.bits.have_result_payload = 1;
+        ASSERT_EQ(encode_rde_operation_init_resp(
+                      instanceId, PLDM_SUCCESS, PLDM_RDE_OPERATION_COMPLETED,
+                      100, 0, &execFlags, 0, &permFlags, body.size(),
+                      PLDM_RDE_VARSTRING_UTF_8, "", body.data(),
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        reply(msg);
+    }
+
+    void expectComplete(uint8_t instanceId, uint32_t resource,
+                        uint16_t operationId)
+    {
+        auto& msg = message(sizeof(struct pldm_rde_operation_complete_req));
+        ASSERT_EQ(encode_rde_operation_complete_req(
+                      instanceId, resource, operationId,
+                      reinterpret_cast<pldm_msg*>(msg.data())),
+                  PLDM_SUCCESS);
+        expectSend(msg);
+    }
+
+    void completeRead(uint8_t instanceId, uint32_t resource,
+                      uint16_t operationId)
+    {
+        expectComplete(instanceId, resource, operationId);
+        replyOperationComplete(instanceId);
+    }
+
+    static std::vector<uint8_t> link(uint8_t resource)
+    {
+        return bejTuple(5, PLDM_BEJ_FORMAT_RESOURCE_LINK, {1, resource});
+    }
+
+    static std::vector<uint8_t> leaf(char name)
+    {
+        return bejEncoding(bejSet(
+            {bejTuple(1, PLDM_BEJ_FORMAT_STRING, {(uint8_t)name, 0})}));
+    }
+
+    // 2 and 3 are in 1, 4 is in 2 and 6 is elsewhere
+    std::vector<struct pldm_rde_resource_link> links = {
+        {4, 2}, {2, 1}, {6, 5}, {3, 1}};
+    struct pldm_rde_expand expand = {};
+    std::vector<ExpandResult> results;
+};
+
+TEST_F(TestRdeExpand, ReadsContainedResourcesTogether)
+{
+    init(2);
+    manager.device.device_concurrency = 2;
+    expand.manager = &manager;
+
+    expectRead(0, 1, 0x8000);
+    expectRead(1, 2, 0x8001);
+    replyResource(0, bejEncoding(bejSet({link(2), link(3), link(7)})));
+    completeRead(2, 1, 0x8000);
+    // The context freed by the first resource goes on to the third
+    expectRead(3, 3, 0x8002);
+    replyResource(1, leaf('b'));
+    completeRead(4, 2, 0x8001);
+    replyResource(3, leaf('c'));
+    completeRead(5, 3, 0x8002);
+    start();
+
+    ASSERT_EQ(pldm_rde_expand_start(engine, &expand), 0);
+    EXPECT_TRUE(pldm_rde_expand_running(&expand));
+    EXPECT_EQ(pldm_rde_expand_start(engine, &expand), -EBUSY);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    EXPECT_FALSE(pldm_rde_expand_running(&expand));
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].rc, 0);
+    EXPECT_EQ(results[0].payload,
+              bejEncoding(bejSet(
+                  {bejTuple(5, PLDM_BEJ_FORMAT_RESOURCE_LINK_EXPANSION,
+                            leaf('b')),
+                   bejTuple(5, PLDM_BEJ_FORMAT_RESOURCE_LINK_EXPANSION,
+                            leaf('c')),
+                   link(7)})));
+}
+
+TEST_F(TestRdeExpand, KeepsLinksToResourcesThatFailed)
+{
+    init(1);
+    expand.manager = &manager;
+    expand.levels = 2;
+    expand.resource_size = 32;
+
+    expectRead(0, 1, 0x8000);
+    replyResource(0, bejEncoding(bejSet({link(2), link(3)})));
+    completeRead(1, 1, 0x8000);
+    expectRead(2, 2, 0x8001);
+    replyResource(2, bejEncoding(bejSet({link(4)})));
+    completeRead(3, 2, 0x8001);
+    // Too large for its buffer
+    expectRead(4, 3, 0x8002);
+    replyResource(4, bejEncoding(bejSet({leaf('c'), leaf('c')})));
+    completeRead(5, 3, 0x8002);
+    expectRead(6, 4, 0x8003);
+    replyResource(6, leaf('d'));
+    completeRead(7, 4, 0x8003);
+    start();
+
+    ASSERT_EQ(pldm_rde_expand_start(engine, &expand), 0);
+    EXPECT_EQ(pldm_rde_engine_run(engine, 1000), 0);
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].rc, 0);
+    EXPECT_EQ(results[0].payload,
+              bejEncoding(bejSet(
+                  {bejTuple(5, PLDM_BEJ_FORMAT_RESOURCE_LINK_EXPANSION,
+                            bejEncoding(bejSet({bejTuple(
+                                5, PLDM_BEJ_FORMAT_RESOURCE_LINK_EXPANSION,
+                                leaf('d'))}))),
+                   link(3)})));
+}
+
+TEST(RdeExpand, ReadsContainmentFromPdrs)
+{
+    // Resource 0x11 in 0x10, with empty names and no additional resources
+    std::vector<uint8_t> record = {0x11, 0, 0, 0, 0, 0x10, 0, 0, 0, 1, 0,
+                                   0,    1, 0, 0, 0, 0};
+    struct pldm_rde_resource_link link = {};
+
+    ASSERT_EQ(pldm_rde_resource_link_from_pdr(record.data(), &link), 0);
+    EXPECT_EQ(link.resource_id, 0x11u);
+    EXPECT_EQ(link.containing_resource_id, 0x10u);
+    EXPECT_EQ(pldm_rde_resource_link_from_pdr(NULL, &link), -EINVAL);
+}
@@ -0,0 +1,166 @@
+#include <errno.h>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "libpldm/requester/pldm_rde_registry.h"
+
+#include <gtest/gtest.h>
+
+class TestRdeRegistry : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(pldm_rde_registry_init(&registry), 0);
+    }
+
+    void TearDown() override
+    {
+        pldm_rde_registry_destroy(registry);
+    }
+
+    std::set<std::pair<int, uint8_t>> devicesWith(uint32_t resourceId)
+    {
+        struct pldm_rde_registry_device* const* devices;
+        std::set<std::pair<int, uint8_t>> found;
+        size_t count =
+            pldm_rde_registry_find_resource(registry, resourceId, &devices);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            found.emplace(devices[i]->net_id, devices[i]->endpoint);
+        }
+        EXPECT_EQ(found.size(), count);
+        return found;
+    }
+
+    struct pldm_rde_registry* registry = nullptr;
+};
+
+TEST_F(TestRdeRegistry, HoldsThousandsOfDevices)
+{
+    constexpr int networks = 20;
+
+    // Endpoint numbers repeat across networks
+    for (int net = 0; net < networks; net++)
+    {
+        for (int endpoint = 8; endpoint < 248; endpoint++)
+        {
+            ASSERT_EQ(pldm_rde_registry_add(registry, net, endpoint, NULL,
+                                            NULL, NULL),
+                      0);
+        }
+    }
+    EXPECT_EQ(pldm_rde_registry_count(registry), networks * 240u);
+    EXPECT_EQ(pldm_rde_registry_add(registry, 3, 9, NULL, NULL, NULL),
+              -EEXIST);
+
+    // Removing every other device must keep the rest reachable
+    for (int net = 0; net < networks; net++)
+    {
+        for (int endpoint = 8; endpoint < 248; endpoint += 2)
+        {
+            ASSERT_EQ(pldm_rde_registry_remove(registry, net, endpoint), 0);
+        }
+    }
+    EXPECT_EQ(pldm_rde_registry_count(registry), networks * 120u);
+    for (int net = 0; net < networks; net++)
+    {
+        for (int endpoint = 8; endpoint < 248; endpoint++)
+        {
+            struct pldm_rde_registry_device* device =
+                pldm_rde_registry_find(registry, net, endpoint);
+            if (endpoint % 2)
+            {
+                ASSERT_NE(device, nullptr);
+                EXPECT_EQ(device->net_id, net);
+                EXPECT_EQ(device->endpoint, endpoint);
+            }
+            else
+            {
+                EXPECT_EQ(device, nullptr);
+            }
+        }
+    }
+    EXPECT_EQ(pldm_rde_registry_remove(registry, 0, 8), -ENOENT);
+}
+
+TEST_F(TestRdeRegistry, IndexesResourcesAcrossDevices)
+{
+    struct pldm_rde_registry_device* first;
+    struct pldm_rde_registry_device* second;
+    std::vector<uint32_t> resources;
+
+    // More resources than a Context Manager holds
+    for (uint32_t i = 0; i < 3 * MAX_RESOURCE_IDS; i++)
+    {
+        resources.push_back(0x10000 + i);
+    }
+
+    ASSERT_EQ(pldm_rde_registry_add(registry, 1, 10, NULL, NULL, &first), 0);
+    ASSERT_EQ(pldm_rde_registry_add(registry, 2, 10, NULL, NULL, &second), 0);
+    ASSERT_EQ(pldm_rde_registry_set_resources(registry, first,
+                                              resources.data(),
+                                              resources.size()),
+              0);
+    ASSERT_EQ(pldm_rde_registry_set_resources(registry, second,
+                                              resources.data(), 10),
+              0);
+    EXPECT_EQ(first->number_of_resources, resources.size());
+
+    using Devices = std::set<std::pair<int, uint8_t>>;
+    EXPECT_EQ(devicesWith(0x10000), Devices({{1, 10}, {2, 10}}));
+    EXPECT_EQ(devicesWith(0x10000 + 100), Devices({{1, 10}}));
+    EXPECT_EQ(devicesWith(0x20000), Devices());
+
+    // Replacing a table drops the old entries, duplicates count once
+    std::vector<uint32_t> replacement = {0x20000, 0x20000, 0x10005};
+    ASSERT_EQ(pldm_rde_registry_set_resources(registry, second,
+                                              replacement.data(),
+                                              replacement.size()),
+              0);
+    EXPECT_EQ(devicesWith(0x10000), Devices({{1, 10}}));
+    EXPECT_EQ(devicesWith(0x20000), Devices({{2, 10}}));
+    EXPECT_EQ(devicesWith(0x10005), Devices({{1, 10}, {2, 10}}));
+
+    ASSERT_EQ(pldm_rde_registry_remove(registry, 1, 10), 0);
+    EXPECT_EQ(devicesWith(0x10005), Devices({{2, 10}}));
+    EXPECT_EQ(devicesWith(0x10000 + 100), Devices());
+}
+
+TEST_F(TestRdeRegistry, StartsFromTheManagerResources)
+{
+    struct pldm_rde_requester_manager manager = {};
+    struct pldm_rde_registry_device* device;
+    int data;
+
+    manager.resource_ids[0] = 0x100;
+    manager.resource_ids[1] = 0x200;
+    manager.number_of_resources = 2;
+
+    ASSERT_EQ(
+        pldm_rde_registry_add(registry, 0, 20, &manager, &data, &device), 0);
+    EXPECT_EQ(device->manager, &manager);
+    EXPECT_EQ(device->data, &data);
+    EXPECT_EQ(pldm_rde_registry_find(registry, 0, 20), device);
+    EXPECT_EQ(devicesWith(0x200).size(), 1u);
+}
+
+TEST(RdeRegistry, RejectsInvalidArguments)
+{
+    struct pldm_rde_registry* registry = nullptr;
+    struct pldm_rde_registry_device* const* devices;
+
+    EXPECT_EQ(pldm_rde_registry_init(NULL), -EINVAL);
+    EXPECT_EQ(pldm_rde_registry_add(NULL, 0, 0, NULL, NULL, NULL), -EINVAL);
+    EXPECT_EQ(pldm_rde_registry_find(NULL, 0, 0), nullptr);
+    EXPECT_EQ(pldm_rde_registry_find_resource(NULL, 0, &devices), 0u);
+
+    ASSERT_EQ(pldm_rde_registry_init(&registry), 0);
+    EXPECT_EQ(pldm_rde_registry_init(&registry), -EINVAL);
+    EXPECT_EQ(pldm_rde_registry_set_resources(registry, NULL, NULL, 0),
+              -EINVAL);
+    pldm_rde_registry_destroy(registry);
+}
@@ -1,11 +1,21 @@
+#include <endian.h>
+#include <errno.h>
 #include <string.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <array>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <map>
+#include <string>
 #include <vector>
 
+#include "libpldm/requester/pldm_rde_read_cache.h"
 #include "libpldm/requester/pldm_rde_requester.h"
+#include "libpldm/utils.h"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -110,8 +120,9 @@ TEST_F(TestRdeRequester, ContextManagerInitializationSuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     EXPECT_EQ(rc, PLDM_BASE_REQUESTER_SUCCESS);
     EXPECT_EQ(manager->mc_concurrency, mcConcurrency);
@@ -129,7 +140,6 @@ TEST_F(TestRdeRequester, ContextManagerInitializationFailureDueToNullManager)
     struct pldm_rde_requester_manager* manager = NULL;
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
     EXPECT_EQ(rc, PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
 }
@@ -141,21 +151,18 @@ TEST_F(TestRdeRequester, ContextManagerInitializationFailureDueToWrongDevId)
         new pldm_rde_requester_manager();
     int rc = pldm_rde_init_context(incorrect_dev_id.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
     EXPECT_EQ(rc, PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
 
     incorrect_dev_id = "";
     rc = pldm_rde_init_context(incorrect_dev_id.c_str(), netId, manager,
                                mcConcurrency, mcTransferSize, &mcFeatures,
-                               numberOfResources, &resourceIds.front(),
                                allocate_memory_to_contexts, free_memory);
     EXPECT_EQ(rc, PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
 
     incorrect_dev_id = "VERY_LONG_DEV_ID";
     rc = pldm_rde_init_context(incorrect_dev_id.c_str(), netId, manager,
                                mcConcurrency, mcTransferSize, &mcFeatures,
-                               numberOfResources, &resourceIds.front(),
                                allocate_memory_to_contexts, free_memory);
     EXPECT_EQ(rc, PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
 }
@@ -167,13 +174,11 @@ TEST_F(TestRdeRequester,
         new pldm_rde_requester_manager();
     int rc =
         pldm_rde_init_context(devId.c_str(), netId, manager, mcConcurrency,
-                              mcTransferSize, &mcFeatures, numberOfResources,
-                              &resourceIds.front(), NULL, free_memory);
+                              mcTransferSize, &mcFeatures, NULL, free_memory);
     EXPECT_EQ(rc, PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
 
     rc = pldm_rde_init_context(devId.c_str(), netId, manager, mcConcurrency,
-                               mcTransferSize, &mcFeatures, numberOfResources,
-                               &resourceIds.front(),
+                               mcTransferSize, &mcFeatures,
                                allocate_memory_to_contexts, NULL);
     EXPECT_EQ(rc, PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
 }
@@ -185,8 +190,9 @@ TEST_F(TestRdeRequester, StartRDEDiscoverySuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context base_context = rde_contexts[0];
 
@@ -203,8 +209,9 @@ TEST_F(TestRdeRequester, StartRDEDiscoveryFailure)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context base_context = rde_contexts[0];
 
@@ -220,8 +227,9 @@ TEST_F(TestRdeRequester, CreateRequesterContextSuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* current_ctx =
         new pldm_rde_requester_context();
@@ -242,8 +250,9 @@ TEST_F(TestRdeRequester, CreateRequesterContextFailure)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* current_ctx = NULL;
     rc = pldm_rde_create_context(current_ctx);
@@ -275,8 +284,9 @@ TEST_F(TestRdeRequester, GetNextRequestInSequenceSuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -300,8 +310,9 @@ TEST_F(TestRdeRequester, GetNextRequestInSequenceFailure)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -319,8 +330,9 @@ TEST_F(TestRdeRequester, PushDiscoveryResponseRedfishParamSuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -373,8 +385,9 @@ TEST_F(TestRdeRequester, PushDiscoveryResponseRedfishMediumParamSuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -410,8 +423,9 @@ TEST_F(TestRdeRequester, PushDiscoveryResponseFailure)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -433,8 +447,9 @@ TEST_F(TestRdeRequester, InitDictionarySchemaSuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
     EXPECT_EQ(rc, PLDM_BASE_REQUESTER_SUCCESS);
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -453,8 +468,9 @@ TEST_F(TestRdeRequester, InitDictionarySchemaFailure)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
     EXPECT_EQ(rc, PLDM_BASE_REQUESTER_SUCCESS);
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -471,8 +487,9 @@ TEST_F(TestRdeRequester, GetNextDictionarySchemaSuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
     EXPECT_EQ(rc, PLDM_BASE_REQUESTER_SUCCESS);
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -502,8 +519,9 @@ TEST_F(TestRdeRequester, GetNextDictionarySchemaFailure)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
     EXPECT_EQ(rc, PLDM_BASE_REQUESTER_SUCCESS);
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -525,8 +543,9 @@ TEST_F(TestRdeRequester, MultipartReceiveSuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
     EXPECT_EQ(rc, PLDM_BASE_REQUESTER_SUCCESS);
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -570,8 +589,9 @@ TEST_F(TestRdeRequester, PushResponseForGetDictionarySchema)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
     EXPECT_EQ(rc, PLDM_BASE_REQUESTER_SUCCESS);
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -604,8 +624,9 @@ TEST_F(TestRdeRequester, PushResponseForMultipartReceive)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
     EXPECT_EQ(rc, PLDM_BASE_REQUESTER_SUCCESS);
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -639,8 +660,9 @@ TEST_F(TestRdeRequester, InitRDEOperationContextSuccess)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -654,8 +676,8 @@ TEST_F(TestRdeRequester, InitRDEOperationContextSuccess)
         &reqPtr);
 
     EXPECT_EQ(rc, PLDM_RDE_REQUESTER_SUCCESS);
-    struct rde_operation* operation =
-        (struct rde_operation*)base_context->operation_ctx;
+    struct rde_operation* operation = &base_context->operation;
+    EXPECT_TRUE(operation->active);
     EXPECT_EQ(operation->request_id, requestId);
     EXPECT_EQ(operation->resource_id, resourceId);
 }
@@ -667,8 +689,9 @@ TEST_F(TestRdeRequester, InitRDEOperationContextFailure)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -690,8 +713,9 @@ TEST_F(TestRdeRequester, GetNextRDEOperationSuccess)
         new pldm_rde_requester_manager();
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -730,8 +754,9 @@ TEST_F(TestRdeRequester, GetNextRDEOperationFailure)
 
     int rc = pldm_rde_init_context(devId.c_str(), netId, manager,
                                    mcConcurrency, mcTransferSize, &mcFeatures,
-                                   numberOfResources, &resourceIds.front(),
                                    allocate_memory_to_contexts, free_memory);
+    pldm_rde_set_resources_in_context(manager, numberOfResources,
+                                      &resourceIds.front());
 
     struct pldm_rde_requester_context* base_context =
         new pldm_rde_requester_context();
@@ -766,3 +791,1661 @@ TEST_F(TestRdeRequester, GetNextRDEOperationFailure)
 
     EXPECT_EQ(rc, PLDM_RDE_CONTEXT_NOT_READY);
 }
+
+#ifdef LIBPLDM_API_TESTING
+std::vector<std::vector<uint8_t>> cached_dictionaries;
+
+void record_cached_dictionary(struct pldm_rde_requester_manager* manager,
+                              struct pldm_rde_requester_context* ctx,
+                              uint8_t** payload, uint32_t payload_length,
+                              bool has_checksum)
+{
+    IGNORE(manager);
+    IGNORE(ctx);
+    EXPECT_TRUE(has_checksum);
+    cached_dictionaries.emplace_back(*payload, *payload + payload_length);
+}
+
+void negotiate_redfish_parameters(struct pldm_rde_requester_manager* manager,
+                                  struct pldm_rde_requester_context* ctx,
+                                  uint32_t signature)
+{
+    bitfield8_t capabilities{};
+    bitfield16_t features{};
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + 16, 0);
+    auto responsePtr = reinterpret_cast<struct pldm_msg*>(response.data());
+
+    ctx->next_command = PLDM_NEGOTIATE_REDFISH_PARAMETERS;
+    ASSERT_EQ(encode_negotiate_redfish_parameters_resp(
+                  0, PLDM_SUCCESS, 1, capabilities, features, signature, "V",
+                  PLDM_RDE_VARSTRING_ASCII, responsePtr),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_discovery_push_response(manager, ctx, responsePtr,
+                                               response.size()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+}
+
+void fetch_dictionary_from_device(struct pldm_rde_requester_manager* manager,
+                                  struct pldm_rde_requester_context* ctx,
+                                  const std::vector<uint8_t>& dictionary)
+{
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+    std::vector<uint8_t> response(
+        sizeof(pldm_msg_hdr) + PLDM_RDE_MULTIPART_RECEIVE_RESP_HDR_SIZE +
+            dictionary.size() + sizeof(uint32_t),
+        0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+
+    ASSERT_EQ(pldm_rde_get_next_dictionary_schema_command(0, manager, ctx,
+                                                          requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(ctx->next_command, PLDM_GET_SCHEMA_DICTIONARY);
+    ASSERT_EQ(encode_get_schema_dictionary_resp(0, PLDM_SUCCESS, 0, 0x10,
+                                                responsePtr),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_get_dictionary_response(
+                  manager, ctx, responsePtr, sizeof(pldm_msg_hdr) + 6,
+                  dummy_callback),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(pldm_rde_get_next_dictionary_schema_command(0, manager, ctx,
+                                                          requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(ctx->next_command, PLDM_RDE_MULTIPART_RECEIVE);
+    ASSERT_EQ(encode_rde_multipart_receive_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_START_AND_END, 0,
+                  dictionary.size(), true, 0xdeadbeef, dictionary.data(),
+                  responsePtr),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_get_dictionary_response(
+                  manager, ctx, responsePtr, response.size(), dummy_callback),
+              PLDM_RDE_REQUESTER_SUCCESS);
+}
+
+class TestRdeDictionaryCache : public TestRdeRequester
+{
+  protected:
+    void SetUp() override
+    {
+        char dirTemplate[] = "/tmp/rde-dictionary-cache-XXXXXX";
+        ASSERT_NE(mkdtemp(dirTemplate), nullptr);
+        cacheDir = dirTemplate;
+        cached_dictionaries.clear();
+
+        ASSERT_EQ(pldm_rde_init_context(devId.c_str(), netId, &manager,
+                                        mcConcurrency, mcTransferSize,
+                                        &mcFeatures,
+                                        allocate_memory_to_contexts,
+                                        free_memory),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_set_resources_in_context(
+                      &manager, numberOfResources, &resourceIds.front()),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_set_dictionary_cache(&manager, cacheDir.c_str(),
+                                                record_cached_dictionary),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_create_context(&ctx), PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        std::string cmd = "rm -rf " + cacheDir;
+        EXPECT_EQ(system(cmd.c_str()), 0);
+    }
+
+    void populate()
+    {
+        negotiate_redfish_parameters(&manager, &ctx, 0x12345678);
+        ASSERT_EQ(pldm_rde_init_get_dictionary_schema(&ctx),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        fetch_dictionary_from_device(&manager, &ctx, dictionaryA);
+        fetch_dictionary_from_device(&manager, &ctx, dictionaryB);
+        ASSERT_EQ(ctx.requester_status, PLDM_RDE_REQUESTER_NO_PENDING_ACTION);
+        ASSERT_TRUE(cached_dictionaries.empty());
+    }
+
+    std::string cacheDir;
+    struct pldm_rde_requester_manager manager = {};
+    struct pldm_rde_requester_context ctx = {};
+    std::vector<uint8_t> dictionaryA = {0x00, 0x01, 0x02, 0x03, 0x04};
+    std::vector<uint8_t> dictionaryB = {0x10, 0x11, 0x12};
+};
+
+TEST_F(TestRdeDictionaryCache, CacheHitSkipsDictionaryTransfer)
+{
+    populate();
+
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+
+    ASSERT_EQ(pldm_rde_init_get_dictionary_schema(&ctx),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_get_next_dictionary_schema_command(0, &manager, &ctx,
+                                                          requestPtr),
+              PLDM_RDE_DICTIONARY_CACHE_HIT);
+    EXPECT_EQ(ctx.requester_status, PLDM_RDE_REQUESTER_NO_PENDING_ACTION);
+    EXPECT_EQ(ctx.context_status, CONTEXT_FREE);
+    EXPECT_EQ(ctx.current_pdr_resource, nullptr);
+
+    uint32_t checksum = htole32(0xdeadbeef);
+    auto checksumBytes = reinterpret_cast<uint8_t*>(&checksum);
+    ASSERT_EQ(cached_dictionaries.size(), 2);
+    dictionaryA.insert(dictionaryA.end(), checksumBytes, checksumBytes + 4);
+    dictionaryB.insert(dictionaryB.end(), checksumBytes, checksumBytes + 4);
+    EXPECT_EQ(cached_dictionaries[0], dictionaryA);
+    EXPECT_EQ(cached_dictionaries[1], dictionaryB);
+}
+
+TEST_F(TestRdeDictionaryCache, SignatureChangeInvalidatesCache)
+{
+    populate();
+
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+
+    negotiate_redfish_parameters(&manager, &ctx, 0x87654321);
+    ASSERT_EQ(pldm_rde_init_get_dictionary_schema(&ctx),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_get_next_dictionary_schema_command(0, &manager, &ctx,
+                                                          requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(ctx.next_command, PLDM_GET_SCHEMA_DICTIONARY);
+    EXPECT_TRUE(cached_dictionaries.empty());
+    free_op_context_after_dictionary_extraction(&ctx);
+}
+
+TEST_F(TestRdeDictionaryCache, CorruptEntryIsFetchedAgain)
+{
+    populate();
+
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+    char name[32];
+
+    snprintf(name, sizeof(name), "/%08x-%u.dict", resourceIds[0],
+             PLDM_RDE_SCHEMA_MAJOR);
+    std::string path = cacheDir + "/" + devId + name;
+    FILE* entry = fopen(path.c_str(), "r+b");
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(fseek(entry, -1, SEEK_END), 0);
+    ASSERT_NE(fputc(0x5a, entry), EOF);
+    ASSERT_EQ(fclose(entry), 0);
+
+    ASSERT_EQ(pldm_rde_init_get_dictionary_schema(&ctx),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_get_next_dictionary_schema_command(0, &manager, &ctx,
+                                                          requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(ctx.next_command, PLDM_GET_SCHEMA_DICTIONARY);
+    EXPECT_TRUE(cached_dictionaries.empty());
+    EXPECT_NE(access(path.c_str(), F_OK), 0);
+    free_op_context_after_dictionary_extraction(&ctx);
+}
+
+TEST_F(TestRdeDictionaryCache, PartialHitResumesAtFirstMiss)
+{
+    populate();
+
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+    uint32_t moreResourceIds[] = {0x00000000, 0x00020000};
+
+    ASSERT_EQ(pldm_rde_set_resources_in_context(&manager, 2, moreResourceIds),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_init_get_dictionary_schema(&ctx),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_get_next_dictionary_schema_command(0, &manager, &ctx,
+                                                          requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(cached_dictionaries.size(), 1);
+    EXPECT_EQ(ctx.current_pdr_resource->resource_id_index, 1);
+    free_op_context_after_dictionary_extraction(&ctx);
+}
+#endif
+
+#ifdef LIBPLDM_API_TESTING
+void exchange_dictionary_step(struct pldm_rde_requester_manager* manager,
+                              struct pldm_rde_requester_context* ctx,
+                              std::vector<uint32_t>& requested)
+{
+    uint8_t dictionary[] = {0xaa, 0xbb};
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + 32, 0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+
+    ASSERT_EQ(pldm_rde_get_next_dictionary_schema_command(0, manager, ctx,
+                                                          requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    if (ctx->next_command == PLDM_GET_SCHEMA_DICTIONARY)
+    {
+        uint32_t resourceId;
+        memcpy(&resourceId, requestPtr->payload, sizeof(resourceId));
+        requested.push_back(le32toh(resourceId));
+        ASSERT_EQ(encode_get_schema_dictionary_resp(0, PLDM_SUCCESS, 0, 0x10,
+                                                    responsePtr),
+                  PLDM_SUCCESS);
+    }
+    else
+    {
+        ASSERT_EQ(ctx->next_command, PLDM_RDE_MULTIPART_RECEIVE);
+        ASSERT_EQ(encode_rde_multipart_receive_resp(
+                      0, PLDM_SUCCESS, PLDM_RDE_START_AND_END, 0,
+                      sizeof(dictionary), true, 0, dictionary, responsePtr),
+                  PLDM_SUCCESS);
+    }
+    ASSERT_EQ(pldm_rde_push_get_dictionary_response(
+                  manager, ctx, responsePtr, response.size(), dummy_callback),
+              PLDM_RDE_REQUESTER_SUCCESS);
+}
+
+TEST_F(TestRdeRequester, DictionaryDownloadSpreadsAcrossContexts)
+{
+    struct pldm_rde_requester_manager manager = {};
+    std::vector<uint32_t> ids = {0x100, 0x200, 0x300, 0x400, 0x500};
+    std::vector<uint32_t> requested;
+    uint8_t started = 0;
+
+    ASSERT_EQ(pldm_rde_init_context(devId.c_str(), netId, &manager,
+                                    mcConcurrency, mcTransferSize, &mcFeatures,
+                                    allocate_memory_to_contexts, free_memory),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_set_resources_in_context(&manager, ids.size(),
+                                                ids.data()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    manager.device.device_concurrency = 2;
+
+    ASSERT_EQ(pldm_rde_start_dictionary_download(&manager, &started),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(started, 2);
+    EXPECT_EQ(manager.ctx[2].current_pdr_resource, nullptr);
+    EXPECT_EQ(pldm_rde_start_dictionary_download(&manager, &started),
+              PLDM_RDE_CONTEXT_NOT_READY);
+
+    std::array<int, 2> exchanges = {};
+    bool pending = true;
+    while (pending)
+    {
+        pending = false;
+        for (int i = 0; i < 2; i++)
+        {
+            if (manager.ctx[i].requester_status ==
+                PLDM_RDE_REQUESTER_NO_PENDING_ACTION)
+            {
+                continue;
+            }
+            exchange_dictionary_step(&manager, &manager.ctx[i], requested);
+            exchanges[i]++;
+            pending = true;
+        }
+    }
+
+    std::sort(requested.begin(), requested.end());
+    EXPECT_EQ(requested, ids);
+    EXPECT_GT(exchanges[0], 2);
+    EXPECT_GT(exchanges[1], 2);
+    EXPECT_FALSE(manager.dictionary_download_scheduled);
+    EXPECT_EQ(manager.ctx[0].current_pdr_resource, nullptr);
+    EXPECT_EQ(manager.ctx[1].current_pdr_resource, nullptr);
+}
+
+TEST_F(TestRdeRequester, DictionaryDownloadRequiresResources)
+{
+    struct pldm_rde_requester_manager manager = {};
+    uint8_t started = 0;
+
+    ASSERT_EQ(pldm_rde_init_context(devId.c_str(), netId, &manager,
+                                    mcConcurrency, mcTransferSize, &mcFeatures,
+                                    allocate_memory_to_contexts, free_memory),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_start_dictionary_download(&manager, &started),
+              PLDM_RDE_NO_PDR_RESOURCES_FOUND);
+    EXPECT_EQ(pldm_rde_start_dictionary_download(NULL, &started),
+              PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
+}
+#endif
+
+#ifdef LIBPLDM_API_TESTING
+TEST_F(TestRdeRequester, LargeUpdatePayloadUsesMultipartSend)
+{
+    struct pldm_rde_requester_manager manager = {};
+    struct pldm_rde_requester_context ctx = {};
+    std::vector<uint8_t> payload(100);
+    std::vector<uint8_t> received;
+    union pldm_rde_operation_flags opFlags = {};
+    union pldm_rde_op_execution_flags execFlags = {};
+    union pldm_rde_permission_flags permFlags = {};
+    uint16_t operationId = 0x8001;
+    int chunks = 0;
+
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+        payload[i] = i;
+    }
+    opFlags.bits.contains_request_payload = 1;
+
+    ASSERT_EQ(pldm_rde_init_context(devId.c_str(), netId, &manager,
+                                    mcConcurrency, mcTransferSize, &mcFeatures,
+                                    allocate_memory_to_contexts, free_memory),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_set_resources_in_context(&manager, numberOfResources,
+                                                &resourceIds.front()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    manager.negotiated_transfer_size = 64;
+    ASSERT_EQ(pldm_rde_create_context(&ctx), PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                  &ctx, requestId, resourceId, operationId,
+                  PLDM_RDE_OPERATION_UPDATE, opFlags.byte, NULL, 0, 0,
+                  payload.size(), NULL, payload.data()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    std::vector<uint8_t> request(manager.negotiated_transfer_size);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + 64, 0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+
+    // The payload does not fit, so RDEOperationInit announces a transfer
+    ASSERT_EQ(pldm_rde_get_next_rde_operation(0, &manager, &ctx, requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    auto initReq =
+        reinterpret_cast<pldm_rde_operation_init_req*>(requestPtr->payload);
+    EXPECT_EQ(le32toh(initReq->request_payload_length), 0);
+    uint32_t sendHandle = le32toh(initReq->send_data_transfer_handle);
+    EXPECT_NE(sendHandle, 0);
+
+    ASSERT_EQ(encode_rde_operation_init_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_OPERATION_NEEDS_INPUT, 0,
+                  PLDM_RDE_COMP_TIME_NOT_SUPPORTED, &execFlags, 0, &permFlags,
+                  0, PLDM_RDE_VARSTRING_UTF_8, "", NULL, responsePtr),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr, response.size(),
+                  dummy_callback),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(ctx.next_command, PLDM_RDE_MULTIPART_SEND);
+
+    uint8_t transferFlag = PLDM_RDE_START;
+    while (ctx.next_command == PLDM_RDE_MULTIPART_SEND)
+    {
+        uint32_t transferHandle;
+        uint16_t returnOperationId;
+        uint32_t nextTransferHandle;
+        uint32_t dataLength;
+        const uint8_t* data;
+
+        ASSERT_EQ(
+            pldm_rde_get_next_rde_operation(0, &manager, &ctx, requestPtr),
+            PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(decode_rde_multipart_send_req(
+                      requestPtr, request.size() - sizeof(pldm_msg_hdr),
+                      &transferHandle, &returnOperationId, &transferFlag,
+                      &nextTransferHandle, &dataLength, &data),
+                  PLDM_SUCCESS);
+        EXPECT_EQ(transferHandle, sendHandle);
+        EXPECT_EQ(returnOperationId, operationId);
+        EXPECT_EQ(transferFlag,
+                  chunks == 0 ? PLDM_RDE_START
+                              : (nextTransferHandle ? PLDM_RDE_MIDDLE
+                                                    : PLDM_RDE_END));
+        received.insert(received.end(), data, data + dataLength);
+        sendHandle = nextTransferHandle;
+        chunks++;
+
+        ASSERT_EQ(encode_rde_multipart_send_resp(
+                      0, PLDM_SUCCESS,
+                      transferFlag == PLDM_RDE_END ? PLDM_XFER_COMPLETE
+                                                   : PLDM_XFER_NEXT_PART,
+                      responsePtr),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(pldm_rde_push_read_operation_response(
+                      &manager, &ctx, responsePtr,
+                      sizeof(pldm_msg_hdr) + RDE_MULTIPART_SEND_RESP_BYTES,
+                      dummy_callback),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    // Every chunk but the last fills the negotiated transfer size
+    EXPECT_EQ(chunks, 3);
+    EXPECT_EQ(transferFlag, PLDM_RDE_END);
+    EXPECT_EQ(ctx.next_command, PLDM_RDE_OPERATION_STATUS);
+    EXPECT_EQ(ctx.requester_status,
+              PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST);
+
+    ASSERT_EQ(received.size(), payload.size() + sizeof(uint32_t));
+    uint32_t checksum;
+    memcpy(&checksum, received.data() + payload.size(), sizeof(checksum));
+    received.resize(payload.size());
+    EXPECT_EQ(received, payload);
+    EXPECT_EQ(le32toh(checksum), crc32(payload.data(), payload.size()));
+    free_rde_op_init_context(&ctx);
+}
+
+TEST_F(TestRdeRequester, UpdateSuppliesCustomParametersThenSendsPayload)
+{
+    struct pldm_rde_requester_manager manager = {};
+    struct pldm_rde_requester_context ctx = {};
+    struct rde_query_options queryOptions = {};
+    std::vector<uint8_t> payload(100);
+    std::vector<uint8_t> received;
+    union pldm_rde_operation_flags opFlags = {};
+    union pldm_rde_op_execution_flags execFlags = {};
+    union pldm_rde_permission_flags permFlags = {};
+    int chunks = 0;
+
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+        payload[i] = i;
+    }
+    opFlags.bits.contains_request_payload = 1;
+    opFlags.bits.contains_custom_request_parameters = 1;
+
+    ASSERT_EQ(pldm_rde_init_context(devId.c_str(), netId, &manager,
+                                    mcConcurrency, mcTransferSize, &mcFeatures,
+                                    allocate_memory_to_contexts, free_memory),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_set_resources_in_context(&manager, numberOfResources,
+                                                &resourceIds.front()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    manager.negotiated_transfer_size = 64;
+    ASSERT_EQ(pldm_rde_create_context(&ctx), PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                  &ctx, requestId, resourceId, 0x8001,
+                  PLDM_RDE_OPERATION_UPDATE, opFlags.byte, &queryOptions, 0,
+                  0, payload.size(), NULL, payload.data()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    std::vector<uint8_t> request(manager.negotiated_transfer_size);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + 64, 0);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+
+    ASSERT_EQ(pldm_rde_get_next_rde_operation(0, &manager, &ctx, requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(encode_rde_operation_init_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_OPERATION_NEEDS_INPUT, 0,
+                  PLDM_RDE_COMP_TIME_NOT_SUPPORTED, &execFlags, 0, &permFlags,
+                  0, PLDM_RDE_VARSTRING_UTF_8, "", NULL, responsePtr),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr, response.size(),
+                  dummy_callback),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(ctx.next_command, PLDM_SUPPLY_CUSTOM_REQUEST_PARAMETERS);
+
+    // The device still needs the payload once the parameters are in
+    ASSERT_EQ(pldm_rde_get_next_rde_operation(0, &manager, &ctx, requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(encode_supply_custom_request_parameters_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_OPERATION_NEEDS_INPUT, 0,
+                  PLDM_RDE_COMP_TIME_NOT_SUPPORTED, &execFlags, 0, &permFlags,
+                  0, PLDM_RDE_VARSTRING_UTF_8, const_cast<char*>(""), NULL,
+                  responsePtr),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr, response.size(),
+                  dummy_callback),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(ctx.next_command, PLDM_RDE_MULTIPART_SEND);
+
+    while (ctx.next_command == PLDM_RDE_MULTIPART_SEND)
+    {
+        uint32_t transferHandle;
+        uint16_t returnOperationId;
+        uint8_t transferFlag;
+        uint32_t nextTransferHandle;
+        uint32_t dataLength;
+        const uint8_t* data;
+
+        ASSERT_EQ(
+            pldm_rde_get_next_rde_operation(0, &manager, &ctx, requestPtr),
+            PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(decode_rde_multipart_send_req(
+                      requestPtr, request.size() - sizeof(pldm_msg_hdr),
+                      &transferHandle, &returnOperationId, &transferFlag,
+                      &nextTransferHandle, &dataLength, &data),
+                  PLDM_SUCCESS);
+        received.insert(received.end(), data, data + dataLength);
+        chunks++;
+
+        ASSERT_EQ(encode_rde_multipart_send_resp(
+                      0, PLDM_SUCCESS,
+                      transferFlag == PLDM_RDE_END ? PLDM_XFER_COMPLETE
+                                                   : PLDM_XFER_NEXT_PART,
+                      responsePtr),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(pldm_rde_push_read_operation_response(
+                      &manager, &ctx, responsePtr,
+                      sizeof(pldm_msg_hdr) + RDE_MULTIPART_SEND_RESP_BYTES,
+                      dummy_callback),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    EXPECT_EQ(chunks, 3);
+    EXPECT_EQ(ctx.next_command, PLDM_RDE_OPERATION_STATUS);
+    ASSERT_EQ(received.size(), payload.size() + sizeof(uint32_t));
+    received.resize(payload.size());
+    EXPECT_EQ(received, payload);
+    free_rde_op_init_context(&ctx);
+}
+
+TEST_F(TestRdeRequester, SuppliesTheCallersEtagOperation)
+{
+    struct pldm_rde_requester_manager manager = {};
+    struct pldm_rde_requester_context ctx = {};
+    struct rde_query_options queryOptions = {};
+    union pldm_rde_operation_flags opFlags = {};
+    char etag[] = "\"1a2b\"";
+
+    opFlags.bits.contains_custom_request_parameters = 1;
+    queryOptions.etag_operation = PLDM_RDE_ETAG_IF_MATCH;
+    queryOptions.etag_count = 1;
+    queryOptions.etag_formats[0] = PLDM_RDE_VARSTRING_UTF_8;
+    queryOptions.etags[0] = etag;
+
+    ASSERT_EQ(pldm_rde_init_context(devId.c_str(), netId, &manager,
+                                    mcConcurrency, mcTransferSize, &mcFeatures,
+                                    allocate_memory_to_contexts, free_memory),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_create_context(&ctx), PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                  &ctx, requestId, resourceId, 0x8001,
+                  PLDM_RDE_OPERATION_READ, opFlags.byte, &queryOptions, 0, 0,
+                  0, NULL, NULL),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    ctx.next_command = PLDM_SUPPLY_CUSTOM_REQUEST_PARAMETERS;
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 64);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+    manager.number_of_resources = 1;
+    ASSERT_EQ(pldm_rde_get_next_rde_operation(0, &manager, &ctx, requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    auto req = reinterpret_cast<pldm_supply_custom_request_parameters_req*>(
+        requestPtr->payload);
+    EXPECT_EQ(req->etag_operation, PLDM_RDE_ETAG_IF_MATCH);
+    EXPECT_EQ(req->etag_count, 1);
+    EXPECT_EQ(req->var_data[0], PLDM_RDE_VARSTRING_UTF_8);
+    EXPECT_EQ(req->var_data[1], sizeof(etag));
+    EXPECT_EQ(memcmp(&req->var_data[2], etag, sizeof(etag)), 0);
+    free_rde_op_init_context(&ctx);
+}
+
+TEST_F(TestRdeRequester, MultipartSendFailsOnUnexpectedTransferOperation)
+{
+    struct pldm_rde_requester_manager manager = {};
+    struct pldm_rde_requester_context ctx = {};
+    std::vector<uint8_t> payload(8, 0x5a);
+
+    ASSERT_EQ(pldm_rde_init_context(devId.c_str(), netId, &manager,
+                                    mcConcurrency, mcTransferSize, &mcFeatures,
+                                    allocate_memory_to_contexts, free_memory),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_create_context(&ctx), PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                  &ctx, requestId, resourceId, 0x8001,
+                  PLDM_RDE_OPERATION_UPDATE, 0, NULL, 1, 0, payload.size(),
+                  NULL, payload.data()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    // A single chunk carries the payload, so the device must not ask for
+    // more
+    ctx.next_command = PLDM_RDE_MULTIPART_SEND;
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 64);
+    auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+    manager.number_of_resources = 1;
+    ASSERT_EQ(pldm_rde_get_next_rde_operation(0, &manager, &ctx, requestPtr),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                  RDE_MULTIPART_SEND_RESP_BYTES);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    ASSERT_EQ(encode_rde_multipart_send_resp(0, PLDM_SUCCESS,
+                                             PLDM_XFER_NEXT_PART, responsePtr),
+              PLDM_SUCCESS);
+    pldm_rde_push_read_operation_response(&manager, &ctx, responsePtr,
+                                          response.size(), dummy_callback);
+    EXPECT_EQ(ctx.requester_status,
+              (uint8_t)PLDM_RDE_REQUESTER_REQUEST_FAILED);
+    EXPECT_EQ(ctx.next_command, PLDM_RDE_OPERATION_COMPLETE);
+    free_rde_op_init_context(&ctx);
+}
+#endif
+
+#ifdef LIBPLDM_API_TESTING
+struct reassembly_notification
+{
+    int calls;
+    uint8_t* payload;
+    uint32_t length;
+    bool hasChecksum;
+} reassemblyNotification;
+
+void record_reassembly(struct pldm_rde_requester_manager* /*manager*/,
+                       struct pldm_rde_requester_context* /*ctx*/,
+                       uint8_t** payload, uint32_t length, bool hasChecksum)
+{
+    reassemblyNotification.calls++;
+    reassemblyNotification.payload = *payload;
+    reassemblyNotification.length = length;
+    reassemblyNotification.hasChecksum = hasChecksum;
+}
+
+class TestRdeReassembly : public TestRdeRequester
+{
+  protected:
+    void SetUp() override
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+
+        reassemblyNotification = {};
+        result.resize(100);
+        for (size_t i = 0; i < result.size(); i++)
+        {
+            result[i] = 0xff - i;
+        }
+
+        ASSERT_EQ(pldm_rde_init_context(
+                      devId.c_str(), netId, &manager, mcConcurrency,
+                      mcTransferSize, &mcFeatures, allocate_memory_to_contexts,
+                      free_memory),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_set_resources_in_context(
+                      &manager, numberOfResources, &resourceIds.front()),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_create_context(&ctx), PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                      &ctx, requestId, resourceId, 0x8001,
+                      PLDM_RDE_OPERATION_READ, 0, NULL, 0, 0, 0, NULL, NULL),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+
+        ASSERT_EQ(encode_rde_operation_init_resp(
+                      0, PLDM_SUCCESS, PLDM_RDE_OPERATION_HAVE_RESULTS, 100,
+                      PLDM_RDE_COMP_TIME_NOT_SUPPORTED, &execFlags,
+                      resultHandle, &permFlags, 0, PLDM_RDE_VARSTRING_UTF_8,
+                      "", NULL, responsePtr()),
+                  PLDM_SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        free_rde_op_init_context(&ctx);
+    }
+
+    pldm_msg* responsePtr()
+    {
+        return reinterpret_cast<pldm_msg*>(response.data());
+    }
+
+    // Receive the result in chunks of chunkSize bytes, stopping at the first
+    // push that fails
+    int receive(uint32_t chunkSize, uint32_t checksum)
+    {
+        int rc = pldm_rde_push_read_operation_response(
+            &manager, &ctx, responsePtr(), response.size(), record_reassembly);
+        if (rc)
+        {
+            return rc;
+        }
+
+        uint32_t handle = resultHandle;
+        size_t offset = 0;
+        while (ctx.next_command == PLDM_RDE_MULTIPART_RECEIVE)
+        {
+            auto op = &ctx.operation;
+            EXPECT_EQ(op->result_transfer_handle, handle);
+
+            size_t length = std::min<size_t>(chunkSize, result.size() - offset);
+            bool last = offset + length == result.size();
+            uint8_t flag = offset == 0 ? (last ? PLDM_RDE_START_AND_END
+                                               : PLDM_RDE_START)
+                                       : (last ? PLDM_RDE_END
+                                               : PLDM_RDE_MIDDLE);
+            handle = last ? 0 : handle + 1;
+            EXPECT_EQ(encode_rde_multipart_receive_resp(
+                          0, PLDM_SUCCESS, flag, handle, length, last,
+                          checksum, result.data() + offset, responsePtr()),
+                      PLDM_SUCCESS);
+            offset += length;
+
+            rc = pldm_rde_push_read_operation_response(
+                &manager, &ctx, responsePtr(), response.size(),
+                record_reassembly);
+            if (rc)
+            {
+                return rc;
+            }
+        }
+
+        return PLDM_RDE_REQUESTER_SUCCESS;
+    }
+
+    static constexpr uint32_t resultHandle = 0x100;
+    struct pldm_rde_requester_manager manager = {};
+    struct pldm_rde_requester_context ctx = {};
+    struct pldm_rde_reassembly reassembly = {};
+    std::vector<uint8_t> result;
+    std::vector<uint8_t> response = std::vector<uint8_t>(256);
+};
+
+TEST_F(TestRdeReassembly, ChunksLandAcrossIovecs)
+{
+    std::array<uint8_t, 30> head = {};
+    std::array<uint8_t, 0> empty = {};
+    std::array<uint8_t, 70> tail = {};
+    std::array<struct iovec, 3> iov = {{{head.data(), head.size()},
+                                        {empty.data(), empty.size()},
+                                        {tail.data(), tail.size()}}};
+
+    reassembly.type = PLDM_RDE_REASSEMBLY_IOVEC;
+    reassembly.dest.iovec.iov = iov.data();
+    reassembly.dest.iovec.iovcnt = iov.size();
+    ASSERT_EQ(pldm_rde_set_operation_reassembly(&ctx, &reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(receive(40, crc32(result.data(), result.size())),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(ctx.next_command, PLDM_RDE_OPERATION_COMPLETE);
+
+    // The callback only hears about the complete payload
+    EXPECT_EQ(reassemblyNotification.calls, 1);
+    EXPECT_EQ(reassemblyNotification.payload, nullptr);
+    EXPECT_EQ(reassemblyNotification.length, result.size());
+    EXPECT_FALSE(reassemblyNotification.hasChecksum);
+
+    std::vector<uint8_t> landed(head.begin(), head.end());
+    landed.insert(landed.end(), tail.begin(), tail.end());
+    EXPECT_EQ(landed, result);
+}
+
+TEST_F(TestRdeReassembly, ChunksLandInFileAtOffset)
+{
+    FILE* file = tmpfile();
+    ASSERT_NE(file, nullptr);
+
+    reassembly.type = PLDM_RDE_REASSEMBLY_FD;
+    reassembly.dest.file.fd = fileno(file);
+    reassembly.dest.file.offset = 16;
+    reassembly.dest.file.size = result.size();
+    ASSERT_EQ(pldm_rde_set_operation_reassembly(&ctx, &reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(receive(33, crc32(result.data(), result.size())),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(reassemblyNotification.calls, 1);
+    EXPECT_EQ(reassemblyNotification.length, result.size());
+
+    std::vector<uint8_t> landed(result.size());
+    ASSERT_EQ(pread(fileno(file), landed.data(), landed.size(), 16),
+              (ssize_t)landed.size());
+    EXPECT_EQ(landed, result);
+    fclose(file);
+}
+
+TEST_F(TestRdeReassembly, ChecksumMismatchFailsRequest)
+{
+    std::vector<uint8_t> buffer(result.size());
+
+    reassembly.type = PLDM_RDE_REASSEMBLY_BUFFER;
+    reassembly.dest.buffer.data = buffer.data();
+    reassembly.dest.buffer.size = buffer.size();
+    ASSERT_EQ(pldm_rde_set_operation_reassembly(&ctx, &reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    EXPECT_EQ(receive(40, ~crc32(result.data(), result.size())),
+              PLDM_RDE_REASSEMBLY_ERROR);
+    EXPECT_EQ(ctx.requester_status,
+              (uint8_t)PLDM_RDE_REQUESTER_REQUEST_FAILED);
+    EXPECT_EQ(ctx.next_command, PLDM_RDE_OPERATION_COMPLETE);
+    EXPECT_EQ(reassemblyNotification.calls, 0);
+}
+
+TEST_F(TestRdeReassembly, OverflowFailsRequest)
+{
+    std::vector<uint8_t> buffer(result.size() - 1);
+
+    reassembly.type = PLDM_RDE_REASSEMBLY_BUFFER;
+    reassembly.dest.buffer.data = buffer.data();
+    reassembly.dest.buffer.size = buffer.size();
+    ASSERT_EQ(pldm_rde_set_operation_reassembly(&ctx, &reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    EXPECT_EQ(receive(40, crc32(result.data(), result.size())),
+              PLDM_RDE_REASSEMBLY_ERROR);
+    EXPECT_EQ(ctx.requester_status,
+              (uint8_t)PLDM_RDE_REQUESTER_REQUEST_FAILED);
+    EXPECT_EQ(reassemblyNotification.calls, 0);
+}
+
+TEST_F(TestRdeReassembly, OutOfSequenceChunkFailsRequest)
+{
+    std::vector<uint8_t> buffer(result.size());
+
+    reassembly.type = PLDM_RDE_REASSEMBLY_BUFFER;
+    reassembly.dest.buffer.data = buffer.data();
+    reassembly.dest.buffer.size = buffer.size();
+    ASSERT_EQ(pldm_rde_set_operation_reassembly(&ctx, &reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(encode_rde_multipart_receive_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_START, resultHandle + 1, 40,
+                  false, 0, result.data(), responsePtr()),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(reassembly.transfer_handle, resultHandle + 1);
+
+    // Pointing back at the handle it was asked for, as the answer to the
+    // previous request would
+    ASSERT_EQ(encode_rde_multipart_receive_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_MIDDLE, resultHandle + 1, 40,
+                  false, 0, result.data() + 40, responsePtr()),
+              PLDM_SUCCESS);
+    EXPECT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REASSEMBLY_ERROR);
+    EXPECT_EQ(ctx.requester_status,
+              (uint8_t)PLDM_RDE_REQUESTER_REQUEST_FAILED);
+    EXPECT_EQ(reassembly.length, 40u);
+    EXPECT_EQ(reassemblyNotification.calls, 0);
+}
+#endif
+
+#ifdef LIBPLDM_API_TESTING
+TEST_F(TestRdeReassembly, LostChunkIsAskedForAgain)
+{
+    std::vector<uint8_t> buffer(result.size());
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    auto op = &ctx.operation;
+    uint32_t handle = 0;
+    uint16_t operationId = 0;
+    uint8_t transferOperation = 0;
+
+    reassembly.type = PLDM_RDE_REASSEMBLY_BUFFER;
+    reassembly.dest.buffer.data = buffer.data();
+    reassembly.dest.buffer.size = buffer.size();
+    ASSERT_EQ(pldm_rde_set_operation_reassembly(&ctx, &reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_set_multipart_receive_retries(&manager, 2),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(encode_rde_multipart_receive_resp(0, PLDM_SUCCESS,
+                                                PLDM_RDE_START, 0x101, 40,
+                                                false, 0, result.data(),
+                                                responsePtr()),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    // The next chunk arrives cut short, then with a generic error
+    ASSERT_EQ(encode_rde_multipart_receive_resp(0, PLDM_SUCCESS,
+                                                PLDM_RDE_MIDDLE, 0x102, 40,
+                                                false, 0, result.data() + 40,
+                                                responsePtr()),
+              PLDM_SUCCESS);
+    EXPECT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(),
+                  sizeof(pldm_msg_hdr) +
+                      PLDM_RDE_MULTIPART_RECEIVE_RESP_HDR_SIZE + 20,
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(ctx.requester_status,
+              PLDM_RDE_REQUESTER_READY_TO_PICK_NEXT_REQUEST);
+    EXPECT_EQ(ctx.next_command, PLDM_RDE_MULTIPART_RECEIVE);
+
+    ASSERT_EQ(pldm_rde_get_next_rde_operation(1, &manager, &ctx, requestMsg),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(decode_rde_multipart_receive_req(
+                  requestMsg, sizeof(struct pldm_rde_multipart_receive_req),
+                  &handle, &operationId, &transferOperation),
+              PLDM_SUCCESS);
+    EXPECT_EQ(handle, 0x101);
+    EXPECT_EQ(transferOperation, PLDM_XFER_CURRENT_PART);
+
+    ASSERT_EQ(encode_rde_multipart_receive_resp(0, PLDM_ERROR_NOT_READY, 0, 0,
+                                                0, false, 0, nullptr,
+                                                responsePtr()),
+              PLDM_SUCCESS);
+    EXPECT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(op->receive_retries, 2);
+
+    // Chunks received start the count over
+    ASSERT_EQ(encode_rde_multipart_receive_resp(0, PLDM_SUCCESS,
+                                                PLDM_RDE_MIDDLE, 0x102, 40,
+                                                false, 0, result.data() + 40,
+                                                responsePtr()),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(op->receive_retries, 0);
+    EXPECT_EQ(op->transfer_operation, PLDM_XFER_NEXT_PART);
+    EXPECT_EQ(op->result_transfer_handle, 0x102);
+
+    ASSERT_EQ(encode_rde_multipart_receive_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_END, 0, 20, true,
+                  crc32(result.data(), result.size()), result.data() + 80,
+                  responsePtr()),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(ctx.next_command, PLDM_RDE_OPERATION_COMPLETE);
+    EXPECT_EQ(reassemblyNotification.calls, 1);
+    EXPECT_EQ(buffer, result);
+}
+
+TEST_F(TestRdeReassembly, RetriesRunOut)
+{
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+
+    ASSERT_EQ(pldm_rde_set_multipart_receive_retries(&manager, 1),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    // Only a context waiting on a MultipartReceive response can time out
+    EXPECT_EQ(pldm_rde_retry_multipart_receive(&manager, &ctx),
+              PLDM_RDE_CONTEXT_NOT_READY);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_get_next_rde_operation(1, &manager, &ctx, requestMsg),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_retry_multipart_receive(&manager, &ctx),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    auto op = &ctx.operation;
+    EXPECT_EQ(op->transfer_operation, PLDM_XFER_FIRST_PART);
+
+    ASSERT_EQ(pldm_rde_get_next_rde_operation(2, &manager, &ctx, requestMsg),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_retry_multipart_receive(&manager, &ctx),
+              PLDM_RDE_REQUESTER_RECV_FAIL);
+    EXPECT_EQ(op->receive_retries, 1);
+
+    ASSERT_EQ(encode_rde_multipart_receive_resp(0, PLDM_ERROR, 0, 0, 0, false,
+                                                0, nullptr, responsePtr()),
+              PLDM_SUCCESS);
+    pldm_rde_push_read_operation_response(&manager, &ctx, responsePtr(),
+                                          response.size(), record_reassembly);
+    EXPECT_EQ(ctx.requester_status,
+              (uint8_t)PLDM_RDE_REQUESTER_REQUEST_FAILED);
+    EXPECT_EQ(ctx.next_command, PLDM_RDE_OPERATION_COMPLETE);
+}
+
+TEST_F(TestRdeReassembly, FreshManagersDoNotRetry)
+{
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+
+    // Managers need not be zeroed before they are initialized
+    memset(&manager, 0xa5, sizeof(manager));
+    ASSERT_EQ(pldm_rde_init_context(devId.c_str(), netId, &manager,
+                                    mcConcurrency, mcTransferSize, &mcFeatures,
+                                    allocate_memory_to_contexts, free_memory),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_set_resources_in_context(&manager, numberOfResources,
+                                                &resourceIds.front()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(manager.multipart_receive_retries, 0);
+
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_get_next_rde_operation(1, &manager, &ctx, requestMsg),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_retry_multipart_receive(&manager, &ctx),
+              PLDM_RDE_REQUESTER_RECV_FAIL);
+}
+
+TEST_F(TestRdeReassembly, RdeErrorsAreNotRetried)
+{
+    ASSERT_EQ(pldm_rde_set_multipart_receive_retries(&manager, 3),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_push_read_operation_response(
+                  &manager, &ctx, responsePtr(), response.size(),
+                  record_reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(encode_rde_multipart_receive_resp(
+                  0, PLDM_RDE_ERROR_OPERATION_ABANDONED, 0, 0, 0, false, 0,
+                  nullptr, responsePtr()),
+              PLDM_SUCCESS);
+    pldm_rde_push_read_operation_response(&manager, &ctx, responsePtr(),
+                                          response.size(), record_reassembly);
+    EXPECT_EQ(ctx.requester_status,
+              (uint8_t)PLDM_RDE_REQUESTER_REQUEST_FAILED);
+    EXPECT_EQ(reassemblyNotification.calls, 0);
+}
+#endif
+
+#ifdef LIBPLDM_API_TESTING
+TEST_F(TestRdeRequester, OperationsDoNotAllocate)
+{
+    struct pldm_rde_requester_manager manager = {};
+    union pldm_rde_operation_flags opFlags = {};
+    union pldm_rde_op_execution_flags execFlags = {};
+    union pldm_rde_permission_flags permFlags = {};
+    struct rde_query_options queryOptions = {};
+    std::array<uint8_t, 4> result = {0xde, 0xad, 0xbe, 0xef};
+    std::vector<uint8_t> response(64);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+
+    ASSERT_EQ(pldm_rde_init_context(devId.c_str(), netId, &manager,
+                                    mcConcurrency, mcTransferSize, &mcFeatures,
+                                    allocate_memory_to_contexts, free_memory),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_rde_set_resources_in_context(&manager, numberOfResources,
+                                                &resourceIds.front()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    opFlags.bits.contains_custom_request_parameters = 1;
+    queryOptions.expand = true;
+    queryOptions.expand_levels = 1;
+
+    unsigned long allocations = pldm_rde_requester_allocations();
+    for (uint8_t i = 0; i < manager.n_ctx; i++)
+    {
+        struct pldm_rde_requester_context* ctx = &manager.ctx[i];
+
+        ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                      ctx, requestId, resourceId, 0x8000 + i,
+                      PLDM_RDE_OPERATION_READ, opFlags.byte, &queryOptions, 0,
+                      0, 0, NULL, NULL),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        auto operation = &ctx->operation;
+        ASSERT_NE(operation->query_options, nullptr);
+        EXPECT_TRUE(operation->query_options->expand);
+
+        ASSERT_EQ(encode_rde_operation_init_resp(
+                      0, PLDM_SUCCESS, PLDM_RDE_OPERATION_COMPLETED, 100, 0,
+                      &execFlags, 0, &permFlags, result.size(),
+                      PLDM_RDE_VARSTRING_UTF_8, "", result.data(),
+                      responsePtr),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(pldm_rde_push_read_operation_response(
+                      &manager, ctx, responsePtr, response.size(),
+                      dummy_callback),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(ctx->next_command, PLDM_RDE_OPERATION_COMPLETE);
+
+        ASSERT_EQ(encode_rde_operation_complete_resp(0, PLDM_SUCCESS,
+                                                     responsePtr),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(pldm_rde_push_read_operation_response(
+                      &manager, ctx, responsePtr,
+                      sizeof(pldm_msg_hdr) + 1, dummy_callback),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        EXPECT_EQ(ctx->requester_status, PLDM_RDE_REQUESTER_NO_PENDING_ACTION);
+        EXPECT_EQ(free_rde_op_init_context(ctx), PLDM_RDE_REQUESTER_SUCCESS);
+        EXPECT_FALSE(ctx->operation.active);
+    }
+    EXPECT_EQ(pldm_rde_requester_allocations(), allocations);
+
+    // Dictionary extraction still tracks its resource on the heap
+    uint8_t started;
+    ASSERT_EQ(pldm_rde_start_dictionary_download(&manager, &started),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_GT(pldm_rde_requester_allocations(), allocations);
+    for (uint8_t i = 0; i < manager.n_ctx; i++)
+    {
+        free_op_context_after_dictionary_extraction(&manager.ctx[i]);
+    }
+}
+#endif
+
+#ifdef LIBPLDM_API_TESTING
+struct cached_read_notification
+{
+    std::vector<uint8_t> payload;
+    bool hasChecksum;
+};
+std::vector<cached_read_notification> cachedReadNotifications;
+
+void record_cached_read(struct pldm_rde_requester_manager* /*manager*/,
+                        struct pldm_rde_requester_context* /*ctx*/,
+                        uint8_t** payload, uint32_t length, bool hasChecksum)
+{
+    cachedReadNotifications.push_back(
+        {std::vector<uint8_t>(*payload, *payload + length), hasChecksum});
+}
+
+class TestRdeReadCache : public TestRdeRequester
+{
+  protected:
+    void SetUp() override
+    {
+        cachedReadNotifications.clear();
+        ASSERT_EQ(pldm_rde_init_context(
+                      devId.c_str(), netId, &manager, mcConcurrency,
+                      mcTransferSize, &mcFeatures, allocate_memory_to_contexts,
+                      free_memory),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_set_resources_in_context(
+                      &manager, numberOfResources, &resourceIds.front()),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_read_cache_init(&cache, 4096), 0);
+        ASSERT_EQ(pldm_rde_set_read_cache(&manager, cache),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_create_context(&ctx), PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        free_rde_op_init_context(&ctx);
+        pldm_rde_read_cache_destroy(cache);
+    }
+
+    pldm_msg* responsePtr()
+    {
+        return reinterpret_cast<pldm_msg*>(response.data());
+    }
+
+    pldm_msg* requestPtr()
+    {
+        return reinterpret_cast<pldm_msg*>(request.data());
+    }
+
+    // Starts an operation and returns its encoded RDEOperationInit flags
+    union pldm_rde_operation_flags start(uint8_t operationType)
+    {
+        union pldm_rde_operation_flags flags = {};
+        uint32_t resource;
+        uint16_t operation;
+        uint8_t type;
+        uint32_t handle;
+        uint8_t locatorLength;
+        uint32_t payloadLength;
+        uint8_t* locator;
+        uint8_t* payload;
+
+        EXPECT_EQ(pldm_rde_init_rde_operation_context(
+                      &ctx, requestId, resourceId, 0x8001, operationType, 0,
+                      NULL, 0, 0, 0, NULL, NULL),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        EXPECT_EQ(
+            pldm_rde_get_next_rde_operation(0, &manager, &ctx, requestPtr()),
+            PLDM_RDE_REQUESTER_SUCCESS);
+        EXPECT_EQ(decode_rde_operation_init_req(
+                      requestPtr(), request.size() - sizeof(pldm_msg_hdr),
+                      &resource, &operation, &type, &flags, &handle,
+                      &locatorLength, &payloadLength, &locator, &payload),
+                  PLDM_SUCCESS);
+        return flags;
+    }
+
+    void push(size_t length)
+    {
+        ASSERT_EQ(pldm_rde_push_read_operation_response(
+                      &manager, &ctx, responsePtr(), length,
+                      record_cached_read),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    void pushCompleted(const char* etag, std::vector<uint8_t> body)
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+
+        execFlags.bits.have_result_payload = 1;
+        if (ctx.next_command == PLDM_RDE_OPERATION_INIT)
+        {
+            ASSERT_EQ(encode_rde_operation_init_resp(
+                          0, PLDM_SUCCESS, PLDM_RDE_OPERATION_COMPLETED, 100,
+                          0, &execFlags, 0, &permFlags, body.size(),
+                          PLDM_RDE_VARSTRING_UTF_8, etag, body.data(),
+                          responsePtr()),
+                      PLDM_SUCCESS);
+        }
+        else
+        {
+            ASSERT_EQ(encode_supply_custom_request_parameters_resp(
+                          0, PLDM_SUCCESS, PLDM_RDE_OPERATION_COMPLETED, 100,
+                          0, &execFlags, 0, &permFlags, body.size(),
+                          PLDM_RDE_VARSTRING_UTF_8, const_cast<char*>(etag),
+                          body.data(), responsePtr()),
+                      PLDM_SUCCESS);
+        }
+        push(response.size());
+        ASSERT_EQ(ctx.next_command, PLDM_RDE_OPERATION_COMPLETE);
+    }
+
+    // The device asks for the custom request parameters carrying the ETag
+    void pushNeedsInput()
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+
+        ASSERT_EQ(encode_rde_operation_init_resp(
+                      0, PLDM_SUCCESS, PLDM_RDE_OPERATION_NEEDS_INPUT, 0,
+                      PLDM_RDE_COMP_TIME_NOT_SUPPORTED, &execFlags, 0,
+                      &permFlags, 0, PLDM_RDE_VARSTRING_UTF_8, "", NULL,
+                      responsePtr()),
+                  PLDM_SUCCESS);
+        push(response.size());
+        ASSERT_EQ(ctx.next_command, PLDM_SUPPLY_CUSTOM_REQUEST_PARAMETERS);
+        ASSERT_EQ(
+            pldm_rde_get_next_rde_operation(0, &manager, &ctx, requestPtr()),
+            PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    std::string suppliedEtag()
+    {
+        auto req = reinterpret_cast<pldm_supply_custom_request_parameters_req*>(
+            requestPtr()->payload);
+        EXPECT_EQ(req->etag_operation, PLDM_RDE_ETAG_IF_NONE_MATCH);
+        EXPECT_EQ(req->etag_count, 1);
+        return std::string(reinterpret_cast<char*>(req->var_data + 2));
+    }
+
+    void pushEtagMatch()
+    {
+        response[sizeof(pldm_msg_hdr)] = PLDM_RDE_ERROR_ETAG_MATCH;
+        push(sizeof(pldm_msg_hdr) + 1);
+        EXPECT_EQ(ctx.next_command, PLDM_RDE_OPERATION_COMPLETE);
+    }
+
+    void complete()
+    {
+        ASSERT_EQ(encode_rde_operation_complete_resp(0, PLDM_SUCCESS,
+                                                     responsePtr()),
+                  PLDM_SUCCESS);
+        push(sizeof(pldm_msg_hdr) + 1);
+        EXPECT_EQ(ctx.requester_status, PLDM_RDE_REQUESTER_NO_PENDING_ACTION);
+    }
+
+    struct pldm_rde_requester_manager manager = {};
+    struct pldm_rde_requester_context ctx = {};
+    struct pldm_rde_read_cache* cache = nullptr;
+    std::vector<uint8_t> request = std::vector<uint8_t>(256);
+    std::vector<uint8_t> response = std::vector<uint8_t>(256);
+};
+
+TEST_F(TestRdeReadCache, UnchangedResourceIsServedFromCache)
+{
+    struct pldm_rde_read_cache_stats stats;
+    std::vector<uint8_t> body = {1, 2, 3, 4};
+
+    EXPECT_FALSE(start(PLDM_RDE_OPERATION_READ)
+                     .bits.contains_custom_request_parameters);
+    pushCompleted("\"1\"", body);
+    complete();
+
+    // The repeated read only asks whether the ETag still matches
+    EXPECT_TRUE(start(PLDM_RDE_OPERATION_READ)
+                    .bits.contains_custom_request_parameters);
+    pushNeedsInput();
+    EXPECT_EQ(suppliedEtag(), "\"1\"");
+    pushEtagMatch();
+    complete();
+
+    ASSERT_EQ(cachedReadNotifications.size(), 2u);
+    EXPECT_EQ(cachedReadNotifications[1].payload, body);
+    EXPECT_FALSE(cachedReadNotifications[1].hasChecksum);
+    ASSERT_EQ(pldm_rde_read_cache_stats(cache, &stats), 0);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.stores, 1u);
+}
+
+TEST_F(TestRdeReadCache, EntryDroppedDuringRevalidationIsServed)
+{
+    std::vector<uint8_t> body = {1, 2, 3, 4};
+
+    start(PLDM_RDE_OPERATION_READ);
+    pushCompleted("\"1\"", body);
+    complete();
+
+    start(PLDM_RDE_OPERATION_READ);
+    pushNeedsInput();
+    EXPECT_EQ(suppliedEtag(), "\"1\"");
+
+    // As another read's store could evict it before the device answers
+    pldm_rde_read_cache_invalidate(cache, netId, devId.c_str(), resourceId);
+    pushEtagMatch();
+    complete();
+
+    ASSERT_EQ(cachedReadNotifications.size(), 2u);
+    EXPECT_EQ(cachedReadNotifications[1].payload, body);
+}
+
+TEST_F(TestRdeReadCache, ChangedResourceReplacesEntry)
+{
+    std::vector<uint8_t> body = {5, 6, 7};
+
+    start(PLDM_RDE_OPERATION_READ);
+    pushCompleted("\"1\"", {1, 2, 3, 4});
+    complete();
+
+    start(PLDM_RDE_OPERATION_READ);
+    pushNeedsInput();
+    pushCompleted("\"2\"", body);
+    complete();
+
+    start(PLDM_RDE_OPERATION_READ);
+    pushNeedsInput();
+    EXPECT_EQ(suppliedEtag(), "\"2\"");
+    pushEtagMatch();
+    complete();
+
+    ASSERT_EQ(cachedReadNotifications.size(), 3u);
+    EXPECT_EQ(cachedReadNotifications[2].payload, body);
+}
+
+TEST_F(TestRdeReadCache, MultipartReadsAreCachedUntilAWrite)
+{
+    union pldm_rde_op_execution_flags execFlags = {};
+    union pldm_rde_permission_flags permFlags = {};
+    struct pldm_rde_read_cache_stats stats;
+    std::vector<uint8_t> body(100);
+
+    for (size_t i = 0; i < body.size(); i++)
+    {
+        body[i] = i;
+    }
+
+    start(PLDM_RDE_OPERATION_READ);
+    ASSERT_EQ(encode_rde_operation_init_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_OPERATION_HAVE_RESULTS, 100,
+                  PLDM_RDE_COMP_TIME_NOT_SUPPORTED, &execFlags, 0x100,
+                  &permFlags, 0, PLDM_RDE_VARSTRING_UTF_8, "\"m\"", NULL,
+                  responsePtr()),
+              PLDM_SUCCESS);
+    push(response.size());
+    ASSERT_EQ(ctx.next_command, PLDM_RDE_MULTIPART_RECEIVE);
+    ASSERT_EQ(encode_rde_multipart_receive_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_START, 0x101, 60, false, 0,
+                  body.data(), responsePtr()),
+              PLDM_SUCCESS);
+    push(response.size());
+    ASSERT_EQ(encode_rde_multipart_receive_resp(
+                  0, PLDM_SUCCESS, PLDM_RDE_END, 0, 40, true,
+                  crc32(body.data(), body.size()), body.data() + 60,
+                  responsePtr()),
+              PLDM_SUCCESS);
+    push(response.size());
+    complete();
+
+    start(PLDM_RDE_OPERATION_READ);
+    pushNeedsInput();
+    EXPECT_EQ(suppliedEtag(), "\"m\"");
+    pushEtagMatch();
+    complete();
+    ASSERT_EQ(cachedReadNotifications.size(), 3u);
+    EXPECT_EQ(cachedReadNotifications[2].payload, body);
+
+    // Writing the resource drops what was read from it
+    start(PLDM_RDE_OPERATION_UPDATE);
+    ASSERT_EQ(pldm_rde_read_cache_stats(cache, &stats), 0);
+    EXPECT_EQ(stats.size, 0u);
+    EXPECT_FALSE(start(PLDM_RDE_OPERATION_READ)
+                     .bits.contains_custom_request_parameters);
+}
+
+TEST(RdeReadCache, RejectsInvalidArguments)
+{
+    struct pldm_rde_read_cache* cache = nullptr;
+    struct pldm_rde_read_cache_stats stats;
+
+    EXPECT_EQ(pldm_rde_read_cache_init(NULL, 1), -EINVAL);
+    EXPECT_EQ(pldm_rde_read_cache_init(&cache, 0), -EINVAL);
+    EXPECT_EQ(pldm_rde_read_cache_stats(NULL, &stats), -EINVAL);
+    EXPECT_EQ(pldm_rde_set_read_cache(NULL, NULL),
+              PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
+    pldm_rde_read_cache_invalidate(NULL, 0, "dev", 0);
+}
+#endif
+
+#ifdef LIBPLDM_API_TESTING
+struct coalesced_read
+{
+    struct pldm_rde_requester_context* ctx;
+    std::vector<uint8_t> payload;
+    bool hasChecksum;
+};
+
+std::vector<coalesced_read> coalescedReadNotifications;
+
+void record_coalesced_read(struct pldm_rde_requester_manager* /*manager*/,
+                           struct pldm_rde_requester_context* ctx,
+                           uint8_t** payload, uint32_t length,
+                           bool hasChecksum)
+{
+    coalescedReadNotifications.push_back(
+        {ctx,
+         *payload ? std::vector<uint8_t>(*payload, *payload + length)
+                  : std::vector<uint8_t>(),
+         hasChecksum});
+}
+
+class TestRdeReadCoalescing : public TestRdeRequester
+{
+  protected:
+    void SetUp() override
+    {
+        coalescedReadNotifications.clear();
+        ASSERT_EQ(pldm_rde_init_context(
+                      devId.c_str(), netId, &manager, mcConcurrency,
+                      mcTransferSize, &mcFeatures, allocate_memory_to_contexts,
+                      free_memory),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_set_resources_in_context(
+                      &manager, numberOfResources, &resourceIds.front()),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_set_read_coalescing(&manager, true),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        for (uint8_t i = 0; i < manager.n_ctx; i++)
+        {
+            free_rde_op_init_context(&manager.ctx[i]);
+        }
+    }
+
+    pldm_msg* responsePtr()
+    {
+        return reinterpret_cast<pldm_msg*>(response.data());
+    }
+
+    pldm_msg* requestPtr()
+    {
+        return reinterpret_cast<pldm_msg*>(request.data());
+    }
+
+    int start(struct pldm_rde_requester_context* ctx, uint32_t resource)
+    {
+        EXPECT_EQ(pldm_rde_init_rde_operation_context(
+                      ctx, requestId, resource, 0x8001,
+                      PLDM_RDE_OPERATION_READ, 0, NULL, 0, 0, 0, NULL, NULL),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        return pldm_rde_get_next_rde_operation(0, &manager, ctx, requestPtr());
+    }
+
+    int push(struct pldm_rde_requester_context* ctx, size_t length)
+    {
+        return pldm_rde_push_read_operation_response(
+            &manager, ctx, responsePtr(), length, record_coalesced_read);
+    }
+
+    void pushStatus(struct pldm_rde_requester_context* ctx, uint8_t status,
+                    const std::vector<uint8_t>& body)
+    {
+        union pldm_rde_op_execution_flags execFlags = {};
+        union pldm_rde_permission_flags permFlags = {};
+
+        execFlags.bits.have_result_payload = !body.empty();
+        ASSERT_EQ(encode_rde_operation_init_resp(
+                      0, PLDM_SUCCESS, status, 100,
+                      PLDM_RDE_COMP_TIME_NOT_SUPPORTED, &execFlags, 0x100,
+                      &permFlags, body.size(), PLDM_RDE_VARSTRING_UTF_8, "",
+                      body.empty() ? NULL : body.data(), responsePtr()),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(push(ctx, response.size()), PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    void pushChunk(struct pldm_rde_requester_context* ctx, uint8_t flag,
+                   uint32_t nextHandle, const uint8_t* data, uint32_t length,
+                   bool addChecksum, uint32_t checksum)
+    {
+        ASSERT_EQ(encode_rde_multipart_receive_resp(
+                      0, PLDM_SUCCESS, flag, nextHandle, length, addChecksum,
+                      checksum, data, responsePtr()),
+                  PLDM_SUCCESS);
+        ASSERT_EQ(push(ctx, response.size()), PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    struct pldm_rde_requester_manager manager = {};
+    std::vector<uint8_t> request = std::vector<uint8_t>(256);
+    std::vector<uint8_t> response = std::vector<uint8_t>(256);
+};
+
+TEST_F(TestRdeReadCoalescing, IdenticalReadsShareAnInlineResult)
+{
+    struct pldm_rde_requester_context* first = &manager.ctx[0];
+    struct pldm_rde_requester_context* joined = &manager.ctx[1];
+    struct pldm_rde_requester_context* other = &manager.ctx[2];
+    std::vector<uint8_t> body = {1, 2, 3, 4};
+
+    ASSERT_EQ(start(first, resourceId), PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(start(joined, resourceId), PLDM_RDE_OPERATION_COALESCED);
+    EXPECT_EQ(joined->requester_status,
+              PLDM_RDE_REQUESTER_WAITING_FOR_RESPONSE);
+    EXPECT_EQ(start(other, resourceId + 1), PLDM_RDE_REQUESTER_SUCCESS);
+
+    pushStatus(first, PLDM_RDE_OPERATION_COMPLETED, body);
+    EXPECT_EQ(first->next_command, PLDM_RDE_OPERATION_COMPLETE);
+    EXPECT_EQ(joined->requester_status, PLDM_RDE_REQUESTER_NO_PENDING_ACTION);
+    EXPECT_EQ(joined->next_command, PLDM_RDE_REQUESTER_NO_NEXT_COMMAND_FOUND);
+
+    ASSERT_EQ(coalescedReadNotifications.size(), 2u);
+    EXPECT_EQ(coalescedReadNotifications[0].ctx, joined);
+    EXPECT_EQ(coalescedReadNotifications[0].payload, body);
+    EXPECT_EQ(coalescedReadNotifications[1].ctx, first);
+    EXPECT_EQ(coalescedReadNotifications[1].payload, body);
+
+    // The result is out, so a new read goes to the device
+    EXPECT_EQ(start(joined, resourceId), PLDM_RDE_REQUESTER_SUCCESS);
+}
+
+TEST_F(TestRdeReadCoalescing, JoinedReadReassemblesAMultipartResult)
+{
+    struct pldm_rde_requester_context* first = &manager.ctx[0];
+    struct pldm_rde_requester_context* joined = &manager.ctx[1];
+    struct pldm_rde_requester_context* late = &manager.ctx[2];
+    std::vector<uint8_t> body(100);
+    std::vector<uint8_t> landed(body.size());
+    struct pldm_rde_reassembly reassembly = {};
+
+    for (size_t i = 0; i < body.size(); i++)
+    {
+        body[i] = i;
+    }
+
+    ASSERT_EQ(start(first, resourceId), PLDM_RDE_REQUESTER_SUCCESS);
+    pushStatus(first, PLDM_RDE_OPERATION_HAVE_RESULTS, {});
+    ASSERT_EQ(first->next_command, PLDM_RDE_MULTIPART_RECEIVE);
+
+    // Nothing was received yet, so the read can still be joined
+    ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                  joined, requestId, resourceId, 0x8002,
+                  PLDM_RDE_OPERATION_READ, 0, NULL, 0, 0, 0, NULL, NULL),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    reassembly.type = PLDM_RDE_REASSEMBLY_BUFFER;
+    reassembly.dest.buffer.data = landed.data();
+    reassembly.dest.buffer.size = landed.size();
+    ASSERT_EQ(pldm_rde_set_operation_reassembly(joined, &reassembly),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_get_next_rde_operation(0, &manager, joined,
+                                              requestPtr()),
+              PLDM_RDE_OPERATION_COALESCED);
+
+    pushChunk(first, PLDM_RDE_START, 0x101, body.data(), 60, false, 0);
+    EXPECT_EQ(start(late, resourceId), PLDM_RDE_REQUESTER_SUCCESS);
+    pushChunk(first, PLDM_RDE_END, 0, body.data() + 60, 40, true,
+              crc32(body.data(), body.size()));
+
+    EXPECT_EQ(joined->requester_status, PLDM_RDE_REQUESTER_NO_PENDING_ACTION);
+    EXPECT_EQ(landed, body);
+    EXPECT_EQ(reassembly.length, body.size());
+
+    // The first read gets its chunks as they come, the joined one the whole
+    ASSERT_EQ(coalescedReadNotifications.size(), 3u);
+    EXPECT_EQ(coalescedReadNotifications[0].ctx, first);
+    EXPECT_EQ(coalescedReadNotifications[1].ctx, joined);
+    EXPECT_EQ(coalescedReadNotifications[1].payload, body);
+    EXPECT_EQ(coalescedReadNotifications[2].ctx, first);
+    EXPECT_TRUE(coalescedReadNotifications[2].hasChecksum);
+}
+
+TEST_F(TestRdeReadCoalescing, JoinedReadsFailWithTheFirst)
+{
+    struct pldm_rde_requester_context* first = &manager.ctx[0];
+    struct pldm_rde_requester_context* joined = &manager.ctx[1];
+    struct pldm_rde_requester_context* abandoned = &manager.ctx[2];
+
+    ASSERT_EQ(start(first, resourceId), PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(start(joined, resourceId), PLDM_RDE_OPERATION_COALESCED);
+
+    response[sizeof(pldm_msg_hdr)] = PLDM_ERROR;
+    push(first, sizeof(pldm_msg_hdr) + 1);
+    EXPECT_EQ((int8_t)first->requester_status,
+              PLDM_RDE_REQUESTER_REQUEST_FAILED);
+    EXPECT_EQ((int8_t)joined->requester_status,
+              PLDM_RDE_REQUESTER_REQUEST_FAILED);
+
+    ASSERT_EQ(start(first, resourceId), PLDM_RDE_REQUESTER_SUCCESS);
+    ASSERT_EQ(start(abandoned, resourceId), PLDM_RDE_OPERATION_COALESCED);
+    ASSERT_EQ(pldm_rde_abandon_coalesced_reads(&manager, first),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ((int8_t)abandoned->requester_status,
+              PLDM_RDE_REQUESTER_REQUEST_FAILED);
+    EXPECT_TRUE(coalescedReadNotifications.empty());
+}
+
+TEST_F(TestRdeReadCoalescing, OnlyPlainReadsAreJoined)
+{
+    struct pldm_rde_requester_context* first = &manager.ctx[0];
+    struct pldm_rde_requester_context* second = &manager.ctx[1];
+    uint8_t payload[4] = {};
+
+    ASSERT_EQ(start(first, resourceId), PLDM_RDE_REQUESTER_SUCCESS);
+
+    // A read with a payload of its own
+    ASSERT_EQ(pldm_rde_init_rde_operation_context(
+                  second, requestId, resourceId, 0x8002,
+                  PLDM_RDE_OPERATION_READ, 0, NULL, 0, 0, sizeof(payload),
+                  NULL, payload),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_get_next_rde_operation(0, &manager, second,
+                                              requestPtr()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(pldm_rde_set_read_coalescing(&manager, false),
+              PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(start(second, resourceId), PLDM_RDE_REQUESTER_SUCCESS);
+    EXPECT_EQ(pldm_rde_set_read_coalescing(NULL, true),
+              PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
+}
+#endif
@@ -0,0 +1,211 @@
+#include <errno.h>
+
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include "libpldm/base.h"
+#include "libpldm/platform.h"
+#include "libpldm/pldm_rde.h"
+#include "libpldm/requester/pldm_base_requester.h"
+#include "libpldm/requester/pldm_platform_requester.h"
+#include "libpldm/requester/pldm_rde_requester.h"
+#include "libpldm/requester/pldm_requester_stats.h"
+
+#include <gtest/gtest.h>
+
+class TestRequesterStats : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        ASSERT_EQ(pldm_requester_stats_init(&stats), 0);
+    }
+
+    void TearDown() override
+    {
+        pldm_requester_stats_destroy(stats);
+    }
+
+    struct pldm_requester_stats_snapshot snapshot()
+    {
+        struct pldm_requester_stats_snapshot snapshot;
+
+        EXPECT_EQ(pldm_requester_stats_snapshot(stats, &snapshot), 0);
+        return snapshot;
+    }
+
+    static uint64_t timed(const struct pldm_requester_command_stats& command)
+    {
+        return std::accumulate(std::begin(command.latency),
+                               std::end(command.latency), uint64_t{0});
+    }
+
+    struct pldm_requester_stats* stats = nullptr;
+};
+
+TEST_F(TestRequesterStats, RejectsBadArguments)
+{
+    struct pldm_requester_stats_snapshot snapshot;
+
+    EXPECT_EQ(pldm_requester_stats_init(nullptr), -EINVAL);
+    EXPECT_EQ(pldm_requester_stats_init(&stats), -EINVAL);
+    EXPECT_EQ(pldm_requester_stats_snapshot(nullptr, &snapshot), -EINVAL);
+    EXPECT_EQ(pldm_requester_stats_snapshot(stats, nullptr), -EINVAL);
+}
+
+TEST_F(TestRequesterStats, CountsBaseCommands)
+{
+    struct requester_base_context ctx = {};
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 8);
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_TID_RESP_BYTES);
+    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    auto responseMsg = reinterpret_cast<pldm_msg*>(response.data());
+
+    ASSERT_EQ(pldm_base_init_context(&ctx, "dev", 1),
+              PLDM_BASE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_base_set_stats(&ctx, stats), PLDM_BASE_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_base_start_discovery(&ctx), PLDM_BASE_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(pldm_base_get_next_request(&ctx, 1, requestMsg),
+              PLDM_BASE_REQUESTER_SUCCESS);
+    ASSERT_EQ(encode_get_tid_resp(1, PLDM_SUCCESS, 9, responseMsg),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_base_push_response(&ctx, responseMsg, response.size()),
+              PLDM_BASE_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(pldm_base_get_next_request(&ctx, 2, requestMsg),
+              PLDM_BASE_REQUESTER_SUCCESS);
+    ASSERT_EQ(encode_get_types_resp(2, PLDM_ERROR_NOT_READY, nullptr,
+                                    responseMsg),
+              PLDM_SUCCESS);
+    EXPECT_EQ(pldm_base_push_response(&ctx, responseMsg,
+                                      sizeof(pldm_msg_hdr) + 1),
+              PLDM_BASE_REQUESTER_NOT_RESP_MSG);
+
+    auto result = snapshot();
+    ASSERT_EQ(result.count, 2);
+    EXPECT_EQ(result.dropped, 0);
+
+    EXPECT_EQ(result.commands[0].type, PLDM_BASE);
+    EXPECT_EQ(result.commands[0].command, PLDM_GET_TID);
+    EXPECT_EQ(result.commands[0].requests, 1);
+    EXPECT_EQ(result.commands[0].responses, 1);
+    EXPECT_EQ(result.commands[0].errors, 0);
+    EXPECT_EQ(result.commands[0].request_bytes, sizeof(pldm_msg_hdr));
+    EXPECT_EQ(result.commands[0].response_bytes, response.size());
+    EXPECT_EQ(timed(result.commands[0]), 1);
+
+    EXPECT_EQ(result.commands[1].command, PLDM_GET_PLDM_TYPES);
+    EXPECT_EQ(result.commands[1].requests, 1);
+    EXPECT_EQ(result.commands[1].responses, 1);
+    EXPECT_EQ(result.commands[1].errors, 1);
+    EXPECT_EQ(result.commands[1].last_error, PLDM_ERROR_NOT_READY);
+    EXPECT_EQ(timed(result.commands[1]), 1);
+}
+
+TEST_F(TestRequesterStats, CountsPlatformCommands)
+{
+    struct pldm_platform_requester_context ctx = {};
+    struct pldm_platform_get_pdr_operation operation = {};
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES);
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_PDR_MIN_RESP_BYTES);
+    std::vector<uint8_t> record(64);
+    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    auto responseMsg = reinterpret_cast<pldm_msg*>(response.data());
+    bool complete = false;
+
+    ASSERT_EQ(pldm_platform_init_context(&ctx, "dev", 1, 256),
+              PLDM_PLATFORM_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_platform_set_stats(&ctx, stats),
+              PLDM_PLATFORM_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_platform_init_get_pdr_operation_context(&ctx, &operation),
+              PLDM_PLATFORM_REQUESTER_SUCCESS);
+    ASSERT_EQ(pldm_platform_start_pdr_discovery(&ctx),
+              PLDM_PLATFORM_REQUESTER_SUCCESS);
+
+    ASSERT_EQ(pldm_platform_get_next_get_pdr_request(&ctx, 3, requestMsg,
+                                                     PLDM_GET_PDR_REQ_BYTES),
+              PLDM_PLATFORM_REQUESTER_SUCCESS);
+    ASSERT_EQ(encode_get_pdr_resp(3, PLDM_PLATFORM_INVALID_RECORD_HANDLE, 0,
+                                  0, 0, 0, nullptr, 0, responseMsg),
+              PLDM_SUCCESS);
+    EXPECT_EQ(pldm_platform_push_get_pdr_response(
+                  &ctx, responseMsg, response.size(), 1, record.data(),
+                  record.size(), &complete),
+              PLDM_PLATFORM_REQUESTER_DECODING_RESPONSE_FAILURE);
+
+    auto result = snapshot();
+    ASSERT_EQ(result.count, 1);
+    EXPECT_EQ(result.commands[0].type, PLDM_PLATFORM);
+    EXPECT_EQ(result.commands[0].command, PLDM_GET_PDR);
+    EXPECT_EQ(result.commands[0].requests, 1);
+    EXPECT_EQ(result.commands[0].request_bytes, request.size());
+    EXPECT_EQ(result.commands[0].responses, 1);
+    EXPECT_EQ(result.commands[0].errors, 1);
+    EXPECT_EQ(result.commands[0].last_error,
+              PLDM_PLATFORM_INVALID_RECORD_HANDLE);
+    EXPECT_EQ(timed(result.commands[0]), 1);
+}
+
+static struct pldm_rde_requester_context* allocateContexts(uint8_t count)
+{
+    return static_cast<struct pldm_rde_requester_context*>(
+        calloc(count, sizeof(struct pldm_rde_requester_context)));
+}
+
+TEST_F(TestRequesterStats, SharedByRdeManagers)
+{
+    struct pldm_rde_requester_manager managers[2] = {};
+    bitfield16_t features{};
+    bitfield8_t capabilities{};
+    std::vector<uint8_t> request(sizeof(pldm_msg_hdr) + 16);
+    std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + 16);
+    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    auto responseMsg = reinterpret_cast<pldm_msg*>(response.data());
+
+    for (auto& manager : managers)
+    {
+        ASSERT_EQ(pldm_rde_init_context("dev", 1, &manager, 1, 256, &features,
+                                        allocateContexts, free),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_set_stats(&manager, stats),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_create_context(&manager.ctx[0]),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_start_discovery(&manager.ctx[0]),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+        ASSERT_EQ(pldm_rde_get_next_discovery_command(4, &manager,
+                                                      &manager.ctx[0],
+                                                      requestMsg),
+                  PLDM_RDE_REQUESTER_SUCCESS);
+    }
+
+    // Only the first manager's request is answered
+    ASSERT_EQ(encode_negotiate_redfish_parameters_resp(
+                  4, PLDM_SUCCESS, 1, capabilities, features, 0, "V",
+                  PLDM_RDE_VARSTRING_ASCII, responseMsg),
+              PLDM_SUCCESS);
+    ASSERT_EQ(pldm_rde_discovery_push_response(&managers[0], &managers[0].ctx[0],
+                                               responseMsg, response.size()),
+              PLDM_RDE_REQUESTER_SUCCESS);
+
+    auto result = snapshot();
+    ASSERT_EQ(result.count, 1);
+    EXPECT_EQ(result.commands[0].type, PLDM_RDE);
+    EXPECT_EQ(result.commands[0].command, PLDM_NEGOTIATE_REDFISH_PARAMETERS);
+    EXPECT_EQ(result.commands[0].requests, 2);
+    EXPECT_EQ(result.commands[0].request_bytes,
+              2 * (sizeof(pldm_msg_hdr) +
+                   sizeof(struct pldm_rde_negotiate_redfish_parameters_req)));
+    EXPECT_EQ(result.commands[0].responses, 1);
+    EXPECT_EQ(result.commands[0].errors, 0);
+    EXPECT_EQ(timed(result.commands[0]), 1);
+
+    for (auto& manager : managers)
+    {
+        free(manager.ctx);
+    }
+}
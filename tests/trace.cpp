@@ -0,0 +1,153 @@
+#include <libpldm/base.h>
+#include <libpldm/pldm_rde.h>
+#include <libpldm/requester/pldm_rde_requester.h>
+#include <libpldm/trace.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+struct TraceMessage
+{
+    enum pldm_trace_level level;
+    uint32_t category;
+    std::string message;
+};
+
+static void collect(void* arg, enum pldm_trace_level level, uint32_t category,
+                    const char* message)
+{
+    auto* messages = static_cast<std::vector<TraceMessage>*>(arg);
+    messages->push_back({level, category, message});
+}
+
+struct TaggedSink
+{
+    pldm_trace_sink_fn sink;
+    std::atomic<unsigned int> calls;
+    std::atomic<unsigned int> mismatches;
+};
+
+static void taggedFirst(void* arg, enum pldm_trace_level, uint32_t,
+                        const char*)
+{
+    auto* tagged = static_cast<TaggedSink*>(arg);
+    tagged->calls++;
+    tagged->mismatches += tagged->sink != taggedFirst;
+}
+
+static void taggedSecond(void* arg, enum pldm_trace_level, uint32_t,
+                         const char*)
+{
+    auto* tagged = static_cast<TaggedSink*>(arg);
+    tagged->calls++;
+    tagged->mismatches += tagged->sink != taggedSecond;
+}
+
+class Trace : public testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        pldm_trace_set_sink(collect, &messages);
+    }
+
+    void TearDown() override
+    {
+        pldm_trace_set_level(PLDM_TRACE_ERROR, 0);
+        pldm_trace_set_sink(nullptr, nullptr);
+    }
+
+    std::vector<TraceMessage> messages;
+};
+
+TEST_F(Trace, NothingIsEnabledInitially)
+{
+    uint8_t completion_code = 0;
+
+    EXPECT_EQ(decode_rde_operation_complete_resp(nullptr, 0, &completion_code),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_TRUE(messages.empty());
+}
+
+TEST_F(Trace, SinkReceivesEnabledMessages)
+{
+    uint8_t completion_code = 0;
+
+    pldm_trace_set_level(PLDM_TRACE_ERROR, PLDM_TRACE_RDE);
+    EXPECT_EQ(decode_rde_operation_complete_resp(nullptr, 0, &completion_code),
+              PLDM_ERROR_INVALID_DATA);
+
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0].level, PLDM_TRACE_ERROR);
+    EXPECT_EQ(messages[0].category, PLDM_TRACE_RDE);
+    // The trailing newline is stripped
+    EXPECT_EQ(messages[0].message, "Invalid message object");
+}
+
+TEST_F(Trace, FiltersByCategory)
+{
+    uint8_t completion_code = 0;
+
+    pldm_trace_set_level(PLDM_TRACE_DEBUG, PLDM_TRACE_ALL_CATEGORIES &
+                                               ~PLDM_TRACE_RDE);
+    EXPECT_EQ(decode_rde_operation_complete_resp(nullptr, 0, &completion_code),
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_TRUE(messages.empty());
+}
+
+TEST_F(Trace, FiltersByLevel)
+{
+    pldm_trace_set_level(PLDM_TRACE_WARNING, PLDM_TRACE_RDE_REQUESTER);
+    EXPECT_EQ(pldm_rde_init_context("dev", 1, nullptr, 1, 0, nullptr, nullptr,
+                                    nullptr),
+              PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0].level, PLDM_TRACE_ERROR);
+    EXPECT_EQ(messages[0].category, PLDM_TRACE_RDE_REQUESTER);
+
+    messages.clear();
+    pldm_trace_set_level(PLDM_TRACE_INFO, PLDM_TRACE_RDE_REQUESTER);
+    EXPECT_EQ(pldm_rde_init_context("dev", 1, nullptr, 1, 0, nullptr, nullptr,
+                                    nullptr),
+              PLDM_RDE_CONTEXT_INITIALIZATION_ERROR);
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0].level, PLDM_TRACE_INFO);
+    EXPECT_EQ(messages[0].message, "Initializing Context Manager...");
+    EXPECT_EQ(messages[1].level, PLDM_TRACE_ERROR);
+}
+
+TEST_F(Trace, SinkIsReplacedWithItsArgument)
+{
+    TaggedSink first{taggedFirst, {0}, {0}};
+    TaggedSink second{taggedSecond, {0}, {0}};
+    std::atomic<bool> done{false};
+    uint8_t completion_code = 0;
+
+    unsigned int traced = 0;
+
+    pldm_trace_set_level(PLDM_TRACE_ERROR, PLDM_TRACE_RDE);
+    pldm_trace_set_sink(taggedFirst, &first);
+    std::thread installer([&] {
+        while (!done)
+        {
+            pldm_trace_set_sink(taggedFirst, &first);
+            pldm_trace_set_sink(taggedSecond, &second);
+        }
+    });
+    // Until both sinks have seen messages
+    while (traced < 10000 || !second.calls)
+    {
+        decode_rde_operation_complete_resp(nullptr, 0, &completion_code);
+        traced++;
+    }
+    done = true;
+    installer.join();
+
+    EXPECT_EQ(first.calls + second.calls, traced);
+    EXPECT_EQ(first.mismatches, 0u);
+    EXPECT_EQ(second.mismatches, 0u);
+}
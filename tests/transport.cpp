@@ -171,3 +171,148 @@ TEST(Transport, send_recv_req_echo)
     free(msg);
     pldm_transport_test_destroy(test);
 }
+
+TEST(Transport, recv_pooled)
+{
+    uint8_t msg[] = {0x01, 0x00, 0x01, 0x00};
+    uint8_t large[] = {0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    struct pldm_transport_test_descriptor seq[4] = {};
+    struct pldm_transport_test* test = NULL;
+    struct pldm_transport* ctx;
+    void* first;
+    void* second;
+    void* third;
+    size_t len;
+    pldm_tid_t tid;
+    int rc;
+
+    for (auto& desc : seq)
+    {
+        desc.type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV;
+        desc.recv_msg.src = 1;
+        desc.recv_msg.msg = msg;
+        desc.recv_msg.len = sizeof(msg);
+    }
+    seq[3].recv_msg.msg = large;
+    seq[3].recv_msg.len = sizeof(large);
+
+    EXPECT_EQ(pldm_transport_test_init(&test, seq, ARRAY_SIZE(seq)), 0);
+    ctx = pldm_transport_test_core(test);
+    EXPECT_EQ(pldm_transport_rx_pool_init(ctx, 1, 2), -EINVAL);
+    EXPECT_EQ(pldm_transport_rx_pool_init(ctx, 1, 8), 0);
+    EXPECT_EQ(pldm_transport_rx_pool_init(ctx, 1, 8), -EBUSY);
+
+    rc = pldm_transport_recv_msg(ctx, &tid, &first, &len);
+    ASSERT_EQ(rc, PLDM_REQUESTER_SUCCESS);
+    EXPECT_EQ(memcmp(first, msg, len), 0);
+
+    // The pool's only buffer is out, so this one comes from the heap
+    rc = pldm_transport_recv_msg(ctx, &tid, &second, &len);
+    ASSERT_EQ(rc, PLDM_REQUESTER_SUCCESS);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(memcmp(second, msg, len), 0);
+    pldm_transport_release_msg(ctx, second);
+
+    // Once handed back, the pool's buffer is used again
+    pldm_transport_release_msg(ctx, first);
+    rc = pldm_transport_recv_msg(ctx, &tid, &third, &len);
+    ASSERT_EQ(rc, PLDM_REQUESTER_SUCCESS);
+    EXPECT_EQ(third, first);
+    pldm_transport_release_msg(ctx, third);
+
+    // Messages larger than the pool's buffers are dropped
+    rc = pldm_transport_recv_msg(ctx, &tid, &first, &len);
+    EXPECT_EQ(rc, PLDM_REQUESTER_INVALID_RECV_LEN);
+    pldm_transport_test_destroy(test);
+}
+
+TEST(Transport, send_batch)
+{
+    uint8_t first[] = {0x81, 0x00, 0x01, 0x01};
+    uint8_t second[] = {0x82, 0x00, 0x01, 0x01};
+    uint8_t third[] = {0x83, 0x00, 0x01, 0x01};
+    const struct pldm_transport_test_descriptor seq[] = {
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_SEND,
+            .send_msg =
+                {
+                    .dst = 1,
+                    .msg = first,
+                    .len = sizeof(first),
+                },
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_SEND,
+            .send_msg =
+                {
+                    .dst = 2,
+                    .msg = second,
+                    .len = sizeof(second),
+                },
+        },
+    };
+    struct pldm_transport_msg msgs[] = {
+        {1, first, sizeof(first)},
+        {2, second, sizeof(second)},
+        {3, third, sizeof(third)},
+    };
+    struct pldm_transport_test* test = NULL;
+    struct pldm_transport* ctx;
+
+    EXPECT_EQ(pldm_transport_test_init(&test, seq, ARRAY_SIZE(seq)), 0);
+    ctx = pldm_transport_test_core(test);
+    EXPECT_EQ(pldm_transport_send_batch(ctx, NULL, 1),
+              PLDM_REQUESTER_INVALID_SETUP);
+    msgs[2].msg_len = 1;
+    EXPECT_EQ(pldm_transport_send_batch(ctx, msgs, ARRAY_SIZE(msgs)),
+              PLDM_REQUESTER_NOT_REQ_MSG);
+    msgs[2].msg_len = sizeof(third);
+
+    // Stops at the third, which the sequence does not expect
+    EXPECT_EQ(pldm_transport_send_batch(ctx, msgs, ARRAY_SIZE(msgs)), 2);
+    EXPECT_EQ(pldm_transport_send_batch(ctx, &msgs[2], 1),
+              PLDM_REQUESTER_SEND_FAIL);
+    pldm_transport_test_destroy(test);
+}
+
+TEST(Transport, recv_batch)
+{
+    uint8_t msg[] = {0x01, 0x00, 0x01, 0x00};
+    uint8_t req[] = {0x81, 0x00, 0x01, 0x01};
+    struct pldm_transport_test_descriptor seq[4] = {};
+    struct pldm_transport_msg msgs[4] = {};
+    struct pldm_transport_test* test = NULL;
+    struct pldm_transport* ctx;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        seq[i].type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV;
+        seq[i].recv_msg.src = i + 1;
+        seq[i].recv_msg.msg = msg;
+        seq[i].recv_msg.len = sizeof(msg);
+    }
+    seq[3].type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_SEND;
+    seq[3].send_msg.dst = 1;
+    seq[3].send_msg.msg = req;
+    seq[3].send_msg.len = sizeof(req);
+
+    EXPECT_EQ(pldm_transport_test_init(&test, seq, ARRAY_SIZE(seq)), 0);
+    ctx = pldm_transport_test_core(test);
+    EXPECT_EQ(pldm_transport_recv_batch(ctx, msgs, 0),
+              PLDM_REQUESTER_INVALID_SETUP);
+
+    // Takes the messages waiting, and no more
+    ASSERT_EQ(pldm_transport_recv_batch(ctx, msgs, ARRAY_SIZE(msgs)), 3);
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(msgs[i].tid, i + 1);
+        EXPECT_EQ(msgs[i].msg_len, sizeof(msg));
+        EXPECT_EQ(memcmp(msgs[i].pldm_msg, msg, sizeof(msg)), 0);
+        pldm_transport_release_msg(ctx, msgs[i].pldm_msg);
+    }
+    EXPECT_EQ(pldm_transport_recv_batch(ctx, msgs, ARRAY_SIZE(msgs)),
+              PLDM_REQUESTER_RECV_FAIL);
+    EXPECT_EQ(pldm_transport_send_msg(ctx, 1, req, sizeof(req)),
+              PLDM_REQUESTER_SUCCESS);
+    pldm_transport_test_destroy(test);
+}
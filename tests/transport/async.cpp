@@ -0,0 +1,225 @@
+#include <libpldm/transport.h>
+#include <libpldm/transport/async.h>
+
+#include "array.h"
+#include "transport/test.h"
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+struct Completion
+{
+    pldm_tid_t tid;
+    std::vector<uint8_t> msg;
+    int rc;
+};
+
+static void record(void* arg, pldm_tid_t tid, const void* pldm_msg,
+                   size_t msg_len, int rc)
+{
+    auto* completions = static_cast<std::vector<Completion>*>(arg);
+    const auto* bytes = static_cast<const uint8_t*>(pldm_msg);
+
+    completions->push_back({tid, {bytes, bytes + msg_len}, rc});
+}
+
+static void handle(void* arg, pldm_tid_t tid, const void* pldm_msg,
+                   size_t msg_len)
+{
+    record(arg, tid, pldm_msg, msg_len, 0);
+}
+
+TEST(TransportAsync, DispatchesByTidAndInstanceId)
+{
+    uint8_t req1[] = {0x81, 0x00, 0x02};
+    uint8_t req2[] = {0x82, 0x00, 0x04};
+    uint8_t resp1[] = {0x01, 0x00, 0x02, 0x00};
+    uint8_t resp2[] = {0x02, 0x00, 0x04, 0x00, 0xaa};
+    uint8_t stale[] = {0x05, 0x00, 0x02, 0x00};
+    uint8_t event[] = {0x83, 0x02, 0x0a, 0x01};
+    const struct pldm_transport_test_descriptor seq[] = {
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_SEND,
+            .send_msg = {.dst = 1, .msg = req1, .len = sizeof(req1)},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_SEND,
+            .send_msg = {.dst = 2, .msg = req1, .len = sizeof(req1)},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_SEND,
+            .send_msg = {.dst = 1, .msg = req2, .len = sizeof(req2)},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV,
+            .recv_msg = {.src = 2, .msg = resp1, .len = sizeof(resp1)},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV,
+            .recv_msg = {.src = 1, .msg = event, .len = sizeof(event)},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV,
+            .recv_msg = {.src = 1, .msg = resp2, .len = sizeof(resp2)},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV,
+            .recv_msg = {.src = 1, .msg = stale, .len = sizeof(stale)},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV,
+            .recv_msg = {.src = 1, .msg = resp1, .len = sizeof(resp1)},
+        },
+    };
+    std::vector<Completion> completions;
+    std::vector<Completion> requests;
+    struct pldm_transport_async* async = NULL;
+    struct pldm_transport_test* test = NULL;
+    struct pldm_transport* ctx;
+
+    ASSERT_EQ(pldm_transport_test_init(&test, seq, ARRAY_SIZE(seq)), 0);
+    ctx = pldm_transport_test_core(test);
+    ASSERT_EQ(pldm_transport_async_init(&async, ctx), 0);
+    ASSERT_EQ(pldm_transport_async_set_request_handler(async, handle,
+                                                       &requests),
+              0);
+
+    EXPECT_EQ(pldm_transport_async_send_request(async, 1, req1, sizeof(req1),
+                                                record, &completions),
+              0);
+    EXPECT_EQ(pldm_transport_async_send_request(async, 2, req1, sizeof(req1),
+                                                record, &completions),
+              0);
+    EXPECT_EQ(pldm_transport_async_send_request(async, 1, req2, sizeof(req2),
+                                                record, &completions),
+              0);
+    // Sends nothing, as the transport would fail the unexpected message
+    EXPECT_EQ(pldm_transport_async_send_request(async, 1, req1, sizeof(req1),
+                                                record, &completions),
+              -EBUSY);
+    EXPECT_EQ(pldm_transport_async_send_request(async, 1, resp1,
+                                                sizeof(resp1), record,
+                                                &completions),
+              -EINVAL);
+    EXPECT_EQ(pldm_transport_async_pending(async), 3);
+    EXPECT_GT(pldm_transport_async_next_timeout(async), 0);
+
+    EXPECT_EQ(pldm_transport_poll(ctx, 0), 1);
+    EXPECT_EQ(pldm_transport_async_dispatch(async), 0);
+
+    ASSERT_EQ(completions.size(), 3);
+    EXPECT_EQ(completions[0].tid, 2);
+    EXPECT_EQ(completions[0].rc, 0);
+    EXPECT_EQ(completions[0].msg,
+              std::vector<uint8_t>(resp1, resp1 + sizeof(resp1)));
+    EXPECT_EQ(completions[1].tid, 1);
+    EXPECT_EQ(completions[1].rc, 0);
+    EXPECT_EQ(completions[1].msg,
+              std::vector<uint8_t>(resp2, resp2 + sizeof(resp2)));
+    EXPECT_EQ(completions[2].tid, 1);
+    EXPECT_EQ(completions[2].rc, 0);
+    EXPECT_EQ(completions[2].msg,
+              std::vector<uint8_t>(resp1, resp1 + sizeof(resp1)));
+
+    ASSERT_EQ(requests.size(), 1);
+    EXPECT_EQ(requests[0].tid, 1);
+    EXPECT_EQ(requests[0].msg,
+              std::vector<uint8_t>(event, event + sizeof(event)));
+
+    EXPECT_EQ(pldm_transport_async_pending(async), 0);
+    EXPECT_EQ(pldm_transport_async_next_timeout(async), -1);
+
+    pldm_transport_async_destroy(async);
+    pldm_transport_test_destroy(test);
+}
+
+TEST(TransportAsync, TimesOut)
+{
+    uint8_t req[] = {0x81, 0x00, 0x02};
+    uint8_t event[] = {0x83, 0x02, 0x0a, 0x01};
+    const struct pldm_transport_test_descriptor seq[] = {
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_SEND,
+            .send_msg = {.dst = 1, .msg = req, .len = sizeof(req)},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_LATENCY,
+            .latency = {.it_interval = {0, 0}, .it_value = {1, 0}},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV,
+            .recv_msg = {.src = 1, .msg = event, .len = sizeof(event)},
+        },
+    };
+    std::vector<Completion> completions;
+    struct pldm_transport_async* async = NULL;
+    struct pldm_transport_test* test = NULL;
+    struct pldm_transport* ctx;
+    int timeout;
+
+    ASSERT_EQ(pldm_transport_test_init(&test, seq, ARRAY_SIZE(seq)), 0);
+    ctx = pldm_transport_test_core(test);
+    ASSERT_EQ(pldm_transport_async_init(&async, ctx), 0);
+    ASSERT_EQ(pldm_transport_async_set_timeout(async, 10), 0);
+
+    EXPECT_EQ(pldm_transport_async_send_request(async, 1, req, sizeof(req),
+                                                record, &completions),
+              0);
+
+    timeout = pldm_transport_async_next_timeout(async);
+    EXPECT_GE(timeout, 0);
+    EXPECT_LE(timeout, 10);
+    EXPECT_EQ(pldm_transport_poll(ctx, timeout), 0);
+
+    // Without a handler the request received is dropped
+    EXPECT_EQ(pldm_transport_async_dispatch(async), 0);
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].tid, 1);
+    EXPECT_EQ(completions[0].rc, -ETIMEDOUT);
+    EXPECT_TRUE(completions[0].msg.empty());
+    EXPECT_EQ(pldm_transport_async_pending(async), 0);
+
+    pldm_transport_async_destroy(async);
+    pldm_transport_test_destroy(test);
+}
+
+TEST(TransportAsync, DestroyCancels)
+{
+    uint8_t req[] = {0x81, 0x00, 0x02};
+    uint8_t resp[] = {0x01, 0x00, 0x02, 0x00};
+    const struct pldm_transport_test_descriptor seq[] = {
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_SEND,
+            .send_msg = {.dst = 1, .msg = req, .len = sizeof(req)},
+        },
+        {
+            .type = PLDM_TRANSPORT_TEST_ELEMENT_MSG_RECV,
+            .recv_msg = {.src = 1, .msg = resp, .len = sizeof(resp)},
+        },
+    };
+    std::vector<Completion> completions;
+    struct pldm_transport_async* async = NULL;
+    struct pldm_transport_test* test = NULL;
+
+    ASSERT_EQ(pldm_transport_test_init(&test, seq, ARRAY_SIZE(seq)), 0);
+    ASSERT_EQ(
+        pldm_transport_async_init(&async, pldm_transport_test_core(test)), 0);
+
+    EXPECT_EQ(pldm_transport_async_send_request(async, 1, req, sizeof(req),
+                                                record, &completions),
+              0);
+    // The transport expects no further send
+    EXPECT_EQ(pldm_transport_async_send_request(async, 2, req, sizeof(req),
+                                                record, &completions),
+              -EIO);
+    EXPECT_EQ(pldm_transport_async_pending(async), 1);
+
+    pldm_transport_async_destroy(async);
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].tid, 1);
+    EXPECT_EQ(completions[0].rc, -ECANCELED);
+    pldm_transport_test_destroy(test);
+}
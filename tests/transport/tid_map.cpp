@@ -0,0 +1,157 @@
+// NOLINTNEXTLINE(bugprone-suspicious-include)
+#include "transport/tid-map.c"
+
+#include <map>
+#include <random>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+TEST(TidMap, MapsBothWays)
+{
+    struct pldm_tid_map map
+    {
+    };
+    uint32_t network;
+    mctp_eid_t eid;
+    pldm_tid_t tid;
+
+    pldm_tid_map_insert(&map, 1, PLDM_TID_MAP_ANY_NETWORK, 8);
+    pldm_tid_map_insert(&map, 2, 1, 8);
+    pldm_tid_map_insert(&map, 3, 2, 9);
+
+    ASSERT_EQ(pldm_tid_map_lookup_eid(&map, 2, &network, &eid), 0);
+    EXPECT_EQ(network, 1);
+    EXPECT_EQ(eid, 8);
+    ASSERT_EQ(pldm_tid_map_lookup_tid(&map, 1, 8, &tid), 0);
+    EXPECT_EQ(tid, 2);
+    ASSERT_EQ(pldm_tid_map_lookup_tid(&map, 2, 9, &tid), 0);
+    EXPECT_EQ(tid, 3);
+
+    // EID 8 mapped on any network covers the networks without their own
+    ASSERT_EQ(pldm_tid_map_lookup_tid(&map, 5, 8, &tid), 0);
+    EXPECT_EQ(tid, 1);
+    EXPECT_EQ(pldm_tid_map_lookup_tid(&map, 1, 9, &tid), -1);
+    EXPECT_EQ(pldm_tid_map_lookup_eid(&map, 4, &network, &eid), -1);
+    EXPECT_EQ(pldm_tid_map_lookup_eid(&map, 0, &network, &eid), -1);
+}
+
+TEST(TidMap, ReplacesMappings)
+{
+    struct pldm_tid_map map
+    {
+    };
+    uint32_t network;
+    mctp_eid_t eid;
+    pldm_tid_t tid;
+
+    pldm_tid_map_insert(&map, 2, 1, 8);
+
+    // The TID moves to the new endpoint
+    pldm_tid_map_insert(&map, 2, 3, 10);
+    EXPECT_EQ(pldm_tid_map_lookup_tid(&map, 1, 8, &tid), -1);
+    ASSERT_EQ(pldm_tid_map_lookup_eid(&map, 2, &network, &eid), 0);
+    EXPECT_EQ(network, 3);
+    EXPECT_EQ(eid, 10);
+
+    // The endpoint moves to the new TID
+    pldm_tid_map_insert(&map, 4, 3, 10);
+    EXPECT_EQ(pldm_tid_map_lookup_eid(&map, 2, &network, &eid), -1);
+    ASSERT_EQ(pldm_tid_map_lookup_tid(&map, 3, 10, &tid), 0);
+    EXPECT_EQ(tid, 4);
+
+    // TID 0 leaves the endpoint unmapped
+    pldm_tid_map_insert(&map, 0, 3, 10);
+    EXPECT_EQ(pldm_tid_map_lookup_tid(&map, 3, 10, &tid), -1);
+    EXPECT_EQ(pldm_tid_map_lookup_eid(&map, 4, &network, &eid), -1);
+
+    pldm_tid_map_insert(&map, 5, 3, 11);
+    pldm_tid_map_remove(&map, 3, 11);
+    EXPECT_EQ(pldm_tid_map_lookup_tid(&map, 3, 11, &tid), -1);
+    EXPECT_EQ(pldm_tid_map_lookup_eid(&map, 5, &network, &eid), -1);
+}
+
+TEST(TidMap, MatchesReferenceWhenFull)
+{
+    std::map<std::pair<uint32_t, mctp_eid_t>, pldm_tid_t> endpoints;
+    std::map<pldm_tid_t, std::pair<uint32_t, mctp_eid_t>> tids;
+    std::mt19937 rng(1);
+    struct pldm_tid_map map
+    {
+    };
+
+    for (int i = 0; i < 20000; i++)
+    {
+        // Few networks and EIDs, so that TIDs collide and move around
+        pldm_tid_t tid = 1 + rng() % 255;
+        uint32_t network = rng() % 4;
+        mctp_eid_t eid = rng() % 96;
+
+        if (rng() % 3)
+        {
+            auto old = tids.find(tid);
+            if (old != tids.end())
+            {
+                endpoints.erase(old->second);
+            }
+            auto taken = endpoints.find({network, eid});
+            if (taken != endpoints.end())
+            {
+                tids.erase(taken->second);
+            }
+            endpoints[{network, eid}] = tid;
+            tids[tid] = {network, eid};
+            pldm_tid_map_insert(&map, tid, network, eid);
+        }
+        else
+        {
+            auto taken = endpoints.find({network, eid});
+            if (taken != endpoints.end())
+            {
+                tids.erase(taken->second);
+                endpoints.erase(taken);
+            }
+            pldm_tid_map_remove(&map, network, eid);
+        }
+    }
+
+    for (int t = 1; t < PLDM_MAX_TIDS; t++)
+    {
+        auto tid = static_cast<pldm_tid_t>(t);
+        uint32_t network;
+        mctp_eid_t eid;
+
+        auto expected = tids.find(tid);
+        if (expected == tids.end())
+        {
+            EXPECT_EQ(pldm_tid_map_lookup_eid(&map, tid, &network, &eid), -1);
+            continue;
+        }
+        ASSERT_EQ(pldm_tid_map_lookup_eid(&map, tid, &network, &eid), 0);
+        EXPECT_EQ(network, expected->second.first);
+        EXPECT_EQ(eid, expected->second.second);
+    }
+
+    for (uint32_t network = 0; network < 4; network++)
+    {
+        for (int e = 0; e < 96; e++)
+        {
+            auto eid = static_cast<mctp_eid_t>(e);
+            pldm_tid_t tid;
+
+            auto expected = endpoints.find({network, eid});
+            if (expected == endpoints.end() && network)
+            {
+                expected = endpoints.find({PLDM_TID_MAP_ANY_NETWORK, eid});
+            }
+            if (expected == endpoints.end())
+            {
+                EXPECT_EQ(pldm_tid_map_lookup_tid(&map, network, eid, &tid),
+                          -1);
+                continue;
+            }
+            ASSERT_EQ(pldm_tid_map_lookup_tid(&map, network, eid, &tid), 0);
+            EXPECT_EQ(tid, expected->second);
+        }
+    }
+}